@@ -0,0 +1,213 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <aasdk/Transport/SSLWrapper.hpp>
+#include <aasdk/Messenger/Cryptor.hpp>
+#include <aasdk/Error/Error.hpp>
+
+// Runs a client Cryptor (head unit) against a server Cryptor (phone) over their memory BIOs
+// and reports handshake time plus record throughput and latency for every crypto backend.
+
+namespace
+{
+
+using namespace aasdk;
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t cMaxFramePayloadSize = 0x4000;
+constexpr size_t cHandshakeRepetitions = 20;
+constexpr size_t cBytesPerFrameSize = 64 * 1024 * 1024;
+constexpr size_t cMaxRecordsPerFrameSize = 200000;
+
+struct CryptorPair
+{
+    messenger::Cryptor::Pointer client;
+    messenger::Cryptor::Pointer server;
+};
+
+struct LatencySummary
+{
+    double megabytesPerSecond;
+    double meanMicroseconds;
+    double p99Microseconds;
+};
+
+double toMicroseconds(Clock::duration duration)
+{
+    return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+LatencySummary summarize(std::vector<Clock::duration>& latencies, size_t recordSize)
+{
+    Clock::duration total(0);
+    for(const auto& latency : latencies)
+    {
+        total += latency;
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    const auto p99 = latencies[std::min(latencies.size() - 1, latencies.size() * 99 / 100)];
+    const auto seconds = std::chrono::duration<double>(total).count();
+
+    return LatencySummary{
+        seconds > 0 ? (static_cast<double>(recordSize) * latencies.size()) / (1024 * 1024) / seconds : 0,
+        toMicroseconds(total) / latencies.size(),
+        toMicroseconds(p99)
+    };
+}
+
+CryptorPair handshake(transport::ISSLWrapper::Pointer sslWrapper)
+{
+    CryptorPair pair{std::make_shared<messenger::Cryptor>(sslWrapper),
+                     std::make_shared<messenger::Cryptor>(sslWrapper, messenger::Cryptor::Role::SERVER)};
+
+    pair.client->init();
+    pair.server->init();
+
+    bool isClientDone = false;
+    bool isServerDone = false;
+
+    while(!isClientDone || !isServerDone)
+    {
+        isClientDone = pair.client->doHandshake();
+        const auto clientFlight = pair.client->readHandshakeBuffer();
+        if(!clientFlight.empty())
+        {
+            pair.server->writeHandshakeBuffer(common::DataConstBuffer(clientFlight));
+        }
+
+        isServerDone = pair.server->doHandshake();
+        const auto serverFlight = pair.server->readHandshakeBuffer();
+        if(!serverFlight.empty())
+        {
+            pair.client->writeHandshakeBuffer(common::DataConstBuffer(serverFlight));
+        }
+    }
+
+    return pair;
+}
+
+void runBackend(const std::string& cryptoBackend)
+{
+    auto sslWrapper = std::make_shared<transport::SSLWrapper>(cryptoBackend);
+
+    Clock::duration handshakeDuration(0);
+    for(size_t i = 0; i < cHandshakeRepetitions; ++i)
+    {
+        const auto start = Clock::now();
+        auto pair = handshake(sslWrapper);
+        handshakeDuration += Clock::now() - start;
+
+        pair.client->deinit();
+        pair.server->deinit();
+    }
+
+    std::cout << std::endl << "Backend: " << sslWrapper->getCryptoBackend() << std::endl;
+    std::cout << "Handshake: " << std::fixed << std::setprecision(1) << toMicroseconds(handshakeDuration) / cHandshakeRepetitions << " us" << std::endl;
+    std::cout << std::setw(8) << "Size"
+              << std::setw(14) << "Enc MB/s" << std::setw(14) << "Enc us" << std::setw(14) << "Enc p99 us"
+              << std::setw(14) << "Dec MB/s" << std::setw(14) << "Dec us" << std::setw(14) << "Dec p99 us" << std::endl;
+
+    auto pair = handshake(sslWrapper);
+
+    for(size_t recordSize = 64; recordSize <= cMaxFramePayloadSize; recordSize *= 4)
+    {
+        const common::Data payload(recordSize, 0x5A);
+        const auto recordCount = std::min(cMaxRecordsPerFrameSize, cBytesPerFrameSize / recordSize);
+
+        std::vector<Clock::duration> encryptLatencies;
+        std::vector<Clock::duration> decryptLatencies;
+        encryptLatencies.reserve(recordCount);
+        decryptLatencies.reserve(recordCount);
+
+        common::Data encrypted;
+        common::Data decrypted;
+        encrypted.reserve(recordSize + 64);
+        decrypted.reserve(recordSize);
+
+        for(size_t i = 0; i < recordCount; ++i)
+        {
+            error::Error e;
+            encrypted.clear();
+            decrypted.clear();
+
+            auto start = Clock::now();
+            pair.client->encrypt(encrypted, common::DataConstBuffer(payload), e);
+            encryptLatencies.push_back(Clock::now() - start);
+
+            start = Clock::now();
+            pair.server->decrypt(decrypted, common::DataConstBuffer(encrypted), static_cast<int>(encrypted.size()), e);
+            decryptLatencies.push_back(Clock::now() - start);
+
+            if(e != error::ErrorCode::NONE || decrypted.size() != recordSize)
+            {
+                std::cerr << "Record round trip failed: " << e.what() << std::endl;
+                std::exit(EXIT_FAILURE);
+            }
+        }
+
+        const auto encryptSummary = summarize(encryptLatencies, recordSize);
+        const auto decryptSummary = summarize(decryptLatencies, recordSize);
+
+        std::cout << std::setw(8) << recordSize
+                  << std::setw(14) << encryptSummary.megabytesPerSecond << std::setw(14) << encryptSummary.meanMicroseconds << std::setw(14) << encryptSummary.p99Microseconds
+                  << std::setw(14) << decryptSummary.megabytesPerSecond << std::setw(14) << decryptSummary.meanMicroseconds << std::setw(14) << decryptSummary.p99Microseconds << std::endl;
+    }
+
+    pair.client->deinit();
+    pair.server->deinit();
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> cryptoBackends;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        cryptoBackends.emplace_back(argv[i]);
+    }
+
+    if(cryptoBackends.empty())
+    {
+        cryptoBackends = aasdk::transport::SSLWrapper::getAvailableCryptoBackends();
+    }
+
+    try
+    {
+        for(const auto& cryptoBackend : cryptoBackends)
+        {
+            runBackend(cryptoBackend);
+        }
+    }
+    catch(const aasdk::error::Error& e)
+    {
+        std::cerr << "Benchmark failed: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
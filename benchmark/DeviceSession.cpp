@@ -0,0 +1,316 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <aasdk_proto/AVStreamTypeEnum.pb.h>
+#include <aasdk_proto/AudioTypeEnum.pb.h>
+#include <aasdk_proto/StatusEnum.pb.h>
+#include <aasdk/Version.hpp>
+#include <aasdk/Messenger/Cryptor.hpp>
+#include <aasdk/Messenger/MessageInStream.hpp>
+#include <aasdk/Messenger/MessageOutStream.hpp>
+#include <aasdk/Messenger/Messenger.hpp>
+#include <aasdk/Channel/Control/DeviceControlServiceChannel.hpp>
+#include <aasdk/Channel/AV/AVSourceServiceChannel.hpp>
+#include <aasdk/Common/Log.hpp>
+#include "DeviceSession.hpp"
+
+
+namespace aasdk
+{
+namespace benchmark
+{
+
+DeviceSession::DeviceSession(asio::io_service& ioService, transport::ITransport::Pointer transport, transport::ISSLWrapper::Pointer sslWrapper, Configuration configuration)
+    : ioService_(ioService)
+    , strand_(ioService)
+    , transport_(std::move(transport))
+    , cryptor_(std::make_shared<messenger::Cryptor>(std::move(sslWrapper), messenger::Cryptor::Role::SERVER))
+    , messenger_(std::make_shared<messenger::Messenger>(ioService,
+                                                        std::make_shared<messenger::MessageInStream>(ioService, transport_, cryptor_),
+                                                        std::make_shared<messenger::MessageOutStream>(ioService, transport_, cryptor_)))
+    , controlServiceChannel_(std::make_shared<channel::control::DeviceControlServiceChannel>(strand_, messenger_))
+    , configuration_(std::move(configuration))
+    , isStopped_(false)
+{
+
+}
+
+void DeviceSession::start()
+{
+    strand_.dispatch([this, self = this->shared_from_this()]() {
+        cryptor_->init();
+        controlServiceChannel_->receive(this->shared_from_this());
+    });
+}
+
+void DeviceSession::stop()
+{
+    strand_.dispatch([this, self = this->shared_from_this()]() {
+        if(isStopped_)
+        {
+            return;
+        }
+
+        isStopped_ = true;
+
+        std::lock_guard<decltype(mutex_)> lock(mutex_);
+        for(auto& mediaStream : mediaStreams_)
+        {
+            mediaStream.second->stop();
+        }
+
+        messenger_->stop();
+        transport_->stop();
+        cryptor_->deinit();
+    });
+}
+
+DeviceSession::Statistics DeviceSession::getStatistics() const
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    Statistics statistics;
+    for(const auto& mediaStream : mediaStreams_)
+    {
+        statistics.emplace(mediaStream.first, mediaStream.second->getStatistics());
+    }
+
+    return statistics;
+}
+
+void DeviceSession::onVersionRequest(uint16_t majorCode, uint16_t minorCode)
+{
+    AASDK_LOG(info) << "[DeviceSession] version request, major: " << majorCode << ", minor: " << minorCode;
+
+    const auto status = majorCode == AASDK_MAJOR ? proto::enums::VersionResponseStatus::MATCH : proto::enums::VersionResponseStatus::MISMATCH;
+    controlServiceChannel_->sendVersionResponse(AASDK_MAJOR, AASDK_MINOR, status, this->createSendPromise());
+    controlServiceChannel_->receive(this->shared_from_this());
+}
+
+void DeviceSession::onHandshake(const common::DataConstBuffer& payload)
+{
+    try
+    {
+        cryptor_->writeHandshakeBuffer(payload);
+        cryptor_->doHandshake();
+
+        auto handshakeBuffer = cryptor_->readHandshakeBuffer();
+        if(!handshakeBuffer.empty())
+        {
+            controlServiceChannel_->sendHandshake(std::move(handshakeBuffer), this->createSendPromise());
+        }
+
+        controlServiceChannel_->receive(this->shared_from_this());
+    }
+    catch(const error::Error& e)
+    {
+        this->onChannelError(e);
+    }
+}
+
+void DeviceSession::onAuthComplete(const proto::messages::AuthCompleteIndication& indication)
+{
+    if(indication.status() != proto::enums::Status::OK || !cryptor_->isActive())
+    {
+        this->onChannelError(error::Error(error::ErrorCode::SSL_HANDSHAKE));
+        return;
+    }
+
+    proto::messages::ServiceDiscoveryRequest request;
+    request.set_device_name(configuration_.deviceName);
+    request.set_device_brand(configuration_.deviceBrand);
+
+    controlServiceChannel_->sendServiceDiscoveryRequest(request, this->createSendPromise());
+    controlServiceChannel_->receive(this->shared_from_this());
+}
+
+void DeviceSession::onServiceDiscoveryResponse(const proto::messages::ServiceDiscoveryResponse& response)
+{
+    AASDK_LOG(info) << "[DeviceSession] service discovery response, head unit: " << response.head_unit_name() << ", channels: " << response.channels_size();
+
+    for(const auto& channelDescriptor : response.channels())
+    {
+        if(!channelDescriptor.has_av_channel())
+        {
+            continue;
+        }
+
+        const auto channelId = static_cast<messenger::ChannelId>(channelDescriptor.channel_id());
+        const auto& avChannel = channelDescriptor.av_channel();
+
+        if(configuration_.isVideoEnabled && avChannel.stream_type() == proto::enums::AVStreamType::VIDEO)
+        {
+            this->openStream(channelId, configuration_.video);
+        }
+        else if(configuration_.isAudioEnabled && avChannel.stream_type() == proto::enums::AVStreamType::AUDIO
+                && avChannel.audio_type() == proto::enums::AudioType::MEDIA)
+        {
+            this->openStream(channelId, configuration_.audio);
+        }
+    }
+
+    controlServiceChannel_->receive(this->shared_from_this());
+}
+
+void DeviceSession::onShutdownRequest(const proto::messages::ShutdownRequest&)
+{
+    controlServiceChannel_->sendShutdownResponse(proto::messages::ShutdownResponse(), this->createSendPromise());
+    this->stop();
+}
+
+void DeviceSession::onShutdownResponse(const proto::messages::ShutdownResponse&)
+{
+    this->stop();
+}
+
+void DeviceSession::onPingRequest(const proto::messages::PingRequest& request)
+{
+    proto::messages::PingResponse response;
+    response.set_timestamp(request.timestamp());
+    controlServiceChannel_->sendPingResponse(response, this->createSendPromise());
+    controlServiceChannel_->receive(this->shared_from_this());
+}
+
+void DeviceSession::onPingResponse(const proto::messages::PingResponse&)
+{
+    controlServiceChannel_->receive(this->shared_from_this());
+}
+
+void DeviceSession::onChannelError(const error::Error& e)
+{
+    if(!isStopped_ && e != error::ErrorCode::OPERATION_ABORTED)
+    {
+        AASDK_LOG(error) << "[DeviceSession] channel error: " << e.what();
+    }
+
+    this->stop();
+}
+
+channel::SendPromise::Pointer DeviceSession::createSendPromise()
+{
+    auto promise = channel::SendPromise::defer(strand_);
+    promise->then([]() {}, std::bind(&DeviceSession::onChannelError, this->shared_from_this(), std::placeholders::_1));
+    return promise;
+}
+
+void DeviceSession::openStream(messenger::ChannelId channelId, const channel::av::AVMediaSource::Configuration& configuration)
+{
+    auto mediaStream = std::make_shared<MediaStream>(ioService_, strand_, messenger_, channelId, configuration);
+
+    {
+        std::lock_guard<decltype(mutex_)> lock(mutex_);
+        if(!mediaStreams_.emplace(channelId, mediaStream).second)
+        {
+            return;
+        }
+    }
+
+    mediaStream->open();
+}
+
+DeviceSession::MediaStream::MediaStream(asio::io_service& ioService, asio::io_service::strand& strand, messenger::IMessenger::Pointer messenger,
+                                        messenger::ChannelId channelId, channel::av::AVMediaSource::Configuration configuration)
+    : strand_(strand)
+    , channel_(std::make_shared<channel::av::AVSourceServiceChannel>(strand, std::move(messenger), channelId))
+    , source_(std::make_shared<channel::av::AVMediaSource>(ioService, channel_, std::move(configuration)))
+{
+
+}
+
+void DeviceSession::MediaStream::open()
+{
+    proto::messages::ChannelOpenRequest request;
+    request.set_priority(0);
+    request.set_channel_id(static_cast<int32_t>(channel_->getId()));
+
+    channel_->sendChannelOpenRequest(request, this->createSendPromise());
+    channel_->receive(this->shared_from_this());
+}
+
+void DeviceSession::MediaStream::stop()
+{
+    source_->stop();
+}
+
+channel::av::AVMediaSource::Statistics DeviceSession::MediaStream::getStatistics() const
+{
+    return source_->getStatistics();
+}
+
+void DeviceSession::MediaStream::onChannelOpenResponse(const proto::messages::ChannelOpenResponse& response)
+{
+    if(response.status() != proto::enums::Status::OK)
+    {
+        AASDK_LOG(error) << "[DeviceSession] channel " << messenger::channelIdToString(channel_->getId()) << " rejected";
+        return;
+    }
+
+    proto::messages::AVChannelSetupRequest request;
+    request.set_config_index(0);
+
+    channel_->sendAVChannelSetupRequest(request, this->createSendPromise());
+    channel_->receive(this->shared_from_this());
+}
+
+void DeviceSession::MediaStream::onAVChannelSetupResponse(const proto::messages::AVChannelSetupResponse& response)
+{
+    if(response.media_status() != proto::enums::AVChannelSetupStatus::OK)
+    {
+        AASDK_LOG(error) << "[DeviceSession] channel " << messenger::channelIdToString(channel_->getId()) << " setup failed";
+        return;
+    }
+
+    proto::messages::AVChannelStartIndication indication;
+    indication.set_session(0);
+    indication.set_config(response.configs_size() > 0 ? response.configs(0) : 0);
+
+    channel_->sendAVChannelStartIndication(indication, this->createSendPromise());
+    source_->start(response.max_unacked());
+    channel_->receive(this->shared_from_this());
+}
+
+void DeviceSession::MediaStream::onAVMediaAckIndication(const proto::messages::AVMediaAckIndication& indication)
+{
+    source_->onAck(indication.value());
+    channel_->receive(this->shared_from_this());
+}
+
+void DeviceSession::MediaStream::onVideoFocusIndication(const proto::messages::VideoFocusIndication&)
+{
+    channel_->receive(this->shared_from_this());
+}
+
+void DeviceSession::MediaStream::onChannelError(const error::Error& e)
+{
+    if(e != error::ErrorCode::OPERATION_ABORTED)
+    {
+        AASDK_LOG(error) << "[DeviceSession] channel " << messenger::channelIdToString(channel_->getId()) << " error: " << e.what();
+    }
+
+    source_->stop();
+}
+
+channel::SendPromise::Pointer DeviceSession::MediaStream::createSendPromise()
+{
+    auto promise = channel::SendPromise::defer(strand_);
+    promise->then([]() {}, std::bind(&MediaStream::onChannelError, this->shared_from_this(), std::placeholders::_1));
+    return promise;
+}
+
+}
+}
@@ -0,0 +1,119 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <asio.hpp>
+#include <aasdk/Transport/ITransport.hpp>
+#include <aasdk/Transport/ISSLWrapper.hpp>
+#include <aasdk/Messenger/ICryptor.hpp>
+#include <aasdk/Messenger/IMessenger.hpp>
+#include <aasdk/Channel/Control/IDeviceControlServiceChannel.hpp>
+#include <aasdk/Channel/AV/IAVSourceServiceChannel.hpp>
+#include <aasdk/Channel/AV/AVMediaSource.hpp>
+
+
+namespace aasdk
+{
+namespace benchmark
+{
+
+// Phone role of a projection session: answers the version request, performs the TLS handshake as
+// the server, requests service discovery and then streams synthetic media on every video and media
+// audio channel the head unit announces.
+class DeviceSession: public channel::control::IDeviceControlServiceChannelEventHandler, public std::enable_shared_from_this<DeviceSession>
+{
+public:
+    typedef std::shared_ptr<DeviceSession> Pointer;
+    typedef std::map<messenger::ChannelId, channel::av::AVMediaSource::Statistics> Statistics;
+
+    struct Configuration
+    {
+        std::string deviceName = "aasdk loopback device";
+        std::string deviceBrand = "aasdk";
+        bool isVideoEnabled = true;
+        channel::av::AVMediaSource::Configuration video;
+        bool isAudioEnabled = false;
+        channel::av::AVMediaSource::Configuration audio;
+    };
+
+    DeviceSession(asio::io_service& ioService, transport::ITransport::Pointer transport, transport::ISSLWrapper::Pointer sslWrapper, Configuration configuration);
+
+    void start();
+    void stop();
+    Statistics getStatistics() const;
+
+    void onVersionRequest(uint16_t majorCode, uint16_t minorCode) override;
+    void onHandshake(const common::DataConstBuffer& payload) override;
+    void onAuthComplete(const proto::messages::AuthCompleteIndication& indication) override;
+    void onServiceDiscoveryResponse(const proto::messages::ServiceDiscoveryResponse& response) override;
+    void onShutdownRequest(const proto::messages::ShutdownRequest& request) override;
+    void onShutdownResponse(const proto::messages::ShutdownResponse& response) override;
+    void onPingRequest(const proto::messages::PingRequest& request) override;
+    void onPingResponse(const proto::messages::PingResponse& response) override;
+    void onChannelError(const error::Error& e) override;
+
+private:
+    using std::enable_shared_from_this<DeviceSession>::shared_from_this;
+
+    class MediaStream: public channel::av::IAVSourceServiceChannelEventHandler, public std::enable_shared_from_this<MediaStream>
+    {
+    public:
+        typedef std::shared_ptr<MediaStream> Pointer;
+
+        MediaStream(asio::io_service& ioService, asio::io_service::strand& strand, messenger::IMessenger::Pointer messenger,
+                    messenger::ChannelId channelId, channel::av::AVMediaSource::Configuration configuration);
+
+        void open();
+        void stop();
+        channel::av::AVMediaSource::Statistics getStatistics() const;
+
+        void onChannelOpenResponse(const proto::messages::ChannelOpenResponse& response) override;
+        void onAVChannelSetupResponse(const proto::messages::AVChannelSetupResponse& response) override;
+        void onAVMediaAckIndication(const proto::messages::AVMediaAckIndication& indication) override;
+        void onVideoFocusIndication(const proto::messages::VideoFocusIndication& indication) override;
+        void onChannelError(const error::Error& e) override;
+
+    private:
+        channel::SendPromise::Pointer createSendPromise();
+
+        asio::io_service::strand& strand_;
+        channel::av::IAVSourceServiceChannel::Pointer channel_;
+        channel::av::AVMediaSource::Pointer source_;
+    };
+
+    channel::SendPromise::Pointer createSendPromise();
+    void openStream(messenger::ChannelId channelId, const channel::av::AVMediaSource::Configuration& configuration);
+
+    asio::io_service& ioService_;
+    asio::io_service::strand strand_;
+    transport::ITransport::Pointer transport_;
+    messenger::ICryptor::Pointer cryptor_;
+    messenger::IMessenger::Pointer messenger_;
+    channel::control::IDeviceControlServiceChannel::Pointer controlServiceChannel_;
+    Configuration configuration_;
+    mutable std::mutex mutex_;
+    std::map<messenger::ChannelId, MediaStream::Pointer> mediaStreams_;
+    bool isStopped_;
+};
+
+}
+}
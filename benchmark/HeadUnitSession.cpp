@@ -0,0 +1,410 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <functional>
+#include <aasdk_proto/AVStreamTypeEnum.pb.h>
+#include <aasdk_proto/AudioTypeEnum.pb.h>
+#include <aasdk_proto/StatusEnum.pb.h>
+#include <aasdk_proto/VideoResolutionEnum.pb.h>
+#include <aasdk_proto/VideoFPSEnum.pb.h>
+#include <aasdk/Messenger/Cryptor.hpp>
+#include <aasdk/Messenger/MessageInStream.hpp>
+#include <aasdk/Messenger/MessageOutStream.hpp>
+#include <aasdk/Messenger/Messenger.hpp>
+#include <aasdk/Transport/Transport.hpp>
+#include <aasdk/Channel/Control/ControlServiceChannel.hpp>
+#include <aasdk/Channel/AV/VideoServiceChannel.hpp>
+#include <aasdk/Channel/AV/MediaAudioServiceChannel.hpp>
+#include <aasdk/Channel/AV/AVMediaSource.hpp>
+#include <aasdk/Channel/AV/AVMediaAckEngine.hpp>
+#include <aasdk/Common/Log.hpp>
+#include "HeadUnitSession.hpp"
+
+
+namespace aasdk
+{
+namespace benchmark
+{
+
+namespace
+{
+
+typedef std::function<void(messenger::Timestamp::ValueType, size_t)> MediaCallback;
+typedef std::function<void(const error::Error&)> ErrorCallback;
+
+// Reports every frame to the session and hands it back to the ack engine right away, as a
+// consumer which renders instantly would. Shared by the video and audio sinks, whose channel
+// interfaces only differ in the video focus messages.
+template<typename ChannelType, typename EventHandlerType>
+class MediaSink: public EventHandlerType, public std::enable_shared_from_this<MediaSink<ChannelType, EventHandlerType>>
+{
+public:
+    MediaSink(asio::io_service::strand& strand, std::shared_ptr<ChannelType> channel, uint32_t maxUnacked, MediaCallback mediaCallback, ErrorCallback errorCallback)
+        : strand_(strand)
+        , channel_(std::move(channel))
+        , maxUnacked_(maxUnacked)
+        , ackEngine_(std::make_shared<channel::av::AVMediaAckEngine>(strand.context(), channel_))
+        , mediaCallback_(std::move(mediaCallback))
+        , errorCallback_(std::move(errorCallback))
+    {
+
+    }
+
+    void onChannelOpenRequest(const proto::messages::ChannelOpenRequest&) override
+    {
+        proto::messages::ChannelOpenResponse response;
+        response.set_status(proto::enums::Status::OK);
+        channel_->sendChannelOpenResponse(response, this->createSendPromise());
+        channel_->receive(this->shared_from_this());
+    }
+
+    void onAVChannelSetupRequest(const proto::messages::AVChannelSetupRequest&) override
+    {
+        proto::messages::AVChannelSetupResponse response;
+        response.set_media_status(proto::enums::AVChannelSetupStatus::OK);
+        response.set_max_unacked(maxUnacked_);
+        response.add_configs(0);
+        channel_->sendAVChannelSetupResponse(response, this->createSendPromise());
+        this->onSetup();
+        channel_->receive(this->shared_from_this());
+    }
+
+    void onAVChannelStartIndication(const proto::messages::AVChannelStartIndication& indication) override
+    {
+        ackEngine_->start(indication.session(), maxUnacked_);
+        channel_->receive(this->shared_from_this());
+    }
+
+    void onAVChannelStopIndication(const proto::messages::AVChannelStopIndication&) override
+    {
+        ackEngine_->stop();
+        channel_->receive(this->shared_from_this());
+    }
+
+    void onAVMediaWithTimestampIndication(messenger::Timestamp::ValueType timestamp, const common::DataConstBuffer& buffer) override
+    {
+        ackEngine_->onMediaReceived();
+        mediaCallback_(timestamp, buffer.size);
+        ackEngine_->release();
+        channel_->receive(this->shared_from_this());
+    }
+
+    void onAVMediaIndication(const common::DataConstBuffer&) override
+    {
+        channel_->receive(this->shared_from_this());
+    }
+
+    void onChannelError(const error::Error& e) override
+    {
+        errorCallback_(e);
+    }
+
+protected:
+    virtual void onSetup() {}
+
+    channel::SendPromise::Pointer createSendPromise()
+    {
+        auto promise = channel::SendPromise::defer(strand_);
+        promise->then([]() {}, errorCallback_);
+        return promise;
+    }
+
+    asio::io_service::strand& strand_;
+    std::shared_ptr<ChannelType> channel_;
+    uint32_t maxUnacked_;
+    channel::av::AVMediaAckEngine::Pointer ackEngine_;
+    MediaCallback mediaCallback_;
+    ErrorCallback errorCallback_;
+};
+
+class VideoSink: public MediaSink<channel::av::IVideoServiceChannel, channel::av::IVideoServiceChannelEventHandler>
+{
+public:
+    using MediaSink::MediaSink;
+
+    void onVideoFocusRequest(const proto::messages::VideoFocusRequest&) override
+    {
+        channel_->receive(this->shared_from_this());
+    }
+
+protected:
+    void onSetup() override
+    {
+        proto::messages::VideoFocusIndication indication;
+        indication.set_focus_mode(proto::enums::VideoFocusMode::FOCUSED);
+        indication.set_unrequested(false);
+        channel_->sendVideoFocusIndication(indication, this->createSendPromise());
+    }
+};
+
+typedef MediaSink<channel::av::IAudioServiceChannel, channel::av::IAudioServiceChannelEventHandler> AudioSink;
+
+messenger::IMessenger::Pointer createMessenger(asio::io_service& ioService, transport::ITransport::Pointer transport, messenger::ICryptor::Pointer cryptor,
+                                               messenger::LatencyTracer::Pointer latencyTracer, metrics::SessionMetrics::Pointer sessionMetrics,
+                                               metrics::StartupTimeline::Pointer startupTimeline)
+{
+    auto messageInStream = std::make_shared<messenger::MessageInStream>(ioService, transport, cryptor);
+    auto messageOutStream = std::make_shared<messenger::MessageOutStream>(ioService, transport, cryptor);
+    auto messenger = std::make_shared<messenger::Messenger>(ioService, messageInStream, messageOutStream);
+
+    if(latencyTracer != nullptr)
+    {
+        messenger->setLatencyTracer(std::move(latencyTracer));
+    }
+
+    if(startupTimeline != nullptr)
+    {
+        messenger->setStartupTimeline(std::move(startupTimeline));
+    }
+
+    if(sessionMetrics != nullptr)
+    {
+        if(auto baseTransport = std::dynamic_pointer_cast<transport::Transport>(transport))
+        {
+            baseTransport->setMetrics(sessionMetrics);
+        }
+
+        messageInStream->setMetrics(sessionMetrics);
+        messageOutStream->setMetrics(sessionMetrics);
+        messenger->setMetrics(std::move(sessionMetrics));
+    }
+
+    return messenger;
+}
+
+}
+
+HeadUnitSession::HeadUnitSession(asio::io_service& ioService, transport::ITransport::Pointer transport, transport::ISSLWrapper::Pointer sslWrapper, uint32_t maxUnacked,
+                                 messenger::LatencyTracer::Pointer latencyTracer, metrics::SessionMetrics::Pointer sessionMetrics,
+                                 metrics::StartupTimeline::Pointer startupTimeline)
+    : strand_(ioService)
+    , transport_(std::move(transport))
+    , cryptor_(std::make_shared<messenger::Cryptor>(std::move(sslWrapper)))
+    , messenger_(createMessenger(ioService, transport_, cryptor_, std::move(latencyTracer), std::move(sessionMetrics), std::move(startupTimeline)))
+    , controlServiceChannel_(std::make_shared<channel::control::ControlServiceChannel>(strand_, messenger_))
+    , videoServiceChannel_(std::make_shared<channel::av::VideoServiceChannel>(strand_, messenger_))
+    , mediaAudioServiceChannel_(std::make_shared<channel::av::MediaAudioServiceChannel>(strand_, messenger_))
+    , maxUnacked_(maxUnacked)
+    , isStopped_(false)
+{
+}
+
+void HeadUnitSession::start()
+{
+    strand_.dispatch([this, self = this->shared_from_this()]() {
+        const auto errorCallback = std::bind(&HeadUnitSession::onChannelError, this->shared_from_this(), std::placeholders::_1);
+
+        videoSink_ = std::make_shared<VideoSink>(strand_, videoServiceChannel_, maxUnacked_,
+                                                 std::bind(&HeadUnitSession::onMedia, this->shared_from_this(), videoServiceChannel_->getId(), std::placeholders::_1, std::placeholders::_2),
+                                                 errorCallback);
+        audioSink_ = std::make_shared<AudioSink>(strand_, mediaAudioServiceChannel_, maxUnacked_,
+                                                 std::bind(&HeadUnitSession::onMedia, this->shared_from_this(), mediaAudioServiceChannel_->getId(), std::placeholders::_1, std::placeholders::_2),
+                                                 errorCallback);
+
+        cryptor_->init();
+        controlServiceChannel_->receive(this->shared_from_this());
+        controlServiceChannel_->sendVersionRequest(this->createSendPromise());
+    });
+}
+
+void HeadUnitSession::stop()
+{
+    strand_.dispatch([this, self = this->shared_from_this()]() {
+        if(isStopped_)
+        {
+            return;
+        }
+
+        isStopped_ = true;
+        messenger_->stop();
+        transport_->stop();
+        cryptor_->deinit();
+
+        // The sinks hold callbacks bound to the session.
+        videoSink_.reset();
+        audioSink_.reset();
+    });
+}
+
+HeadUnitSession::Statistics HeadUnitSession::getStatistics() const
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    return statistics_;
+}
+
+void HeadUnitSession::onVersionResponse(uint16_t majorCode, uint16_t minorCode, proto::enums::VersionResponseStatus::Enum status)
+{
+    AASDK_LOG(info) << "[HeadUnitSession] version response, major: " << majorCode << ", minor: " << minorCode;
+
+    if(status == proto::enums::VersionResponseStatus::MISMATCH)
+    {
+        this->onChannelError(error::Error(error::ErrorCode::OPERATION_ABORTED));
+        return;
+    }
+
+    try
+    {
+        cryptor_->doHandshake();
+        controlServiceChannel_->sendHandshake(cryptor_->readHandshakeBuffer(), this->createSendPromise());
+        controlServiceChannel_->receive(this->shared_from_this());
+    }
+    catch(const error::Error& e)
+    {
+        this->onChannelError(e);
+    }
+}
+
+void HeadUnitSession::onHandshake(const common::DataConstBuffer& payload)
+{
+    try
+    {
+        cryptor_->writeHandshakeBuffer(payload);
+
+        if(!cryptor_->doHandshake())
+        {
+            controlServiceChannel_->sendHandshake(cryptor_->readHandshakeBuffer(), this->createSendPromise());
+        }
+        else
+        {
+            proto::messages::AuthCompleteIndication authCompleteIndication;
+            authCompleteIndication.set_status(proto::enums::Status::OK);
+            controlServiceChannel_->sendAuthComplete(authCompleteIndication, this->createSendPromise());
+        }
+
+        controlServiceChannel_->receive(this->shared_from_this());
+    }
+    catch(const error::Error& e)
+    {
+        this->onChannelError(e);
+    }
+}
+
+void HeadUnitSession::onServiceDiscoveryRequest(const proto::messages::ServiceDiscoveryRequest& request)
+{
+    AASDK_LOG(info) << "[HeadUnitSession] service discovery request, device: " << request.device_name();
+
+    proto::messages::ServiceDiscoveryResponse response;
+    response.set_head_unit_name("aasdk loopback head unit");
+    response.set_car_model("aasdk");
+    response.set_car_year("2018");
+    response.set_car_serial("0");
+    response.set_left_hand_drive_vehicle(true);
+    response.set_headunit_manufacturer("aasdk");
+    response.set_headunit_model("loopback");
+    response.set_sw_build("1");
+    response.set_sw_version("1.0");
+    response.set_can_play_native_media_during_vr(false);
+
+    auto* videoChannelDescriptor = response.add_channels();
+    videoChannelDescriptor->set_channel_id(static_cast<uint32_t>(videoServiceChannel_->getId()));
+    auto* videoChannel = videoChannelDescriptor->mutable_av_channel();
+    videoChannel->set_stream_type(proto::enums::AVStreamType::VIDEO);
+    videoChannel->set_available_while_in_call(true);
+    auto* videoConfig = videoChannel->add_video_configs();
+    videoConfig->set_video_resolution(proto::enums::VideoResolution::_1080p);
+    videoConfig->set_video_fps(proto::enums::VideoFPS::_60);
+    videoConfig->set_margin_width(0);
+    videoConfig->set_margin_height(0);
+    videoConfig->set_dpi(160);
+
+    auto* audioChannelDescriptor = response.add_channels();
+    audioChannelDescriptor->set_channel_id(static_cast<uint32_t>(mediaAudioServiceChannel_->getId()));
+    auto* audioChannel = audioChannelDescriptor->mutable_av_channel();
+    audioChannel->set_stream_type(proto::enums::AVStreamType::AUDIO);
+    audioChannel->set_audio_type(proto::enums::AudioType::MEDIA);
+    audioChannel->set_available_while_in_call(true);
+    auto* audioConfig = audioChannel->add_audio_configs();
+    audioConfig->set_sample_rate(48000);
+    audioConfig->set_bit_depth(16);
+    audioConfig->set_channel_count(2);
+
+    videoServiceChannel_->receive(std::static_pointer_cast<channel::av::IVideoServiceChannelEventHandler>(videoSink_));
+    mediaAudioServiceChannel_->receive(audioSink_);
+    controlServiceChannel_->sendServiceDiscoveryResponse(response, this->createSendPromise());
+    controlServiceChannel_->receive(this->shared_from_this());
+}
+
+void HeadUnitSession::onAudioFocusRequest(const proto::messages::AudioFocusRequest&)
+{
+    controlServiceChannel_->receive(this->shared_from_this());
+}
+
+void HeadUnitSession::onShutdownRequest(const proto::messages::ShutdownRequest&)
+{
+    controlServiceChannel_->sendShutdownResponse(proto::messages::ShutdownResponse(), this->createSendPromise());
+    this->stop();
+}
+
+void HeadUnitSession::onShutdownResponse(const proto::messages::ShutdownResponse&)
+{
+    this->stop();
+}
+
+void HeadUnitSession::onNavigationFocusRequest(const proto::messages::NavigationFocusRequest&)
+{
+    controlServiceChannel_->receive(this->shared_from_this());
+}
+
+void HeadUnitSession::onPingRequest(const proto::messages::PingRequest& request)
+{
+    proto::messages::PingResponse response;
+    response.set_timestamp(request.timestamp());
+    controlServiceChannel_->sendPingResponse(response, this->createSendPromise());
+    controlServiceChannel_->receive(this->shared_from_this());
+}
+
+void HeadUnitSession::onPingResponse(const proto::messages::PingResponse&)
+{
+    controlServiceChannel_->receive(this->shared_from_this());
+}
+
+void HeadUnitSession::onVoiceSessionRequest(const proto::messages::VoiceSessionRequest&)
+{
+    controlServiceChannel_->receive(this->shared_from_this());
+}
+
+void HeadUnitSession::onChannelError(const error::Error& e)
+{
+    if(!isStopped_ && e != error::ErrorCode::OPERATION_ABORTED)
+    {
+        AASDK_LOG(error) << "[HeadUnitSession] channel error: " << e.what();
+    }
+
+    this->stop();
+}
+
+channel::SendPromise::Pointer HeadUnitSession::createSendPromise()
+{
+    auto promise = channel::SendPromise::defer(strand_);
+    promise->then([]() {}, std::bind(&HeadUnitSession::onChannelError, this->shared_from_this(), std::placeholders::_1));
+    return promise;
+}
+
+void HeadUnitSession::onMedia(messenger::ChannelId channelId, messenger::Timestamp::ValueType timestamp, size_t size)
+{
+    const auto now = channel::av::AVMediaSource::now();
+
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    auto& statistics = statistics_[channelId];
+    ++statistics.receivedFrames;
+    statistics.receivedBytes += size;
+    statistics.latencies.push_back(now > timestamp ? now - timestamp : 0);
+}
+
+}
+}
@@ -0,0 +1,102 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <vector>
+#include <asio.hpp>
+#include <aasdk/Transport/ITransport.hpp>
+#include <aasdk/Transport/ISSLWrapper.hpp>
+#include <aasdk/Messenger/ICryptor.hpp>
+#include <aasdk/Messenger/IMessenger.hpp>
+#include <aasdk/Messenger/LatencyTracer.hpp>
+#include <aasdk/Metrics/SessionMetrics.hpp>
+#include <aasdk/Metrics/StartupTimeline.hpp>
+#include <aasdk/Channel/Control/IControlServiceChannel.hpp>
+#include <aasdk/Channel/AV/IVideoServiceChannel.hpp>
+#include <aasdk/Channel/AV/IAudioServiceChannel.hpp>
+
+
+namespace aasdk
+{
+namespace benchmark
+{
+
+// Minimal head unit used as the sink of the loopback benchmark. It announces one video and one
+// media audio channel, acknowledges every frame and records how long each one took to arrive.
+class HeadUnitSession: public channel::control::IControlServiceChannelEventHandler, public std::enable_shared_from_this<HeadUnitSession>
+{
+public:
+    typedef std::shared_ptr<HeadUnitSession> Pointer;
+
+    struct ChannelStatistics
+    {
+        uint64_t receivedFrames = 0;
+        uint64_t receivedBytes = 0;
+        // Transport latency of every frame in microseconds, measured from the sender's timestamp.
+        std::vector<uint64_t> latencies;
+    };
+
+    typedef std::map<messenger::ChannelId, ChannelStatistics> Statistics;
+
+    HeadUnitSession(asio::io_service& ioService, transport::ITransport::Pointer transport, transport::ISSLWrapper::Pointer sslWrapper, uint32_t maxUnacked,
+                    messenger::LatencyTracer::Pointer latencyTracer = nullptr, metrics::SessionMetrics::Pointer sessionMetrics = nullptr,
+                    metrics::StartupTimeline::Pointer startupTimeline = nullptr);
+
+    void start();
+    void stop();
+    Statistics getStatistics() const;
+
+    void onVersionResponse(uint16_t majorCode, uint16_t minorCode, proto::enums::VersionResponseStatus::Enum status) override;
+    void onHandshake(const common::DataConstBuffer& payload) override;
+    void onServiceDiscoveryRequest(const proto::messages::ServiceDiscoveryRequest& request) override;
+    void onAudioFocusRequest(const proto::messages::AudioFocusRequest& request) override;
+    void onShutdownRequest(const proto::messages::ShutdownRequest& request) override;
+    void onShutdownResponse(const proto::messages::ShutdownResponse& response) override;
+    void onNavigationFocusRequest(const proto::messages::NavigationFocusRequest& request) override;
+    void onPingRequest(const proto::messages::PingRequest& request) override;
+    void onPingResponse(const proto::messages::PingResponse& response) override;
+    void onChannelError(const error::Error& e) override;
+    void onVoiceSessionRequest(const proto::messages::VoiceSessionRequest& request) override;
+
+private:
+    using std::enable_shared_from_this<HeadUnitSession>::shared_from_this;
+
+    channel::SendPromise::Pointer createSendPromise();
+    void onMedia(messenger::ChannelId channelId, messenger::Timestamp::ValueType timestamp, size_t size);
+
+    asio::io_service::strand strand_;
+    transport::ITransport::Pointer transport_;
+    messenger::ICryptor::Pointer cryptor_;
+    messenger::IMessenger::Pointer messenger_;
+    channel::control::IControlServiceChannel::Pointer controlServiceChannel_;
+    channel::av::IVideoServiceChannel::Pointer videoServiceChannel_;
+    channel::av::IAudioServiceChannel::Pointer mediaAudioServiceChannel_;
+    channel::av::IVideoServiceChannelEventHandler::Pointer videoSink_;
+    channel::av::IAudioServiceChannelEventHandler::Pointer audioSink_;
+    uint32_t maxUnacked_;
+    bool isStopped_;
+
+    mutable std::mutex mutex_;
+    Statistics statistics_;
+};
+
+}
+}
@@ -0,0 +1,337 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <asio.hpp>
+#include <aasdk/Transport/SSLWrapper.hpp>
+#include <aasdk/Transport/MemoryTransport.hpp>
+#include <aasdk/Transport/TCPTransport.hpp>
+#include <aasdk/TCP/TCPWrapper.hpp>
+#include <aasdk/TCP/TCPEndpoint.hpp>
+#include <aasdk/Metrics/PrometheusExporter.hpp>
+#include "DeviceSession.hpp"
+#include "HeadUnitSession.hpp"
+
+// Runs the phone role against a head unit on one machine and reports media throughput and
+// end-to-end frame latency. By default both ends live in this process and talk over an in-memory
+// link; --tcp moves them onto a loopback socket and --listen only runs the phone, waiting for an
+// external head unit build to connect.
+
+namespace
+{
+
+using namespace aasdk;
+
+struct Options
+{
+    size_t duration = 10;
+    size_t threads = 2;
+    uint32_t maxUnacked = 1;
+    uint16_t tcpPort = 0;
+    bool isListenOnly = false;
+    bool isTraceEnabled = false;
+    bool isMetricsEnabled = false;
+    bool isStartupEnabled = false;
+    transport::MemoryPipe::Configuration link;
+    benchmark::DeviceSession::Configuration device;
+};
+
+void printUsage(const char* name)
+{
+    std::cerr << "Usage: " << name << " [options]" << std::endl
+              << "  --duration <s>        measurement time, default 10" << std::endl
+              << "  --bitrate <bit/s>     video bitrate, default 8000000" << std::endl
+              << "  --fps <n>             video frame rate, default 30" << std::endl
+              << "  --audio               also stream 48 kHz stereo media audio" << std::endl
+              << "  --trace               break the head unit receive latency down per pipeline stage" << std::endl
+              << "  --metrics             dump the head unit session metrics in Prometheus text format" << std::endl
+              << "  --startup             print the head unit connection timeline up to the first video frame" << std::endl
+              << "  --max-unacked <n>     head unit ack window, default 1" << std::endl
+              << "  --bandwidth <B/s>     in-memory link bandwidth, default unlimited" << std::endl
+              << "  --latency-us <us>     in-memory link one-way latency, default 0" << std::endl
+              << "  --tcp <port>          use a loopback TCP socket instead of the in-memory link" << std::endl
+              << "  --listen <port>       run the phone only and wait for a head unit on this port" << std::endl
+              << "  --threads <n>         io_service threads, default 2" << std::endl;
+}
+
+bool parseOptions(int argc, char* argv[], Options& options)
+{
+    options.device.audio.bitrate = 48000 * 2 * 16;
+    options.device.audio.frameRate = 50;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        const std::string option(argv[i]);
+
+        if(option == "--audio")
+        {
+            options.device.isAudioEnabled = true;
+            continue;
+        }
+
+        if(option == "--trace")
+        {
+            options.isTraceEnabled = true;
+            continue;
+        }
+
+        if(option == "--metrics")
+        {
+            options.isMetricsEnabled = true;
+            continue;
+        }
+
+        if(option == "--startup")
+        {
+            options.isStartupEnabled = true;
+            continue;
+        }
+
+        if(i + 1 >= argc)
+        {
+            return false;
+        }
+
+        const auto value = std::strtoull(argv[++i], nullptr, 10);
+
+        if(option == "--duration") options.duration = value;
+        else if(option == "--bitrate") options.device.video.bitrate = value;
+        else if(option == "--fps") options.device.video.frameRate = value;
+        else if(option == "--max-unacked") options.maxUnacked = static_cast<uint32_t>(value);
+        else if(option == "--bandwidth") options.link.bandwidth = value;
+        else if(option == "--latency-us") options.link.latency = std::chrono::microseconds(value);
+        else if(option == "--tcp") options.tcpPort = static_cast<uint16_t>(value);
+        else if(option == "--listen") { options.tcpPort = static_cast<uint16_t>(value); options.isListenOnly = true; }
+        else if(option == "--threads") options.threads = std::max<size_t>(value, 1);
+        else return false;
+    }
+
+    return true;
+}
+
+double percentile(const std::vector<uint64_t>& sorted, size_t percent)
+{
+    return sorted.empty() ? 0 : static_cast<double>(sorted[std::min(sorted.size() - 1, sorted.size() * percent / 100)]);
+}
+
+void printStatistics(const benchmark::DeviceSession::Statistics& deviceStatistics, const benchmark::HeadUnitSession::Statistics& headUnitStatistics, size_t duration)
+{
+    std::cout << std::endl << std::setw(14) << "Channel"
+              << std::setw(10) << "Sent" << std::setw(10) << "Skipped" << std::setw(10) << "Acked"
+              << std::setw(10) << "Received" << std::setw(10) << "MB/s"
+              << std::setw(12) << "Mean us" << std::setw(12) << "p50 us" << std::setw(12) << "p99 us" << std::setw(12) << "Max us" << std::endl;
+
+    for(const auto& device : deviceStatistics)
+    {
+        std::cout << std::setw(14) << messenger::channelIdToString(device.first)
+                  << std::setw(10) << device.second.sentFrames << std::setw(10) << device.second.skippedFrames << std::setw(10) << device.second.ackedFrames;
+
+        const auto headUnit = headUnitStatistics.find(device.first);
+        if(headUnit != headUnitStatistics.end())
+        {
+            auto latencies = headUnit->second.latencies;
+            std::sort(latencies.begin(), latencies.end());
+
+            uint64_t total = 0;
+            for(const auto latency : latencies)
+            {
+                total += latency;
+            }
+
+            std::cout << std::setw(10) << headUnit->second.receivedFrames
+                      << std::setw(10) << std::fixed << std::setprecision(2) << static_cast<double>(headUnit->second.receivedBytes) / (1024 * 1024) / duration
+                      << std::setw(12) << std::setprecision(1) << (latencies.empty() ? 0.0 : static_cast<double>(total) / latencies.size())
+                      << std::setw(12) << percentile(latencies, 50) << std::setw(12) << percentile(latencies, 99)
+                      << std::setw(12) << (latencies.empty() ? 0.0 : static_cast<double>(latencies.back()));
+        }
+
+        std::cout << std::endl;
+    }
+}
+
+void printStartupTimeline(const metrics::StartupTimeline::Events& events)
+{
+    std::cout << std::endl << "Head unit startup timeline" << std::endl;
+    std::cout << std::setw(12) << "Elapsed ms" << "  " << std::left << std::setw(28) << "Phase" << "Detail" << std::right << std::endl;
+
+    for(const auto& event : events)
+    {
+        const auto elapsed = std::chrono::duration<double, std::milli>(metrics::StartupTimeline::getElapsed(events, event)).count();
+        std::cout << std::setw(12) << std::fixed << std::setprecision(3) << elapsed << "  "
+                  << std::left << std::setw(28) << metrics::startupPhaseToString(event.phase) << event.detail << std::right << std::endl;
+    }
+}
+
+void printLatencyTrace(const messenger::LatencyTracer& latencyTracer)
+{
+    std::cout << std::endl << std::setw(14) << "Channel" << std::setw(26) << "Stage"
+              << std::setw(10) << "Count" << std::setw(12) << "Mean us" << std::setw(12) << "p50 us" << std::setw(12) << "p99 us" << std::setw(12) << "Max us" << std::endl;
+
+    const auto printHistogram = [](const std::string& channel, const std::string& stage, const messenger::LatencyHistogram& histogram) {
+        const auto toMicroseconds = [](common::TraceClock::duration duration) { return std::chrono::duration<double, std::micro>(duration).count(); };
+
+        std::cout << std::setw(14) << channel << std::setw(26) << stage << std::setw(10) << histogram.getCount()
+                  << std::setw(12) << std::fixed << std::setprecision(1) << toMicroseconds(histogram.getMean())
+                  << std::setw(12) << toMicroseconds(histogram.getPercentile(0.5)) << std::setw(12) << toMicroseconds(histogram.getPercentile(0.99))
+                  << std::setw(12) << toMicroseconds(histogram.getMax()) << std::endl;
+    };
+
+    for(const auto channelId : latencyTracer.getChannelIds())
+    {
+        const auto channel = messenger::channelIdToString(channelId);
+
+        for(size_t i = 0; i < static_cast<size_t>(messenger::TraceStage::COUNT); ++i)
+        {
+            const auto stage = static_cast<messenger::TraceStage>(i);
+            const auto histogram = latencyTracer.getStageHistogram(channelId, stage);
+
+            if(histogram.getCount() > 0)
+            {
+                printHistogram(channel, messenger::traceStageToString(stage), histogram);
+            }
+        }
+
+        printHistogram(channel, "TOTAL", latencyTracer.getTotalHistogram(channelId));
+    }
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if(!parseOptions(argc, argv, options))
+    {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    asio::io_service ioService;
+    auto sslWrapper = std::make_shared<transport::SSLWrapper>();
+    tcp::TCPWrapper tcpWrapper;
+
+    transport::ITransport::Pointer deviceTransport;
+    transport::ITransport::Pointer headUnitTransport;
+
+    if(options.tcpPort == 0)
+    {
+        std::tie(headUnitTransport, deviceTransport) = transport::MemoryTransport::createPair(ioService, options.link);
+    }
+    else
+    {
+        asio::ip::tcp::acceptor acceptor(ioService, asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), options.tcpPort));
+        auto deviceSocket = std::make_shared<asio::ip::tcp::socket>(ioService);
+
+        if(!options.isListenOnly)
+        {
+            auto headUnitSocket = std::make_shared<asio::ip::tcp::socket>(ioService);
+            const auto ec = tcpWrapper.connect(*headUnitSocket, "127.0.0.1", options.tcpPort);
+            if(ec)
+            {
+                std::cerr << "Connect failed: " << ec.message() << std::endl;
+                return EXIT_FAILURE;
+            }
+
+            headUnitTransport = std::make_shared<transport::TCPTransport>(ioService, std::make_shared<tcp::TCPEndpoint>(tcpWrapper, std::move(headUnitSocket)));
+        }
+        else
+        {
+            std::cout << "Waiting for a head unit on port " << options.tcpPort << std::endl;
+        }
+
+        asio::error_code ec;
+        acceptor.accept(*deviceSocket, ec);
+        if(ec)
+        {
+            std::cerr << "Accept failed: " << ec.message() << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        deviceSocket->set_option(asio::ip::tcp::no_delay(true), ec);
+        deviceTransport = std::make_shared<transport::TCPTransport>(ioService, std::make_shared<tcp::TCPEndpoint>(tcpWrapper, std::move(deviceSocket)));
+    }
+
+    auto deviceSession = std::make_shared<benchmark::DeviceSession>(ioService, deviceTransport, sslWrapper, options.device);
+    auto latencyTracer = options.isTraceEnabled ? std::make_shared<messenger::LatencyTracer>() : nullptr;
+    auto metricsRegistry = std::make_shared<metrics::MetricsRegistry>();
+    auto sessionMetrics = options.isMetricsEnabled ? std::make_shared<metrics::SessionMetrics>(metricsRegistry, metrics::Labels{{"role", "head_unit"}}) : nullptr;
+    auto startupTimeline = options.isStartupEnabled ? std::make_shared<metrics::StartupTimeline>() : nullptr;
+    benchmark::HeadUnitSession::Pointer headUnitSession;
+    if(headUnitTransport != nullptr)
+    {
+        headUnitSession = std::make_shared<benchmark::HeadUnitSession>(ioService, headUnitTransport, sslWrapper, options.maxUnacked, latencyTracer, sessionMetrics, startupTimeline);
+    }
+
+    asio::steady_timer durationTimer(ioService, std::chrono::seconds(options.duration));
+    asio::steady_timer shutdownTimer(ioService);
+    durationTimer.async_wait([&](const asio::error_code&) {
+        deviceSession->stop();
+        if(headUnitSession != nullptr)
+        {
+            headUnitSession->stop();
+        }
+
+        // Give the sessions a moment to unwind before tearing down the io_service.
+        shutdownTimer.expires_from_now(std::chrono::milliseconds(100));
+        shutdownTimer.async_wait([&](const asio::error_code&) { ioService.stop(); });
+    });
+
+    deviceSession->start();
+    if(headUnitSession != nullptr)
+    {
+        headUnitSession->start();
+    }
+
+    std::vector<std::thread> threads;
+    for(size_t i = 0; i < options.threads; ++i)
+    {
+        threads.emplace_back([&ioService]() { ioService.run(); });
+    }
+
+    for(auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    printStatistics(deviceSession->getStatistics(),
+                    headUnitSession != nullptr ? headUnitSession->getStatistics() : benchmark::HeadUnitSession::Statistics(),
+                    options.duration);
+
+    if(latencyTracer != nullptr)
+    {
+        printLatencyTrace(*latencyTracer);
+    }
+
+    if(startupTimeline != nullptr)
+    {
+        printStartupTimeline(startupTimeline->getEvents());
+    }
+
+    if(sessionMetrics != nullptr)
+    {
+        std::cout << std::endl << metrics::PrometheusExporter::format(metricsRegistry->getSnapshot());
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,97 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "AllocationCounter.hpp"
+
+
+namespace
+{
+
+std::atomic<uint64_t> allocationCount(0);
+
+void* allocate(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+    if(auto memory = std::malloc(size == 0 ? 1 : size))
+    {
+        return memory;
+    }
+
+    throw std::bad_alloc();
+}
+
+}
+
+void* operator new(std::size_t size)
+{
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return allocate(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+namespace aasdk
+{
+namespace benchmark
+{
+
+uint64_t getAllocationCount()
+{
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+AllocationScope::AllocationScope(::benchmark::State& state)
+    : state_(state)
+    , startCount_(getAllocationCount())
+{
+
+}
+
+AllocationScope::~AllocationScope()
+{
+    state_.counters["allocs/op"] = ::benchmark::Counter(static_cast<double>(getAllocationCount() - startCount_), ::benchmark::Counter::kAvgIterations);
+}
+
+}
+}
@@ -0,0 +1,78 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <aasdk_proto/AVChannelMessageIdsEnum.pb.h>
+#include <aasdk/Channel/AV/AudioCaptureRing.hpp>
+#include <aasdk/Messenger/Message.hpp>
+#include <aasdk/Messenger/MessageId.hpp>
+#include "AllocationCounter.hpp"
+
+
+namespace
+{
+
+using namespace aasdk;
+
+proto::data::AudioConfig createMicrophoneConfig()
+{
+    proto::data::AudioConfig audioConfig;
+    audioConfig.set_sample_rate(16000);
+    audioConfig.set_bit_depth(16);
+    audioConfig.set_channel_count(1);
+    return audioConfig;
+}
+
+// What AVInputServiceChannel builds for every common::Data chunk handed to it.
+void AudioCapture_CopyIntoMessage(::benchmark::State& state)
+{
+    const common::Data pcm(640, 0x5A);
+    aasdk::benchmark::AllocationScope allocations(state);
+
+    for(auto _ : state)
+    {
+        auto message(std::make_shared<messenger::Message>(messenger::ChannelId::AV_INPUT, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
+        message->insertPayload(messenger::MessageId(proto::ids::AVChannelMessage::AV_MEDIA_WITH_TIMESTAMP_INDICATION).getData());
+        message->insertPayload(messenger::Timestamp(0).getData());
+        message->insertPayload(pcm);
+        ::benchmark::DoNotOptimize(message->getPayload().data());
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * pcm.size());
+}
+BENCHMARK(AudioCapture_CopyIntoMessage);
+
+void AudioCapture_Ring(::benchmark::State& state)
+{
+    channel::av::AudioCaptureRing::Configuration configuration;
+    configuration.chunkDuration = std::chrono::milliseconds(20);
+    channel::av::AudioCaptureRing captureRing(createMicrophoneConfig(), configuration);
+    const common::Data pcm(captureRing.getChunkSize(), 0x5A);
+    aasdk::benchmark::AllocationScope allocations(state);
+
+    for(auto _ : state)
+    {
+        captureRing.write(common::DataConstBuffer(pcm), 0);
+        auto message = captureRing.pop();
+        ::benchmark::DoNotOptimize(message->getPayload().data());
+        captureRing.release(message);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * pcm.size());
+}
+BENCHMARK(AudioCapture_Ring);
+
+}
@@ -0,0 +1,150 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <array>
+#include <string>
+#include <google/protobuf/arena.h>
+#include <aasdk_proto/ServiceDiscoveryResponseMessage.pb.h>
+#include <aasdk_proto/NavigationTurnMessage.pb.h>
+#include <aasdk/Common/Data.hpp>
+#include "AllocationCounter.hpp"
+
+
+namespace
+{
+
+using namespace aasdk;
+
+template<typename MessageType>
+common::Data createPayload();
+
+template<>
+common::Data createPayload<proto::messages::ServiceDiscoveryResponse>()
+{
+    proto::messages::ServiceDiscoveryResponse response;
+    response.set_head_unit_name("aasdk benchmark head unit");
+    response.set_car_model("aasdk benchmark car model");
+    response.set_car_year("2018");
+    response.set_car_serial("0123456789abcdef0123");
+    response.set_left_hand_drive_vehicle(true);
+    response.set_headunit_manufacturer("aasdk benchmark manufacturer");
+    response.set_headunit_model("aasdk benchmark model");
+    response.set_sw_build("aasdk benchmark build");
+    response.set_sw_version("aasdk benchmark version");
+    response.set_can_play_native_media_during_vr(false);
+
+    for(uint32_t channelId = 1; channelId <= 8; ++channelId)
+    {
+        auto* channelDescriptor = response.add_channels();
+        channelDescriptor->set_channel_id(channelId);
+        auto* avChannel = channelDescriptor->mutable_av_channel();
+        avChannel->set_stream_type(proto::enums::AVStreamType::AUDIO);
+        avChannel->set_audio_type(proto::enums::AudioType::MEDIA);
+        avChannel->set_available_while_in_call(true);
+
+        for(uint32_t i = 0; i < 3; ++i)
+        {
+            auto* audioConfig = avChannel->add_audio_configs();
+            audioConfig->set_sample_rate(16000 * (i + 1));
+            audioConfig->set_bit_depth(16);
+            audioConfig->set_channel_count(2);
+        }
+    }
+
+    common::Data data(response.ByteSizeLong());
+    response.SerializeToArray(data.data(), static_cast<int>(data.size()));
+    return data;
+}
+
+template<>
+common::Data createPayload<proto::messages::NavigationTurnMessage>()
+{
+    proto::messages::NavigationTurnMessage turn;
+    turn.set_event_name("Turn left onto the aasdk benchmark street");
+    turn.set_turn_side(proto::enums::NavigationTurnSide::TURN_LEFT);
+    turn.set_turn_event(proto::enums::NavigationTurnEvent::TURN);
+    turn.set_image(std::string(4096, '\x5A'));
+    turn.set_turn_number(1);
+    turn.set_turn_angle(90);
+
+    common::Data data(turn.ByteSizeLong());
+    turn.SerializeToArray(data.data(), static_cast<int>(data.size()));
+    return data;
+}
+
+// A message constructed for every payload, as the channels did before MessageDispatcher.
+template<typename MessageType>
+void ChannelParsing_Stack(::benchmark::State& state)
+{
+    const auto payload = createPayload<MessageType>();
+    aasdk::benchmark::AllocationScope allocations(state);
+
+    for(auto _ : state)
+    {
+        MessageType message;
+        ::benchmark::DoNotOptimize(message.ParseFromArray(payload.data(), static_cast<int>(payload.size())));
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * payload.size());
+}
+
+// One message kept per route and parsed into again.
+template<typename MessageType>
+void ChannelParsing_Reused(::benchmark::State& state)
+{
+    const auto payload = createPayload<MessageType>();
+    MessageType message;
+    aasdk::benchmark::AllocationScope allocations(state);
+
+    for(auto _ : state)
+    {
+        ::benchmark::DoNotOptimize(message.ParseFromArray(payload.data(), static_cast<int>(payload.size())));
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * payload.size());
+}
+
+// A message created on an arena with a preallocated first block, reset after every payload.
+template<typename MessageType>
+void ChannelParsing_Arena(::benchmark::State& state)
+{
+    const auto payload = createPayload<MessageType>();
+    std::array<char, 4096> block;
+    google::protobuf::ArenaOptions options;
+    options.initial_block = block.data();
+    options.initial_block_size = block.size();
+    google::protobuf::Arena arena(options);
+    aasdk::benchmark::AllocationScope allocations(state);
+
+    for(auto _ : state)
+    {
+        auto* message = google::protobuf::Arena::CreateMessage<MessageType>(&arena);
+        ::benchmark::DoNotOptimize(message->ParseFromArray(payload.data(), static_cast<int>(payload.size())));
+        arena.Reset();
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * payload.size());
+}
+
+BENCHMARK_TEMPLATE(ChannelParsing_Stack, proto::messages::ServiceDiscoveryResponse);
+BENCHMARK_TEMPLATE(ChannelParsing_Reused, proto::messages::ServiceDiscoveryResponse);
+BENCHMARK_TEMPLATE(ChannelParsing_Arena, proto::messages::ServiceDiscoveryResponse);
+BENCHMARK_TEMPLATE(ChannelParsing_Stack, proto::messages::NavigationTurnMessage);
+BENCHMARK_TEMPLATE(ChannelParsing_Reused, proto::messages::NavigationTurnMessage);
+BENCHMARK_TEMPLATE(ChannelParsing_Arena, proto::messages::NavigationTurnMessage);
+
+}
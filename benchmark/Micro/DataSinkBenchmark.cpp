@@ -0,0 +1,52 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <aasdk/Transport/DataSink.hpp>
+#include "AllocationCounter.hpp"
+
+
+namespace
+{
+
+using namespace aasdk;
+
+void DataSink_FillCommitConsume(::benchmark::State& state)
+{
+    transport::DataSink dataSink;
+    const auto size = static_cast<common::Data::size_type>(state.range(0));
+    aasdk::benchmark::AllocationScope allocations(state);
+
+    for(auto _ : state)
+    {
+        common::Data::size_type committed = 0;
+        while(committed < size)
+        {
+            auto buffer = dataSink.fill();
+            const auto chunkSize = std::min(buffer.size, size - committed);
+            dataSink.commit(chunkSize);
+            committed += chunkSize;
+        }
+
+        ::benchmark::DoNotOptimize(dataSink.consume(size));
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(DataSink_FillCommitConsume)->Arg(4)->Arg(512)->Arg(16384)->Arg(65536);
+
+}
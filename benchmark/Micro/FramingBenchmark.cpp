@@ -0,0 +1,128 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <asio.hpp>
+#include <aasdk/Messenger/FrameHeader.hpp>
+#include <aasdk/Messenger/FrameSize.hpp>
+#include <aasdk/Messenger/MessageOutStream.hpp>
+#include "AllocationCounter.hpp"
+
+
+namespace
+{
+
+using namespace aasdk;
+
+void FrameHeader_Encode(::benchmark::State& state)
+{
+    aasdk::benchmark::AllocationScope allocations(state);
+
+    for(auto _ : state)
+    {
+        messenger::FrameHeader frameHeader(messenger::ChannelId::VIDEO, messenger::FrameType::BULK, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC);
+        ::benchmark::DoNotOptimize(frameHeader.getData());
+    }
+}
+BENCHMARK(FrameHeader_Encode);
+
+void FrameHeader_Decode(::benchmark::State& state)
+{
+    const auto data = messenger::FrameHeader(messenger::ChannelId::VIDEO, messenger::FrameType::BULK, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC).getData();
+    aasdk::benchmark::AllocationScope allocations(state);
+
+    for(auto _ : state)
+    {
+        messenger::FrameHeader frameHeader{common::DataConstBuffer(data)};
+        ::benchmark::DoNotOptimize(frameHeader.getChannelId());
+    }
+}
+BENCHMARK(FrameHeader_Decode);
+
+void FrameSize_Encode(::benchmark::State& state)
+{
+    const bool isExtended = state.range(0) != 0;
+    aasdk::benchmark::AllocationScope allocations(state);
+
+    for(auto _ : state)
+    {
+        auto frameSize = isExtended ? messenger::FrameSize(0x4000, 0x10000) : messenger::FrameSize(0x4000);
+        ::benchmark::DoNotOptimize(frameSize.getData());
+    }
+}
+BENCHMARK(FrameSize_Encode)->ArgName("extended")->Arg(0)->Arg(1);
+
+void FrameSize_Decode(::benchmark::State& state)
+{
+    const auto data = state.range(0) != 0 ? messenger::FrameSize(0x4000, 0x10000).getData() : messenger::FrameSize(0x4000).getData();
+    aasdk::benchmark::AllocationScope allocations(state);
+
+    for(auto _ : state)
+    {
+        messenger::FrameSize frameSize{common::DataConstBuffer(data)};
+        ::benchmark::DoNotOptimize(frameSize.getTotalSize());
+    }
+}
+BENCHMARK(FrameSize_Decode)->ArgName("extended")->Arg(0)->Arg(1);
+
+// Completes every send at once so only the framing work is measured.
+class NullTransport: public transport::ITransport
+{
+public:
+    void receive(size_t, ReceivePromise::Pointer promise) override
+    {
+        promise->reject(error::Error(error::ErrorCode::OPERATION_ABORTED));
+    }
+
+    void send(common::Data data, SendPromise::Pointer promise) override
+    {
+        ::benchmark::DoNotOptimize(data.data());
+        promise->resolve();
+    }
+
+    void stop() override {}
+
+    ReceiveTimestamps getLastReceiveTimestamps() const override
+    {
+        return ReceiveTimestamps();
+    }
+};
+
+// compoundFrame() is private; a plain message through stream() runs it once per frame plus
+// the strand and promise plumbing every real send goes through.
+void MessageOutStream_StreamPlain(::benchmark::State& state)
+{
+    asio::io_service ioService;
+    auto messageOutStream = std::make_shared<messenger::MessageOutStream>(ioService, std::make_shared<NullTransport>(), messenger::ICryptor::Pointer());
+    const common::Data payload(state.range(0), 0x5A);
+    aasdk::benchmark::AllocationScope allocations(state);
+
+    for(auto _ : state)
+    {
+        auto message = std::make_shared<messenger::Message>(messenger::ChannelId::VIDEO, messenger::EncryptionType::PLAIN, messenger::MessageType::SPECIFIC);
+        message->insertPayload(payload);
+
+        messageOutStream->stream(std::move(message), messenger::SendPromise::defer(ioService));
+        ioService.poll();
+        ioService.reset();
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(MessageOutStream_StreamPlain)->Arg(64)->Arg(1024)->Arg(16383)->Arg(65536);
+
+}
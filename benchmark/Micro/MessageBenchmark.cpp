@@ -0,0 +1,111 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <aasdk_proto/AVMediaAckIndicationMessage.pb.h>
+#include <aasdk_proto/ServiceDiscoveryResponseMessage.pb.h>
+#include <aasdk/Messenger/Message.hpp>
+#include <aasdk/Messenger/MessageId.hpp>
+#include <aasdk/Messenger/ChannelReceiveMessageQueue.hpp>
+#include "AllocationCounter.hpp"
+
+
+namespace
+{
+
+using namespace aasdk;
+
+proto::messages::ServiceDiscoveryResponse createServiceDiscoveryResponse()
+{
+    proto::messages::ServiceDiscoveryResponse response;
+    response.set_head_unit_name("aasdk");
+    response.set_car_model("aasdk");
+    response.set_car_year("2018");
+    response.set_car_serial("0");
+    response.set_left_hand_drive_vehicle(true);
+    response.set_headunit_manufacturer("aasdk");
+    response.set_headunit_model("benchmark");
+    response.set_sw_build("1");
+    response.set_sw_version("1.0");
+    response.set_can_play_native_media_during_vr(false);
+
+    for(uint32_t channelId = 1; channelId <= 8; ++channelId)
+    {
+        auto* channelDescriptor = response.add_channels();
+        channelDescriptor->set_channel_id(channelId);
+        auto* avChannel = channelDescriptor->mutable_av_channel();
+        avChannel->set_stream_type(proto::enums::AVStreamType::AUDIO);
+        avChannel->set_audio_type(proto::enums::AudioType::MEDIA);
+        auto* audioConfig = avChannel->add_audio_configs();
+        audioConfig->set_sample_rate(48000);
+        audioConfig->set_bit_depth(16);
+        audioConfig->set_channel_count(2);
+    }
+
+    return response;
+}
+
+template<typename ProtobufMessage>
+void insertProtobuf(::benchmark::State& state, const ProtobufMessage& protobufMessage)
+{
+    aasdk::benchmark::AllocationScope allocations(state);
+
+    for(auto _ : state)
+    {
+        messenger::Message message(messenger::ChannelId::CONTROL, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC);
+        message.insertPayload(messenger::MessageId(1).getData());
+        message.insertPayload(protobufMessage);
+        ::benchmark::DoNotOptimize(message.getPayload().data());
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * protobufMessage.ByteSizeLong());
+}
+
+void Message_InsertSmallProtobuf(::benchmark::State& state)
+{
+    proto::messages::AVMediaAckIndication indication;
+    indication.set_session(1);
+    indication.set_value(1);
+
+    insertProtobuf(state, indication);
+}
+BENCHMARK(Message_InsertSmallProtobuf);
+
+void Message_InsertLargeProtobuf(::benchmark::State& state)
+{
+    insertProtobuf(state, createServiceDiscoveryResponse());
+}
+BENCHMARK(Message_InsertLargeProtobuf);
+
+void ChannelReceiveMessageQueue_PushPop(::benchmark::State& state)
+{
+    messenger::ChannelReceiveMessageQueue queue;
+    const messenger::ChannelId channelIds[] = {messenger::ChannelId::VIDEO, messenger::ChannelId::MEDIA_AUDIO, messenger::ChannelId::INPUT, messenger::ChannelId::SENSOR};
+    size_t index = 0;
+    aasdk::benchmark::AllocationScope allocations(state);
+
+    for(auto _ : state)
+    {
+        const auto channelId = channelIds[index++ % 4];
+        auto queued = std::make_shared<messenger::Message>(channelId, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC);
+        queue.push(std::move(queued));
+        ::benchmark::DoNotOptimize(queue.pop(channelId));
+    }
+}
+BENCHMARK(ChannelReceiveMessageQueue_PushPop);
+
+}
@@ -0,0 +1,69 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <asio.hpp>
+#include <aasdk/IO/Promise.hpp>
+#include <aasdk/Common/Data.hpp>
+#include "AllocationCounter.hpp"
+
+
+namespace
+{
+
+using namespace aasdk;
+
+void Promise_DeferResolve(::benchmark::State& state)
+{
+    asio::io_service ioService;
+    size_t resolved = 0;
+    aasdk::benchmark::AllocationScope allocations(state);
+
+    for(auto _ : state)
+    {
+        auto promise = io::Promise<void>::defer(ioService);
+        promise->then([&resolved]() { ++resolved; });
+        promise->resolve();
+        ioService.poll();
+        ioService.reset();
+    }
+
+    ::benchmark::DoNotOptimize(resolved);
+}
+BENCHMARK(Promise_DeferResolve);
+
+void Promise_DeferResolveData(::benchmark::State& state)
+{
+    asio::io_service ioService;
+    asio::io_service::strand strand(ioService);
+    size_t resolved = 0;
+    aasdk::benchmark::AllocationScope allocations(state);
+
+    for(auto _ : state)
+    {
+        auto promise = io::Promise<common::Data>::defer(strand);
+        promise->then([&resolved](common::Data data) { resolved += data.size(); });
+        promise->resolve(common::Data(state.range(0)));
+        ioService.poll();
+        ioService.reset();
+    }
+
+    ::benchmark::DoNotOptimize(resolved);
+}
+BENCHMARK(Promise_DeferResolveData)->Arg(16)->Arg(16384);
+
+}
@@ -0,0 +1,69 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <benchmark/benchmark.h>
+#include <aasdk/Channel/AV/H264AccessUnitAssembler.hpp>
+#include <aasdk/Channel/AV/StartCodeScanner.hpp>
+#include "AllocationCounter.hpp"
+
+
+namespace
+{
+
+using namespace aasdk;
+
+// A keyframe sized payload: SPS, PPS and one large IDR slice without any start code inside.
+common::Data createKeyFrame(size_t size)
+{
+    common::Data data{0x00, 0x00, 0x00, 0x01, 0x67, 0x42, 0x00, 0x1F,
+                      0x00, 0x00, 0x00, 0x01, 0x68, 0xCE, 0x3C, 0x80,
+                      0x00, 0x00, 0x00, 0x01, 0x65};
+    data.resize(size, 0x5A);
+    return data;
+}
+
+template<const uint8_t* (*Find)(const uint8_t*, const uint8_t*)>
+void StartCode_Scan(::benchmark::State& state)
+{
+    const common::Data data(static_cast<size_t>(state.range(0)), 0x5A);
+
+    for(auto _ : state)
+    {
+        ::benchmark::DoNotOptimize(Find(data.data(), data.data() + data.size()));
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK_TEMPLATE(StartCode_Scan, channel::av::findStartCodeScalar)->Arg(1024)->Arg(65536);
+BENCHMARK_TEMPLATE(StartCode_Scan, channel::av::findStartCode)->Arg(1024)->Arg(65536);
+
+void H264AccessUnitAssembler_KeyFrame(::benchmark::State& state)
+{
+    const auto data = createKeyFrame(static_cast<size_t>(state.range(0)));
+    channel::av::H264AccessUnitAssembler assembler;
+    aasdk::benchmark::AllocationScope allocations(state);
+
+    for(auto _ : state)
+    {
+        ::benchmark::DoNotOptimize(assembler.assemble(0, common::DataConstBuffer(data)).isKeyFrame);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(H264AccessUnitAssembler_KeyFrame)->Arg(65536);
+
+}
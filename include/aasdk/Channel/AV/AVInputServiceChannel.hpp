@@ -20,7 +20,10 @@
 
 #include <aasdk/Messenger/MessageId.hpp>
 #include <aasdk/Messenger/Timestamp.hpp>
+#include <aasdk_proto/ControlMessageIdsEnum.pb.h>
+#include <aasdk_proto/AVChannelMessageIdsEnum.pb.h>
 #include <aasdk/Channel/ServiceChannel.hpp>
+#include <aasdk/Channel/MessageDispatcher.hpp>
 #include <aasdk/Channel/AV/IAVInputServiceChannel.hpp>
 
 
@@ -38,15 +41,18 @@ class AVInputServiceChannel
                                   SendPromise::Pointer promise) override;
     void sendAVInputOpenResponse(const proto::messages::AVInputOpenResponse& response, SendPromise::Pointer promise) override;
     void sendAVMediaWithTimestampIndication(messenger::Timestamp::ValueType, const common::Data& data, SendPromise::Pointer promise) override;
+    void sendAVMediaWithTimestampIndication(AudioCaptureRing::Pointer captureRing, SendPromise::Pointer promise) override;
     messenger::ChannelId getId() const override;
 
 private:
     using std::enable_shared_from_this<AVInputServiceChannel>::shared_from_this;
     void messageHandler(messenger::Message::Pointer message, IAVInputServiceChannelEventHandler::Pointer eventHandler);
-    void handleAVChannelSetupRequest(const common::DataConstBuffer& payload, IAVInputServiceChannelEventHandler::Pointer eventHandler);
-    void handleAVInputOpenRequest(const common::DataConstBuffer& payload, IAVInputServiceChannelEventHandler::Pointer eventHandler);
-    void handleAVMediaAckIndication(const common::DataConstBuffer& payload, IAVInputServiceChannelEventHandler::Pointer eventHandler);
-    void handleChannelOpenRequest(const common::DataConstBuffer& payload, IAVInputServiceChannelEventHandler::Pointer eventHandler);
+
+    MessageDispatcher<AVInputServiceChannel, IAVInputServiceChannelEventHandler,
+        MessageRoute<proto::ids::AVChannelMessage::SETUP_REQUEST, &IAVInputServiceChannelEventHandler::onAVChannelSetupRequest>,
+        MessageRoute<proto::ids::AVChannelMessage::AV_INPUT_OPEN_REQUEST, &IAVInputServiceChannelEventHandler::onAVInputOpenRequest>,
+        MessageRoute<proto::ids::AVChannelMessage::AV_MEDIA_ACK_INDICATION, &IAVInputServiceChannelEventHandler::onAVMediaAckIndication>,
+        MessageRoute<proto::ids::ControlMessage::CHANNEL_OPEN_REQUEST, &IAVInputServiceChannelEventHandler::onChannelOpenRequest>> dispatcher_;
 };
 
 }
@@ -0,0 +1,90 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <asio.hpp>
+#include <aasdk/Channel/AV/IVideoServiceChannel.hpp>
+#include <aasdk/Channel/AV/IAudioServiceChannel.hpp>
+
+
+namespace aasdk
+{
+namespace channel
+{
+namespace av
+{
+
+// Credit based flow control for the sink side of a video or audio channel. A frame counts as
+// outstanding from its arrival until the consumer releases it; released frames are acknowledged
+// in batches of half the max_unacked window, or immediately once the phone has used up the whole
+// window, so the source never stalls while the OUT endpoint carries one ack per batch.
+// Attached with setAckEngine, the channel drives start, stop and onMediaReceived; the consumer
+// only calls release.
+class AVMediaAckEngine: public std::enable_shared_from_this<AVMediaAckEngine>
+{
+public:
+    typedef std::shared_ptr<AVMediaAckEngine> Pointer;
+
+    struct Statistics
+    {
+        uint64_t receivedFrames = 0;
+        uint64_t releasedFrames = 0;
+        uint64_t ackedFrames = 0;
+        uint64_t sentAcks = 0;
+    };
+
+    AVMediaAckEngine(asio::io_service& ioService, IVideoServiceChannel::Pointer channel);
+    AVMediaAckEngine(asio::io_service& ioService, IAudioServiceChannel::Pointer channel);
+
+    // Called on AV_CHANNEL_START_INDICATION with the window advertised in the setup response.
+    void start(int32_t session, uint32_t maxUnacked);
+    void stop();
+    void onMediaReceived();
+    void release(uint32_t count = 1);
+    // Acknowledges released frames without waiting for the batch to fill up.
+    void flush();
+    Statistics getStatistics() const;
+
+private:
+    using std::enable_shared_from_this<AVMediaAckEngine>::shared_from_this;
+    typedef std::function<void(const proto::messages::AVMediaAckIndication&, SendPromise::Pointer)> AckSender;
+
+    AVMediaAckEngine(asio::io_service& ioService, AckSender ackSender);
+
+    void sendAck();
+
+    asio::io_service::strand strand_;
+    AckSender ackSender_;
+    int32_t session_;
+    uint32_t maxUnacked_;
+    uint32_t batchSize_;
+    uint32_t outstanding_;
+    uint32_t released_;
+    bool isActive_;
+
+    std::atomic<uint64_t> receivedFrames_;
+    std::atomic<uint64_t> releasedFrames_;
+    std::atomic<uint64_t> ackedFrames_;
+    std::atomic<uint64_t> sentAcks_;
+};
+
+}
+}
+}
@@ -0,0 +1,96 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <asio.hpp>
+#include <aasdk/Common/Data.hpp>
+#include <aasdk/Messenger/Timestamp.hpp>
+#include <aasdk/Channel/AV/IAVSourceServiceChannel.hpp>
+
+
+namespace aasdk
+{
+namespace channel
+{
+namespace av
+{
+
+// Synthetic media producer for the phone role. Emits AV_MEDIA_WITH_TIMESTAMP_INDICATION frames at a
+// fixed rate and never keeps more than max_unacked frames outstanding; a frame which is due while
+// the window is full is skipped, the way a real encoder would drop it.
+class AVMediaSource: public std::enable_shared_from_this<AVMediaSource>
+{
+public:
+    typedef std::shared_ptr<AVMediaSource> Pointer;
+
+    struct Configuration
+    {
+        // Media payload bits per second, excluding the timestamp and protocol framing.
+        size_t bitrate = 8 * 1000 * 1000;
+        size_t frameRate = 30;
+    };
+
+    struct Statistics
+    {
+        uint64_t sentFrames = 0;
+        uint64_t sentBytes = 0;
+        uint64_t ackedFrames = 0;
+        uint64_t skippedFrames = 0;
+    };
+
+    AVMediaSource(asio::io_service& ioService, IAVSourceServiceChannel::Pointer channel, Configuration configuration);
+
+    void start(uint32_t maxUnacked);
+    void stop();
+    void onAck(uint32_t value);
+    Statistics getStatistics() const;
+
+    // Microseconds of the steady clock. Frames are stamped with it so a receiver running
+    // on the same machine can compute the end-to-end latency.
+    static messenger::Timestamp::ValueType now();
+
+private:
+    using std::enable_shared_from_this<AVMediaSource>::shared_from_this;
+    typedef std::chrono::steady_clock Clock;
+
+    void produceFrame();
+    void scheduleFrame();
+
+    asio::io_service::strand strand_;
+    asio::steady_timer timer_;
+    IAVSourceServiceChannel::Pointer channel_;
+    Configuration configuration_;
+    common::Data frame_;
+    Clock::duration frameInterval_;
+    Clock::time_point nextFrameTime_;
+    uint32_t maxUnacked_;
+    uint32_t unacked_;
+    bool isActive_;
+
+    std::atomic<uint64_t> sentFrames_;
+    std::atomic<uint64_t> sentBytes_;
+    std::atomic<uint64_t> ackedFrames_;
+    std::atomic<uint64_t> skippedFrames_;
+};
+
+}
+}
+}
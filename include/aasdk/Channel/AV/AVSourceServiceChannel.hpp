@@ -0,0 +1,56 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <aasdk_proto/ControlMessageIdsEnum.pb.h>
+#include <aasdk_proto/AVChannelMessageIdsEnum.pb.h>
+#include <aasdk/Channel/ServiceChannel.hpp>
+#include <aasdk/Channel/MessageDispatcher.hpp>
+#include <aasdk/Channel/AV/IAVSourceServiceChannel.hpp>
+
+
+namespace aasdk::channel::av {
+
+class AVSourceServiceChannel
+    : public IAVSourceServiceChannel, public ServiceChannel, public std::enable_shared_from_this<AVSourceServiceChannel> {
+ public:
+  AVSourceServiceChannel(asio::io_service::strand &strand, messenger::IMessenger::Pointer messenger, messenger::ChannelId channelId);
+
+  void receive(IAVSourceServiceChannelEventHandler::Pointer eventHandler) override;
+    void sendChannelOpenRequest(const proto::messages::ChannelOpenRequest& request, SendPromise::Pointer promise) override;
+    void sendAVChannelSetupRequest(const proto::messages::AVChannelSetupRequest& request, SendPromise::Pointer promise) override;
+    void sendAVChannelStartIndication(const proto::messages::AVChannelStartIndication& indication, SendPromise::Pointer promise) override;
+    void sendAVChannelStopIndication(const proto::messages::AVChannelStopIndication& indication, SendPromise::Pointer promise) override;
+    void sendAVMediaWithTimestampIndication(messenger::Timestamp::ValueType timestamp, const common::DataConstBuffer& buffer, SendPromise::Pointer promise) override;
+    void sendAVMediaIndication(const common::DataConstBuffer& buffer, SendPromise::Pointer promise) override;
+    void sendVideoFocusRequest(const proto::messages::VideoFocusRequest& request, SendPromise::Pointer promise) override;
+    messenger::ChannelId getId() const override;
+
+private:
+    using std::enable_shared_from_this<AVSourceServiceChannel>::shared_from_this;
+    void messageHandler(messenger::Message::Pointer message, IAVSourceServiceChannelEventHandler::Pointer eventHandler);
+
+    MessageDispatcher<AVSourceServiceChannel, IAVSourceServiceChannelEventHandler,
+        MessageRoute<proto::ids::ControlMessage::CHANNEL_OPEN_RESPONSE, &IAVSourceServiceChannelEventHandler::onChannelOpenResponse>,
+        MessageRoute<proto::ids::AVChannelMessage::SETUP_RESPONSE, &IAVSourceServiceChannelEventHandler::onAVChannelSetupResponse>,
+        MessageRoute<proto::ids::AVChannelMessage::AV_MEDIA_ACK_INDICATION, &IAVSourceServiceChannelEventHandler::onAVMediaAckIndication>,
+        MessageRoute<proto::ids::AVChannelMessage::VIDEO_FOCUS_INDICATION, &IAVSourceServiceChannelEventHandler::onVideoFocusIndication>> dispatcher_;
+};
+
+}
@@ -0,0 +1,61 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <chrono>
+#include <aasdk/Messenger/ClockSyncEstimator.hpp>
+
+
+namespace aasdk
+{
+namespace channel
+{
+namespace av
+{
+
+// Tells the audio and video sinks when to present a buffer. Both streams are played out a fixed
+// presentation delay after the phone time they are stamped with, mapped to the local clock;
+// each sink hands its buffers over early by its own output latency so they end up in sync.
+class AVSync
+{
+public:
+    typedef messenger::ClockSyncEstimator::Clock Clock;
+
+    struct Configuration
+    {
+        std::chrono::microseconds presentationDelay = std::chrono::milliseconds(100);
+        std::chrono::microseconds audioOutputLatency = std::chrono::microseconds(0);
+        std::chrono::microseconds videoOutputLatency = std::chrono::microseconds(0);
+    };
+
+    AVSync(messenger::ClockSyncEstimator::Pointer clockSyncEstimator, Configuration configuration);
+
+    // Local time at which the buffer has to be handed to the audio or video output.
+    Clock::time_point getAudioPresentationTime(messenger::Timestamp::ValueType timestamp) const;
+    Clock::time_point getVideoPresentationTime(messenger::Timestamp::ValueType timestamp) const;
+    // Positive if the video frame is already behind its presentation time and worth skipping.
+    Clock::duration getVideoLateness(messenger::Timestamp::ValueType timestamp, Clock::time_point now = Clock::now()) const;
+
+private:
+    messenger::ClockSyncEstimator::Pointer clockSyncEstimator_;
+    Configuration configuration_;
+};
+
+}
+}
+}
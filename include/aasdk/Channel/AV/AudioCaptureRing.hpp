@@ -0,0 +1,111 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <aasdk_proto/AudioConfigData.pb.h>
+#include <aasdk/Common/Data.hpp>
+#include <aasdk/Messenger/Message.hpp>
+#include <aasdk/Messenger/Timestamp.hpp>
+
+
+namespace aasdk
+{
+namespace channel
+{
+namespace av
+{
+
+// Preallocated AV_MEDIA_WITH_TIMESTAMP_INDICATION messages for the microphone. The capture
+// callback writes PCM straight behind the reserved message id and timestamp, a chunk holds
+// chunkDuration of audio in the negotiated AudioConfig, and the very same message is handed
+// to the messenger and reused once it went out. fill/commit (capture thread) and pop/release
+// (channel strand, AVInputServiceChannel dispatches there) never lock or allocate; audio is
+// dropped while every slot is in flight.
+class AudioCaptureRing
+{
+public:
+    typedef std::shared_ptr<AudioCaptureRing> Pointer;
+
+    struct Configuration
+    {
+        std::chrono::milliseconds chunkDuration = std::chrono::milliseconds(20);
+        size_t slotCount = 8;
+    };
+
+    struct Statistics
+    {
+        uint64_t completedChunks = 0;
+        uint64_t droppedBytes = 0;
+    };
+
+    AudioCaptureRing(const proto::data::AudioConfig& audioConfig, Configuration configuration);
+
+    // Free space of the chunk being captured, empty if no slot is free.
+    common::DataBuffer fill();
+    // Timestamp of the first committed sample, it stamps the chunk if the commit starts one.
+    // Returns true if the commit completed a chunk; without a free slot the data is counted as dropped.
+    bool commit(size_t size, messenger::Timestamp::ValueType timestamp);
+    // Copies as much PCM as fits, returns the number of completed chunks.
+    size_t write(const common::DataConstBuffer& buffer, messenger::Timestamp::ValueType timestamp);
+
+    // Oldest completed chunk, nullptr if there is none.
+    messenger::Message::Pointer pop();
+    void release(const messenger::Message::Pointer& message);
+
+    size_t getChunkSize() const;
+    Statistics getStatistics() const;
+
+private:
+    enum class SlotState
+    {
+        FREE,
+        READY,
+        SENDING
+    };
+
+    struct Slot
+    {
+        messenger::Message::Pointer message;
+        std::atomic<SlotState> state;
+    };
+
+    static constexpr size_t cHeaderSize = sizeof(uint16_t) + sizeof(messenger::Timestamp::ValueType);
+
+    size_t chunkSize_;
+    std::vector<Slot> slots_;
+
+    // Capture thread state.
+    size_t fillIndex_;
+    size_t fillOffset_;
+
+    // Channel strand state.
+    size_t popIndex_;
+
+    std::atomic<uint64_t> completedChunks_;
+    std::atomic<uint64_t> droppedBytes_;
+
+    AudioCaptureRing(const AudioCaptureRing&) = delete;
+};
+
+}
+}
+}
@@ -0,0 +1,119 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <aasdk/Common/Data.hpp>
+#include <aasdk/Messenger/Timestamp.hpp>
+
+
+namespace aasdk
+{
+namespace channel
+{
+namespace av
+{
+
+// Single producer, single consumer PCM buffer between an audio channel and the audio sink thread.
+// The producer estimates the arrival jitter from the media timestamps (RFC 3550 style) and sets
+// the depth the consumer plays out at: playback starts once the target depth is buffered, and
+// after an underrun it waits for the target depth again. If the buffer has grown past twice
+// the target, the consumer skips the oldest audio. push() and pull() never lock or allocate.
+class AudioJitterBuffer
+{
+public:
+    typedef std::shared_ptr<AudioJitterBuffer> Pointer;
+
+    struct Configuration
+    {
+        uint32_t sampleRate = 48000;
+        uint32_t channelCount = 2;
+        uint32_t bitsPerSample = 16;
+        std::chrono::milliseconds minDepth = std::chrono::milliseconds(20);
+        std::chrono::milliseconds maxDepth = std::chrono::milliseconds(200);
+        std::chrono::milliseconds capacity = std::chrono::milliseconds(500);
+    };
+
+    struct Statistics
+    {
+        uint64_t pushedBytes = 0;
+        uint64_t pulledBytes = 0;
+        uint64_t underruns = 0;
+        // Incoming audio which did not fit any more.
+        uint64_t overflowBytes = 0;
+        // Oldest audio skipped to bring the latency back to the target.
+        uint64_t skippedBytes = 0;
+    };
+
+    explicit AudioJitterBuffer(Configuration configuration);
+
+    // Producer side, called on the channel strand.
+    void push(messenger::Timestamp::ValueType timestamp, const common::DataConstBuffer& buffer);
+    void push(const common::DataConstBuffer& buffer);
+    // Drops the buffered audio, e.g. on AV_CHANNEL_STOP_INDICATION. Takes effect on the next pull().
+    void reset();
+
+    // Consumer side. Always fills the whole buffer, with silence while nothing is playable, and
+    // returns the number of bytes which carry audio.
+    size_t pull(common::DataBuffer buffer);
+
+    std::chrono::microseconds getJitter() const;
+    std::chrono::microseconds getTargetDepth() const;
+    Statistics getStatistics() const;
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    void write(const common::DataConstBuffer& buffer);
+    void read(uint64_t readIndex, common::Data::value_type* data, size_t size);
+    void updateJitter(messenger::Timestamp::ValueType timestamp);
+    size_t toBytes(std::chrono::microseconds duration) const;
+    size_t alignToFrame(size_t size) const;
+
+    Configuration configuration_;
+    size_t frameSize_;
+    common::Data data_;
+    std::atomic<uint64_t> writeIndex_;
+    std::atomic<uint64_t> readIndex_;
+    std::atomic<size_t> targetDepth_;
+    std::atomic<bool> isResetRequested_;
+
+    // Producer state.
+    bool hasPreviousArrival_;
+    Clock::time_point previousArrival_;
+    messenger::Timestamp::ValueType previousTimestamp_;
+    double jitter_;
+    std::atomic<int64_t> jitterMicroseconds_;
+
+    // Consumer state.
+    bool isPrebuffering_;
+
+    std::atomic<uint64_t> pushedBytes_;
+    std::atomic<uint64_t> pulledBytes_;
+    std::atomic<uint64_t> underruns_;
+    std::atomic<uint64_t> overflowBytes_;
+    std::atomic<uint64_t> skippedBytes_;
+
+    AudioJitterBuffer(const AudioJitterBuffer&) = delete;
+};
+
+}
+}
+}
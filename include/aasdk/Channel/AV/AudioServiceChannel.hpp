@@ -19,8 +19,13 @@
 #pragma once
 
 #include <aasdk/Messenger/MessageId.hpp>
+#include <aasdk_proto/ControlMessageIdsEnum.pb.h>
+#include <aasdk_proto/AVChannelMessageIdsEnum.pb.h>
 #include <aasdk/Channel/ServiceChannel.hpp>
+#include <aasdk/Channel/MessageDispatcher.hpp>
 #include <aasdk/Channel/AV/IAudioServiceChannel.hpp>
+#include <aasdk/Channel/AV/AudioJitterBuffer.hpp>
+#include <aasdk/Channel/AV/AVMediaAckEngine.hpp>
 
 
 namespace aasdk::channel::av {
@@ -40,14 +45,30 @@ class AudioServiceChannel
     void sendAVMediaAckIndication(const proto::messages::AVMediaAckIndication& indication, SendPromise::Pointer promise) override;
     messenger::ChannelId getId() const override;
 
+    // Media is pushed into the jitter buffer and still passed to the event handler, which keeps
+    // acknowledging it. Must be attached before the first receive.
+    void setJitterBuffer(AudioJitterBuffer::Pointer jitterBuffer);
+    // Started and stopped with the channel and fed every media message; the event handler then
+    // releases media through the engine instead of acknowledging it. Must be attached before the
+    // first receive.
+    void setAckEngine(AVMediaAckEngine::Pointer ackEngine);
+
 private:
     using std::enable_shared_from_this<AudioServiceChannel>::shared_from_this;
     void messageHandler(messenger::Message::Pointer message, IAudioServiceChannelEventHandler::Pointer eventHandler);
-    void handleAVChannelSetupRequest(const common::DataConstBuffer& payload, IAudioServiceChannelEventHandler::Pointer eventHandler);
-    void handleStartIndication(const common::DataConstBuffer& payload, IAudioServiceChannelEventHandler::Pointer eventHandler);
-    void handleStopIndication(const common::DataConstBuffer& payload, IAudioServiceChannelEventHandler::Pointer eventHandler);
-    void handleChannelOpenRequest(const common::DataConstBuffer& payload, IAudioServiceChannelEventHandler::Pointer eventHandler);
+    void handleStartIndication(const proto::messages::AVChannelStartIndication& indication, IAudioServiceChannelEventHandler::Pointer eventHandler);
+    void handleStopIndication(const proto::messages::AVChannelStopIndication& indication, IAudioServiceChannelEventHandler::Pointer eventHandler);
     void handleAVMediaWithTimestampIndication(const common::DataConstBuffer& payload, IAudioServiceChannelEventHandler::Pointer eventHandler);
+
+    AudioJitterBuffer::Pointer jitterBuffer_;
+    AVMediaAckEngine::Pointer ackEngine_;
+    uint32_t maxUnacked_ = 1;
+
+    MessageDispatcher<AudioServiceChannel, IAudioServiceChannelEventHandler,
+        MessageRoute<proto::ids::AVChannelMessage::SETUP_REQUEST, &IAudioServiceChannelEventHandler::onAVChannelSetupRequest>,
+        MessageRoute<proto::ids::AVChannelMessage::START_INDICATION, &AudioServiceChannel::handleStartIndication>,
+        MessageRoute<proto::ids::AVChannelMessage::STOP_INDICATION, &AudioServiceChannel::handleStopIndication>,
+        MessageRoute<proto::ids::ControlMessage::CHANNEL_OPEN_REQUEST, &IAudioServiceChannelEventHandler::onChannelOpenRequest>> dispatcher_;
 };
 
 }
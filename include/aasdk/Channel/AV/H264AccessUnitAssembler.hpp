@@ -0,0 +1,98 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <vector>
+#include <aasdk/Common/Data.hpp>
+#include <aasdk/Messenger/Timestamp.hpp>
+
+
+namespace aasdk
+{
+namespace channel
+{
+namespace av
+{
+
+enum class H264NalUnitType : uint8_t
+{
+    UNSPECIFIED = 0,
+    NON_IDR_SLICE = 1,
+    SLICE_DATA_PARTITION_A = 2,
+    SLICE_DATA_PARTITION_B = 3,
+    SLICE_DATA_PARTITION_C = 4,
+    IDR_SLICE = 5,
+    SEI = 6,
+    SPS = 7,
+    PPS = 8,
+    ACCESS_UNIT_DELIMITER = 9,
+    END_OF_SEQUENCE = 10,
+    END_OF_STREAM = 11,
+    FILLER_DATA = 12
+};
+
+struct H264NalUnit
+{
+    H264NalUnitType type;
+    uint8_t refIdc;
+    // Header byte and payload, without the start code.
+    common::DataConstBuffer data;
+};
+
+struct H264AccessUnit
+{
+    messenger::Timestamp::ValueType timestamp = 0;
+    bool hasTimestamp = false;
+    // Carries an IDR slice, decoding can start here.
+    bool isKeyFrame = false;
+    // Carries SPS/PPS but no slice, the phone sends one before the first frame.
+    bool isCodecConfig = false;
+    // No slice is referenced by later frames.
+    bool isDroppable = false;
+    // The whole Annex-B payload as received.
+    common::DataConstBuffer data;
+    std::vector<H264NalUnit> nalUnits;
+};
+
+// Splits the Annex-B payloads of the video channel into NAL units and classifies the access unit
+// each payload carries. The returned access unit points into the payload and is only valid until
+// the next call; the latest SPS/PPS are copied so a decoder can be reset after frames were dropped.
+class H264AccessUnitAssembler
+{
+public:
+    H264AccessUnitAssembler();
+
+    const H264AccessUnit& assemble(messenger::Timestamp::ValueType timestamp, const common::DataConstBuffer& buffer);
+    const H264AccessUnit& assemble(const common::DataConstBuffer& buffer);
+
+    // SPS and PPS of the stream in Annex-B format, empty until the first codec config arrived.
+    const common::Data& getCodecConfig() const;
+
+private:
+    void parse(const common::DataConstBuffer& buffer);
+    void updateCodecConfig();
+
+    H264AccessUnit accessUnit_;
+    common::Data codecConfig_;
+
+    H264AccessUnitAssembler(const H264AccessUnitAssembler&) = delete;
+};
+
+}
+}
+}
@@ -26,6 +26,7 @@
 #include <aasdk/Messenger/Timestamp.hpp>
 #include <aasdk/Channel/Promise.hpp>
 #include <aasdk/Channel/AV/IAVInputServiceChannelEventHandler.hpp>
+#include <aasdk/Channel/AV/AudioCaptureRing.hpp>
 
 
 namespace aasdk::channel::av {
@@ -41,6 +42,8 @@ class IAVInputServiceChannel {
     virtual void sendChannelOpenResponse(const proto::messages::ChannelOpenResponse& response, SendPromise::Pointer promise) = 0;
     virtual void sendAVChannelSetupResponse(const proto::messages::AVChannelSetupResponse& response, SendPromise::Pointer promise) = 0;
     virtual void sendAVMediaWithTimestampIndication(messenger::Timestamp::ValueType, const common::Data& data, SendPromise::Pointer promise) = 0;
+    // Sends the oldest completed chunk of the ring without copying it.
+    virtual void sendAVMediaWithTimestampIndication(AudioCaptureRing::Pointer captureRing, SendPromise::Pointer promise) = 0;
     virtual void sendAVInputOpenResponse(const proto::messages::AVInputOpenResponse& response, SendPromise::Pointer promise) = 0;
     virtual messenger::ChannelId getId() const = 0;
 };
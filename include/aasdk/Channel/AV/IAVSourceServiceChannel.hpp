@@ -0,0 +1,56 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <memory>
+#include <aasdk_proto/ChannelOpenRequestMessage.pb.h>
+#include <aasdk_proto/AVChannelSetupRequestMessage.pb.h>
+#include <aasdk_proto/AVChannelStartIndicationMessage.pb.h>
+#include <aasdk_proto/AVChannelStopIndicationMessage.pb.h>
+#include <aasdk_proto/VideoFocusRequestMessage.pb.h>
+#include <aasdk/Messenger/ChannelId.hpp>
+#include <aasdk/Messenger/Timestamp.hpp>
+#include <aasdk/Common/Data.hpp>
+#include <aasdk/Channel/Promise.hpp>
+#include <aasdk/Channel/AV/IAVSourceServiceChannelEventHandler.hpp>
+
+
+namespace aasdk::channel::av {
+
+// Phone side of a video or audio output channel: opens the channel, negotiates the
+// configuration and streams media towards the head unit.
+class IAVSourceServiceChannel {
+ public:
+  typedef std::shared_ptr<IAVSourceServiceChannel> Pointer;
+
+  IAVSourceServiceChannel() = default;
+  virtual ~IAVSourceServiceChannel() = default;
+
+    virtual void receive(IAVSourceServiceChannelEventHandler::Pointer eventHandler) = 0;
+    virtual void sendChannelOpenRequest(const proto::messages::ChannelOpenRequest& request, SendPromise::Pointer promise) = 0;
+    virtual void sendAVChannelSetupRequest(const proto::messages::AVChannelSetupRequest& request, SendPromise::Pointer promise) = 0;
+    virtual void sendAVChannelStartIndication(const proto::messages::AVChannelStartIndication& indication, SendPromise::Pointer promise) = 0;
+    virtual void sendAVChannelStopIndication(const proto::messages::AVChannelStopIndication& indication, SendPromise::Pointer promise) = 0;
+    virtual void sendAVMediaWithTimestampIndication(messenger::Timestamp::ValueType timestamp, const common::DataConstBuffer& buffer, SendPromise::Pointer promise) = 0;
+    virtual void sendAVMediaIndication(const common::DataConstBuffer& buffer, SendPromise::Pointer promise) = 0;
+    virtual void sendVideoFocusRequest(const proto::messages::VideoFocusRequest& request, SendPromise::Pointer promise) = 0;
+    virtual messenger::ChannelId getId() const = 0;
+};
+
+}
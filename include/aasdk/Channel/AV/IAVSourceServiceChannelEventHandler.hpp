@@ -0,0 +1,44 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <aasdk_proto/ChannelOpenResponseMessage.pb.h>
+#include <aasdk_proto/AVChannelSetupResponseMessage.pb.h>
+#include <aasdk_proto/AVMediaAckIndicationMessage.pb.h>
+#include <aasdk_proto/VideoFocusIndicationMessage.pb.h>
+#include <aasdk/Error/Error.hpp>
+
+
+namespace aasdk::channel::av {
+
+class IAVSourceServiceChannelEventHandler {
+ public:
+  typedef std::shared_ptr<IAVSourceServiceChannelEventHandler> Pointer;
+
+  IAVSourceServiceChannelEventHandler() = default;
+  virtual ~IAVSourceServiceChannelEventHandler() = default;
+
+    virtual void onChannelOpenResponse(const proto::messages::ChannelOpenResponse& response) = 0;
+    virtual void onAVChannelSetupResponse(const proto::messages::AVChannelSetupResponse& response) = 0;
+    virtual void onAVMediaAckIndication(const proto::messages::AVMediaAckIndication& indication) = 0;
+    virtual void onVideoFocusIndication(const proto::messages::VideoFocusIndication& indication) = 0;
+    virtual void onChannelError(const error::Error& e) = 0;
+};
+
+}
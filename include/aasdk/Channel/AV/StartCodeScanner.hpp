@@ -0,0 +1,39 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <cstdint>
+
+
+namespace aasdk
+{
+namespace channel
+{
+namespace av
+{
+
+// Returns the first Annex-B start code prefix (00 00 01) in [begin, end), or end if there is none.
+// A four byte start code is found at its last three bytes. Uses SSE2 or NEON when the target has it.
+const uint8_t* findStartCode(const uint8_t* begin, const uint8_t* end);
+
+// Byte by byte reference of findStartCode.
+const uint8_t* findStartCodeScalar(const uint8_t* begin, const uint8_t* end);
+
+}
+}
+}
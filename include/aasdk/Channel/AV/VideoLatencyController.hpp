@@ -0,0 +1,92 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <aasdk/Common/TraceClock.hpp>
+#include <aasdk/Channel/AV/H264AccessUnitAssembler.hpp>
+
+
+namespace aasdk
+{
+namespace channel
+{
+namespace av
+{
+
+// Bounds the time video frames spend queued in the messenger while the consumer is behind.
+// A frame which waited longer than maxQueueDelay is dropped if nothing references it; once a
+// reference frame has to go, the rest of the GOP goes too and delivery resumes with the next IDR.
+// A keyframe is requested when a GOP starts being dropped; if none arrives within maxDropDuration
+// delivery resumes anyway, trading a short corruption for a frozen picture.
+// Codec config and payloads which are not Annex-B are always delivered. Enables the trace clock, which dates every received message.
+class VideoLatencyController
+{
+public:
+    typedef std::shared_ptr<VideoLatencyController> Pointer;
+
+    struct Configuration
+    {
+        std::chrono::milliseconds maxQueueDelay = std::chrono::milliseconds(100);
+        std::chrono::milliseconds maxDropDuration = std::chrono::seconds(2);
+    };
+
+    struct Statistics
+    {
+        uint64_t deliveredFrames = 0;
+        uint64_t droppedNonReferenceFrames = 0;
+        uint64_t droppedGopFrames = 0;
+        uint64_t droppedGops = 0;
+        uint64_t expiredGopDrops = 0;
+    };
+
+    // Called from onFrame, on the channel strand.
+    typedef std::function<void()> KeyFrameRequestHandler;
+
+    explicit VideoLatencyController(Configuration configuration);
+    ~VideoLatencyController();
+
+    // Returns false if the frame has to be dropped instead of passed to the consumer.
+    bool onFrame(const common::DataConstBuffer& buffer, common::TraceClock::duration queueDelay);
+    bool onFrame(const common::DataConstBuffer& buffer, common::TraceClock::duration queueDelay, common::TraceClock::time_point now);
+    void reset();
+    void setKeyFrameRequestHandler(KeyFrameRequestHandler keyFrameRequestHandler);
+    Statistics getStatistics() const;
+
+private:
+    Configuration configuration_;
+    H264AccessUnitAssembler assembler_;
+    KeyFrameRequestHandler keyFrameRequestHandler_;
+    bool isWaitingForKeyFrame_;
+    common::TraceClock::time_point dropStartTime_;
+
+    std::atomic<uint64_t> deliveredFrames_;
+    std::atomic<uint64_t> droppedNonReferenceFrames_;
+    std::atomic<uint64_t> droppedGopFrames_;
+    std::atomic<uint64_t> droppedGops_;
+    std::atomic<uint64_t> expiredGopDrops_;
+
+    VideoLatencyController(const VideoLatencyController&) = delete;
+};
+
+}
+}
+}
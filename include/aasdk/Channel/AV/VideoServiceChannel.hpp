@@ -18,8 +18,14 @@
 
 #pragma once
 
+#include <aasdk_proto/ControlMessageIdsEnum.pb.h>
+#include <aasdk_proto/AVChannelMessageIdsEnum.pb.h>
 #include <aasdk/Channel/ServiceChannel.hpp>
+#include <aasdk/Channel/MessageDispatcher.hpp>
 #include <aasdk/Channel/AV/IVideoServiceChannel.hpp>
+#include <aasdk/Channel/AV/VideoLatencyController.hpp>
+#include <aasdk/Channel/AV/AVMediaAckEngine.hpp>
+#include <aasdk/Messenger/ClockSyncEstimator.hpp>
 
 
 namespace aasdk::channel::av {
@@ -38,15 +44,39 @@ class VideoServiceChannel
     void sendAVMediaAckIndication(const proto::messages::AVMediaAckIndication& indication, SendPromise::Pointer promise) override;
     messenger::ChannelId getId() const override;
 
+    // Frames the controller drops never reach the event handler. They are released through the
+    // ack engine if one is attached, otherwise acknowledged here in batches of half the window.
+    // Must be attached before the first receive.
+    void setLatencyController(VideoLatencyController::Pointer latencyController);
+    // Feeds the arrival of every timestamped frame to the estimator. Must be attached before the first receive.
+    void setClockSyncEstimator(messenger::ClockSyncEstimator::Pointer clockSyncEstimator);
+    // Started and stopped with the channel and fed every delivered frame; the event handler then
+    // releases frames through the engine instead of acknowledging them. Must be attached before
+    // the first receive.
+    void setAckEngine(AVMediaAckEngine::Pointer ackEngine);
+
 private:
     using std::enable_shared_from_this<VideoServiceChannel>::shared_from_this;
     void messageHandler(messenger::Message::Pointer message, IVideoServiceChannelEventHandler::Pointer eventHandler);
-    void handleAVChannelSetupRequest(const common::DataConstBuffer& payload, IVideoServiceChannelEventHandler::Pointer eventHandler);
-    void handleStartIndication(const common::DataConstBuffer& payload, IVideoServiceChannelEventHandler::Pointer eventHandler);
-    void handleStopIndication(const common::DataConstBuffer& payload, IVideoServiceChannelEventHandler::Pointer eventHandler);
-    void handleChannelOpenRequest(const common::DataConstBuffer& payload, IVideoServiceChannelEventHandler::Pointer eventHandler);
-    void handleVideoFocusRequest(const common::DataConstBuffer& payload, IVideoServiceChannelEventHandler::Pointer eventHandler);
+    void handleStartIndication(const proto::messages::AVChannelStartIndication& indication, IVideoServiceChannelEventHandler::Pointer eventHandler);
+    void handleStopIndication(const proto::messages::AVChannelStopIndication& indication, IVideoServiceChannelEventHandler::Pointer eventHandler);
     void handleAVMediaWithTimestampIndication(const common::DataConstBuffer& payload, IVideoServiceChannelEventHandler::Pointer eventHandler);
+    bool isFrameDropped(const messenger::Message& message, const common::DataConstBuffer& frame);
+    void sendDroppedFramesAck();
+
+    VideoLatencyController::Pointer latencyController_;
+    messenger::ClockSyncEstimator::Pointer clockSyncEstimator_;
+    AVMediaAckEngine::Pointer ackEngine_;
+    int32_t session_ = 0;
+    uint32_t maxUnacked_ = 1;
+    uint32_t droppedFramesToAck_ = 0;
+
+    MessageDispatcher<VideoServiceChannel, IVideoServiceChannelEventHandler,
+        MessageRoute<proto::ids::AVChannelMessage::SETUP_REQUEST, &IVideoServiceChannelEventHandler::onAVChannelSetupRequest>,
+        MessageRoute<proto::ids::AVChannelMessage::START_INDICATION, &VideoServiceChannel::handleStartIndication>,
+        MessageRoute<proto::ids::AVChannelMessage::STOP_INDICATION, &VideoServiceChannel::handleStopIndication>,
+        MessageRoute<proto::ids::ControlMessage::CHANNEL_OPEN_REQUEST, &IVideoServiceChannelEventHandler::onChannelOpenRequest>,
+        MessageRoute<proto::ids::AVChannelMessage::VIDEO_FOCUS_REQUEST, &IVideoServiceChannelEventHandler::onVideoFocusRequest>> dispatcher_;
 };
 
 }
@@ -18,7 +18,10 @@
 
 #pragma once
 
+#include <aasdk_proto/ControlMessageIdsEnum.pb.h>
+#include <aasdk_proto/BluetoothChannelMessageIdsEnum.pb.h>
 #include <aasdk/Channel/ServiceChannel.hpp>
+#include <aasdk/Channel/MessageDispatcher.hpp>
 #include <aasdk/Channel/Bluetooth/IBluetoothServiceChannel.hpp>
 
 
@@ -40,8 +43,12 @@ class BluetoothServiceChannel
 private:
     using std::enable_shared_from_this<BluetoothServiceChannel>::shared_from_this;
     void messageHandler(messenger::Message::Pointer message, IBluetoothServiceChannelEventHandler::Pointer eventHandler);
-    void handleChannelOpenRequest(const common::DataConstBuffer& payload, IBluetoothServiceChannelEventHandler::Pointer eventHandler);
-    void handleBluetoothPairingRequest(const common::DataConstBuffer& payload, IBluetoothServiceChannelEventHandler::Pointer eventHandler);
+    void handleChannelOpenRequest(const proto::messages::ChannelOpenRequest& request, IBluetoothServiceChannelEventHandler::Pointer eventHandler);
+    void handleBluetoothPairingRequest(const proto::messages::BluetoothPairingRequest& request, IBluetoothServiceChannelEventHandler::Pointer eventHandler);
+
+    MessageDispatcher<BluetoothServiceChannel, IBluetoothServiceChannelEventHandler,
+        MessageRoute<proto::ids::ControlMessage::CHANNEL_OPEN_REQUEST, &BluetoothServiceChannel::handleChannelOpenRequest>,
+        MessageRoute<proto::ids::BluetoothChannelMessage::PAIRING_REQUEST, &BluetoothServiceChannel::handleBluetoothPairingRequest>> dispatcher_;
 };
 
 }
@@ -20,7 +20,10 @@
 
 #include <asio.hpp>
 #include <aasdk/Messenger/IMessenger.hpp>
+#include <aasdk/Messenger/ClockSyncEstimator.hpp>
+#include <aasdk_proto/ControlMessageIdsEnum.pb.h>
 #include <aasdk/Channel/ServiceChannel.hpp>
+#include <aasdk/Channel/MessageDispatcher.hpp>
 #include <aasdk/Channel/Control/IControlServiceChannel.hpp>
 
 namespace aasdk::channel::control {
@@ -43,19 +46,30 @@ class ControlServiceChannel
     void sendPingRequest(const proto::messages::PingRequest& request, SendPromise::Pointer promise) override;
     void sendPingResponse(const proto::messages::PingResponse& response, SendPromise::Pointer promise) override;
 
+    // Feeds ping requests and responses to the estimator, outgoing ping requests have to be
+    // stamped with ClockSyncEstimator::now(). Must be attached before the first receive.
+    void setClockSyncEstimator(messenger::ClockSyncEstimator::Pointer clockSyncEstimator);
+
 private:
     using std::enable_shared_from_this<ControlServiceChannel>::shared_from_this;
     void messageHandler(messenger::Message::Pointer message, IControlServiceChannelEventHandler::Pointer eventHandler);
 
     void handleVersionResponse(const common::DataConstBuffer& payload, IControlServiceChannelEventHandler::Pointer eventHandler);
-    void handleServiceDiscoveryRequest(const common::DataConstBuffer& payload, IControlServiceChannelEventHandler::Pointer eventHandler);
-    void handleAudioFocusRequest(const common::DataConstBuffer& payload, IControlServiceChannelEventHandler::Pointer eventHandler);
-    void handleShutdownRequest(const common::DataConstBuffer& payload, IControlServiceChannelEventHandler::Pointer eventHandler);
-    void handleShutdownResponse(const common::DataConstBuffer& payload, IControlServiceChannelEventHandler::Pointer eventHandler);
-    void handleNavigationFocusRequest(const common::DataConstBuffer& payload, IControlServiceChannelEventHandler::Pointer eventHandler);
-    void handlePingRequest(const common::DataConstBuffer& payload, IControlServiceChannelEventHandler::Pointer eventHandler);
-    void handlePingResponse(const common::DataConstBuffer& payload, IControlServiceChannelEventHandler::Pointer eventHandler);
-    void handleVoiceSessionRequest(const common::DataConstBuffer& payload, IControlServiceChannelEventHandler::Pointer eventHandler);
+    void handleAudioFocusRequest(const proto::messages::AudioFocusRequest& request, IControlServiceChannelEventHandler::Pointer eventHandler);
+    void handlePingRequest(const proto::messages::PingRequest& request, IControlServiceChannelEventHandler::Pointer eventHandler);
+    void handlePingResponse(const proto::messages::PingResponse& response, IControlServiceChannelEventHandler::Pointer eventHandler);
+
+    messenger::ClockSyncEstimator::Pointer clockSyncEstimator_;
+
+    MessageDispatcher<ControlServiceChannel, IControlServiceChannelEventHandler,
+        MessageRoute<proto::ids::ControlMessage::SERVICE_DISCOVERY_REQUEST, &IControlServiceChannelEventHandler::onServiceDiscoveryRequest>,
+        MessageRoute<proto::ids::ControlMessage::AUDIO_FOCUS_REQUEST, &ControlServiceChannel::handleAudioFocusRequest>,
+        MessageRoute<proto::ids::ControlMessage::SHUTDOWN_REQUEST, &IControlServiceChannelEventHandler::onShutdownRequest>,
+        MessageRoute<proto::ids::ControlMessage::SHUTDOWN_RESPONSE, &IControlServiceChannelEventHandler::onShutdownResponse>,
+        MessageRoute<proto::ids::ControlMessage::NAVIGATION_FOCUS_REQUEST, &IControlServiceChannelEventHandler::onNavigationFocusRequest>,
+        MessageRoute<proto::ids::ControlMessage::PING_REQUEST, &ControlServiceChannel::handlePingRequest>,
+        MessageRoute<proto::ids::ControlMessage::PING_RESPONSE, &ControlServiceChannel::handlePingResponse>,
+        MessageRoute<proto::ids::ControlMessage::VOICE_SESSION_REQUEST, &IControlServiceChannelEventHandler::onVoiceSessionRequest>> dispatcher_;
 };
 
 }
@@ -0,0 +1,60 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <asio.hpp>
+#include <aasdk/Messenger/IMessenger.hpp>
+#include <aasdk_proto/ControlMessageIdsEnum.pb.h>
+#include <aasdk/Channel/ServiceChannel.hpp>
+#include <aasdk/Channel/MessageDispatcher.hpp>
+#include <aasdk/Channel/Control/IDeviceControlServiceChannel.hpp>
+
+namespace aasdk::channel::control {
+
+class DeviceControlServiceChannel
+    : public IDeviceControlServiceChannel, public ServiceChannel, public std::enable_shared_from_this<DeviceControlServiceChannel> {
+ public:
+  DeviceControlServiceChannel(asio::io_service::strand &strand, messenger::IMessenger::Pointer messenger);
+
+  void receive(IDeviceControlServiceChannelEventHandler::Pointer eventHandler) override;
+
+    void sendVersionResponse(uint16_t majorCode, uint16_t minorCode, proto::enums::VersionResponseStatus::Enum status, SendPromise::Pointer promise) override;
+    void sendHandshake(common::Data handshakeBuffer, SendPromise::Pointer promise) override;
+    void sendServiceDiscoveryRequest(const proto::messages::ServiceDiscoveryRequest& request, SendPromise::Pointer promise) override;
+    void sendShutdownRequest(const proto::messages::ShutdownRequest& request, SendPromise::Pointer promise) override;
+    void sendShutdownResponse(const proto::messages::ShutdownResponse& response, SendPromise::Pointer promise) override;
+    void sendPingRequest(const proto::messages::PingRequest& request, SendPromise::Pointer promise) override;
+    void sendPingResponse(const proto::messages::PingResponse& response, SendPromise::Pointer promise) override;
+
+private:
+    using std::enable_shared_from_this<DeviceControlServiceChannel>::shared_from_this;
+    void messageHandler(messenger::Message::Pointer message, IDeviceControlServiceChannelEventHandler::Pointer eventHandler);
+
+    void handleVersionRequest(const common::DataConstBuffer& payload, IDeviceControlServiceChannelEventHandler::Pointer eventHandler);
+
+    MessageDispatcher<DeviceControlServiceChannel, IDeviceControlServiceChannelEventHandler,
+        MessageRoute<proto::ids::ControlMessage::AUTH_COMPLETE, &IDeviceControlServiceChannelEventHandler::onAuthComplete>,
+        MessageRoute<proto::ids::ControlMessage::SERVICE_DISCOVERY_RESPONSE, &IDeviceControlServiceChannelEventHandler::onServiceDiscoveryResponse>,
+        MessageRoute<proto::ids::ControlMessage::SHUTDOWN_REQUEST, &IDeviceControlServiceChannelEventHandler::onShutdownRequest>,
+        MessageRoute<proto::ids::ControlMessage::SHUTDOWN_RESPONSE, &IDeviceControlServiceChannelEventHandler::onShutdownResponse>,
+        MessageRoute<proto::ids::ControlMessage::PING_REQUEST, &IDeviceControlServiceChannelEventHandler::onPingRequest>,
+        MessageRoute<proto::ids::ControlMessage::PING_RESPONSE, &IDeviceControlServiceChannelEventHandler::onPingResponse>> dispatcher_;
+};
+
+}
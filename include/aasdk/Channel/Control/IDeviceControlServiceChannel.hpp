@@ -0,0 +1,54 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <aasdk_proto/ServiceDiscoveryRequestMessage.pb.h>
+#include <aasdk_proto/ShutdownRequestMessage.pb.h>
+#include <aasdk_proto/ShutdownResponseMessage.pb.h>
+#include <aasdk_proto/PingRequestMessage.pb.h>
+#include <aasdk_proto/PingResponseMessage.pb.h>
+#include <aasdk_proto/VersionResponseStatusEnum.pb.h>
+#include <aasdk/Common/Data.hpp>
+#include <aasdk/Channel/Promise.hpp>
+#include <aasdk/Channel/Control/IDeviceControlServiceChannelEventHandler.hpp>
+
+
+namespace aasdk::channel::control {
+
+// Phone side of the control channel: answers the version request, acts as the TLS server
+// and starts service discovery once the head unit reports the authentication as complete.
+class IDeviceControlServiceChannel {
+ public:
+  typedef std::shared_ptr<IDeviceControlServiceChannel> Pointer;
+
+  IDeviceControlServiceChannel() = default;
+  virtual ~IDeviceControlServiceChannel() = default;
+
+    virtual void receive(IDeviceControlServiceChannelEventHandler::Pointer eventHandler) = 0;
+
+    virtual void sendVersionResponse(uint16_t majorCode, uint16_t minorCode, proto::enums::VersionResponseStatus::Enum status, SendPromise::Pointer promise) = 0;
+    virtual void sendHandshake(common::Data handshakeBuffer, SendPromise::Pointer promise) = 0;
+    virtual void sendServiceDiscoveryRequest(const proto::messages::ServiceDiscoveryRequest& request, SendPromise::Pointer promise) = 0;
+    virtual void sendShutdownRequest(const proto::messages::ShutdownRequest& request, SendPromise::Pointer promise) = 0;
+    virtual void sendShutdownResponse(const proto::messages::ShutdownResponse& response, SendPromise::Pointer promise) = 0;
+    virtual void sendPingRequest(const proto::messages::PingRequest& request, SendPromise::Pointer promise) = 0;
+    virtual void sendPingResponse(const proto::messages::PingResponse& response, SendPromise::Pointer promise) = 0;
+};
+
+}
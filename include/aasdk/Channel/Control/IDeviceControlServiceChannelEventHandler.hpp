@@ -0,0 +1,52 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <aasdk/Error/Error.hpp>
+#include <aasdk/Common/Data.hpp>
+#include <aasdk_proto/AuthCompleteIndicationMessage.pb.h>
+#include <aasdk_proto/ServiceDiscoveryResponseMessage.pb.h>
+#include <aasdk_proto/ShutdownRequestMessage.pb.h>
+#include <aasdk_proto/ShutdownResponseMessage.pb.h>
+#include <aasdk_proto/PingRequestMessage.pb.h>
+#include <aasdk_proto/PingResponseMessage.pb.h>
+
+
+namespace aasdk::channel::control {
+
+// Control channel events seen by the phone (mobile device) end of the link.
+class IDeviceControlServiceChannelEventHandler {
+ public:
+  typedef std::shared_ptr<IDeviceControlServiceChannelEventHandler> Pointer;
+
+  IDeviceControlServiceChannelEventHandler() = default;
+  virtual ~IDeviceControlServiceChannelEventHandler() = default;
+
+    virtual void onVersionRequest(uint16_t majorCode, uint16_t minorCode) = 0;
+    virtual void onHandshake(const common::DataConstBuffer& payload) = 0;
+    virtual void onAuthComplete(const proto::messages::AuthCompleteIndication& indication) = 0;
+    virtual void onServiceDiscoveryResponse(const proto::messages::ServiceDiscoveryResponse& response) = 0;
+    virtual void onShutdownRequest(const proto::messages::ShutdownRequest& request) = 0;
+    virtual void onShutdownResponse(const proto::messages::ShutdownResponse& response) = 0;
+    virtual void onPingRequest(const proto::messages::PingRequest& request) = 0;
+    virtual void onPingResponse(const proto::messages::PingResponse& response) = 0;
+    virtual void onChannelError(const error::Error& e) = 0;
+};
+
+}
@@ -0,0 +1,82 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <asio.hpp>
+#include <aasdk/Channel/Input/IInputServiceChannel.hpp>
+
+
+namespace aasdk
+{
+namespace channel
+{
+namespace input
+{
+
+// Coalesces touch moves in front of an input channel. A DRAG indication is held back for up to
+// the latency budget and every DRAG which follows in that time only updates the locations of its
+// pointers, so a fast swipe goes out as one indication per budget instead of one per sample.
+// Any other indication (PRESS, RELEASE, POINTER_DOWN/UP, keys) flushes the held DRAG and is sent
+// immediately. The promises of merged indications settle with the indication that carried them.
+class InputEventBatcher: public std::enable_shared_from_this<InputEventBatcher>
+{
+public:
+    typedef std::shared_ptr<InputEventBatcher> Pointer;
+
+    struct Configuration
+    {
+        std::chrono::microseconds latencyBudget = std::chrono::milliseconds(4);
+    };
+
+    struct Statistics
+    {
+        uint64_t receivedIndications = 0;
+        uint64_t sentIndications = 0;
+    };
+
+    InputEventBatcher(asio::io_service& ioService, IInputServiceChannel::Pointer channel, Configuration configuration);
+
+    void send(const proto::messages::InputEventIndication& indication, SendPromise::Pointer promise);
+    void flush();
+    Statistics getStatistics() const;
+
+private:
+    using std::enable_shared_from_this<InputEventBatcher>::shared_from_this;
+
+    static bool isMove(const proto::messages::InputEventIndication& indication);
+    void merge(const proto::messages::InputEventIndication& indication);
+    void sendPending();
+    void sendIndication(const proto::messages::InputEventIndication& indication, std::vector<SendPromise::Pointer> promises);
+
+    asio::io_service::strand strand_;
+    asio::steady_timer timer_;
+    IInputServiceChannel::Pointer channel_;
+    Configuration configuration_;
+    proto::messages::InputEventIndication pendingIndication_;
+    std::vector<SendPromise::Pointer> pendingPromises_;
+
+    std::atomic<uint64_t> receivedIndications_;
+    std::atomic<uint64_t> sentIndications_;
+};
+
+}
+}
+}
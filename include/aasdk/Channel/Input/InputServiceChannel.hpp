@@ -18,7 +18,10 @@
 
 #pragma once
 
+#include <aasdk_proto/ControlMessageIdsEnum.pb.h>
+#include <aasdk_proto/InputChannelMessageIdsEnum.pb.h>
 #include <aasdk/Channel/ServiceChannel.hpp>
+#include <aasdk/Channel/MessageDispatcher.hpp>
 #include <aasdk/Channel/Input/IInputServiceChannel.hpp>
 
 
@@ -40,8 +43,10 @@ class InputServiceChannel
 private:
     using std::enable_shared_from_this<InputServiceChannel>::shared_from_this;
     void messageHandler(messenger::Message::Pointer message, IInputServiceChannelEventHandler::Pointer eventHandler);
-    void handleBindingRequest(const common::DataConstBuffer& payload, IInputServiceChannelEventHandler::Pointer eventHandler);
-    void handleChannelOpenRequest(const common::DataConstBuffer& payload, IInputServiceChannelEventHandler::Pointer eventHandler);
+
+    MessageDispatcher<InputServiceChannel, IInputServiceChannelEventHandler,
+        MessageRoute<proto::ids::InputChannelMessage::BINDING_REQUEST, &IInputServiceChannelEventHandler::onBindingRequest>,
+        MessageRoute<proto::ids::ControlMessage::CHANNEL_OPEN_REQUEST, &IInputServiceChannelEventHandler::onChannelOpenRequest>> dispatcher_;
 };
 
 }
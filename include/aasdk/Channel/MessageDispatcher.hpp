@@ -0,0 +1,109 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <aasdk/Common/Data.hpp>
+#include <aasdk/Error/Error.hpp>
+
+
+namespace aasdk
+{
+namespace channel
+{
+
+template<typename HandlerType>
+struct MessageRouteTraits;
+
+// Handler of the event handler interface, called with the parsed message.
+template<typename ClassType, typename MessageType>
+struct MessageRouteTraits<void (ClassType::*)(const MessageType&)>
+{
+    typedef MessageType Message;
+};
+
+// Handler of the channel itself, called with the parsed message and the event handler.
+template<typename ClassType, typename MessageType, typename EventHandlerPointer>
+struct MessageRouteTraits<void (ClassType::*)(const MessageType&, EventHandlerPointer)>
+{
+    typedef MessageType Message;
+};
+
+// One entry of a dispatch table: the payload of message Id is parsed into the message type
+// the handler takes.
+template<uint16_t Id, auto Handler>
+struct MessageRoute
+{
+    static constexpr uint16_t id = Id;
+    static constexpr auto handler = Handler;
+    typedef typename MessageRouteTraits<decltype(Handler)>::Message Message;
+};
+
+// Dispatches the protobuf messages of a channel through a table of MessageRoutes expanded at
+// compile time. Every route owns one message which is reused for each payload it parses, so
+// repeated and string fields keep their allocations between messages.
+template<typename ChannelType, typename EventHandlerType, typename... Routes>
+class MessageDispatcher
+{
+public:
+    typedef typename EventHandlerType::Pointer EventHandlerPointer;
+
+    // Returns false if no route matches the message id, the payload is left untouched then.
+    bool dispatch(ChannelType& channel, uint16_t id, const common::DataConstBuffer& payload, EventHandlerPointer& eventHandler)
+    {
+        return this->dispatch(std::index_sequence_for<Routes...>(), channel, id, payload, eventHandler);
+    }
+
+private:
+    template<size_t... Indices>
+    bool dispatch(std::index_sequence<Indices...>, ChannelType& channel, uint16_t id, const common::DataConstBuffer& payload, EventHandlerPointer& eventHandler)
+    {
+        return ((id == std::tuple_element_t<Indices, std::tuple<Routes...>>::id && this->route<Indices>(channel, payload, eventHandler)) || ...);
+    }
+
+    template<size_t Index>
+    bool route(ChannelType& channel, const common::DataConstBuffer& payload, EventHandlerPointer& eventHandler)
+    {
+        typedef std::tuple_element_t<Index, std::tuple<Routes...>> Route;
+        auto& message = std::get<Index>(messages_);
+
+        if(!message.ParseFromArray(payload.cdata, payload.size))
+        {
+            eventHandler->onChannelError(error::Error(error::ErrorCode::PARSE_PAYLOAD));
+        }
+        else if constexpr(std::is_invocable_v<decltype(Route::handler), EventHandlerType&, const typename Route::Message&>)
+        {
+            std::invoke(Route::handler, *eventHandler, message);
+        }
+        else
+        {
+            std::invoke(Route::handler, channel, message, std::move(eventHandler));
+        }
+
+        return true;
+    }
+
+    std::tuple<typename Routes::Message...> messages_;
+};
+
+}
+}
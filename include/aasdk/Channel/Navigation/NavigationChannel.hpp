@@ -21,7 +21,10 @@
 
 #include <asio.hpp>
 #include <aasdk/Messenger/IMessenger.hpp>
+#include <aasdk_proto/ControlMessageIdsEnum.pb.h>
+#include <aasdk_proto/NavigationChannelMessageIdsEnum.pb.h>
 #include <aasdk/Channel/ServiceChannel.hpp>
+#include <aasdk/Channel/MessageDispatcher.hpp>
 #include <aasdk/Channel/Navigation/INavigationChannel.hpp>
 
 namespace aasdk::channel::navigation {
@@ -39,14 +42,12 @@ class NavigationChannel
  private:
   using std::enable_shared_from_this<NavigationChannel>::shared_from_this;
   void messageHandler(messenger::Message::Pointer message, INavigationChannelEventHandler::Pointer eventHandler);
-  void handleChannelOpenRequest(const common::DataConstBuffer& payload, INavigationChannelEventHandler::Pointer eventHandler);
-
-  void handleNavigationStatus(const common::DataConstBuffer &payload,
-                              INavigationChannelEventHandler::Pointer eventHandler);
-  void handleNavigationTurn(const common::DataConstBuffer &payload,
-                            INavigationChannelEventHandler::Pointer eventHandler);
-  void handleNavigationDistance(const common::DataConstBuffer &payload,
-                                INavigationChannelEventHandler::Pointer eventHandler);
+
+  MessageDispatcher<NavigationChannel, INavigationChannelEventHandler,
+      MessageRoute<proto::ids::NavigationChannelMessage::NAVIGATION_STATUS, &INavigationChannelEventHandler::onNavigationStatus>,
+      MessageRoute<proto::ids::NavigationChannelMessage::NAVIGATION_TURN_EVENT, &INavigationChannelEventHandler::onNavigationTurn>,
+      MessageRoute<proto::ids::NavigationChannelMessage::NAVIGATION_DISTANCE_EVENT, &INavigationChannelEventHandler::onNavigationDistance>,
+      MessageRoute<proto::ids::ControlMessage::CHANNEL_OPEN_REQUEST, &INavigationChannelEventHandler::onChannelOpenRequest>> dispatcher_;
 };
 
 }
\ No newline at end of file
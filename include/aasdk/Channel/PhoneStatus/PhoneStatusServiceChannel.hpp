@@ -18,7 +18,10 @@
 
 #pragma once
 
+#include <aasdk_proto/ControlMessageIdsEnum.pb.h>
+#include <aasdk_proto/PhoneStatusChannelMessageIdsEnum.pb.h>
 #include <aasdk/Channel/ServiceChannel.hpp>
+#include <aasdk/Channel/MessageDispatcher.hpp>
 #include <aasdk/Channel/PhoneStatus/IPhoneStatusServiceChannel.hpp>
 
 
@@ -41,8 +44,10 @@ namespace aasdk
             private:
                 using std::enable_shared_from_this<PhoneStatusServiceChannel>::shared_from_this;
                 void messageHandler(messenger::Message::Pointer message, IPhoneStatusServiceChannelEventHandler::Pointer eventHandler);
-                void handleChannelOpenRequest(const common::DataConstBuffer& payload, IPhoneStatusServiceChannelEventHandler::Pointer eventHandler);
-                void handlePhoneStatusMessage(const common::DataConstBuffer& payload, IPhoneStatusServiceChannelEventHandler::Pointer eventHandler);
+
+                MessageDispatcher<PhoneStatusServiceChannel, IPhoneStatusServiceChannelEventHandler,
+                    MessageRoute<proto::ids::PhoneStatusChannelMessage::PHONE_STATUS, &IPhoneStatusServiceChannelEventHandler::onPhoneStatusMessage>,
+                    MessageRoute<proto::ids::ControlMessage::CHANNEL_OPEN_REQUEST, &IPhoneStatusServiceChannelEventHandler::onChannelOpenRequest>> dispatcher_;
             };
 
         }
@@ -0,0 +1,99 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <string>
+#include <asio.hpp>
+#include <aasdk_proto/SensorStartRequestMessage.pb.h>
+#include <aasdk/Channel/Sensor/ISensorServiceChannel.hpp>
+
+
+namespace aasdk::channel::sensor {
+
+// Sits between the sensor sources and the sensor channel. Sources push raw readings with
+// update(); the latest reading per sensor type is sent no more often than the refresh interval
+// (milliseconds) the phone asked for in its SensorStartRequest, readings equal to the last sent
+// one are suppressed, and every sensor due within the merge window shares one indication.
+// Readings of sensors the phone has not started are kept until it does.
+class SensorAggregator: public std::enable_shared_from_this<SensorAggregator>
+{
+public:
+    typedef std::shared_ptr<SensorAggregator> Pointer;
+    typedef std::chrono::steady_clock Clock;
+    // Source of the current time for all refresh decisions. The timer only wakes the aggregator,
+    // readings are sent once this clock says they are due.
+    typedef std::function<Clock::time_point()> TimeSource;
+
+    struct Configuration
+    {
+        std::chrono::milliseconds mergeWindow = std::chrono::milliseconds(5);
+    };
+
+    struct Statistics
+    {
+        uint64_t receivedReadings = 0;
+        uint64_t suppressedReadings = 0;
+        uint64_t sentReadings = 0;
+        uint64_t sentIndications = 0;
+    };
+
+    SensorAggregator(asio::io_service& ioService, ISensorServiceChannel::Pointer channel, Configuration configuration);
+    SensorAggregator(asio::io_service& ioService, ISensorServiceChannel::Pointer channel, Configuration configuration, TimeSource timeSource);
+
+    void start(const proto::messages::SensorStartRequestMessage& request);
+    void stop();
+    void update(const proto::messages::SensorEventIndication& indication);
+    Statistics getStatistics() const;
+
+private:
+    using std::enable_shared_from_this<SensorAggregator>::shared_from_this;
+
+    struct Sensor
+    {
+        bool isStarted = false;
+        bool isPending = false;
+        Clock::duration refreshInterval = Clock::duration::zero();
+        Clock::time_point nextTime;
+        // Single field indication with the latest reading.
+        proto::messages::SensorEventIndication reading;
+        std::string sentReading;
+    };
+
+    void schedule();
+    void sendDueReadings();
+
+    asio::io_service::strand strand_;
+    asio::steady_timer timer_;
+    ISensorServiceChannel::Pointer channel_;
+    Configuration configuration_;
+    TimeSource timeSource_;
+    // Keyed by SensorEventIndication field number, sensor types sharing a field share the entry.
+    std::map<int, Sensor> sensors_;
+    bool isTimerArmed_;
+
+    std::atomic<uint64_t> receivedReadings_;
+    std::atomic<uint64_t> suppressedReadings_;
+    std::atomic<uint64_t> sentReadings_;
+    std::atomic<uint64_t> sentIndications_;
+};
+
+}
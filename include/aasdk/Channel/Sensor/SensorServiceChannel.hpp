@@ -18,7 +18,10 @@
 
 #pragma once
 
+#include <aasdk_proto/ControlMessageIdsEnum.pb.h>
+#include <aasdk_proto/SensorChannelMessageIdsEnum.pb.h>
 #include <aasdk/Channel/ServiceChannel.hpp>
+#include <aasdk/Channel/MessageDispatcher.hpp>
 #include <aasdk/Channel/Sensor/ISensorServiceChannel.hpp>
 
 
@@ -39,8 +42,10 @@ class SensorServiceChannel
 private:
     using std::enable_shared_from_this<SensorServiceChannel>::shared_from_this;
     void messageHandler(messenger::Message::Pointer message, ISensorServiceChannelEventHandler::Pointer eventHandler);
-    void handleSensorStartRequest(const common::DataConstBuffer& payload, ISensorServiceChannelEventHandler::Pointer eventHandler);
-    void handleChannelOpenRequest(const common::DataConstBuffer& payload, ISensorServiceChannelEventHandler::Pointer eventHandler);
+
+    MessageDispatcher<SensorServiceChannel, ISensorServiceChannelEventHandler,
+        MessageRoute<proto::ids::SensorChannelMessage::SENSOR_START_REQUEST, &ISensorServiceChannelEventHandler::onSensorStartRequest>,
+        MessageRoute<proto::ids::ControlMessage::CHANNEL_OPEN_REQUEST, &ISensorServiceChannelEventHandler::onChannelOpenRequest>> dispatcher_;
 };
 
 }
@@ -36,6 +36,7 @@ protected:
 
     virtual ~ServiceChannel() = default;
     void send(messenger::Message::Pointer message, SendPromise::Pointer promise);
+    void traceMessage(messenger::Message& message) const;
 
     asio::io_service::strand& strand_;
     messenger::IMessenger::Pointer messenger_;
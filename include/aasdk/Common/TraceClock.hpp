@@ -0,0 +1,49 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+
+namespace aasdk
+{
+namespace common
+{
+
+// Clock for latency tracing. Timestamps are only taken while tracing is enabled by at least
+// one user; otherwise now() returns an empty time point and costs a single atomic load.
+class TraceClock
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+    typedef Clock::time_point time_point;
+    typedef Clock::duration duration;
+
+    static time_point now();
+    static bool isEnabled();
+    static void enable();
+    static void disable();
+
+private:
+    static std::atomic<size_t> users_;
+};
+
+}
+}
@@ -61,7 +61,12 @@ enum class ErrorCode
     OPERATION_ABORTED = 30,
     OPERATION_IN_PROGRESS = 31,
     PARSE_PAYLOAD = 32,
-    TCP_TRANSFER = 33
+    TCP_TRANSFER = 33,
+    CAPTURE_FILE_OPEN = 34,
+    CAPTURE_FILE_WRITE = 35,
+    CAPTURE_FILE_FORMAT = 36,
+    METRIC_TYPE_MISMATCH = 37,
+    CAPTURE_RING_EMPTY = 38
 };
 
 }
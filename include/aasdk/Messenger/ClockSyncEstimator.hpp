@@ -0,0 +1,79 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <aasdk/Messenger/Timestamp.hpp>
+
+
+namespace aasdk
+{
+namespace messenger
+{
+
+// Maps phone timestamps (microseconds) onto the local steady clock as local = phone + offset,
+// where the offset drifts linearly with phone time. Every phone timestamp seen on arrival gives
+// an upper bound of the offset; the lowest bound per second, less half the minimum ping round
+// trip, is fitted to a line over the last few seconds. Only feed timestamps taken when the
+// phone sent the message (ping requests, live video), not buffered-ahead audio.
+class ClockSyncEstimator
+{
+public:
+    typedef std::shared_ptr<ClockSyncEstimator> Pointer;
+    typedef std::chrono::steady_clock Clock;
+
+    ClockSyncEstimator();
+
+    // Local timestamp for outgoing ping requests, the phone echoes it in the ping response.
+    static int64_t now();
+
+    void onPingResponse(int64_t requestTimestamp, Clock::time_point arrival = Clock::now());
+    void onPingRequest(int64_t phoneTimestamp, Clock::time_point arrival = Clock::now());
+    void onMediaTimestamp(Timestamp::ValueType phoneTimestamp, Clock::time_point arrival = Clock::now());
+
+    bool isSynchronized() const;
+    Clock::time_point toLocal(Timestamp::ValueType phoneTimestamp) const;
+    // Local clock rate error against the phone, in parts per million.
+    double getDrift() const;
+    Clock::duration getMinRoundTripTime() const;
+
+private:
+    struct Sample
+    {
+        int64_t phoneTimestamp;
+        int64_t offset;
+    };
+
+    void addSample(int64_t phoneTimestamp, Clock::time_point arrival);
+    void fit();
+
+    mutable std::mutex mutex_;
+    int64_t minRoundTripTime_;
+    std::deque<Sample> samples_;
+    int64_t bucketStart_;
+    int64_t referenceTimestamp_;
+    double offset_;
+    double drift_;
+    bool isSynchronized_;
+};
+
+}
+}
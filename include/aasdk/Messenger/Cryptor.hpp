@@ -1,8 +1,10 @@
 #pragma once
 
+#include <chrono>
 #include <mutex>
 #include <aasdk/Transport/ISSLWrapper.hpp>
 #include <aasdk/Messenger/ICryptor.hpp>
+#include <aasdk/Messenger/ISSLSessionCache.hpp>
 
 
 namespace aasdk
@@ -13,23 +15,37 @@ namespace messenger
 class Cryptor: public ICryptor
 {
 public:
+    enum class Role
+    {
+        CLIENT,
+        SERVER
+    };
+
     Cryptor(transport::ISSLWrapper::Pointer sslWrapper);
+    Cryptor(transport::ISSLWrapper::Pointer sslWrapper, Role role);
+    Cryptor(transport::ISSLWrapper::Pointer sslWrapper, ISSLSessionCache::Pointer sessionCache, std::string deviceId);
 
     void init() override;
     void deinit() override;
     bool doHandshake() override;
     size_t encrypt(common::Data& output, const common::DataConstBuffer& buffer) override;
     size_t decrypt(common::Data& output, const common::DataConstBuffer& buffer, int length) override;
+    size_t encrypt(common::Data& output, const common::DataConstBuffer& buffer, error::Error& e) override;
+    size_t decrypt(common::Data& output, const common::DataConstBuffer& buffer, int length, error::Error& e) override;
 
     common::Data readHandshakeBuffer() override;
     void writeHandshakeBuffer(const common::DataConstBuffer& buffer) override;
     bool isActive() const override;
+    IRecordDecryptor::Pointer createRecordDecryptor() override;
 
 private:
-    size_t read(common::Data& output);
-    void write(const common::DataConstBuffer& buffer);
+    size_t read(common::Data& output, error::Error& e);
+    void write(const common::DataConstBuffer& buffer, error::Error& e);
+    void restoreSession();
+    void storeSession();
 
     transport::ISSLWrapper::Pointer sslWrapper_;
+    Role role_;
     size_t maxBufferSize_;
     X509* certificate_;
     EVP_PKEY* privateKey_;
@@ -37,6 +53,10 @@ private:
     SSL* ssl_;
     transport::ISSLWrapper::BIOs bIOs_;
     bool isActive_;
+    ISSLSessionCache::Pointer sessionCache_;
+    std::string deviceId_;
+    bool isHandshakeStarted_;
+    std::chrono::steady_clock::time_point handshakeStartTime_;
 
     const static std::string cCertificate;
     const static std::string cPrivateKey;
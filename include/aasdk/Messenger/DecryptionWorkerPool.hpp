@@ -0,0 +1,67 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace aasdk
+{
+namespace messenger
+{
+
+class DecryptionWorkerPool
+{
+public:
+    typedef std::shared_ptr<DecryptionWorkerPool> Pointer;
+    typedef std::function<void()> Job;
+
+    DecryptionWorkerPool(size_t workerCount);
+    ~DecryptionWorkerPool();
+
+    void post(Job job);
+    size_t getWorkerCount() const;
+
+private:
+    // Shared with every worker: the last reference to the pool may be dropped by a job, in which
+    // case the worker running it outlives the pool.
+    struct State
+    {
+        std::deque<Job> jobs;
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool isStopped = false;
+    };
+
+    static void run(std::shared_ptr<State> state);
+
+    std::shared_ptr<State> state_;
+    std::vector<std::thread> workers_;
+
+    DecryptionWorkerPool(const DecryptionWorkerPool&) = delete;
+};
+
+}
+}
@@ -2,6 +2,8 @@
 
 #include <memory>
 #include <aasdk/Common/Data.hpp>
+#include <aasdk/Error/Error.hpp>
+#include <aasdk/Messenger/IRecordDecryptor.hpp>
 
 
 namespace aasdk::messenger {
@@ -18,9 +20,12 @@ class ICryptor {
     virtual bool doHandshake() = 0;
     virtual size_t encrypt(common::Data& output, const common::DataConstBuffer& buffer) = 0;
     virtual size_t decrypt(common::Data& output, const common::DataConstBuffer& buffer, int length) = 0;
+    virtual size_t encrypt(common::Data& output, const common::DataConstBuffer& buffer, error::Error& e) = 0;
+    virtual size_t decrypt(common::Data& output, const common::DataConstBuffer& buffer, int length, error::Error& e) = 0;
     virtual common::Data readHandshakeBuffer() = 0;
     virtual void writeHandshakeBuffer(const common::DataConstBuffer& buffer) = 0;
     virtual bool isActive() const = 0;
+    virtual IRecordDecryptor::Pointer createRecordDecryptor() = 0;
 };
 
 }
@@ -0,0 +1,48 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <openssl/ssl.h>
+#include <aasdk/Messenger/HandshakeStatistics.hpp>
+
+
+namespace aasdk
+{
+namespace messenger
+{
+
+class ISSLSessionCache
+{
+public:
+    typedef std::shared_ptr<ISSLSessionCache> Pointer;
+    typedef std::shared_ptr<SSL_SESSION> Session;
+
+    virtual ~ISSLSessionCache() = default;
+
+    virtual Session find(const std::string& deviceId) = 0;
+    virtual void store(const std::string& deviceId, Session session) = 0;
+    virtual void remove(const std::string& deviceId) = 0;
+    virtual void reportHandshake(bool resumed, std::chrono::microseconds duration) = 0;
+    virtual HandshakeStatistics getStatistics() const = 0;
+};
+
+}
+}
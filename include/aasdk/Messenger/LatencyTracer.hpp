@@ -0,0 +1,99 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <array>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <aasdk/Messenger/ChannelId.hpp>
+#include <aasdk/Messenger/MessageTrace.hpp>
+#include <aasdk/Metrics/Metric.hpp>
+
+
+namespace aasdk
+{
+namespace messenger
+{
+
+// Power of two buckets: bucket 0 counts durations below 1 us, bucket i durations below 2^i us,
+// the last bucket everything above.
+class LatencyHistogram
+{
+public:
+    // Same buckets as the exported metrics histograms.
+    static constexpr size_t cBucketCount = metrics::HistogramSnapshot::cBucketCount;
+
+    LatencyHistogram();
+
+    void add(common::TraceClock::duration duration);
+
+    size_t getCount() const;
+    common::TraceClock::duration getMean() const;
+    common::TraceClock::duration getMax() const;
+    // Upper bound of the bucket holding the given fraction (0..1) of the samples.
+    common::TraceClock::duration getPercentile(double fraction) const;
+    const std::array<size_t, cBucketCount>& getBuckets() const;
+
+    static common::TraceClock::duration getBucketUpperBound(size_t bucket);
+
+private:
+    std::array<size_t, cBucketCount> buckets_;
+    size_t count_;
+    common::TraceClock::duration sum_;
+    common::TraceClock::duration max_;
+};
+
+// Collects per-channel latency histograms of traced messages. Timestamps are taken across the
+// whole receive pipeline for as long as any tracer exists.
+class LatencyTracer
+{
+public:
+    typedef std::shared_ptr<LatencyTracer> Pointer;
+    typedef std::function<void(ChannelId channelId, const MessageTrace& trace)> Callback;
+
+    LatencyTracer();
+    ~LatencyTracer();
+
+    void setCallback(Callback callback);
+    void record(ChannelId channelId, const MessageTrace& trace);
+    void reset();
+
+    std::vector<ChannelId> getChannelIds() const;
+    LatencyHistogram getStageHistogram(ChannelId channelId, TraceStage stage) const;
+    LatencyHistogram getTotalHistogram(ChannelId channelId) const;
+
+private:
+    struct ChannelHistograms
+    {
+        std::array<LatencyHistogram, static_cast<size_t>(TraceStage::COUNT)> stages;
+        LatencyHistogram total;
+    };
+
+    mutable std::mutex mutex_;
+    std::map<ChannelId, ChannelHistograms> channels_;
+    Callback callback_;
+
+    LatencyTracer(const LatencyTracer&) = delete;
+};
+
+}
+}
@@ -25,6 +25,7 @@
 #include <aasdk/Messenger/EncryptionType.hpp>
 #include <aasdk/Messenger/MessageType.hpp>
 #include <aasdk/Messenger/MessageId.hpp>
+#include <aasdk/Messenger/MessageTrace.hpp>
 
 
 namespace aasdk
@@ -52,11 +53,15 @@ public:
     void insertPayload(const common::DataConstBuffer& buffer);
     void insertPayload(common::DataBuffer& buffer);
 
+    MessageTrace& getTrace();
+    const MessageTrace& getTrace() const;
+
 private:
     ChannelId channelId_;
     EncryptionType encryptionType_;
     MessageType type_;
     common::Data payload_;
+    MessageTrace trace_;
 
     Message(const Message&) = delete;
 };
@@ -1,12 +1,15 @@
 #pragma once
 
+#include <deque>
 #include <map>
 #include <aasdk/Transport/ITransport.hpp>
 #include <aasdk/Messenger/IMessageInStream.hpp>
 #include <aasdk/Messenger/ICryptor.hpp>
+#include <aasdk/Messenger/DecryptionWorkerPool.hpp>
 #include <aasdk/Messenger/FrameHeader.hpp>
 #include <aasdk/Messenger/FrameSize.hpp>
 #include <aasdk/Messenger/FrameType.hpp>
+#include <aasdk/Metrics/SessionMetrics.hpp>
 
 namespace aasdk
 {
@@ -17,15 +20,44 @@ class MessageInStream: public IMessageInStream, public std::enable_shared_from_t
 {
 public:
     MessageInStream(asio::io_service& ioService, transport::ITransport::Pointer transport, ICryptor::Pointer cryptor);
+    MessageInStream(asio::io_service& ioService, transport::ITransport::Pointer transport, ICryptor::Pointer cryptor, DecryptionWorkerPool::Pointer decryptionWorkerPool);
 
     void startReceive(ReceivePromise::Pointer promise) override;
+    // Must be attached before the first receive.
+    void setMetrics(metrics::SessionMetrics::Pointer metrics);
 
 private:
     using std::enable_shared_from_this<MessageInStream>::shared_from_this;
 
+    enum class PipelineState
+    {
+        DISABLED,
+        PENDING,
+        ACTIVE
+    };
+
+    struct PipelinedFrame
+    {
+        FrameHeader frameHeader;
+        common::Data payload;
+        error::Error error;
+        MessageTrace trace;
+    };
+
+    void receiveFrameHeader();
     void receiveFrameHeaderHandler(const common::DataConstBuffer& buffer);
     void receiveFrameSizeHandler(const common::DataConstBuffer& buffer);
-    void receiveFramePayloadHandler(const common::DataConstBuffer& buffer);
+    void receiveFramePayloadHandler(common::Data data);
+    void traceFrameHeader();
+    void rejectReceive(const error::Error& e);
+    Message::Pointer findMessage(const FrameHeader& frameHeader, bool& isValidFrame);
+
+    bool activatePipeline(const common::DataConstBuffer& buffer);
+    void pipelineFrame(common::Data data);
+    void pipelinedFrameHandler(uint64_t frameIndex, PipelinedFrame frame);
+    void assemblePipelinedFrames();
+    void resolvePipelinedMessage();
+    bool canReceiveAhead() const;
 
     asio::io_service::strand strand_;
     transport::ITransport::Pointer transport_;
@@ -41,6 +73,24 @@ private:
     int frameSize_;
     bool isValidFrame_;
     int currentMessageIndex_;
+
+    FrameHeader frameHeader_;
+    MessageTrace frameTrace_;
+    bool isReceiving_;
+    DecryptionWorkerPool::Pointer decryptionWorkerPool_;
+    metrics::SessionMetrics::Pointer metrics_;
+    PipelineState pipelineState_;
+    IRecordDecryptor::Pointer recordDecryptor_;
+    uint64_t recordSequenceNumber_;
+    uint64_t nextFrameIndex_;
+    uint64_t nextAssembledFrameIndex_;
+    std::map<uint64_t, PipelinedFrame> pipelinedFrames_;
+    std::deque<Message::Pointer> pipelinedMessages_;
+    error::Error pipelineError_;
+
+    static constexpr uint64_t cFirstApplicationRecordSequenceNumber = 1;
+    static constexpr uint64_t cMaxFramesInFlight = 32;
+    static constexpr size_t cMaxPipelinedMessages = 32;
 };
 
 }
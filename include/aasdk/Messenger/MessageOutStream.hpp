@@ -24,6 +24,7 @@
 #include <aasdk/Messenger/IMessageOutStream.hpp>
 #include <aasdk/Messenger/FrameHeader.hpp>
 #include <aasdk/Messenger/FrameSize.hpp>
+#include <aasdk/Metrics/SessionMetrics.hpp>
 
 
 namespace aasdk::messenger {
@@ -33,12 +34,14 @@ class MessageOutStream : public IMessageOutStream, public std::enable_shared_fro
   MessageOutStream(asio::io_service &ioService, transport::ITransport::Pointer transport, ICryptor::Pointer cryptor);
 
   void stream(Message::Pointer message, SendPromise::Pointer promise) override;
+  // Must be attached before the first message is streamed.
+  void setMetrics(metrics::SessionMetrics::Pointer metrics);
 
  private:
     using std::enable_shared_from_this<MessageOutStream>::shared_from_this;
 
     void streamSplittedMessage();
-    common::Data compoundFrame(FrameType frameType, const common::DataConstBuffer& payloadBuffer);
+    common::Data compoundFrame(FrameType frameType, const common::DataConstBuffer& payloadBuffer, error::Error& e);
     void streamEncryptedFrame(FrameType frameType, const common::DataConstBuffer& payloadBuffer);
     void streamPlainFrame(FrameType frameType, const common::DataConstBuffer& payloadBuffer);
     void setFrameSize(common::Data& data, FrameType frameType, size_t payloadSize, size_t totalSize);
@@ -51,6 +54,7 @@ class MessageOutStream : public IMessageOutStream, public std::enable_shared_fro
     size_t offset_;
     size_t remainingSize_;
     SendPromise::Pointer promise_;
+    metrics::SessionMetrics::Pointer metrics_;
 
     static constexpr size_t cMaxFramePayloadSize = 0x4000;
 
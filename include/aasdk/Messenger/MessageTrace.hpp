@@ -0,0 +1,75 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <string>
+#include <aasdk/Common/TraceClock.hpp>
+
+
+namespace aasdk
+{
+namespace messenger
+{
+
+class LatencyTracer;
+
+// Receive pipeline stages in the order a message passes them.
+enum class TraceStage
+{
+    TRANSFER_COMPLETED,
+    DATA_DISTRIBUTED,
+    FRAME_HEADER_DECODED,
+    DECRYPTED,
+    REASSEMBLED,
+    MESSENGER_DISPATCHED,
+    CHANNEL_HANDLER_ENTERED,
+    COUNT
+};
+
+std::string traceStageToString(TraceStage stage);
+
+// Time at which a received message passed every pipeline stage. Stages of multi-frame messages
+// refer to the frame that completed the message.
+class MessageTrace
+{
+public:
+    void mark(TraceStage stage);
+    void mark(TraceStage stage, common::TraceClock::time_point timePoint);
+    void merge(const MessageTrace& other);
+
+    bool isMarked(TraceStage stage) const;
+    common::TraceClock::time_point get(TraceStage stage) const;
+
+    // Time spent since the closest earlier marked stage, zero if there is none.
+    common::TraceClock::duration getStageDuration(TraceStage stage) const;
+    // Time between the first and the last marked stage.
+    common::TraceClock::duration getTotalDuration() const;
+
+    void setTracer(std::shared_ptr<LatencyTracer> tracer);
+    const std::shared_ptr<LatencyTracer>& getTracer() const;
+
+private:
+    std::array<common::TraceClock::time_point, static_cast<size_t>(TraceStage::COUNT)> timePoints_;
+    std::shared_ptr<LatencyTracer> tracer_;
+};
+
+}
+}
@@ -25,6 +25,9 @@
 #include <aasdk/Messenger/IMessageOutStream.hpp>
 #include <aasdk/Messenger/ChannelReceiveMessageQueue.hpp>
 #include <aasdk/Messenger/ChannelReceivePromiseQueue.hpp>
+#include <aasdk/Messenger/LatencyTracer.hpp>
+#include <aasdk/Metrics/SessionMetrics.hpp>
+#include <aasdk/Metrics/StartupTimeline.hpp>
 
 
 namespace aasdk
@@ -40,6 +43,14 @@ public:
     void enqueueSend(Message::Pointer message, SendPromise::Pointer promise) override;
     void stop() override;
 
+    // Received messages carry the tracer to their service channel, which records the complete trace.
+    void setLatencyTracer(LatencyTracer::Pointer latencyTracer);
+    // Must be attached before the first receive or send.
+    void setMetrics(metrics::SessionMetrics::Pointer metrics);
+    // Marks the protocol steps of the connection sequence and finishes the timeline if the session
+    // stops or fails before the first video frame. Must be attached before the first receive or send.
+    void setStartupTimeline(metrics::StartupTimeline::Pointer startupTimeline);
+
 private:
     using std::enable_shared_from_this<Messenger>::shared_from_this;
     typedef std::list<std::pair<Message::Pointer, SendPromise::Pointer>> ChannelSendQueue;
@@ -48,6 +59,8 @@ private:
     void outStreamMessageHandler(ChannelSendQueue::iterator queueElement);
     void rejectReceivePromiseQueue(const error::Error& e);
     void rejectSendPromiseQueue(const error::Error& e);
+    void updateSendQueueDepth();
+    void markStartupPhase(const Message& message, const char* direction);
     void parseMessage(Message::Pointer message, ReceivePromise::Pointer promise);
 
     asio::io_service::strand receiveStrand_;
@@ -58,6 +71,9 @@ private:
     ChannelReceivePromiseQueue channelReceivePromiseQueue_;
     ChannelReceiveMessageQueue channelReceiveMessageQueue_;
     ChannelSendQueue channelSendPromiseQueue_;
+    LatencyTracer::Pointer latencyTracer_;
+    metrics::SessionMetrics::Pointer metrics_;
+    metrics::StartupTimeline::Pointer startupTimeline_;
 
     Messenger(const Messenger&) = delete;
 };
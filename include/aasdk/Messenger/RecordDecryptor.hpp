@@ -0,0 +1,54 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <aasdk/Transport/ISSLWrapper.hpp>
+#include <aasdk/Messenger/IRecordDecryptor.hpp>
+
+
+namespace aasdk
+{
+namespace messenger
+{
+
+class RecordDecryptor: public IRecordDecryptor
+{
+public:
+    RecordDecryptor(transport::ISSLWrapper::RecordKeys keys);
+    ~RecordDecryptor() override;
+
+    size_t getRecordCount(const common::DataConstBuffer& buffer) const override;
+    size_t decrypt(common::Data& output, const common::DataConstBuffer& buffer, uint64_t sequenceNumber, error::Error& e) const override;
+
+private:
+    bool decryptRecord(common::Data& output, const common::DataConstBuffer& record, uint64_t sequenceNumber) const;
+
+    transport::ISSLWrapper::RecordKeys keys_;
+
+    static constexpr size_t cRecordHeaderSize = 5;
+    static constexpr size_t cExplicitNonceSize = 8;
+    static constexpr size_t cTagSize = 16;
+    static constexpr uint8_t cAlertContentType = 21;
+    static constexpr uint8_t cApplicationDataContentType = 23;
+    static constexpr uint8_t cAlertLevelFatal = 2;
+    static constexpr uint8_t cAlertCloseNotify = 0;
+};
+
+}
+}
@@ -0,0 +1,56 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <aasdk/Messenger/ISSLSessionCache.hpp>
+
+
+namespace aasdk
+{
+namespace messenger
+{
+
+class SSLSessionCache: public ISSLSessionCache
+{
+public:
+    SSLSessionCache(size_t capacity = cDefaultCapacity);
+
+    Session find(const std::string& deviceId) override;
+    void store(const std::string& deviceId, Session session) override;
+    void remove(const std::string& deviceId) override;
+    void reportHandshake(bool resumed, std::chrono::microseconds duration) override;
+    HandshakeStatistics getStatistics() const override;
+
+    static constexpr size_t cDefaultCapacity = 16;
+
+private:
+    typedef std::list<std::pair<std::string, Session>> Sessions;
+
+    Sessions::iterator lookup(const std::string& deviceId);
+
+    size_t capacity_;
+    Sessions sessions_;
+    HandshakeStatistics statistics_;
+    mutable std::mutex mutex_;
+};
+
+}
+}
@@ -0,0 +1,119 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace aasdk
+{
+namespace metrics
+{
+
+typedef std::vector<std::pair<std::string, std::string>> Labels;
+
+enum class MetricType
+{
+    COUNTER,
+    GAUGE,
+    HISTOGRAM
+};
+
+struct MetricDescriptor
+{
+    std::string name;
+    std::string help;
+    MetricType type;
+    Labels labels;
+};
+
+// Metrics are updated with relaxed atomics only, so instrumentation can stay on in production.
+class Counter
+{
+public:
+    Counter();
+
+    void increment(uint64_t value = 1);
+    uint64_t get() const;
+
+private:
+    std::atomic<uint64_t> value_;
+};
+
+class Gauge
+{
+public:
+    Gauge();
+
+    void set(int64_t value);
+    void increment(int64_t value = 1);
+    void decrement(int64_t value = 1);
+    int64_t get() const;
+
+private:
+    std::atomic<int64_t> value_;
+};
+
+struct HistogramSnapshot
+{
+    static constexpr size_t cBucketCount = 24;
+
+    // Non-cumulative; bucket 0 counts durations up to 1 us, bucket i durations up to 2^i us and
+    // the last bucket everything above.
+    std::array<uint64_t, cBucketCount> buckets{};
+    uint64_t count = 0;
+    std::chrono::nanoseconds sum{0};
+
+    static size_t getBucket(std::chrono::nanoseconds duration);
+    static std::chrono::nanoseconds getBucketUpperBound(size_t bucket);
+};
+
+class Histogram
+{
+public:
+    Histogram();
+
+    void observe(std::chrono::nanoseconds duration);
+    HistogramSnapshot getSnapshot() const;
+
+private:
+    std::array<std::atomic<uint64_t>, HistogramSnapshot::cBucketCount> buckets_;
+    std::atomic<uint64_t> count_;
+    std::atomic<int64_t> sum_;
+};
+
+struct MetricSnapshot
+{
+    std::shared_ptr<const MetricDescriptor> descriptor;
+    // Counter and gauge value; histograms fill the histogram member instead.
+    double value = 0;
+    HistogramSnapshot histogram;
+};
+
+typedef std::vector<MetricSnapshot> MetricsSnapshot;
+
+}
+}
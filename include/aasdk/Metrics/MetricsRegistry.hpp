@@ -0,0 +1,67 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <aasdk/Metrics/Metric.hpp>
+
+
+namespace aasdk
+{
+namespace metrics
+{
+
+// Owns every metric of a process or session. Registration takes a lock and returns a reference
+// which stays valid for the lifetime of the registry; updates through that reference never lock.
+// Registering the same name and labels again returns the existing metric; a name keeps the type
+// it was first registered with, anything else throws METRIC_TYPE_MISMATCH.
+class MetricsRegistry
+{
+public:
+    typedef std::shared_ptr<MetricsRegistry> Pointer;
+
+    MetricsRegistry() = default;
+
+    Counter& getCounter(const std::string& name, const std::string& help, const Labels& labels = Labels());
+    Gauge& getGauge(const std::string& name, const std::string& help, const Labels& labels = Labels());
+    Histogram& getHistogram(const std::string& name, const std::string& help, const Labels& labels = Labels());
+
+    MetricsSnapshot getSnapshot() const;
+
+private:
+    struct Entry
+    {
+        std::shared_ptr<const MetricDescriptor> descriptor;
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Gauge> gauge;
+        std::unique_ptr<Histogram> histogram;
+    };
+
+    Entry& getEntry(const std::string& name, const std::string& help, MetricType type, const Labels& labels);
+
+    mutable std::mutex mutex_;
+    std::deque<Entry> entries_;
+
+    MetricsRegistry(const MetricsRegistry&) = delete;
+};
+
+}
+}
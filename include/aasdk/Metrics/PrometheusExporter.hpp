@@ -0,0 +1,45 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <string>
+#include <aasdk/Metrics/Metric.hpp>
+
+
+namespace aasdk
+{
+namespace metrics
+{
+
+// Formats a snapshot in the Prometheus text exposition format (version 0.0.4). Durations of
+// histograms are exported in seconds.
+class PrometheusExporter
+{
+public:
+    static std::string format(const MetricsSnapshot& snapshot);
+
+private:
+    static std::string formatLabels(const Labels& labels, const std::string& extraName = std::string(), const std::string& extraValue = std::string());
+    // HELP text escapes only backslash and line feed, label values also double quotes.
+    static std::string escape(const std::string& value, bool escapeQuotes = true);
+    static std::string typeToString(MetricType type);
+};
+
+}
+}
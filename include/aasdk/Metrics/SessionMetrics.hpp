@@ -0,0 +1,96 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+#include <aasdk/Messenger/ChannelId.hpp>
+#include <aasdk/Messenger/FrameType.hpp>
+#include <aasdk/Metrics/MetricsRegistry.hpp>
+
+
+namespace aasdk
+{
+namespace metrics
+{
+
+// Metrics of one Android Auto session, registered once so the instrumented components only
+// touch atomics. Attach the same instance to the transport, both message streams and the
+// messenger of a session before it starts.
+class SessionMetrics
+{
+public:
+    typedef std::shared_ptr<SessionMetrics> Pointer;
+
+    struct ChannelMetrics
+    {
+        Counter& messagesReceived;
+        Counter& messagesSent;
+        Counter& bytesReceived;
+        Counter& bytesSent;
+        Gauge& receiveQueueDepth;
+    };
+
+    // Every metric carries the given labels, e.g. {{"session", "1"}, {"transport", "usb"}}.
+    SessionMetrics(MetricsRegistry::Pointer registry, Labels labels = Labels());
+
+    ChannelMetrics& getChannel(messenger::ChannelId channelId);
+    Counter& getFramesReceived(messenger::FrameType frameType);
+    Counter& getFramesSent(messenger::FrameType frameType);
+    Counter& getDecryptFailures();
+    Gauge& getSendQueueDepth();
+    Counter& getReceiveRejections();
+    Counter& getSendRejections();
+
+    Counter& getTransportBytesReceived();
+    Counter& getTransportBytesSent();
+    Counter& getTransportReceiveRejections();
+    Counter& getTransportSendRejections();
+    Histogram& getReceiveTransferLatency();
+    Histogram& getSendTransferLatency();
+
+    const MetricsRegistry::Pointer& getRegistry() const;
+
+    // Known channels plus one slot for everything else.
+    static constexpr size_t cChannelCount = static_cast<size_t>(messenger::ChannelId::MEDIA_STATUS) + 2;
+
+private:
+    static constexpr size_t cFrameTypeCount = static_cast<size_t>(messenger::FrameType::BULK) + 1;
+
+    MetricsRegistry::Pointer registry_;
+    std::vector<ChannelMetrics> channels_;
+    std::array<Counter*, cFrameTypeCount> framesReceived_;
+    std::array<Counter*, cFrameTypeCount> framesSent_;
+    Counter& decryptFailures_;
+    Gauge& sendQueueDepth_;
+    Counter& receiveRejections_;
+    Counter& sendRejections_;
+    Counter& transportBytesReceived_;
+    Counter& transportBytesSent_;
+    Counter& transportReceiveRejections_;
+    Counter& transportSendRejections_;
+    Histogram& receiveTransferLatency_;
+    Histogram& sendTransferLatency_;
+
+    SessionMetrics(const SessionMetrics&) = delete;
+};
+
+}
+}
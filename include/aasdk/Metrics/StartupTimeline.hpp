@@ -0,0 +1,105 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <aasdk/Common/TraceClock.hpp>
+#include <aasdk/Error/Error.hpp>
+
+
+namespace aasdk
+{
+namespace metrics
+{
+
+enum class StartupPhase
+{
+    HOTPLUG_ARRIVED,
+    ACCESSORY_MODE_QUERY,
+    ACCESSORY_MODE_SWITCHED,
+    DEVICE_REENUMERATED,
+    AOAP_DEVICE_CREATED,
+    VERSION_REQUEST,
+    VERSION_RESPONSE,
+    SSL_HANDSHAKE,
+    AUTH_COMPLETE,
+    SERVICE_DISCOVERY_REQUEST,
+    SERVICE_DISCOVERY_RESPONSE,
+    CHANNEL_OPEN_REQUEST,
+    CHANNEL_OPEN_RESPONSE,
+    FIRST_VIDEO_FRAME
+};
+
+std::string startupPhaseToString(StartupPhase phase);
+
+// Timeline of one connection from the hotplug event to the first video frame. The USB hub,
+// the accessory mode query chain, AOAPDevice::create and the messenger mark the phases they
+// pass through; the callback receives the whole timeline once the first video frame is seen,
+// or the phases reached so far and the error if the connection ends earlier. Keeps the trace
+// clock running until then.
+class StartupTimeline
+{
+public:
+    typedef std::shared_ptr<StartupTimeline> Pointer;
+    typedef std::function<Pointer()> Factory;
+    typedef common::TraceClock Clock;
+
+    struct Event
+    {
+        StartupPhase phase;
+        // Query type, channel or direction of the step, e.g. "SEND_MODEL" or "VIDEO sent".
+        std::string detail;
+        Clock::time_point time;
+    };
+
+    typedef std::vector<Event> Events;
+    // The error is NONE if the first video frame was reached.
+    typedef std::function<void(const Events&, const error::Error&)> Callback;
+
+    StartupTimeline(Callback callback = nullptr);
+    ~StartupTimeline();
+
+    // Does nothing once the timeline is completed.
+    void mark(StartupPhase phase, std::string detail = std::string());
+    // Completes the timeline before the first video frame, e.g. on unplug or messenger stop.
+    void finish(const error::Error& e);
+    Events getEvents() const;
+    bool isCompleted() const;
+
+    // Time elapsed between the first event and the given one.
+    static Clock::duration getElapsed(const Events& events, const Event& event);
+
+private:
+    void complete(std::unique_lock<std::mutex>& lock, const error::Error& e);
+
+    mutable std::mutex mutex_;
+    Callback callback_;
+    Events events_;
+    bool isCompleted_;
+
+    StartupTimeline(const StartupTimeline&) = delete;
+};
+
+}
+}
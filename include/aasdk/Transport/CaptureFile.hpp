@@ -0,0 +1,102 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <aasdk/Common/Data.hpp>
+
+
+namespace aasdk
+{
+namespace transport
+{
+
+// Capture file layout, all integers little endian:
+//   header: "AASDKCAP", uint32 version, uint32 header size
+//   record: uint64 nanoseconds since the capture started, uint32 size with the direction in
+//           the top bit, followed by the payload
+// Records are stored in write order. A received chunk is stamped with the time its transfer
+// completed, so it may carry an earlier timestamp than a sent chunk recorded before it.
+// The file is grown in large steps while capturing and trimmed on close; a zero-size record
+// marks the end of a capture which was never closed.
+enum class CaptureDirection
+{
+    RECEIVE = 0,
+    SEND = 1
+};
+
+class CaptureWriter
+{
+public:
+    typedef std::shared_ptr<CaptureWriter> Pointer;
+
+    explicit CaptureWriter(const std::string& path);
+    ~CaptureWriter();
+
+    void write(CaptureDirection direction, const common::DataConstBuffer& buffer);
+    // Records the chunk as seen at the given time, e.g. when its transfer completed.
+    void write(CaptureDirection direction, const common::DataConstBuffer& buffer, std::chrono::steady_clock::time_point timestamp);
+    void close();
+
+private:
+    bool reserve(size_t size);
+
+    std::mutex mutex_;
+    int fd_;
+    common::Data::value_type* mapping_;
+    size_t capacity_;
+    size_t size_;
+    std::chrono::steady_clock::time_point startTime_;
+
+    CaptureWriter(const CaptureWriter&) = delete;
+};
+
+class CaptureReader
+{
+public:
+    typedef std::shared_ptr<CaptureReader> Pointer;
+
+    struct Record
+    {
+        std::chrono::nanoseconds timestamp;
+        CaptureDirection direction;
+        // Points into the mapped file, valid for the lifetime of the reader.
+        common::DataConstBuffer data;
+    };
+
+    explicit CaptureReader(const std::string& path);
+    ~CaptureReader();
+
+    const std::vector<Record>& getRecords() const;
+
+private:
+    int fd_;
+    const common::Data::value_type* mapping_;
+    size_t size_;
+    std::vector<Record> records_;
+
+    CaptureReader(const CaptureReader&) = delete;
+};
+
+}
+}
@@ -0,0 +1,57 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <asio.hpp>
+#include <aasdk/Transport/ITransport.hpp>
+#include <aasdk/Transport/CaptureFile.hpp>
+
+
+namespace aasdk
+{
+namespace transport
+{
+
+// Wraps any transport and records every chunk handed to send() and every chunk delivered by
+// receive() with its monotonic timestamp. Received chunks are stamped with the completion time
+// of the transfer that carried them, so a burst keeps its shape however late it is consumed.
+// The bytes are captured below the Cryptor, so application frames are recorded encrypted.
+class CaptureTransport: public ITransport, public std::enable_shared_from_this<CaptureTransport>
+{
+public:
+    CaptureTransport(asio::io_service& ioService, ITransport::Pointer transport, CaptureWriter::Pointer captureWriter);
+    ~CaptureTransport() override;
+
+    void receive(size_t size, ReceivePromise::Pointer promise) override;
+    void send(common::Data data, SendPromise::Pointer promise) override;
+    void stop() override;
+    ReceiveTimestamps getLastReceiveTimestamps() const override;
+
+private:
+    using std::enable_shared_from_this<CaptureTransport>::shared_from_this;
+
+    asio::io_service::strand receiveStrand_;
+    ITransport::Pointer transport_;
+    CaptureWriter::Pointer captureWriter_;
+
+    CaptureTransport(const CaptureTransport&) = delete;
+};
+
+}
+}
@@ -21,6 +21,7 @@
 #include <limits>
 #include <boost/circular_buffer.hpp>
 #include <aasdk/Common/Data.hpp>
+#include <aasdk/Error/Error.hpp>
 
 
 
@@ -36,9 +37,11 @@ public:
 
     common::DataBuffer fill();
     void commit(common::Data::size_type size);
+    void commit(common::Data::size_type size, error::Error& e);
 
     common::Data::size_type getAvailableSize();
     common::Data consume(common::Data::size_type size);
+    common::Data consume(common::Data::size_type size, error::Error& e);
 
 private:
     boost::circular_buffer<common::Data::value_type> data_;
@@ -19,6 +19,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 #include <openssl/ssl.h>
 
 
@@ -29,12 +30,20 @@ class ISSLWrapper {
   typedef std::pair<BIO *, BIO *> BIOs;
   typedef std::shared_ptr<ISSLWrapper> Pointer;
 
+  struct RecordKeys
+  {
+      const EVP_CIPHER* cipher = nullptr;
+      std::vector<uint8_t> key;
+      std::vector<uint8_t> implicitIv;
+  };
+
   ISSLWrapper() = default;
   virtual ~ISSLWrapper() = default;
 
     virtual X509* readCertificate(const std::string& certificate) = 0;
     virtual EVP_PKEY* readPrivateKey(const std::string& privateKey) = 0;
     virtual const SSL_METHOD* getMethod() = 0;
+    virtual const SSL_METHOD* getServerMethod() = 0;
     virtual SSL_CTX* createContext(const SSL_METHOD* method) = 0;
     virtual bool useCertificate(SSL_CTX* context, X509* certificate) = 0;
     virtual bool usePrivateKey(SSL_CTX* context, EVP_PKEY* privateKey) = 0;
@@ -43,12 +52,20 @@ class ISSLWrapper {
     virtual std::pair<BIO*, BIO*> createBIOs() = 0;
     virtual void setBIOs(SSL* ssl, const BIOs& bIOs, size_t maxBufferSize) = 0;
     virtual void setConnectState(SSL* ssl) = 0;
+    virtual void setAcceptState(SSL* ssl) = 0;
     virtual int doHandshake(SSL* ssl) = 0;
     virtual void free(SSL* ssl) = 0;
     virtual void free(SSL_CTX* context) = 0;
     virtual void free(BIO* bio) = 0;
     virtual void free(X509* certificate) = 0;
     virtual void free(EVP_PKEY* privateKey) = 0;
+    virtual void free(SSL_SESSION* session) = 0;
+
+    virtual SSL_SESSION* getSession(SSL* ssl) = 0;
+    virtual bool setSession(SSL* ssl, SSL_SESSION* session) = 0;
+    virtual bool isSessionReused(SSL* ssl) = 0;
+    virtual bool isSessionResumable(const SSL_SESSION* session) = 0;
+    virtual bool exportPeerRecordKeys(SSL* ssl, RecordKeys& keys) = 0;
 
     virtual size_t bioCtrlPending(BIO* b) = 0;
     virtual int bioRead(BIO *b, void *data, int len) = 0;
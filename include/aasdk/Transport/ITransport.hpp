@@ -20,6 +20,7 @@
 
 #include <memory>
 #include <aasdk/Common/Data.hpp>
+#include <aasdk/Common/TraceClock.hpp>
 #include <aasdk/IO/Promise.hpp>
 
 
@@ -31,12 +32,20 @@ class ITransport {
   typedef io::Promise<common::Data> ReceivePromise;
   typedef io::Promise<void> SendPromise;
 
+  // When the data handed to a receive promise arrived and when it was handed over.
+  struct ReceiveTimestamps {
+    common::TraceClock::time_point transferCompleted;
+    common::TraceClock::time_point distributed;
+  };
+
   ITransport() = default;
     virtual ~ITransport() = default;
 
     virtual void receive(size_t size, ReceivePromise::Pointer promise) = 0;
     virtual void send(common::Data data, SendPromise::Pointer promise) = 0;
     virtual void stop() = 0;
+    // Timestamps of the most recently resolved receive, empty unless tracing is enabled.
+    virtual ReceiveTimestamps getLastReceiveTimestamps() const = 0;
 };
 
 }
@@ -0,0 +1,95 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <asio.hpp>
+#include <boost/circular_buffer.hpp>
+#include <aasdk/Common/Data.hpp>
+#include <aasdk/IO/Promise.hpp>
+
+
+namespace aasdk
+{
+namespace transport
+{
+
+// One direction of an in-memory link. Writes are split into bulk transfers which are delivered
+// after the configured bandwidth and latency; a read never crosses a transfer boundary.
+class MemoryPipe: public std::enable_shared_from_this<MemoryPipe>
+{
+public:
+    typedef std::shared_ptr<MemoryPipe> Pointer;
+    typedef io::Promise<size_t> Promise;
+
+    struct Configuration
+    {
+        // Bytes per second, 0 means unlimited.
+        size_t bandwidth = 0;
+        std::chrono::microseconds latency = std::chrono::microseconds(0);
+        size_t packetSize = 512;
+        size_t maxTransferSize = 16384;
+        size_t capacity = 1024 * 1024;
+    };
+
+    MemoryPipe(asio::io_service& ioService, Configuration configuration);
+
+    void write(common::DataConstBuffer buffer, Promise::Pointer promise);
+    void read(common::DataBuffer buffer, Promise::Pointer promise);
+    void close();
+
+private:
+    using std::enable_shared_from_this<MemoryPipe>::shared_from_this;
+    typedef std::chrono::steady_clock Clock;
+
+    struct Transfer
+    {
+        size_t size;
+        Clock::time_point arrivalTime;
+    };
+
+    void pushTransfers();
+    void deliverTransfer();
+    Clock::duration getWireTime(size_t size) const;
+
+    Configuration configuration_;
+    std::mutex mutex_;
+    boost::circular_buffer<common::Data::value_type> data_;
+    std::deque<Transfer> transfers_;
+    Clock::time_point linkFreeTime_;
+    bool isClosed_;
+
+    common::DataConstBuffer writeBuffer_;
+    size_t writeOffset_;
+    Promise::Pointer writePromise_;
+    asio::steady_timer writeTimer_;
+
+    common::DataBuffer readBuffer_;
+    Promise::Pointer readPromise_;
+    asio::steady_timer readTimer_;
+    bool isReadTimerArmed_;
+
+    MemoryPipe(const MemoryPipe&) = delete;
+};
+
+}
+}
@@ -0,0 +1,51 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <aasdk/Transport/MemoryPipe.hpp>
+#include <aasdk/Transport/Transport.hpp>
+
+
+namespace aasdk
+{
+namespace transport
+{
+
+class MemoryTransport: public Transport
+{
+public:
+    typedef std::pair<ITransport::Pointer, ITransport::Pointer> Pair;
+
+    MemoryTransport(asio::io_service& ioService, MemoryPipe::Pointer inPipe, MemoryPipe::Pointer outPipe);
+
+    static Pair createPair(asio::io_service& ioService, const MemoryPipe::Configuration& configuration = MemoryPipe::Configuration());
+
+    void stop() override;
+
+private:
+    void enqueueReceive(common::DataBuffer buffer) override;
+    void enqueueSend(SendQueue::iterator queueElement) override;
+    void sendHandler(SendQueue::iterator queueElement, const error::Error& e);
+
+    MemoryPipe::Pointer inPipe_;
+    MemoryPipe::Pointer outPipe_;
+};
+
+}
+}
@@ -0,0 +1,81 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <list>
+#include <mutex>
+#include <asio.hpp>
+#include <aasdk/Transport/ITransport.hpp>
+#include <aasdk/Transport/CaptureFile.hpp>
+
+
+namespace aasdk
+{
+namespace transport
+{
+
+// Serves the received side of a capture back to the stack. With ORIGINAL pacing a chunk is
+// delivered no earlier than its last byte originally arrived, measured from the first receive()
+// call; AS_FAST_AS_POSSIBLE ignores the timestamps. Sent data is accepted and discarded. Once
+// the capture is exhausted pending receives are rejected as if the device was unplugged.
+class ReplayTransport: public ITransport, public std::enable_shared_from_this<ReplayTransport>
+{
+public:
+    enum class Pacing
+    {
+        ORIGINAL,
+        AS_FAST_AS_POSSIBLE
+    };
+
+    ReplayTransport(asio::io_service& ioService, CaptureReader::Pointer captureReader, Pacing pacing);
+
+    void receive(size_t size, ReceivePromise::Pointer promise) override;
+    void send(common::Data data, SendPromise::Pointer promise) override;
+    void stop() override;
+    ReceiveTimestamps getLastReceiveTimestamps() const override;
+
+private:
+    using std::enable_shared_from_this<ReplayTransport>::shared_from_this;
+    typedef std::chrono::steady_clock Clock;
+    typedef std::list<std::pair<size_t, ReceivePromise::Pointer>> ReceiveQueue;
+
+    void distributeRecords();
+    bool findAvailableSize(size_t size, std::chrono::nanoseconds& timestamp) const;
+    void rejectReceivePromises(const error::Error& e);
+
+    asio::io_service::strand strand_;
+    asio::steady_timer timer_;
+    CaptureReader::Pointer captureReader_;
+    Pacing pacing_;
+    ReceiveQueue receiveQueue_;
+    size_t recordIndex_;
+    size_t recordOffset_;
+    Clock::time_point startTime_;
+    bool isStarted_;
+    bool isTimerArmed_;
+    bool isStopped_;
+    ReceiveTimestamps lastReceiveTimestamps_;
+    mutable std::mutex receiveTimestampsMutex_;
+
+    ReplayTransport(const ReplayTransport&) = delete;
+};
+
+}
+}
@@ -18,6 +18,10 @@
 
 #pragma once
 
+#include <chrono>
+#include <string>
+#include <vector>
+#include <openssl/engine.h>
 #include <aasdk/Transport/ISSLWrapper.hpp>
 
 
@@ -30,11 +34,18 @@ class SSLWrapper: public ISSLWrapper
 {
 public:
     SSLWrapper();
+    // An engine backend is registered as the OpenSSL default for the whole process while this
+    // wrapper lives; only one wrapper with an engine backend should exist at a time.
+    explicit SSLWrapper(const std::string& cryptoBackend);
     ~SSLWrapper() override;
 
+    const std::string& getCryptoBackend() const;
+    static std::vector<std::string> getAvailableCryptoBackends();
+
     X509* readCertificate(const std::string& certificate) override;
     EVP_PKEY* readPrivateKey(const std::string& privateKey) override;
     const SSL_METHOD* getMethod() override;
+    const SSL_METHOD* getServerMethod() override;
     SSL_CTX* createContext(const SSL_METHOD* method) override;
     bool useCertificate(SSL_CTX* context, X509* certificate) override;
     bool usePrivateKey(SSL_CTX* context, EVP_PKEY* privateKey) override;
@@ -43,6 +54,7 @@ public:
     BIOs createBIOs() override;
     void setBIOs(SSL* ssl, const BIOs& bIOs, size_t maxBufferSize) override;
     void setConnectState(SSL* ssl) override;
+    void setAcceptState(SSL* ssl) override;
     int doHandshake(SSL* ssl) override;
     int getError(SSL* ssl, int returnCode) override;
 
@@ -51,6 +63,13 @@ public:
     void free(BIO* bio) override;
     void free(X509* certificate) override;
     void free(EVP_PKEY* privateKey) override;
+    void free(SSL_SESSION* session) override;
+
+    SSL_SESSION* getSession(SSL* ssl) override;
+    bool setSession(SSL* ssl, SSL_SESSION* session) override;
+    bool isSessionReused(SSL* ssl) override;
+    bool isSessionResumable(const SSL_SESSION* session) override;
+    bool exportPeerRecordKeys(SSL* ssl, RecordKeys& keys) override;
 
     size_t bioCtrlPending(BIO* b) override;
     int bioRead(BIO *b, void *data, int len) override;
@@ -58,6 +77,30 @@ public:
     int getAvailableBytes(const SSL* ssl) override;
     int sslRead(SSL *ssl, void *buf, int num) override;
     int sslWrite(SSL *ssl, const void *buf, int num) override;
+
+    static const std::string cDefaultCryptoBackend;
+    static const std::string cAutoCryptoBackend;
+    static const std::string cDevCryptoEngine;
+
+    // Record cipher time of an engine and of the default implementation over the same ciphers.
+    struct EngineTiming
+    {
+        std::string engineId;
+        std::chrono::nanoseconds engineDuration;
+        std::chrono::nanoseconds defaultDuration;
+    };
+
+    // Engine with the lowest engine to default time ratio, the default backend unless an engine beats it.
+    static std::string selectFastestEngine(const std::vector<EngineTiming>& timings);
+
+private:
+    bool useEngine(const std::string& engineId);
+    static std::vector<EngineTiming> measureEngines();
+    static std::chrono::nanoseconds measureCipher(ENGINE* engine, const EVP_CIPHER* cipher);
+    static bool derivePRF(const EVP_MD* digest, const std::vector<uint8_t>& secret, const std::string& label, const std::vector<uint8_t>& seed, std::vector<uint8_t>& output);
+
+    ENGINE* engine_;
+    std::string cryptoBackend_;
 };
 
 }
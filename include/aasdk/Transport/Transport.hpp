@@ -19,10 +19,12 @@
 #pragma once
 
 #include <list>
+#include <mutex>
 #include <queue>
 #include <asio.hpp>
 #include <aasdk/Transport/ITransport.hpp>
 #include <aasdk/Transport/DataSink.hpp>
+#include <aasdk/Metrics/SessionMetrics.hpp>
 
 namespace aasdk
 {
@@ -36,6 +38,10 @@ public:
 
     void receive(size_t size, ReceivePromise::Pointer promise) override;
     void send(common::Data data, SendPromise::Pointer promise) override;
+    ReceiveTimestamps getLastReceiveTimestamps() const override;
+
+    // Must be attached before the first receive or send.
+    void setMetrics(metrics::SessionMetrics::Pointer metrics);
 
 private:
     Transport(const Transport&) = delete;
@@ -46,6 +52,7 @@ protected:
 
     using std::enable_shared_from_this<Transport>::shared_from_this;
     void receiveHandler(size_t bytesTransferred);
+    void receiveHandler(size_t bytesTransferred, common::TraceClock::time_point transferCompletionTime);
     void distributeReceivedData();
     void rejectReceivePromises(const error::Error& e);
 
@@ -53,9 +60,13 @@ protected:
     virtual void enqueueSend(SendQueue::iterator queueElement) = 0;
 
     DataSink receivedDataSink_;
+    metrics::SessionMetrics::Pointer metrics_;
 
     asio::io_service::strand receiveStrand_;
     ReceiveQueue receiveQueue_;
+    common::TraceClock::time_point lastTransferCompletionTime_;
+    ReceiveTimestamps lastReceiveTimestamps_;
+    mutable std::mutex receiveTimestampsMutex_;
 
     asio::io_service::strand sendStrand_;
     SendQueue sendQueue_;
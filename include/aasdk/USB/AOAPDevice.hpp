@@ -23,6 +23,7 @@
 #include <libusb.h>
 #include <aasdk/USB/IUSBWrapper.hpp>
 #include <aasdk/USB/IAOAPDevice.hpp>
+#include <aasdk/Metrics/StartupTimeline.hpp>
 
 
 namespace aasdk::usb {
@@ -38,7 +39,8 @@ class AOAPDevice : public IAOAPDevice {
   IUSBEndpoint &getInEndpoint() override;
   IUSBEndpoint &getOutEndpoint() override;
 
-    static IAOAPDevice::Pointer create(IUSBWrapper& usbWrapper, asio::io_service& ioService, DeviceHandle handle);
+    static IAOAPDevice::Pointer create(IUSBWrapper& usbWrapper, asio::io_service& ioService, DeviceHandle handle,
+                                       metrics::StartupTimeline::Pointer startupTimeline = nullptr);
 
 private:
     static ConfigDescriptorHandle getConfigDescriptor(IUSBWrapper& usbWrapper, DeviceHandle handle);
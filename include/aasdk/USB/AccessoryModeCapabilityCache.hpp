@@ -0,0 +1,54 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <set>
+#include <libusb.h>
+
+
+namespace aasdk
+{
+namespace usb
+{
+
+// Remembers devices which already answered the AOAP protocol version query, so a reconnecting
+// phone goes straight to the string queries. Devices are identified by vendor id, product id and
+// device release number; the serial number would need a string descriptor control transfer,
+// which costs the round trip the cache saves.
+class AccessoryModeCapabilityCache
+{
+public:
+    typedef std::shared_ptr<AccessoryModeCapabilityCache> Pointer;
+    typedef uint64_t Key;
+
+    static Key getKey(const libusb_device_descriptor& deviceDescriptor);
+
+    bool contains(Key key) const;
+    void insert(Key key);
+    void erase(Key key);
+
+private:
+    mutable std::mutex mutex_;
+    std::set<Key> keys_;
+};
+
+}
+}
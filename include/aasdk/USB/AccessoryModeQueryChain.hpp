@@ -18,9 +18,11 @@
 
 #pragma once
 
+#include <vector>
 #include <aasdk/USB/IUSBWrapper.hpp>
 #include <aasdk/USB/IAccessoryModeQueryFactory.hpp>
 #include <aasdk/USB/IAccessoryModeQueryChain.hpp>
+#include <aasdk/USB/AccessoryModeCapabilityCache.hpp>
 
 
 namespace aasdk
@@ -35,10 +37,12 @@ class AccessoryModeQueryChain: public IAccessoryModeQueryChain, public std::enab
 public:
     AccessoryModeQueryChain(IUSBWrapper& usbWrapper,
                             asio::io_service& ioService,
-                            IAccessoryModeQueryFactory& queryFactory);
+                            IAccessoryModeQueryFactory& queryFactory,
+                            AccessoryModeCapabilityCache::Pointer capabilityCache = nullptr);
 
     void start(DeviceHandle handle, Promise::Pointer promise) override;
     void cancel() override;
+    void setStartupTimeline(metrics::StartupTimeline::Pointer startupTimeline) override;
     
 private:
     using std::enable_shared_from_this<AccessoryModeQueryChain>::shared_from_this;
@@ -46,20 +50,21 @@ private:
     void startQuery(AccessoryModeQueryType queryType, IUSBEndpoint::Pointer usbEndpoint, IAccessoryModeQuery::Promise::Pointer queryPromise);
 
     void protocolVersionQueryHandler(IUSBEndpoint::Pointer usbEndpoint);
-    void manufacturerQueryHandler(IUSBEndpoint::Pointer usbEndpoint);
-    void modelQueryHandler(IUSBEndpoint::Pointer usbEndpoint);
-    void descriptionQueryHandler(IUSBEndpoint::Pointer usbEndpoint);
-    void versionQueryHandler(IUSBEndpoint::Pointer usbEndpoint);
-    void uriQueryHandler(IUSBEndpoint::Pointer usbEndpoint);
-    void serialQueryHandler(IUSBEndpoint::Pointer usbEndpoint);
+    void sendStrings(IUSBEndpoint::Pointer usbEndpoint);
+    void sendStringQueryHandler(IUSBEndpoint::Pointer usbEndpoint);
     void startQueryHandler(IUSBEndpoint::Pointer usbEndpoint);
-    
+    void queryErrorHandler(const error::Error& e);
+
     IUSBWrapper& usbWrapper_;
     asio::io_service::strand strand_;
     IAccessoryModeQueryFactory& queryFactory_;
     DeviceHandle handle_;    
     Promise::Pointer promise_;
-    IAccessoryModeQuery::Pointer activeQuery_;
+    std::vector<IAccessoryModeQuery::Pointer> activeQueries_;
+    size_t pendingStringQueries_;
+    AccessoryModeCapabilityCache::Pointer capabilityCache_;
+    AccessoryModeCapabilityCache::Key capabilityKey_;
+    metrics::StartupTimeline::Pointer startupTimeline_;
 
     AccessoryModeQueryChain(const AccessoryModeQueryChain&) = delete;
 };
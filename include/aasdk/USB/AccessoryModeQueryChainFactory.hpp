@@ -20,6 +20,7 @@
 
 #include <aasdk/USB/IAccessoryModeQueryChainFactory.hpp>
 #include <aasdk/USB/IAccessoryModeQueryFactory.hpp>
+#include <aasdk/USB/AccessoryModeCapabilityCache.hpp>
 
 
 namespace aasdk::usb {
@@ -29,12 +30,18 @@ class AccessoryModeQueryChainFactory : public IAccessoryModeQueryChainFactory {
   AccessoryModeQueryChainFactory(IUSBWrapper &usbWrapper,
                                  asio::io_service &ioService,
                                  IAccessoryModeQueryFactory &queryFactory);
+  // Chains share the capability cache, so a phone reconnecting to this factory skips the protocol version query.
+  AccessoryModeQueryChainFactory(IUSBWrapper &usbWrapper,
+                                 asio::io_service &ioService,
+                                 IAccessoryModeQueryFactory &queryFactory,
+                                 AccessoryModeCapabilityCache::Pointer capabilityCache);
   IAccessoryModeQueryChain::Pointer create() override;
 
 private:
     IUSBWrapper& usbWrapper_;
     asio::io_service& ioService_;
     IAccessoryModeQueryFactory& queryFactory_;
+    AccessoryModeCapabilityCache::Pointer capabilityCache_;
 };
 
 }
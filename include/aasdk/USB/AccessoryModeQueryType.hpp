@@ -20,6 +20,7 @@
 
 #include <memory>
 #include <functional>
+#include <string>
 
 
 namespace aasdk
@@ -39,5 +40,7 @@ enum class AccessoryModeQueryType
     START
 };
 
+std::string accessoryModeQueryTypeToString(AccessoryModeQueryType queryType);
+
 }
 }
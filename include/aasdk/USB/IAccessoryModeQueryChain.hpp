@@ -22,6 +22,7 @@
 #include <functional>
 #include <aasdk/USB/IUSBWrapper.hpp>
 #include <aasdk/IO/Promise.hpp>
+#include <aasdk/Metrics/StartupTimeline.hpp>
 
 
 namespace aasdk
@@ -39,6 +40,7 @@ public:
     virtual ~IAccessoryModeQueryChain() = default;
     virtual void start(DeviceHandle handle, Promise::Pointer promise) = 0;
     virtual void cancel() = 0;
+    virtual void setStartupTimeline(metrics::StartupTimeline::Pointer startupTimeline) = 0;
 };
 
 }
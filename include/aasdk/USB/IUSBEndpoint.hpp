@@ -21,6 +21,7 @@
 #include <memory>
 #include <aasdk/USB/USBWrapper.hpp>
 #include <aasdk/Common/Data.hpp>
+#include <aasdk/Common/TraceClock.hpp>
 #include <aasdk/IO/Promise.hpp>
 
 
@@ -44,6 +45,8 @@ public:
     virtual void interruptTransfer(common::DataBuffer buffer, uint32_t timeout, Promise::Pointer promise) = 0;
     virtual void cancelTransfers() = 0;
     virtual DeviceHandle getDeviceHandle() const = 0;
+    // Completion time of the most recently resolved transfer, empty unless tracing is enabled.
+    virtual common::TraceClock::time_point getLastTransferCompletionTime() const = 0;
 };
 
 }
@@ -23,6 +23,7 @@
 #include <aasdk/USB/IUSBWrapper.hpp>
 #include <aasdk/Error/Error.hpp>
 #include <aasdk/IO/Promise.hpp>
+#include <aasdk/Metrics/StartupTimeline.hpp>
 
 
 namespace aasdk::usb {
@@ -37,6 +38,13 @@ class IUSBHub {
 
     virtual void start(Promise::Pointer promise) = 0;
     virtual void cancel() = 0;
+    // Every probed device gets a timeline of its own from the factory, which collects its hotplug
+    // and accessory mode steps and is finished with the error if the device fails to switch or
+    // the hub is cancelled. A switched device keeps its timeline across the re-enumeration.
+    virtual void setStartupTimelineFactory(metrics::StartupTimeline::Factory startupTimelineFactory) = 0;
+    // Timeline of the AOAP device the last start() promise was resolved with, to be continued by
+    // AOAPDevice::create and the messenger.
+    virtual metrics::StartupTimeline::Pointer getStartupTimeline() const = 0;
 };
 
 }
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <unordered_map>
 #include <memory>
 #include <asio.hpp>
@@ -41,6 +42,7 @@ public:
     uint8_t getAddress() override;
     void cancelTransfers() override;
     DeviceHandle getDeviceHandle() const override;
+    common::TraceClock::time_point getLastTransferCompletionTime() const override;
 
 private:
     typedef std::unordered_map<libusb_transfer*, Promise::Pointer> Transfers;
@@ -55,6 +57,7 @@ private:
     uint8_t endpointAddress_;
     Transfers transfers_;
     std::shared_ptr<USBEndpoint> self_;
+    std::atomic<common::TraceClock::time_point> lastTransferCompletionTime_;
 
     USBEndpoint(const USBEndpoint&) = delete;
 };
@@ -18,8 +18,12 @@
 
 #pragma once
 
+#include <chrono>
 #include <asio.hpp>
 #include <list>
+#include <map>
+#include <mutex>
+#include <vector>
 #include <aasdk/USB/IUSBHub.hpp>
 #include <aasdk/USB/IAccessoryModeQueryChainFactory.hpp>
 
@@ -34,25 +38,62 @@ class IUSBWrapper;
 class USBHub: public IUSBHub, public std::enable_shared_from_this<USBHub>
 {
 public:
+    struct Configuration
+    {
+        // Delay between opening a non-AOAP device and starting its accessory mode query chain.
+        // Some virtualized USB stacks (e.g. VMware) need about a second; bare metal needs none.
+        std::chrono::milliseconds queryChainDelay = std::chrono::milliseconds(0);
+
+        // Only devices passing these filters are opened and probed; AOAP devices always pass.
+        // An empty list probes every vendor.
+        std::vector<uint16_t> vendorIds;
+        // A device is skipped when its class, or every interface class of a per-interface
+        // device, is one of these. Only hubs are skipped by default: phones tethering over RNDIS
+        // report the wireless class and phones in USB-MIDI mode only audio interfaces, so
+        // further classes (e.g. HID, printer, mass storage) are opt-in.
+        std::vector<uint8_t> ignoredClasses = {LIBUSB_CLASS_HUB};
+        // Remember vendor/product ids which rejected the AOAP protocol version query and skip them
+        // for nonAOAPDeviceCacheDuration; a phone may only reject it until it is unlocked.
+        bool isNonAOAPDeviceCacheEnabled = true;
+        std::chrono::seconds nonAOAPDeviceCacheDuration = std::chrono::minutes(5);
+    };
+
     USBHub(IUSBWrapper& usbWrapper, asio::io_service& ioService, IAccessoryModeQueryChainFactory& queryChainFactory);
+    USBHub(IUSBWrapper& usbWrapper, asio::io_service& ioService, IAccessoryModeQueryChainFactory& queryChainFactory, Configuration configuration);
 
     void start(Promise::Pointer promise) override;
     void cancel() override;
+    void setStartupTimelineFactory(metrics::StartupTimeline::Factory startupTimelineFactory) override;
+    metrics::StartupTimeline::Pointer getStartupTimeline() const override;
     
 private:
     typedef std::list<IAccessoryModeQueryChain::Pointer> QueryChainQueue;
+    typedef std::list<std::shared_ptr<asio::steady_timer>> DelayTimers;
     using std::enable_shared_from_this<USBHub>::shared_from_this;
     void handleDevice(libusb_device* device);
+    void startQueryChain(QueryChainQueue::iterator queueElementIter, DeviceHandle handle, uint32_t deviceId, metrics::StartupTimeline::Pointer startupTimeline);
+    metrics::StartupTimeline::Pointer createStartupTimeline(const libusb_device_descriptor& deviceDescriptor);
+    bool isCandidateDevice(libusb_device* device, const libusb_device_descriptor& deviceDescriptor) const;
+    bool isIgnoredClass(uint8_t deviceClass) const;
     bool isAOAPDevice(const libusb_device_descriptor& deviceDescriptor) const;
     static int hotplugEventsHandler(libusb_context* usbContext, libusb_device* device, libusb_hotplug_event event, void* uerData);
 
     IUSBWrapper& usbWrapper_;
     asio::io_service::strand strand_;
     IAccessoryModeQueryChainFactory& queryChainFactory_;
+    Configuration configuration_;
     Promise::Pointer hotplugPromise_;
     Pointer self_;
     HotplugCallbackHandle hotplugHandle_;
     QueryChainQueue queryChainQueue_;
+    DelayTimers delayTimers_;
+    // Vendor/product id to the time its entry expires.
+    std::map<uint32_t, std::chrono::steady_clock::time_point> nonAOAPDevices_;
+    metrics::StartupTimeline::Factory startupTimelineFactory_;
+    // Timelines of devices switched to accessory mode, waiting for their AOAP re-enumeration.
+    std::list<metrics::StartupTimeline::Pointer> switchedDeviceStartupTimelines_;
+    mutable std::mutex startupTimelineMutex_;
+    metrics::StartupTimeline::Pointer startupTimeline_;
 
     static constexpr uint16_t cGoogleVendorId = 0x18D1;
     static constexpr uint16_t cAOAPId = 0x2D00;
@@ -73,27 +73,14 @@ messenger::ChannelId AVInputServiceChannel::getId() const
 
 void AVInputServiceChannel::messageHandler(messenger::Message::Pointer message, IAVInputServiceChannelEventHandler::Pointer eventHandler)
 {
+    this->traceMessage(*message);
     messenger::MessageId messageId(message->getPayload());
     common::DataConstBuffer payload(message->getPayload(), messageId.getSizeOf());
 
-    switch(messageId.getId())
+    if(!dispatcher_.dispatch(*this, messageId.getId(), payload, eventHandler))
     {
-    case proto::ids::AVChannelMessage::SETUP_REQUEST:
-        this->handleAVChannelSetupRequest(payload, std::move(eventHandler));
-        break;
-    case proto::ids::AVChannelMessage::AV_INPUT_OPEN_REQUEST:
-        this->handleAVInputOpenRequest(payload, std::move(eventHandler));
-        break;
-    case proto::ids::AVChannelMessage::AV_MEDIA_ACK_INDICATION:
-        this->handleAVMediaAckIndication(payload, std::move(eventHandler));
-        break;
-    case proto::ids::ControlMessage::CHANNEL_OPEN_REQUEST:
-        this->handleChannelOpenRequest(payload, std::move(eventHandler));
-        break;
-    default:
         AASDK_LOG(error) << "[AVInputServiceChannel] message not handled: " << messageId.getId();
         this->receive(std::move(eventHandler));
-        break;
     }
 }
 
@@ -118,56 +105,31 @@ void AVInputServiceChannel::sendAVMediaWithTimestampIndication(messenger::Timest
     this->send(std::move(message), std::move(promise));
 }
 
-void AVInputServiceChannel::handleAVChannelSetupRequest(const common::DataConstBuffer& payload, IAVInputServiceChannelEventHandler::Pointer eventHandler)
+void AVInputServiceChannel::sendAVMediaWithTimestampIndication(AudioCaptureRing::Pointer captureRing, SendPromise::Pointer promise)
 {
-    proto::messages::AVChannelSetupRequest request;
-    if(request.ParseFromArray(payload.cdata, payload.size))
-    {
-        eventHandler->onAVChannelSetupRequest(request);
-    }
-    else
-    {
-        eventHandler->onChannelError(error::Error(error::ErrorCode::PARSE_PAYLOAD));
-    }
-}
-
-void AVInputServiceChannel::handleAVInputOpenRequest(const common::DataConstBuffer& payload, IAVInputServiceChannelEventHandler::Pointer eventHandler)
-{
-    proto::messages::AVInputOpenRequest request;
-    if(request.ParseFromArray(payload.cdata, payload.size))
-    {
-        eventHandler->onAVInputOpenRequest(request);
-    }
-    else
-    {
-        eventHandler->onChannelError(error::Error(error::ErrorCode::PARSE_PAYLOAD));
-    }
-}
-
-void AVInputServiceChannel::handleAVMediaAckIndication(const common::DataConstBuffer& payload, IAVInputServiceChannelEventHandler::Pointer eventHandler)
-{
-    proto::messages::AVMediaAckIndication indication;
-    if(indication.ParseFromArray(payload.cdata, payload.size))
-    {
-        eventHandler->onAVMediaAckIndication(indication);
-    }
-    else
-    {
-        eventHandler->onChannelError(error::Error(error::ErrorCode::PARSE_PAYLOAD));
-    }
-}
-
-void AVInputServiceChannel::handleChannelOpenRequest(const common::DataConstBuffer& payload, IAVInputServiceChannelEventHandler::Pointer eventHandler)
-{
-    proto::messages::ChannelOpenRequest request;
-    if(request.ParseFromArray(payload.cdata, payload.size))
-    {
-        eventHandler->onChannelOpenRequest(request);
-    }
-    else
-    {
-        eventHandler->onChannelError(error::Error(error::ErrorCode::PARSE_PAYLOAD));
-    }
+    // pop and release share the ring's read side, so both run on the channel strand.
+    strand_.dispatch([this, self = this->shared_from_this(), captureRing = std::move(captureRing), promise = std::move(promise)]() mutable {
+        auto message = captureRing->pop();
+
+        if(message == nullptr)
+        {
+            promise->reject(error::Error(error::ErrorCode::CAPTURE_RING_EMPTY));
+            return;
+        }
+
+        // The slot is handed back to the capture thread once the messenger is done with it.
+        auto sendPromise = SendPromise::defer(strand_);
+        sendPromise->then([captureRing, message, promise]() {
+                              captureRing->release(message);
+                              promise->resolve();
+                          },
+                          [captureRing, message, promise](const error::Error& e) {
+                              captureRing->release(message);
+                              promise->reject(e);
+                          });
+
+        this->send(std::move(message), std::move(sendPromise));
+    });
 }
 
 }
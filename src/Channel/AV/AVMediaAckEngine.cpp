@@ -0,0 +1,183 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <aasdk/Channel/AV/AVMediaAckEngine.hpp>
+#include <aasdk/Common/Log.hpp>
+
+
+namespace aasdk
+{
+namespace channel
+{
+namespace av
+{
+
+namespace
+{
+
+template<typename ChannelPointer>
+auto createAckSender(ChannelPointer channel)
+{
+    // The channel owns the engine once it is attached, so only a weak reference is kept here.
+    return [channel = std::weak_ptr<typename ChannelPointer::element_type>(channel)](const proto::messages::AVMediaAckIndication& indication, SendPromise::Pointer promise) {
+        if(auto lockedChannel = channel.lock())
+        {
+            lockedChannel->sendAVMediaAckIndication(indication, std::move(promise));
+        }
+        else
+        {
+            promise->reject(error::Error(error::ErrorCode::OPERATION_ABORTED));
+        }
+    };
+}
+
+}
+
+AVMediaAckEngine::AVMediaAckEngine(asio::io_service& ioService, IVideoServiceChannel::Pointer channel)
+    : AVMediaAckEngine(ioService, createAckSender(std::move(channel)))
+{
+
+}
+
+AVMediaAckEngine::AVMediaAckEngine(asio::io_service& ioService, IAudioServiceChannel::Pointer channel)
+    : AVMediaAckEngine(ioService, createAckSender(std::move(channel)))
+{
+
+}
+
+AVMediaAckEngine::AVMediaAckEngine(asio::io_service& ioService, AckSender ackSender)
+    : strand_(ioService)
+    , ackSender_(std::move(ackSender))
+    , session_(0)
+    , maxUnacked_(1)
+    , batchSize_(1)
+    , outstanding_(0)
+    , released_(0)
+    , isActive_(false)
+    , receivedFrames_(0)
+    , releasedFrames_(0)
+    , ackedFrames_(0)
+    , sentAcks_(0)
+{
+
+}
+
+void AVMediaAckEngine::start(int32_t session, uint32_t maxUnacked)
+{
+    strand_.dispatch([this, self = this->shared_from_this(), session, maxUnacked]() {
+        session_ = session;
+        maxUnacked_ = std::max<uint32_t>(maxUnacked, 1);
+        batchSize_ = (maxUnacked_ + 1) / 2;
+        outstanding_ = 0;
+        released_ = 0;
+        isActive_ = true;
+    });
+}
+
+void AVMediaAckEngine::stop()
+{
+    strand_.dispatch([this, self = this->shared_from_this()]() {
+        // The phone forgets its credits together with the session.
+        isActive_ = false;
+        outstanding_ = 0;
+        released_ = 0;
+    });
+}
+
+void AVMediaAckEngine::onMediaReceived()
+{
+    strand_.dispatch([this, self = this->shared_from_this()]() {
+        if(!isActive_)
+        {
+            return;
+        }
+
+        ++outstanding_;
+        receivedFrames_.fetch_add(1, std::memory_order_relaxed);
+
+        if(released_ > 0 && outstanding_ >= maxUnacked_)
+        {
+            this->sendAck();
+        }
+    });
+}
+
+void AVMediaAckEngine::release(uint32_t count)
+{
+    strand_.dispatch([this, self = this->shared_from_this(), count]() {
+        if(!isActive_)
+        {
+            return;
+        }
+
+        // Frames of a previous session are not ours to acknowledge.
+        const auto released = std::min(count, outstanding_ - released_);
+        released_ += released;
+        releasedFrames_.fetch_add(released, std::memory_order_relaxed);
+
+        if(released_ > 0 && (released_ >= batchSize_ || outstanding_ >= maxUnacked_))
+        {
+            this->sendAck();
+        }
+    });
+}
+
+void AVMediaAckEngine::flush()
+{
+    strand_.dispatch([this, self = this->shared_from_this()]() {
+        if(isActive_ && released_ > 0)
+        {
+            this->sendAck();
+        }
+    });
+}
+
+AVMediaAckEngine::Statistics AVMediaAckEngine::getStatistics() const
+{
+    Statistics statistics;
+    statistics.receivedFrames = receivedFrames_.load(std::memory_order_relaxed);
+    statistics.releasedFrames = releasedFrames_.load(std::memory_order_relaxed);
+    statistics.ackedFrames = ackedFrames_.load(std::memory_order_relaxed);
+    statistics.sentAcks = sentAcks_.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+void AVMediaAckEngine::sendAck()
+{
+    proto::messages::AVMediaAckIndication indication;
+    indication.set_session(session_);
+    indication.set_value(released_);
+
+    outstanding_ -= released_;
+    ackedFrames_.fetch_add(released_, std::memory_order_relaxed);
+    sentAcks_.fetch_add(1, std::memory_order_relaxed);
+    released_ = 0;
+
+    auto sendPromise = SendPromise::defer(strand_);
+    sendPromise->then([]() {},
+                      [this, self = this->shared_from_this()](const error::Error& e) {
+                          AASDK_LOG(error) << "[AVMediaAckEngine] send failed: " << e.what();
+                          isActive_ = false;
+                      });
+
+    ackSender_(indication, std::move(sendPromise));
+}
+
+}
+}
+}
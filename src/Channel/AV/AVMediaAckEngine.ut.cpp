@@ -0,0 +1,124 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <boost/test/unit_test.hpp>
+#include <Channel/AV/UT/VideoServiceChannel.mock.hpp>
+#include <aasdk/Channel/AV/AVMediaAckEngine.hpp>
+
+
+namespace aasdk
+{
+namespace channel
+{
+namespace av
+{
+namespace ut
+{
+
+using ::testing::_;
+using ::testing::AllOf;
+using ::testing::Property;
+
+class AVMediaAckEngineUnitTest
+{
+protected:
+    AVMediaAckEngineUnitTest()
+        : channelMock_(std::make_shared<VideoServiceChannelMock>())
+        , ackEngine_(std::make_shared<AVMediaAckEngine>(ioService_, channelMock_))
+    {
+
+    }
+
+    void receive(size_t count)
+    {
+        for(size_t i = 0; i < count; ++i)
+        {
+            ackEngine_->onMediaReceived();
+        }
+    }
+
+    asio::io_service ioService_;
+    std::shared_ptr<VideoServiceChannelMock> channelMock_;
+    AVMediaAckEngine::Pointer ackEngine_;
+};
+
+auto isAck(int32_t session, uint32_t value)
+{
+    return AllOf(Property(&proto::messages::AVMediaAckIndication::session, session),
+                 Property(&proto::messages::AVMediaAckIndication::value, value));
+}
+
+BOOST_FIXTURE_TEST_CASE(AVMediaAckEngine_BatchReleasedFrames, AVMediaAckEngineUnitTest)
+{
+    ackEngine_->start(7, 8);
+    this->receive(6);
+    ioService_.run();
+    ioService_.reset();
+
+    // Nothing is acknowledged until the consumer has released half of the window.
+    EXPECT_CALL(*channelMock_, sendAVMediaAckIndication(_, _)).Times(0);
+    ackEngine_->release(3);
+    ioService_.run();
+    ioService_.reset();
+    ::testing::Mock::VerifyAndClearExpectations(channelMock_.get());
+
+    EXPECT_CALL(*channelMock_, sendAVMediaAckIndication(isAck(7, 4), _));
+    ackEngine_->release();
+    ioService_.run();
+    ioService_.reset();
+
+    const auto statistics = ackEngine_->getStatistics();
+    BOOST_CHECK_EQUAL(statistics.receivedFrames, 6u);
+    BOOST_CHECK_EQUAL(statistics.releasedFrames, 4u);
+    BOOST_CHECK_EQUAL(statistics.ackedFrames, 4u);
+    BOOST_CHECK_EQUAL(statistics.sentAcks, 1u);
+}
+
+BOOST_FIXTURE_TEST_CASE(AVMediaAckEngine_AckImmediatelyWhenWindowIsFull, AVMediaAckEngineUnitTest)
+{
+    ackEngine_->start(1, 8);
+    this->receive(8);
+
+    EXPECT_CALL(*channelMock_, sendAVMediaAckIndication(isAck(1, 1), _));
+    ackEngine_->release();
+    ioService_.run();
+}
+
+BOOST_FIXTURE_TEST_CASE(AVMediaAckEngine_FlushAndStop, AVMediaAckEngineUnitTest)
+{
+    ackEngine_->start(1, 8);
+    this->receive(4);
+
+    EXPECT_CALL(*channelMock_, sendAVMediaAckIndication(isAck(1, 2), _));
+    ackEngine_->release(2);
+    ackEngine_->flush();
+    ioService_.run();
+    ioService_.reset();
+    ::testing::Mock::VerifyAndClearExpectations(channelMock_.get());
+
+    // Releases arriving after the session has ended are dropped.
+    EXPECT_CALL(*channelMock_, sendAVMediaAckIndication(_, _)).Times(0);
+    ackEngine_->stop();
+    ackEngine_->release(2);
+    ackEngine_->flush();
+    ioService_.run();
+}
+
+}
+}
+}
+}
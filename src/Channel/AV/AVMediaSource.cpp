@@ -0,0 +1,143 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <aasdk/Channel/AV/AVMediaSource.hpp>
+#include <aasdk/Common/Log.hpp>
+
+
+namespace aasdk
+{
+namespace channel
+{
+namespace av
+{
+
+AVMediaSource::AVMediaSource(asio::io_service& ioService, IAVSourceServiceChannel::Pointer channel, Configuration configuration)
+    : strand_(ioService)
+    , timer_(ioService)
+    , channel_(std::move(channel))
+    , configuration_(std::move(configuration))
+    , maxUnacked_(1)
+    , unacked_(0)
+    , isActive_(false)
+    , sentFrames_(0)
+    , sentBytes_(0)
+    , ackedFrames_(0)
+    , skippedFrames_(0)
+{
+    configuration_.frameRate = std::max<size_t>(configuration_.frameRate, 1);
+    frame_.resize(std::max<size_t>(configuration_.bitrate / 8 / configuration_.frameRate, 1), 0);
+    frameInterval_ = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / configuration_.frameRate));
+}
+
+void AVMediaSource::start(uint32_t maxUnacked)
+{
+    strand_.dispatch([this, self = this->shared_from_this(), maxUnacked]() {
+        if(isActive_)
+        {
+            return;
+        }
+
+        maxUnacked_ = std::max<uint32_t>(maxUnacked, 1);
+        unacked_ = 0;
+        isActive_ = true;
+        nextFrameTime_ = Clock::now();
+        this->produceFrame();
+    });
+}
+
+void AVMediaSource::stop()
+{
+    strand_.dispatch([this, self = this->shared_from_this()]() {
+        isActive_ = false;
+        timer_.cancel();
+    });
+}
+
+void AVMediaSource::onAck(uint32_t value)
+{
+    strand_.dispatch([this, self = this->shared_from_this(), value]() {
+        const auto acked = std::min(value, unacked_);
+        unacked_ -= acked;
+        ackedFrames_.fetch_add(acked, std::memory_order_relaxed);
+    });
+}
+
+AVMediaSource::Statistics AVMediaSource::getStatistics() const
+{
+    Statistics statistics;
+    statistics.sentFrames = sentFrames_.load(std::memory_order_relaxed);
+    statistics.sentBytes = sentBytes_.load(std::memory_order_relaxed);
+    statistics.ackedFrames = ackedFrames_.load(std::memory_order_relaxed);
+    statistics.skippedFrames = skippedFrames_.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+messenger::Timestamp::ValueType AVMediaSource::now()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now().time_since_epoch()).count();
+}
+
+void AVMediaSource::produceFrame()
+{
+    if(!isActive_)
+    {
+        return;
+    }
+
+    if(unacked_ < maxUnacked_)
+    {
+        ++unacked_;
+
+        auto sendPromise = SendPromise::defer(strand_);
+        sendPromise->then([]() {},
+                          [this, self = this->shared_from_this()](const error::Error& e) {
+                              AASDK_LOG(error) << "[AVMediaSource] send failed: " << e.what();
+                              isActive_ = false;
+                              timer_.cancel();
+                          });
+
+        channel_->sendAVMediaWithTimestampIndication(now(), common::DataConstBuffer(frame_), std::move(sendPromise));
+        sentFrames_.fetch_add(1, std::memory_order_relaxed);
+        sentBytes_.fetch_add(frame_.size(), std::memory_order_relaxed);
+    }
+    else
+    {
+        skippedFrames_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    this->scheduleFrame();
+}
+
+void AVMediaSource::scheduleFrame()
+{
+    nextFrameTime_ += frameInterval_;
+
+    timer_.expires_at(nextFrameTime_);
+    timer_.async_wait(strand_.wrap([this, self = this->shared_from_this()](const asio::error_code& ec) {
+        if(!ec)
+        {
+            this->produceFrame();
+        }
+    }));
+}
+
+}
+}
+}
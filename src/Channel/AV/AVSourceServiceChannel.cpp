@@ -0,0 +1,133 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <aasdk_proto/ControlMessageIdsEnum.pb.h>
+#include <aasdk_proto/AVChannelMessageIdsEnum.pb.h>
+#include <aasdk/Channel/AV/IAVSourceServiceChannelEventHandler.hpp>
+#include <aasdk/Channel/AV/AVSourceServiceChannel.hpp>
+#include <aasdk/Common/Log.hpp>
+
+
+namespace aasdk
+{
+namespace channel
+{
+namespace av
+{
+
+AVSourceServiceChannel::AVSourceServiceChannel(asio::io_service::strand& strand, messenger::IMessenger::Pointer messenger, messenger::ChannelId channelId)
+    : ServiceChannel(strand, std::move(messenger), channelId)
+{
+
+}
+
+void AVSourceServiceChannel::receive(IAVSourceServiceChannelEventHandler::Pointer eventHandler)
+{
+    auto receivePromise = messenger::ReceivePromise::defer(strand_);
+    receivePromise->then([this, self = this->shared_from_this(), eventHandler](messenger::Message::Pointer message) {
+                           this->messageHandler(std::move(message), eventHandler);},
+                         std::bind(&IAVSourceServiceChannelEventHandler::onChannelError, eventHandler, std::placeholders::_1));
+
+    messenger_->enqueueReceive(channelId_, std::move(receivePromise));
+}
+
+messenger::ChannelId AVSourceServiceChannel::getId() const
+{
+    return channelId_;
+}
+
+void AVSourceServiceChannel::sendChannelOpenRequest(const proto::messages::ChannelOpenRequest& request, SendPromise::Pointer promise)
+{
+    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::CONTROL));
+    message->insertPayload(messenger::MessageId(proto::ids::ControlMessage::CHANNEL_OPEN_REQUEST).getData());
+    message->insertPayload(request);
+
+    this->send(std::move(message), std::move(promise));
+}
+
+void AVSourceServiceChannel::sendAVChannelSetupRequest(const proto::messages::AVChannelSetupRequest& request, SendPromise::Pointer promise)
+{
+    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
+    message->insertPayload(messenger::MessageId(proto::ids::AVChannelMessage::SETUP_REQUEST).getData());
+    message->insertPayload(request);
+
+    this->send(std::move(message), std::move(promise));
+}
+
+void AVSourceServiceChannel::sendAVChannelStartIndication(const proto::messages::AVChannelStartIndication& indication, SendPromise::Pointer promise)
+{
+    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
+    message->insertPayload(messenger::MessageId(proto::ids::AVChannelMessage::START_INDICATION).getData());
+    message->insertPayload(indication);
+
+    this->send(std::move(message), std::move(promise));
+}
+
+void AVSourceServiceChannel::sendAVChannelStopIndication(const proto::messages::AVChannelStopIndication& indication, SendPromise::Pointer promise)
+{
+    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
+    message->insertPayload(messenger::MessageId(proto::ids::AVChannelMessage::STOP_INDICATION).getData());
+    message->insertPayload(indication);
+
+    this->send(std::move(message), std::move(promise));
+}
+
+void AVSourceServiceChannel::sendAVMediaWithTimestampIndication(messenger::Timestamp::ValueType timestamp, const common::DataConstBuffer& buffer, SendPromise::Pointer promise)
+{
+    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
+    message->insertPayload(messenger::MessageId(proto::ids::AVChannelMessage::AV_MEDIA_WITH_TIMESTAMP_INDICATION).getData());
+    message->insertPayload(messenger::Timestamp(timestamp).getData());
+    message->insertPayload(buffer);
+
+    this->send(std::move(message), std::move(promise));
+}
+
+void AVSourceServiceChannel::sendAVMediaIndication(const common::DataConstBuffer& buffer, SendPromise::Pointer promise)
+{
+    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
+    message->insertPayload(messenger::MessageId(proto::ids::AVChannelMessage::AV_MEDIA_INDICATION).getData());
+    message->insertPayload(buffer);
+
+    this->send(std::move(message), std::move(promise));
+}
+
+void AVSourceServiceChannel::sendVideoFocusRequest(const proto::messages::VideoFocusRequest& request, SendPromise::Pointer promise)
+{
+    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
+    message->insertPayload(messenger::MessageId(proto::ids::AVChannelMessage::VIDEO_FOCUS_REQUEST).getData());
+    message->insertPayload(request);
+
+    this->send(std::move(message), std::move(promise));
+}
+
+void AVSourceServiceChannel::messageHandler(messenger::Message::Pointer message, IAVSourceServiceChannelEventHandler::Pointer eventHandler)
+{
+    this->traceMessage(*message);
+    messenger::MessageId messageId(message->getPayload());
+    common::DataConstBuffer payload(message->getPayload(), messageId.getSizeOf());
+
+    if(!dispatcher_.dispatch(*this, messageId.getId(), payload, eventHandler))
+    {
+        AASDK_LOG(error) << "[AVSourceServiceChannel] message not handled: " << messageId.getId();
+        this->receive(std::move(eventHandler));
+    }
+}
+
+}
+}
+}
@@ -0,0 +1,52 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <aasdk/Channel/AV/AVSync.hpp>
+
+
+namespace aasdk
+{
+namespace channel
+{
+namespace av
+{
+
+AVSync::AVSync(messenger::ClockSyncEstimator::Pointer clockSyncEstimator, Configuration configuration)
+    : clockSyncEstimator_(std::move(clockSyncEstimator))
+    , configuration_(std::move(configuration))
+{
+
+}
+
+AVSync::Clock::time_point AVSync::getAudioPresentationTime(messenger::Timestamp::ValueType timestamp) const
+{
+    return clockSyncEstimator_->toLocal(timestamp) + configuration_.presentationDelay - configuration_.audioOutputLatency;
+}
+
+AVSync::Clock::time_point AVSync::getVideoPresentationTime(messenger::Timestamp::ValueType timestamp) const
+{
+    return clockSyncEstimator_->toLocal(timestamp) + configuration_.presentationDelay - configuration_.videoOutputLatency;
+}
+
+AVSync::Clock::duration AVSync::getVideoLateness(messenger::Timestamp::ValueType timestamp, Clock::time_point now) const
+{
+    return now - this->getVideoPresentationTime(timestamp);
+}
+
+}
+}
+}
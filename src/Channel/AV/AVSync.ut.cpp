@@ -0,0 +1,52 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <boost/test/unit_test.hpp>
+#include <aasdk/Channel/AV/AVSync.hpp>
+
+
+namespace aasdk
+{
+namespace channel
+{
+namespace av
+{
+namespace ut
+{
+
+BOOST_AUTO_TEST_CASE(AVSync_PresentationTimes)
+{
+    typedef AVSync::Clock Clock;
+
+    auto clockSyncEstimator = std::make_shared<messenger::ClockSyncEstimator>();
+    clockSyncEstimator->onPingRequest(0, Clock::time_point(std::chrono::seconds(10)));
+
+    AVSync::Configuration configuration;
+    configuration.presentationDelay = std::chrono::milliseconds(100);
+    configuration.audioOutputLatency = std::chrono::milliseconds(40);
+    configuration.videoOutputLatency = std::chrono::milliseconds(16);
+    AVSync avSync(clockSyncEstimator, configuration);
+
+    BOOST_CHECK(avSync.getAudioPresentationTime(1000000) == Clock::time_point(std::chrono::milliseconds(11060)));
+    BOOST_CHECK(avSync.getVideoPresentationTime(1000000) == Clock::time_point(std::chrono::milliseconds(11084)));
+    BOOST_CHECK(avSync.getVideoLateness(1000000, Clock::time_point(std::chrono::milliseconds(11100))) == std::chrono::milliseconds(16));
+}
+
+}
+}
+}
+}
@@ -0,0 +1,168 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <cstring>
+#include <endian.h>
+#include <aasdk_proto/AVChannelMessageIdsEnum.pb.h>
+#include <aasdk/Channel/AV/AudioCaptureRing.hpp>
+
+
+namespace aasdk
+{
+namespace channel
+{
+namespace av
+{
+
+AudioCaptureRing::AudioCaptureRing(const proto::data::AudioConfig& audioConfig, Configuration configuration)
+    : slots_(std::max<size_t>(configuration.slotCount, 1))
+    , fillIndex_(0)
+    , fillOffset_(0)
+    , popIndex_(0)
+    , completedChunks_(0)
+    , droppedBytes_(0)
+{
+    const size_t frameSize = std::max<size_t>(audioConfig.channel_count() * audioConfig.bit_depth() / 8, 1);
+    const size_t frames = static_cast<size_t>(audioConfig.sample_rate()) * configuration.chunkDuration.count() / 1000;
+    chunkSize_ = std::max<size_t>(frames, 1) * frameSize;
+
+    const uint16_t messageId = htobe16(proto::ids::AVChannelMessage::AV_MEDIA_WITH_TIMESTAMP_INDICATION);
+
+    for(auto& slot : slots_)
+    {
+        slot.message = std::make_shared<messenger::Message>(messenger::ChannelId::AV_INPUT, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC);
+        slot.message->getPayload().resize(cHeaderSize + chunkSize_);
+        std::memcpy(slot.message->getPayload().data(), &messageId, sizeof(messageId));
+        slot.state = SlotState::FREE;
+    }
+}
+
+common::DataBuffer AudioCaptureRing::fill()
+{
+    auto& slot = slots_[fillIndex_];
+
+    if(slot.state.load(std::memory_order_acquire) != SlotState::FREE)
+    {
+        return common::DataBuffer();
+    }
+
+    return common::DataBuffer(slot.message->getPayload(), cHeaderSize + fillOffset_);
+}
+
+bool AudioCaptureRing::commit(size_t size, messenger::Timestamp::ValueType timestamp)
+{
+    auto& slot = slots_[fillIndex_];
+    auto& payload = slot.message->getPayload();
+
+    // A commit without a free slot would write into a message that is still queued for sending.
+    if(slot.state.load(std::memory_order_acquire) != SlotState::FREE)
+    {
+        droppedBytes_.fetch_add(size, std::memory_order_relaxed);
+        return false;
+    }
+
+    if(fillOffset_ == 0)
+    {
+        const auto timestampBig = htobe64(timestamp);
+        std::memcpy(&payload[sizeof(uint16_t)], &timestampBig, sizeof(timestampBig));
+    }
+
+    fillOffset_ = std::min(fillOffset_ + size, chunkSize_);
+
+    if(fillOffset_ < chunkSize_)
+    {
+        return false;
+    }
+
+    slot.state.store(SlotState::READY, std::memory_order_release);
+    fillIndex_ = (fillIndex_ + 1) % slots_.size();
+    fillOffset_ = 0;
+    completedChunks_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+size_t AudioCaptureRing::write(const common::DataConstBuffer& buffer, messenger::Timestamp::ValueType timestamp)
+{
+    size_t completed = 0;
+    size_t offset = 0;
+
+    while(offset < buffer.size)
+    {
+        auto target = this->fill();
+
+        if(target.size == 0)
+        {
+            droppedBytes_.fetch_add(buffer.size - offset, std::memory_order_relaxed);
+            break;
+        }
+
+        const auto size = std::min(target.size, buffer.size - offset);
+        std::memcpy(target.data, buffer.cdata + offset, size);
+        offset += size;
+
+        if(this->commit(size, timestamp))
+        {
+            ++completed;
+        }
+    }
+
+    return completed;
+}
+
+messenger::Message::Pointer AudioCaptureRing::pop()
+{
+    auto& slot = slots_[popIndex_];
+
+    if(slot.state.load(std::memory_order_acquire) != SlotState::READY)
+    {
+        return nullptr;
+    }
+
+    slot.state.store(SlotState::SENDING, std::memory_order_relaxed);
+    popIndex_ = (popIndex_ + 1) % slots_.size();
+    return slot.message;
+}
+
+void AudioCaptureRing::release(const messenger::Message::Pointer& message)
+{
+    for(auto& slot : slots_)
+    {
+        if(slot.message == message)
+        {
+            slot.state.store(SlotState::FREE, std::memory_order_release);
+            return;
+        }
+    }
+}
+
+size_t AudioCaptureRing::getChunkSize() const
+{
+    return chunkSize_;
+}
+
+AudioCaptureRing::Statistics AudioCaptureRing::getStatistics() const
+{
+    Statistics statistics;
+    statistics.completedChunks = completedChunks_.load(std::memory_order_relaxed);
+    statistics.droppedBytes = droppedBytes_.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+}
+}
+}
@@ -0,0 +1,109 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <boost/test/unit_test.hpp>
+#include <aasdk_proto/AVChannelMessageIdsEnum.pb.h>
+#include <aasdk/Channel/AV/AudioCaptureRing.hpp>
+
+
+namespace aasdk
+{
+namespace channel
+{
+namespace av
+{
+namespace ut
+{
+
+class AudioCaptureRingUnitTest
+{
+protected:
+    AudioCaptureRingUnitTest()
+    {
+        audioConfig_.set_sample_rate(16000);
+        audioConfig_.set_bit_depth(16);
+        audioConfig_.set_channel_count(1);
+
+        configuration_.chunkDuration = std::chrono::milliseconds(10);
+        configuration_.slotCount = 2;
+    }
+
+    proto::data::AudioConfig audioConfig_;
+    AudioCaptureRing::Configuration configuration_;
+};
+
+BOOST_FIXTURE_TEST_CASE(AudioCaptureRing_CompleteChunk, AudioCaptureRingUnitTest)
+{
+    AudioCaptureRing captureRing(audioConfig_, configuration_);
+    BOOST_CHECK_EQUAL(captureRing.getChunkSize(), 320u);
+
+    const common::Data pcm(200, 0x5A);
+    BOOST_CHECK_EQUAL(captureRing.write(common::DataConstBuffer(pcm), 0x0102030405060708), 0u);
+    BOOST_CHECK(captureRing.pop() == nullptr);
+
+    // The second write completes the first chunk and starts the next one.
+    BOOST_CHECK_EQUAL(captureRing.write(common::DataConstBuffer(pcm), 0x1111111111111111), 1u);
+
+    const auto message = captureRing.pop();
+    BOOST_REQUIRE(message != nullptr);
+    BOOST_CHECK(message->getChannelId() == messenger::ChannelId::AV_INPUT);
+
+    const auto& payload = message->getPayload();
+    BOOST_REQUIRE_EQUAL(payload.size(), 330u);
+    const messenger::MessageId messageId(payload);
+    BOOST_CHECK_EQUAL(messageId.getId(), proto::ids::AVChannelMessage::AV_MEDIA_WITH_TIMESTAMP_INDICATION);
+    const messenger::Timestamp timestamp(common::DataConstBuffer(payload, sizeof(uint16_t)));
+    BOOST_CHECK_EQUAL(timestamp.getValue(), 0x0102030405060708u);
+    BOOST_CHECK(std::all_of(payload.begin() + 10, payload.end(), [](auto byte) { return byte == 0x5A; }));
+
+    BOOST_CHECK(captureRing.pop() == nullptr);
+}
+
+BOOST_FIXTURE_TEST_CASE(AudioCaptureRing_DropWhileSlotsAreInFlight, AudioCaptureRingUnitTest)
+{
+    AudioCaptureRing captureRing(audioConfig_, configuration_);
+    const common::Data pcm(captureRing.getChunkSize(), 0x5A);
+
+    BOOST_CHECK_EQUAL(captureRing.write(common::DataConstBuffer(pcm), 1), 1u);
+    BOOST_CHECK_EQUAL(captureRing.write(common::DataConstBuffer(pcm), 2), 1u);
+    BOOST_CHECK_EQUAL(captureRing.write(common::DataConstBuffer(pcm), 3), 0u);
+    BOOST_CHECK(captureRing.fill().size == 0);
+    BOOST_CHECK_EQUAL(captureRing.getStatistics().droppedBytes, pcm.size());
+
+    // Committing into a slot which is not free must not complete it again.
+    BOOST_CHECK(!captureRing.commit(pcm.size(), 5));
+    BOOST_CHECK_EQUAL(captureRing.getStatistics().droppedBytes, 2 * pcm.size());
+
+    const auto first = captureRing.pop();
+    BOOST_REQUIRE(first != nullptr);
+    BOOST_CHECK(captureRing.fill().size == 0);
+
+    // A released slot is captured into again, the message object is reused.
+    captureRing.release(first);
+    BOOST_CHECK_EQUAL(captureRing.fill().size, pcm.size());
+    BOOST_CHECK_EQUAL(captureRing.write(common::DataConstBuffer(pcm), 4), 1u);
+
+    BOOST_CHECK(captureRing.pop() != first);
+    BOOST_CHECK(captureRing.pop() == first);
+    BOOST_CHECK_EQUAL(captureRing.getStatistics().completedChunks, 3u);
+    BOOST_CHECK_EQUAL(captureRing.getStatistics().droppedBytes, 2 * pcm.size());
+}
+
+}
+}
+}
+}
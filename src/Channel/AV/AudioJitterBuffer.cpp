@@ -0,0 +1,214 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <aasdk/Channel/AV/AudioJitterBuffer.hpp>
+
+
+namespace aasdk
+{
+namespace channel
+{
+namespace av
+{
+
+namespace
+{
+
+// Timestamps further apart than this belong to a new stream, not to jitter.
+constexpr int64_t cMaxTimestampGapMicroseconds = 1000 * 1000;
+
+}
+
+AudioJitterBuffer::AudioJitterBuffer(Configuration configuration)
+    : configuration_(std::move(configuration))
+    , frameSize_(std::max<size_t>(configuration_.channelCount * configuration_.bitsPerSample / 8, 1))
+    , writeIndex_(0)
+    , readIndex_(0)
+    , targetDepth_(0)
+    , isResetRequested_(false)
+    , hasPreviousArrival_(false)
+    , previousTimestamp_(0)
+    , jitter_(0)
+    , jitterMicroseconds_(0)
+    , isPrebuffering_(true)
+    , pushedBytes_(0)
+    , pulledBytes_(0)
+    , underruns_(0)
+    , overflowBytes_(0)
+    , skippedBytes_(0)
+{
+    data_.resize(std::max(this->toBytes(configuration_.capacity), frameSize_));
+    targetDepth_ = this->toBytes(configuration_.minDepth);
+}
+
+void AudioJitterBuffer::push(messenger::Timestamp::ValueType timestamp, const common::DataConstBuffer& buffer)
+{
+    this->updateJitter(timestamp);
+    this->write(buffer);
+}
+
+void AudioJitterBuffer::push(const common::DataConstBuffer& buffer)
+{
+    this->write(buffer);
+}
+
+void AudioJitterBuffer::reset()
+{
+    hasPreviousArrival_ = false;
+    isResetRequested_.store(true, std::memory_order_release);
+}
+
+size_t AudioJitterBuffer::pull(common::DataBuffer buffer)
+{
+    auto readIndex = readIndex_.load(std::memory_order_relaxed);
+
+    if(isResetRequested_.exchange(false, std::memory_order_acquire))
+    {
+        readIndex = writeIndex_.load(std::memory_order_acquire);
+        readIndex_.store(readIndex, std::memory_order_release);
+        isPrebuffering_ = true;
+    }
+
+    const auto available = static_cast<size_t>(writeIndex_.load(std::memory_order_acquire) - readIndex);
+    const auto targetDepth = targetDepth_.load(std::memory_order_relaxed);
+    size_t size = 0;
+
+    if(isPrebuffering_ && available >= std::max(targetDepth, frameSize_))
+    {
+        isPrebuffering_ = false;
+    }
+
+    if(!isPrebuffering_)
+    {
+        auto playable = available;
+
+        if(playable > 2 * targetDepth + buffer.size)
+        {
+            const auto skipped = this->alignToFrame(playable - targetDepth - buffer.size);
+            readIndex += skipped;
+            playable -= skipped;
+            skippedBytes_.fetch_add(skipped, std::memory_order_relaxed);
+        }
+
+        size = this->alignToFrame(std::min(playable, buffer.size));
+        this->read(readIndex, buffer.data, size);
+        readIndex_.store(readIndex + size, std::memory_order_release);
+        pulledBytes_.fetch_add(size, std::memory_order_relaxed);
+
+        if(size < buffer.size)
+        {
+            underruns_.fetch_add(1, std::memory_order_relaxed);
+            isPrebuffering_ = true;
+        }
+    }
+
+    std::memset(buffer.data + size, 0, buffer.size - size);
+    return size;
+}
+
+std::chrono::microseconds AudioJitterBuffer::getJitter() const
+{
+    return std::chrono::microseconds(jitterMicroseconds_.load(std::memory_order_relaxed));
+}
+
+std::chrono::microseconds AudioJitterBuffer::getTargetDepth() const
+{
+    const auto bytesPerSecond = static_cast<uint64_t>(configuration_.sampleRate) * frameSize_;
+    return std::chrono::microseconds(bytesPerSecond == 0 ? 0 : targetDepth_.load(std::memory_order_relaxed) * 1000000 / bytesPerSecond);
+}
+
+AudioJitterBuffer::Statistics AudioJitterBuffer::getStatistics() const
+{
+    Statistics statistics;
+    statistics.pushedBytes = pushedBytes_.load(std::memory_order_relaxed);
+    statistics.pulledBytes = pulledBytes_.load(std::memory_order_relaxed);
+    statistics.underruns = underruns_.load(std::memory_order_relaxed);
+    statistics.overflowBytes = overflowBytes_.load(std::memory_order_relaxed);
+    statistics.skippedBytes = skippedBytes_.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+void AudioJitterBuffer::write(const common::DataConstBuffer& buffer)
+{
+    const auto writeIndex = writeIndex_.load(std::memory_order_relaxed);
+    const auto used = static_cast<size_t>(writeIndex - readIndex_.load(std::memory_order_acquire));
+
+    if(buffer.size > data_.size() - used)
+    {
+        overflowBytes_.fetch_add(buffer.size, std::memory_order_relaxed);
+        return;
+    }
+
+    const auto offset = static_cast<size_t>(writeIndex % data_.size());
+    const auto head = std::min(buffer.size, data_.size() - offset);
+    std::memcpy(&data_[offset], buffer.cdata, head);
+    std::memcpy(&data_[0], buffer.cdata + head, buffer.size - head);
+
+    writeIndex_.store(writeIndex + buffer.size, std::memory_order_release);
+    pushedBytes_.fetch_add(buffer.size, std::memory_order_relaxed);
+}
+
+void AudioJitterBuffer::read(uint64_t readIndex, common::Data::value_type* data, size_t size)
+{
+    const auto offset = static_cast<size_t>(readIndex % data_.size());
+    const auto head = std::min(size, data_.size() - offset);
+    std::memcpy(data, &data_[offset], head);
+    std::memcpy(data + head, &data_[0], size - head);
+}
+
+void AudioJitterBuffer::updateJitter(messenger::Timestamp::ValueType timestamp)
+{
+    const auto arrival = Clock::now();
+
+    if(hasPreviousArrival_)
+    {
+        const auto timestampDelta = static_cast<int64_t>(timestamp - previousTimestamp_);
+
+        if(timestampDelta >= 0 && timestampDelta <= cMaxTimestampGapMicroseconds)
+        {
+            const auto arrivalDelta = std::chrono::duration_cast<std::chrono::microseconds>(arrival - previousArrival_).count();
+            jitter_ += (std::abs(static_cast<double>(arrivalDelta - timestampDelta)) - jitter_) / 16;
+
+            const auto depth = std::min(configuration_.minDepth + std::chrono::microseconds(static_cast<int64_t>(3 * jitter_)),
+                                        std::chrono::duration_cast<std::chrono::microseconds>(configuration_.maxDepth));
+            targetDepth_.store(this->toBytes(depth), std::memory_order_relaxed);
+            jitterMicroseconds_.store(static_cast<int64_t>(jitter_), std::memory_order_relaxed);
+        }
+    }
+
+    hasPreviousArrival_ = true;
+    previousArrival_ = arrival;
+    previousTimestamp_ = timestamp;
+}
+
+size_t AudioJitterBuffer::toBytes(std::chrono::microseconds duration) const
+{
+    const auto frames = static_cast<uint64_t>(std::max<int64_t>(duration.count(), 0)) * configuration_.sampleRate / 1000000;
+    return static_cast<size_t>(frames * frameSize_);
+}
+
+size_t AudioJitterBuffer::alignToFrame(size_t size) const
+{
+    return size - size % frameSize_;
+}
+
+}
+}
+}
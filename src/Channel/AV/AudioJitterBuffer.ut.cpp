@@ -0,0 +1,129 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <boost/test/unit_test.hpp>
+#include <aasdk/Channel/AV/AudioJitterBuffer.hpp>
+
+
+namespace aasdk
+{
+namespace channel
+{
+namespace av
+{
+namespace ut
+{
+
+class AudioJitterBufferUnitTest
+{
+protected:
+    AudioJitterBufferUnitTest()
+        : output_(10, 0xFF)
+    {
+        // One byte per millisecond keeps the depths easy to follow.
+        configuration_.sampleRate = 1000;
+        configuration_.channelCount = 1;
+        configuration_.bitsPerSample = 8;
+        configuration_.minDepth = std::chrono::milliseconds(20);
+        configuration_.maxDepth = std::chrono::milliseconds(40);
+        configuration_.capacity = std::chrono::milliseconds(100);
+        jitterBuffer_ = std::make_shared<AudioJitterBuffer>(configuration_);
+    }
+
+    size_t pull()
+    {
+        return jitterBuffer_->pull(common::DataBuffer(output_));
+    }
+
+    AudioJitterBuffer::Configuration configuration_;
+    AudioJitterBuffer::Pointer jitterBuffer_;
+    common::Data output_;
+};
+
+BOOST_FIXTURE_TEST_CASE(AudioJitterBuffer_PrebufferAndUnderrun, AudioJitterBufferUnitTest)
+{
+    const common::Data chunk(10, 0x11);
+
+    jitterBuffer_->push(common::DataConstBuffer(chunk));
+    BOOST_CHECK_EQUAL(this->pull(), 0u);
+    BOOST_CHECK(output_ == common::Data(10, 0x00));
+
+    jitterBuffer_->push(common::DataConstBuffer(chunk));
+    BOOST_CHECK_EQUAL(this->pull(), 10u);
+    BOOST_CHECK(output_ == chunk);
+    BOOST_CHECK_EQUAL(this->pull(), 10u);
+
+    // Running dry pads with silence and waits for the target depth again.
+    BOOST_CHECK_EQUAL(this->pull(), 0u);
+    jitterBuffer_->push(common::DataConstBuffer(chunk));
+    BOOST_CHECK_EQUAL(this->pull(), 0u);
+
+    const auto statistics = jitterBuffer_->getStatistics();
+    BOOST_CHECK_EQUAL(statistics.pushedBytes, 30u);
+    BOOST_CHECK_EQUAL(statistics.pulledBytes, 20u);
+    BOOST_CHECK_EQUAL(statistics.underruns, 1u);
+}
+
+BOOST_FIXTURE_TEST_CASE(AudioJitterBuffer_SkipExcessAndOverflow, AudioJitterBufferUnitTest)
+{
+
+    common::Data data(90);
+    for(size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<common::Data::value_type>(i);
+    }
+
+    jitterBuffer_->push(common::DataConstBuffer(data));
+    jitterBuffer_->push(common::DataConstBuffer(data));
+
+    // 90 ms buffered against a 20 ms target: the oldest 60 ms are skipped.
+    BOOST_CHECK_EQUAL(this->pull(), 10u);
+    BOOST_CHECK_EQUAL(output_[0], 60);
+
+    const auto statistics = jitterBuffer_->getStatistics();
+    BOOST_CHECK_EQUAL(statistics.overflowBytes, 90u);
+    BOOST_CHECK_EQUAL(statistics.skippedBytes, 60u);
+}
+
+BOOST_FIXTURE_TEST_CASE(AudioJitterBuffer_Reset, AudioJitterBufferUnitTest)
+{
+    const common::Data chunk(30, 0x11);
+
+    jitterBuffer_->push(common::DataConstBuffer(chunk));
+    jitterBuffer_->reset();
+    BOOST_CHECK_EQUAL(this->pull(), 0u);
+}
+
+BOOST_FIXTURE_TEST_CASE(AudioJitterBuffer_AdaptToJitter, AudioJitterBufferUnitTest)
+{
+    const common::Data chunk(20, 0x11);
+    BOOST_CHECK(jitterBuffer_->getTargetDepth() == std::chrono::milliseconds(20));
+
+    // Chunks 20 ms apart in media time arrive in one burst.
+    for(messenger::Timestamp::ValueType timestamp = 0; timestamp < 2000000; timestamp += 20000)
+    {
+        jitterBuffer_->push(timestamp, common::DataConstBuffer(chunk));
+    }
+
+    BOOST_CHECK(jitterBuffer_->getJitter() > std::chrono::milliseconds(10));
+    BOOST_CHECK(jitterBuffer_->getTargetDepth() == std::chrono::milliseconds(40));
+}
+
+}
+}
+}
+}
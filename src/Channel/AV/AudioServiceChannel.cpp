@@ -53,6 +53,16 @@ messenger::ChannelId AudioServiceChannel::getId() const
     return channelId_;
 }
 
+void AudioServiceChannel::setJitterBuffer(AudioJitterBuffer::Pointer jitterBuffer)
+{
+    jitterBuffer_ = std::move(jitterBuffer);
+}
+
+void AudioServiceChannel::setAckEngine(AVMediaAckEngine::Pointer ackEngine)
+{
+    ackEngine_ = std::move(ackEngine);
+}
+
 void AudioServiceChannel::sendChannelOpenResponse(const proto::messages::ChannelOpenResponse& response, SendPromise::Pointer promise)
 {
     auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::CONTROL));
@@ -64,6 +74,8 @@ void AudioServiceChannel::sendChannelOpenResponse(const proto::messages::Channel
 
 void AudioServiceChannel::sendAVChannelSetupResponse(const proto::messages::AVChannelSetupResponse& response, SendPromise::Pointer promise)
 {
+    maxUnacked_ = response.max_unacked();
+
     auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
     message->insertPayload(messenger::MessageId(proto::ids::AVChannelMessage::SETUP_RESPONSE).getData());
     message->insertPayload(response);
@@ -82,86 +94,66 @@ void AudioServiceChannel::sendAVMediaAckIndication(const proto::messages::AVMedi
 
 void AudioServiceChannel::messageHandler(messenger::Message::Pointer message, IAudioServiceChannelEventHandler::Pointer eventHandler)
 {
+    this->traceMessage(*message);
     messenger::MessageId messageId(message->getPayload());
     common::DataConstBuffer payload(message->getPayload(), messageId.getSizeOf());
 
     switch(messageId.getId())
     {
-    case proto::ids::AVChannelMessage::SETUP_REQUEST:
-        this->handleAVChannelSetupRequest(payload, std::move(eventHandler));
-        break;
-    case proto::ids::AVChannelMessage::START_INDICATION:
-        this->handleStartIndication(payload, std::move(eventHandler));
-        break;
-    case proto::ids::AVChannelMessage::STOP_INDICATION:
-        this->handleStopIndication(payload, std::move(eventHandler));
-        break;
     case proto::ids::AVChannelMessage::AV_MEDIA_WITH_TIMESTAMP_INDICATION:
+        if(ackEngine_ != nullptr)
+        {
+            ackEngine_->onMediaReceived();
+        }
+
         this->handleAVMediaWithTimestampIndication(payload, std::move(eventHandler));
         break;
     case proto::ids::AVChannelMessage::AV_MEDIA_INDICATION:
+        if(ackEngine_ != nullptr)
+        {
+            ackEngine_->onMediaReceived();
+        }
+
+        if(jitterBuffer_ != nullptr)
+        {
+            jitterBuffer_->push(payload);
+        }
+
         eventHandler->onAVMediaIndication(payload);
         break;
-    case proto::ids::ControlMessage::CHANNEL_OPEN_REQUEST:
-        this->handleChannelOpenRequest(payload, std::move(eventHandler));
-        break;
     default:
-        AASDK_LOG(error) << "[AudioServiceChannel] message not handled: " << messageId.getId();
-        this->receive(std::move(eventHandler));
+        if(!dispatcher_.dispatch(*this, messageId.getId(), payload, eventHandler))
+        {
+            AASDK_LOG(error) << "[AudioServiceChannel] message not handled: " << messageId.getId();
+            this->receive(std::move(eventHandler));
+        }
         break;
     }
 }
 
-void AudioServiceChannel::handleAVChannelSetupRequest(const common::DataConstBuffer& payload, IAudioServiceChannelEventHandler::Pointer eventHandler)
+void AudioServiceChannel::handleStartIndication(const proto::messages::AVChannelStartIndication& indication, IAudioServiceChannelEventHandler::Pointer eventHandler)
 {
-    proto::messages::AVChannelSetupRequest request;
-    if(request.ParseFromArray(payload.cdata, payload.size))
-    {
-        eventHandler->onAVChannelSetupRequest(request);
-    }
-    else
+    if(ackEngine_ != nullptr)
     {
-        eventHandler->onChannelError(error::Error(error::ErrorCode::PARSE_PAYLOAD));
+        ackEngine_->start(indication.session(), maxUnacked_);
     }
-}
 
-void AudioServiceChannel::handleStartIndication(const common::DataConstBuffer& payload, IAudioServiceChannelEventHandler::Pointer eventHandler)
-{
-    proto::messages::AVChannelStartIndication indication;
-    if(indication.ParseFromArray(payload.cdata, payload.size))
-    {
-        eventHandler->onAVChannelStartIndication(indication);
-    }
-    else
-    {
-        eventHandler->onChannelError(error::Error(error::ErrorCode::PARSE_PAYLOAD));
-    }
+    eventHandler->onAVChannelStartIndication(indication);
 }
 
-void AudioServiceChannel::handleStopIndication(const common::DataConstBuffer& payload, IAudioServiceChannelEventHandler::Pointer eventHandler)
+void AudioServiceChannel::handleStopIndication(const proto::messages::AVChannelStopIndication& indication, IAudioServiceChannelEventHandler::Pointer eventHandler)
 {
-    proto::messages::AVChannelStopIndication indication;
-    if(indication.ParseFromArray(payload.cdata, payload.size))
+    if(jitterBuffer_ != nullptr)
     {
-        eventHandler->onAVChannelStopIndication(indication);
-    }
-    else
-    {
-        eventHandler->onChannelError(error::Error(error::ErrorCode::PARSE_PAYLOAD));
+        jitterBuffer_->reset();
     }
-}
 
-void AudioServiceChannel::handleChannelOpenRequest(const common::DataConstBuffer& payload, IAudioServiceChannelEventHandler::Pointer eventHandler)
-{
-    proto::messages::ChannelOpenRequest request;
-    if(request.ParseFromArray(payload.cdata, payload.size))
+    if(ackEngine_ != nullptr)
     {
-        eventHandler->onChannelOpenRequest(request);
-    }
-    else
-    {
-        eventHandler->onChannelError(error::Error(error::ErrorCode::PARSE_PAYLOAD));
+        ackEngine_->stop();
     }
+
+    eventHandler->onAVChannelStopIndication(indication);
 }
 
 void AudioServiceChannel::handleAVMediaWithTimestampIndication(const common::DataConstBuffer& payload, IAudioServiceChannelEventHandler::Pointer eventHandler)
@@ -169,7 +161,14 @@ void AudioServiceChannel::handleAVMediaWithTimestampIndication(const common::Dat
     if(payload.size >= sizeof(messenger::Timestamp::ValueType))
     {
         messenger::Timestamp timestamp(payload);
-        eventHandler->onAVMediaWithTimestampIndication(timestamp.getValue(), common::DataConstBuffer(payload.cdata, payload.size, sizeof(messenger::Timestamp::ValueType)));
+        common::DataConstBuffer buffer(payload.cdata, payload.size, sizeof(messenger::Timestamp::ValueType));
+
+        if(jitterBuffer_ != nullptr)
+        {
+            jitterBuffer_->push(timestamp.getValue(), buffer);
+        }
+
+        eventHandler->onAVMediaWithTimestampIndication(timestamp.getValue(), buffer);
     }
     else
     {
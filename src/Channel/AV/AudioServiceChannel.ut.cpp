@@ -0,0 +1,153 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <boost/test/unit_test.hpp>
+#include <aasdk_proto/AVChannelMessageIdsEnum.pb.h>
+#include <aasdk_proto/AVMediaAckIndicationMessage.pb.h>
+#include <Messenger/UT/Messenger.mock.hpp>
+#include <Channel/AV/UT/AudioServiceChannelEventHandler.mock.hpp>
+#include <aasdk/Channel/AV/AudioServiceChannel.hpp>
+
+
+namespace aasdk
+{
+namespace channel
+{
+namespace av
+{
+namespace ut
+{
+
+using ::testing::_;
+using ::testing::NiceMock;
+using ::testing::SaveArg;
+
+class AudioServiceChannelUnitTest
+{
+protected:
+    AudioServiceChannelUnitTest()
+        : strand_(ioService_)
+        , messengerMock_(std::make_shared<NiceMock<messenger::ut::MessengerMock>>())
+        , eventHandlerMock_(std::make_shared<NiceMock<AudioServiceChannelEventHandlerMock>>())
+        , channel_(std::make_shared<AudioServiceChannel>(strand_, messengerMock_, messenger::ChannelId::MEDIA_AUDIO))
+    {
+        ON_CALL(*messengerMock_, enqueueReceive(messenger::ChannelId::MEDIA_AUDIO, _)).WillByDefault(SaveArg<1>(&receivePromise_));
+        ON_CALL(*messengerMock_, enqueueSend(_, _)).WillByDefault(::testing::Invoke(
+            [this](messenger::Message::Pointer message, messenger::SendPromise::Pointer promise) {
+                messenger::MessageId messageId(message->getPayload());
+                if(messageId.getId() == proto::ids::AVChannelMessage::AV_MEDIA_ACK_INDICATION)
+                {
+                    proto::messages::AVMediaAckIndication indication;
+                    indication.ParseFromArray(message->getPayload().data() + messageId.getSizeOf(), message->getPayload().size() - messageId.getSizeOf());
+                    acks_.push_back(indication);
+                }
+
+                promise->resolve();
+            }));
+    }
+
+    void deliver(uint16_t id, const google::protobuf::Message& indication)
+    {
+        auto message = std::make_shared<messenger::Message>(messenger::ChannelId::MEDIA_AUDIO, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC);
+        message->insertPayload(messenger::MessageId(id).getData());
+        message->insertPayload(indication);
+        this->deliver(std::move(message));
+    }
+
+    void deliverMedia(messenger::Timestamp::ValueType timestamp, const common::Data& samples)
+    {
+        auto message = std::make_shared<messenger::Message>(messenger::ChannelId::MEDIA_AUDIO, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC);
+        message->insertPayload(messenger::MessageId(proto::ids::AVChannelMessage::AV_MEDIA_WITH_TIMESTAMP_INDICATION).getData());
+        message->insertPayload(messenger::Timestamp(timestamp).getData());
+        message->insertPayload(samples);
+        this->deliver(std::move(message));
+    }
+
+    void deliver(messenger::Message::Pointer message)
+    {
+        channel_->receive(eventHandlerMock_);
+        receivePromise_->resolve(std::move(message));
+        this->run();
+    }
+
+    void run()
+    {
+        ioService_.run();
+        ioService_.reset();
+    }
+
+    asio::io_service ioService_;
+    asio::io_service::strand strand_;
+    std::shared_ptr<NiceMock<messenger::ut::MessengerMock>> messengerMock_;
+    std::shared_ptr<NiceMock<AudioServiceChannelEventHandlerMock>> eventHandlerMock_;
+    std::shared_ptr<AudioServiceChannel> channel_;
+    messenger::ReceivePromise::Pointer receivePromise_;
+    std::vector<proto::messages::AVMediaAckIndication> acks_;
+};
+
+BOOST_FIXTURE_TEST_CASE(AudioServiceChannel_AckEngineFollowsSession, AudioServiceChannelUnitTest)
+{
+    auto ackEngine = std::make_shared<AVMediaAckEngine>(ioService_, channel_);
+    channel_->setAckEngine(ackEngine);
+
+    proto::messages::AVChannelSetupResponse response;
+    response.set_media_status(proto::enums::AVChannelSetupStatus::OK);
+    response.set_max_unacked(2);
+    channel_->sendAVChannelSetupResponse(response, SendPromise::defer(ioService_));
+
+    proto::messages::AVChannelStartIndication startIndication;
+    startIndication.set_session(9);
+    startIndication.set_config(0);
+
+    EXPECT_CALL(*eventHandlerMock_, onAVChannelStartIndication(_));
+    EXPECT_CALL(*eventHandlerMock_, onAVMediaWithTimestampIndication(_, _)).Times(3);
+    EXPECT_CALL(*eventHandlerMock_, onAVChannelStopIndication(_));
+
+    this->deliver(proto::ids::AVChannelMessage::START_INDICATION, startIndication);
+    this->deliverMedia(1000, common::Data(32, 0x01));
+    this->deliverMedia(2000, common::Data(32, 0x02));
+
+    // The whole window of two is in use, so a single release is acknowledged right away.
+    ackEngine->release();
+    this->run();
+
+    BOOST_REQUIRE_EQUAL(acks_.size(), 1u);
+    BOOST_CHECK_EQUAL(acks_[0].session(), 9);
+    BOOST_CHECK_EQUAL(acks_[0].value(), 1u);
+
+    this->deliver(proto::ids::AVChannelMessage::STOP_INDICATION, proto::messages::AVChannelStopIndication());
+    this->deliverMedia(3000, common::Data(32, 0x03));
+    ackEngine->release();
+    this->run();
+
+    BOOST_CHECK_EQUAL(acks_.size(), 1u);
+    BOOST_CHECK_EQUAL(ackEngine->getStatistics().receivedFrames, 2u);
+}
+
+BOOST_FIXTURE_TEST_CASE(AudioServiceChannel_AckEngineDoesNotKeepChannelAlive, AudioServiceChannelUnitTest)
+{
+    std::weak_ptr<AudioServiceChannel> channel(channel_);
+    channel_->setAckEngine(std::make_shared<AVMediaAckEngine>(ioService_, channel_));
+    channel_.reset();
+
+    BOOST_CHECK(channel.expired());
+}
+
+}
+}
+}
+}
@@ -0,0 +1,139 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <aasdk/Channel/AV/H264AccessUnitAssembler.hpp>
+#include <aasdk/Channel/AV/StartCodeScanner.hpp>
+
+
+namespace aasdk
+{
+namespace channel
+{
+namespace av
+{
+
+namespace
+{
+
+const common::Data cStartCode{0x00, 0x00, 0x00, 0x01};
+
+bool isSlice(H264NalUnitType type)
+{
+    return type >= H264NalUnitType::NON_IDR_SLICE && type <= H264NalUnitType::IDR_SLICE;
+}
+
+}
+
+H264AccessUnitAssembler::H264AccessUnitAssembler()
+{
+    accessUnit_.nalUnits.reserve(8);
+}
+
+const H264AccessUnit& H264AccessUnitAssembler::assemble(messenger::Timestamp::ValueType timestamp, const common::DataConstBuffer& buffer)
+{
+    this->parse(buffer);
+    accessUnit_.timestamp = timestamp;
+    accessUnit_.hasTimestamp = true;
+    return accessUnit_;
+}
+
+const H264AccessUnit& H264AccessUnitAssembler::assemble(const common::DataConstBuffer& buffer)
+{
+    this->parse(buffer);
+    accessUnit_.timestamp = 0;
+    accessUnit_.hasTimestamp = false;
+    return accessUnit_;
+}
+
+const common::Data& H264AccessUnitAssembler::getCodecConfig() const
+{
+    return codecConfig_;
+}
+
+void H264AccessUnitAssembler::parse(const common::DataConstBuffer& buffer)
+{
+    accessUnit_.data = buffer;
+    accessUnit_.nalUnits.clear();
+
+    const auto end = buffer.cdata + buffer.size;
+    auto startCode = findStartCode(buffer.cdata, end);
+
+    while(startCode != end)
+    {
+        const auto begin = startCode + 3;
+        startCode = findStartCode(begin, end);
+
+        // Drops the leading zero of a four byte start code and any trailing_zero_8bits.
+        auto nalEnd = startCode;
+        while(nalEnd > begin && nalEnd[-1] == 0)
+        {
+            --nalEnd;
+        }
+
+        if(nalEnd > begin)
+        {
+            accessUnit_.nalUnits.push_back(H264NalUnit{static_cast<H264NalUnitType>(begin[0] & 0x1F),
+                                                       static_cast<uint8_t>((begin[0] >> 5) & 0x03),
+                                                       common::DataConstBuffer(begin, nalEnd - begin)});
+        }
+    }
+
+    bool hasSlice = false;
+    bool hasParameterSet = false;
+    bool isReference = false;
+    accessUnit_.isKeyFrame = false;
+
+    for(const auto& nalUnit : accessUnit_.nalUnits)
+    {
+        if(isSlice(nalUnit.type))
+        {
+            hasSlice = true;
+            isReference = isReference || nalUnit.refIdc != 0;
+            accessUnit_.isKeyFrame = accessUnit_.isKeyFrame || nalUnit.type == H264NalUnitType::IDR_SLICE;
+        }
+        else if(nalUnit.type == H264NalUnitType::SPS || nalUnit.type == H264NalUnitType::PPS)
+        {
+            hasParameterSet = true;
+        }
+    }
+
+    accessUnit_.isCodecConfig = hasParameterSet && !hasSlice;
+    accessUnit_.isDroppable = hasSlice && !isReference;
+
+    if(hasParameterSet)
+    {
+        this->updateCodecConfig();
+    }
+}
+
+void H264AccessUnitAssembler::updateCodecConfig()
+{
+    codecConfig_.clear();
+
+    for(const auto& nalUnit : accessUnit_.nalUnits)
+    {
+        if(nalUnit.type == H264NalUnitType::SPS || nalUnit.type == H264NalUnitType::PPS)
+        {
+            codecConfig_.insert(codecConfig_.end(), cStartCode.begin(), cStartCode.end());
+            common::copy(codecConfig_, nalUnit.data);
+        }
+    }
+}
+
+}
+}
+}
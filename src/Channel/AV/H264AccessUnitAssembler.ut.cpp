@@ -0,0 +1,120 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <random>
+#include <boost/test/unit_test.hpp>
+#include <aasdk/Channel/AV/H264AccessUnitAssembler.hpp>
+#include <aasdk/Channel/AV/StartCodeScanner.hpp>
+
+
+namespace aasdk
+{
+namespace channel
+{
+namespace av
+{
+namespace ut
+{
+
+BOOST_AUTO_TEST_CASE(StartCodeScanner_MatchesScalarScan)
+{
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> distribution(0, 3);
+
+    // Random bytes drawn from {0, 1, 2, 3} contain start codes at every possible offset.
+    common::Data data(4096);
+    for(auto& byte : data)
+    {
+        byte = static_cast<common::Data::value_type>(distribution(generator));
+    }
+
+    const uint8_t* end = data.data() + data.size();
+    const uint8_t* expected = data.data();
+    const uint8_t* actual = data.data();
+
+    do
+    {
+        expected = findStartCodeScalar(expected, end);
+        actual = findStartCode(actual, end);
+        BOOST_REQUIRE(actual == expected);
+
+        expected = std::min(expected + 1, end);
+        actual = expected;
+    } while(expected != end);
+}
+
+BOOST_AUTO_TEST_CASE(StartCodeScanner_NoStartCode)
+{
+    const common::Data data(100, 0x00);
+    BOOST_CHECK(findStartCode(data.data(), data.data() + data.size()) == data.data() + data.size());
+
+    const common::Data tail{0x05, 0x00, 0x00};
+    BOOST_CHECK(findStartCode(tail.data(), tail.data() + tail.size()) == tail.data() + tail.size());
+}
+
+BOOST_AUTO_TEST_CASE(H264AccessUnitAssembler_CodecConfigAndKeyFrame)
+{
+    H264AccessUnitAssembler assembler;
+
+    const common::Data codecConfig{0x00, 0x00, 0x00, 0x01, 0x67, 0x42, 0x00, 0x1F,
+                                   0x00, 0x00, 0x00, 0x01, 0x68, 0xCE, 0x3C, 0x80};
+    const auto& config = assembler.assemble(common::DataConstBuffer(codecConfig));
+
+    BOOST_CHECK(!config.hasTimestamp);
+    BOOST_CHECK(config.isCodecConfig);
+    BOOST_CHECK(!config.isKeyFrame);
+    BOOST_REQUIRE_EQUAL(config.nalUnits.size(), 2u);
+    BOOST_CHECK(config.nalUnits[0].type == H264NalUnitType::SPS);
+    BOOST_CHECK_EQUAL(config.nalUnits[0].data.size, 4u);
+    BOOST_CHECK(config.nalUnits[1].type == H264NalUnitType::PPS);
+    BOOST_CHECK(assembler.getCodecConfig() == codecConfig);
+
+    const common::Data keyFrame{0x00, 0x00, 0x01, 0x65, 0x88, 0x84, 0x00, 0x00};
+    const auto& frame = assembler.assemble(1234, common::DataConstBuffer(keyFrame));
+
+    BOOST_CHECK(frame.hasTimestamp);
+    BOOST_CHECK_EQUAL(frame.timestamp, 1234u);
+    BOOST_CHECK(frame.isKeyFrame);
+    BOOST_CHECK(!frame.isCodecConfig);
+    BOOST_CHECK(!frame.isDroppable);
+    BOOST_REQUIRE_EQUAL(frame.nalUnits.size(), 1u);
+    BOOST_CHECK_EQUAL(frame.nalUnits[0].data.size, 3u);
+    BOOST_CHECK(assembler.getCodecConfig() == codecConfig);
+}
+
+BOOST_AUTO_TEST_CASE(H264AccessUnitAssembler_NonReferenceFrame)
+{
+    H264AccessUnitAssembler assembler;
+
+    const common::Data referenceFrame{0x00, 0x00, 0x00, 0x01, 0x09, 0xF0, 0x00, 0x00, 0x01, 0x41, 0x9A, 0x02};
+    const auto& reference = assembler.assemble(1, common::DataConstBuffer(referenceFrame));
+    BOOST_REQUIRE_EQUAL(reference.nalUnits.size(), 2u);
+    BOOST_CHECK(reference.nalUnits[0].type == H264NalUnitType::ACCESS_UNIT_DELIMITER);
+    BOOST_CHECK_EQUAL(reference.nalUnits[1].refIdc, 2u);
+    BOOST_CHECK(!reference.isKeyFrame);
+    BOOST_CHECK(!reference.isDroppable);
+
+    const common::Data nonReferenceFrame{0x00, 0x00, 0x01, 0x01, 0x9E, 0x04};
+    const auto& nonReference = assembler.assemble(2, common::DataConstBuffer(nonReferenceFrame));
+    BOOST_CHECK(nonReference.isDroppable);
+    BOOST_CHECK(assembler.getCodecConfig().empty());
+}
+
+}
+}
+}
+}
@@ -0,0 +1,98 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <aasdk/Channel/AV/StartCodeScanner.hpp>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+
+namespace aasdk
+{
+namespace channel
+{
+namespace av
+{
+
+const uint8_t* findStartCodeScalar(const uint8_t* begin, const uint8_t* end)
+{
+    for(auto current = begin; end - current >= 3; ++current)
+    {
+        // The third byte decides how far the window can move on.
+        if(current[2] > 1)
+        {
+            current += 2;
+        }
+        else if(current[2] == 1 && current[1] == 0 && current[0] == 0)
+        {
+            return current;
+        }
+    }
+
+    return end;
+}
+
+const uint8_t* findStartCode(const uint8_t* begin, const uint8_t* end)
+{
+    auto current = begin;
+
+#if defined(__SSE2__)
+    const auto zero = _mm_setzero_si128();
+    const auto one = _mm_set1_epi8(1);
+
+    // Every block tests 16 candidate positions, the loads reach two bytes past them.
+    for(; end - current >= 18; current += 16)
+    {
+        const auto first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(current));
+        const auto second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(current + 1));
+        const auto third = _mm_loadu_si128(reinterpret_cast<const __m128i*>(current + 2));
+        const auto matches = _mm_and_si128(_mm_and_si128(_mm_cmpeq_epi8(first, zero), _mm_cmpeq_epi8(second, zero)), _mm_cmpeq_epi8(third, one));
+        const auto mask = _mm_movemask_epi8(matches);
+
+        if(mask != 0)
+        {
+            return current + __builtin_ctz(static_cast<unsigned int>(mask));
+        }
+    }
+#elif defined(__ARM_NEON)
+    const auto zero = vdupq_n_u8(0);
+    const auto one = vdupq_n_u8(1);
+
+    for(; end - current >= 18; current += 16)
+    {
+        const auto first = vld1q_u8(current);
+        const auto second = vld1q_u8(current + 1);
+        const auto third = vld1q_u8(current + 2);
+        const auto matches = vreinterpretq_u64_u8(vandq_u8(vandq_u8(vceqq_u8(first, zero), vceqq_u8(second, zero)), vceqq_u8(third, one)));
+
+        if((vgetq_lane_u64(matches, 0) | vgetq_lane_u64(matches, 1)) != 0)
+        {
+            // NEON has no movemask, the hit is located within the block instead.
+            return findStartCodeScalar(current, current + 18);
+        }
+    }
+#endif
+
+    return findStartCodeScalar(current, end);
+}
+
+}
+}
+}
@@ -0,0 +1,132 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <aasdk/Channel/AV/VideoLatencyController.hpp>
+#include <aasdk/Common/Log.hpp>
+
+
+namespace aasdk
+{
+namespace channel
+{
+namespace av
+{
+
+VideoLatencyController::VideoLatencyController(Configuration configuration)
+    : configuration_(std::move(configuration))
+    , isWaitingForKeyFrame_(false)
+    , deliveredFrames_(0)
+    , droppedNonReferenceFrames_(0)
+    , droppedGopFrames_(0)
+    , droppedGops_(0)
+    , expiredGopDrops_(0)
+{
+    common::TraceClock::enable();
+}
+
+VideoLatencyController::~VideoLatencyController()
+{
+    common::TraceClock::disable();
+}
+
+bool VideoLatencyController::onFrame(const common::DataConstBuffer& buffer, common::TraceClock::duration queueDelay)
+{
+    return this->onFrame(buffer, queueDelay, common::TraceClock::now());
+}
+
+bool VideoLatencyController::onFrame(const common::DataConstBuffer& buffer, common::TraceClock::duration queueDelay, common::TraceClock::time_point now)
+{
+    const auto& accessUnit = assembler_.assemble(buffer);
+
+    if(accessUnit.nalUnits.empty())
+    {
+        // Not Annex-B, there is nothing to base a decision on.
+        deliveredFrames_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    if(accessUnit.isCodecConfig || accessUnit.isKeyFrame)
+    {
+        // Dropping an IDR would cost a whole GOP, it is always worth decoding.
+        isWaitingForKeyFrame_ = false;
+        deliveredFrames_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    if(isWaitingForKeyFrame_ && now - dropStartTime_ > configuration_.maxDropDuration)
+    {
+        AASDK_LOG(info) << "[VideoLatencyController] no keyframe within "
+                        << configuration_.maxDropDuration.count() << " ms, resuming delivery.";
+        isWaitingForKeyFrame_ = false;
+        expiredGopDrops_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if(!isWaitingForKeyFrame_ && queueDelay > configuration_.maxQueueDelay)
+    {
+        if(accessUnit.isDroppable)
+        {
+            droppedNonReferenceFrames_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        AASDK_LOG(info) << "[VideoLatencyController] queue delay "
+                        << std::chrono::duration_cast<std::chrono::milliseconds>(queueDelay).count()
+                        << " ms, dropping frames until the next keyframe.";
+        isWaitingForKeyFrame_ = true;
+        dropStartTime_ = now;
+        droppedGops_.fetch_add(1, std::memory_order_relaxed);
+
+        if(keyFrameRequestHandler_ != nullptr)
+        {
+            keyFrameRequestHandler_();
+        }
+    }
+
+    if(isWaitingForKeyFrame_)
+    {
+        droppedGopFrames_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    deliveredFrames_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void VideoLatencyController::reset()
+{
+    isWaitingForKeyFrame_ = false;
+}
+
+void VideoLatencyController::setKeyFrameRequestHandler(KeyFrameRequestHandler keyFrameRequestHandler)
+{
+    keyFrameRequestHandler_ = std::move(keyFrameRequestHandler);
+}
+
+VideoLatencyController::Statistics VideoLatencyController::getStatistics() const
+{
+    Statistics statistics;
+    statistics.deliveredFrames = deliveredFrames_.load(std::memory_order_relaxed);
+    statistics.droppedNonReferenceFrames = droppedNonReferenceFrames_.load(std::memory_order_relaxed);
+    statistics.droppedGopFrames = droppedGopFrames_.load(std::memory_order_relaxed);
+    statistics.droppedGops = droppedGops_.load(std::memory_order_relaxed);
+    statistics.expiredGopDrops = expiredGopDrops_.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+}
+}
+}
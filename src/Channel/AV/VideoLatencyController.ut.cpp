@@ -0,0 +1,120 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <boost/test/unit_test.hpp>
+#include <aasdk/Channel/AV/VideoLatencyController.hpp>
+
+
+namespace aasdk
+{
+namespace channel
+{
+namespace av
+{
+namespace ut
+{
+
+namespace
+{
+
+const common::Data cKeyFrame{0x00, 0x00, 0x00, 0x01, 0x65, 0x88, 0x84};
+const common::Data cReferenceFrame{0x00, 0x00, 0x00, 0x01, 0x41, 0x9A, 0x02};
+const common::Data cNonReferenceFrame{0x00, 0x00, 0x00, 0x01, 0x01, 0x9E, 0x04};
+const common::Data cCodecConfig{0x00, 0x00, 0x00, 0x01, 0x67, 0x42, 0x00, 0x1F, 0x00, 0x00, 0x00, 0x01, 0x68, 0xCE};
+
+const std::chrono::milliseconds cOnTime(10);
+const std::chrono::milliseconds cLate(500);
+
+VideoLatencyController::Configuration createConfiguration()
+{
+    VideoLatencyController::Configuration configuration;
+    configuration.maxQueueDelay = std::chrono::milliseconds(100);
+    return configuration;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(VideoLatencyController_DropNonReferenceFrames)
+{
+    VideoLatencyController controller(createConfiguration());
+
+    BOOST_CHECK(controller.onFrame(common::DataConstBuffer(cNonReferenceFrame), cOnTime));
+    BOOST_CHECK(!controller.onFrame(common::DataConstBuffer(cNonReferenceFrame), cLate));
+    // Only the late frame itself was dropped, the GOP carries on.
+    BOOST_CHECK(controller.onFrame(common::DataConstBuffer(cReferenceFrame), cOnTime));
+
+    const auto statistics = controller.getStatistics();
+    BOOST_CHECK_EQUAL(statistics.deliveredFrames, 2u);
+    BOOST_CHECK_EQUAL(statistics.droppedNonReferenceFrames, 1u);
+    BOOST_CHECK_EQUAL(statistics.droppedGops, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(VideoLatencyController_DropGopUntilKeyFrame)
+{
+    VideoLatencyController controller(createConfiguration());
+
+    BOOST_CHECK(controller.onFrame(common::DataConstBuffer(cKeyFrame), cOnTime));
+    BOOST_CHECK(!controller.onFrame(common::DataConstBuffer(cReferenceFrame), cLate));
+    BOOST_CHECK(!controller.onFrame(common::DataConstBuffer(cReferenceFrame), cOnTime));
+    BOOST_CHECK(!controller.onFrame(common::DataConstBuffer(cNonReferenceFrame), cOnTime));
+    BOOST_CHECK(controller.onFrame(common::DataConstBuffer(cCodecConfig), cLate));
+    BOOST_CHECK(controller.onFrame(common::DataConstBuffer(cKeyFrame), cLate));
+    BOOST_CHECK(controller.onFrame(common::DataConstBuffer(cReferenceFrame), cOnTime));
+
+    const auto statistics = controller.getStatistics();
+    BOOST_CHECK_EQUAL(statistics.deliveredFrames, 4u);
+    BOOST_CHECK_EQUAL(statistics.droppedGopFrames, 3u);
+    BOOST_CHECK_EQUAL(statistics.droppedGops, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(VideoLatencyController_PassThroughUnknownPayload)
+{
+    VideoLatencyController controller(createConfiguration());
+    const common::Data payload(100, 0x5A);
+
+    BOOST_CHECK(controller.onFrame(common::DataConstBuffer(payload), cLate));
+    BOOST_CHECK_EQUAL(controller.getStatistics().deliveredFrames, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(VideoLatencyController_ResumeAfterMaxDropDuration)
+{
+    auto configuration = createConfiguration();
+    configuration.maxDropDuration = std::chrono::milliseconds(1000);
+    VideoLatencyController controller(configuration);
+
+    size_t keyFrameRequests = 0;
+    controller.setKeyFrameRequestHandler([&keyFrameRequests]() { ++keyFrameRequests; });
+
+    const common::TraceClock::time_point start(std::chrono::seconds(100));
+    BOOST_CHECK(!controller.onFrame(common::DataConstBuffer(cReferenceFrame), cLate, start));
+    BOOST_CHECK_EQUAL(keyFrameRequests, 1u);
+    BOOST_CHECK(!controller.onFrame(common::DataConstBuffer(cReferenceFrame), cOnTime, start + std::chrono::milliseconds(1000)));
+
+    // No keyframe showed up in time, delivery resumes without one.
+    BOOST_CHECK(controller.onFrame(common::DataConstBuffer(cReferenceFrame), cOnTime, start + std::chrono::milliseconds(1001)));
+
+    const auto statistics = controller.getStatistics();
+    BOOST_CHECK_EQUAL(statistics.droppedGops, 1u);
+    BOOST_CHECK_EQUAL(statistics.droppedGopFrames, 2u);
+    BOOST_CHECK_EQUAL(statistics.expiredGopDrops, 1u);
+    BOOST_CHECK_EQUAL(statistics.deliveredFrames, 1u);
+}
+
+}
+}
+}
+}
@@ -16,6 +16,7 @@
 *  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
 #include <aasdk_proto/ControlMessageIdsEnum.pb.h>
 #include <aasdk_proto/AVChannelMessageIdsEnum.pb.h>
 #include <aasdk/Messenger/Timestamp.hpp>
@@ -53,6 +54,21 @@ messenger::ChannelId VideoServiceChannel::getId() const
     return channelId_;
 }
 
+void VideoServiceChannel::setLatencyController(VideoLatencyController::Pointer latencyController)
+{
+    latencyController_ = std::move(latencyController);
+}
+
+void VideoServiceChannel::setClockSyncEstimator(messenger::ClockSyncEstimator::Pointer clockSyncEstimator)
+{
+    clockSyncEstimator_ = std::move(clockSyncEstimator);
+}
+
+void VideoServiceChannel::setAckEngine(AVMediaAckEngine::Pointer ackEngine)
+{
+    ackEngine_ = std::move(ackEngine);
+}
+
 void VideoServiceChannel::sendChannelOpenResponse(const proto::messages::ChannelOpenResponse& response, SendPromise::Pointer promise)
 {
     auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::CONTROL));
@@ -64,6 +80,8 @@ void VideoServiceChannel::sendChannelOpenResponse(const proto::messages::Channel
 
 void VideoServiceChannel::sendAVChannelSetupResponse(const proto::messages::AVChannelSetupResponse& response, SendPromise::Pointer promise)
 {
+    maxUnacked_ = response.max_unacked();
+
     auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
     message->insertPayload(messenger::MessageId(proto::ids::AVChannelMessage::SETUP_RESPONSE).getData());
     message->insertPayload(response);
@@ -91,71 +109,96 @@ void VideoServiceChannel::sendAVMediaAckIndication(const proto::messages::AVMedi
 
 void VideoServiceChannel::messageHandler(messenger::Message::Pointer message, IVideoServiceChannelEventHandler::Pointer eventHandler)
 {
+    this->traceMessage(*message);
     messenger::MessageId messageId(message->getPayload());
     common::DataConstBuffer payload(message->getPayload(), messageId.getSizeOf());
 
     switch(messageId.getId())
     {
-    case proto::ids::AVChannelMessage::SETUP_REQUEST:
-        this->handleAVChannelSetupRequest(payload, std::move(eventHandler));
-        break;
-    case proto::ids::AVChannelMessage::START_INDICATION:
-        this->handleStartIndication(payload, std::move(eventHandler));
-        break;
-    case proto::ids::AVChannelMessage::STOP_INDICATION:
-        this->handleStopIndication(payload, std::move(eventHandler));
-        break;
     case proto::ids::AVChannelMessage::AV_MEDIA_WITH_TIMESTAMP_INDICATION:
-        this->handleAVMediaWithTimestampIndication(payload, std::move(eventHandler));
+        if(clockSyncEstimator_ != nullptr && payload.size >= sizeof(messenger::Timestamp::ValueType))
+        {
+            // Reassembly time leaves the messenger queue out of the arrival, if the trace clock runs.
+            const auto& trace = message->getTrace();
+            clockSyncEstimator_->onMediaTimestamp(messenger::Timestamp(payload).getValue(),
+                                                  trace.isMarked(messenger::TraceStage::REASSEMBLED) ? trace.get(messenger::TraceStage::REASSEMBLED) : messenger::ClockSyncEstimator::Clock::now());
+        }
+
+        if(this->isFrameDropped(*message, common::DataConstBuffer(payload.cdata, payload.size, sizeof(messenger::Timestamp::ValueType))))
+        {
+            this->receive(std::move(eventHandler));
+        }
+        else
+        {
+            if(ackEngine_ != nullptr)
+            {
+                ackEngine_->onMediaReceived();
+            }
+
+            this->handleAVMediaWithTimestampIndication(payload, std::move(eventHandler));
+        }
         break;
     case proto::ids::AVChannelMessage::AV_MEDIA_INDICATION:
-        eventHandler->onAVMediaIndication(payload);
-        break;
-    case proto::ids::ControlMessage::CHANNEL_OPEN_REQUEST:
-        this->handleChannelOpenRequest(payload, std::move(eventHandler));
-        break;
-    case proto::ids::AVChannelMessage::VIDEO_FOCUS_REQUEST:
-        this->handleVideoFocusRequest(payload, std::move(eventHandler));
+        if(this->isFrameDropped(*message, payload))
+        {
+            this->receive(std::move(eventHandler));
+        }
+        else
+        {
+            if(ackEngine_ != nullptr)
+            {
+                ackEngine_->onMediaReceived();
+            }
+
+            eventHandler->onAVMediaIndication(payload);
+        }
         break;
     default:
-        AASDK_LOG(error) << "[VideoServiceChannel] message not handled: " << messageId.getId();
-        this->receive(std::move(eventHandler));
+        if(!dispatcher_.dispatch(*this, messageId.getId(), payload, eventHandler))
+        {
+            AASDK_LOG(error) << "[VideoServiceChannel] message not handled: " << messageId.getId();
+            this->receive(std::move(eventHandler));
+        }
         break;
     }
 }
 
-void VideoServiceChannel::handleAVChannelSetupRequest(const common::DataConstBuffer& payload, IVideoServiceChannelEventHandler::Pointer eventHandler)
+void VideoServiceChannel::handleStartIndication(const proto::messages::AVChannelStartIndication& indication, IVideoServiceChannelEventHandler::Pointer eventHandler)
 {
-    proto::messages::AVChannelSetupRequest request;
-    if(request.ParseFromArray(payload.cdata, payload.size))
+    session_ = indication.session();
+    droppedFramesToAck_ = 0;
+
+    if(latencyController_ != nullptr)
     {
-        eventHandler->onAVChannelSetupRequest(request);
+        latencyController_->reset();
     }
-    else
+
+    if(ackEngine_ != nullptr)
     {
-        eventHandler->onChannelError(error::Error(error::ErrorCode::PARSE_PAYLOAD));
+        ackEngine_->start(session_, maxUnacked_);
     }
+
+    eventHandler->onAVChannelStartIndication(indication);
 }
 
-void VideoServiceChannel::handleStartIndication(const common::DataConstBuffer& payload, IVideoServiceChannelEventHandler::Pointer eventHandler)
+void VideoServiceChannel::handleStopIndication(const proto::messages::AVChannelStopIndication& indication, IVideoServiceChannelEventHandler::Pointer eventHandler)
 {
-    proto::messages::AVChannelStartIndication indication;
-    if(indication.ParseFromArray(payload.cdata, payload.size))
-    {
-        eventHandler->onAVChannelStartIndication(indication);
-    }
-    else
+    droppedFramesToAck_ = 0;
+
+    if(ackEngine_ != nullptr)
     {
-        eventHandler->onChannelError(error::Error(error::ErrorCode::PARSE_PAYLOAD));
+        ackEngine_->stop();
     }
+
+    eventHandler->onAVChannelStopIndication(indication);
 }
 
-void VideoServiceChannel::handleStopIndication(const common::DataConstBuffer& payload, IVideoServiceChannelEventHandler::Pointer eventHandler)
+void VideoServiceChannel::handleAVMediaWithTimestampIndication(const common::DataConstBuffer& payload, IVideoServiceChannelEventHandler::Pointer eventHandler)
 {
-    proto::messages::AVChannelStopIndication indication;
-    if(indication.ParseFromArray(payload.cdata, payload.size))
+    if(payload.size >= sizeof(messenger::Timestamp::ValueType))
     {
-        eventHandler->onAVChannelStopIndication(indication);
+        messenger::Timestamp timestamp(payload);
+        eventHandler->onAVMediaWithTimestampIndication(timestamp.getValue(), common::DataConstBuffer(payload.cdata, payload.size, sizeof(messenger::Timestamp::ValueType)));
     }
     else
     {
@@ -163,43 +206,54 @@ void VideoServiceChannel::handleStopIndication(const common::DataConstBuffer& pa
     }
 }
 
-void VideoServiceChannel::handleChannelOpenRequest(const common::DataConstBuffer& payload, IVideoServiceChannelEventHandler::Pointer eventHandler)
+bool VideoServiceChannel::isFrameDropped(const messenger::Message& message, const common::DataConstBuffer& frame)
 {
-    proto::messages::ChannelOpenRequest request;
-    if(request.ParseFromArray(payload.cdata, payload.size))
+    if(latencyController_ == nullptr)
     {
-        eventHandler->onChannelOpenRequest(request);
+        return false;
     }
-    else
+
+    const auto& trace = message.getTrace();
+    const auto queueDelay = trace.isMarked(messenger::TraceStage::REASSEMBLED)
+            ? common::TraceClock::now() - trace.get(messenger::TraceStage::REASSEMBLED) : common::TraceClock::duration::zero();
+
+    if(latencyController_->onFrame(frame, queueDelay))
     {
-        eventHandler->onChannelError(error::Error(error::ErrorCode::PARSE_PAYLOAD));
+        // The drop run is over, nothing of it may stay counted against max_unacked.
+        if(droppedFramesToAck_ > 0)
+        {
+            this->sendDroppedFramesAck();
+        }
+
+        return false;
     }
-}
 
-void VideoServiceChannel::handleVideoFocusRequest(const common::DataConstBuffer& payload, IVideoServiceChannelEventHandler::Pointer eventHandler)
-{
-    proto::messages::VideoFocusRequest request;
-    if(request.ParseFromArray(payload.cdata, payload.size))
+    // The phone still counts the frame against max_unacked.
+    if(ackEngine_ != nullptr)
     {
-        eventHandler->onVideoFocusRequest(request);
+        ackEngine_->onMediaReceived();
+        ackEngine_->release();
     }
-    else
+    else if(++droppedFramesToAck_ >= (std::max<uint32_t>(maxUnacked_, 1) + 1) / 2)
     {
-        eventHandler->onChannelError(error::Error(error::ErrorCode::PARSE_PAYLOAD));
+        this->sendDroppedFramesAck();
     }
+
+    return true;
 }
 
-void VideoServiceChannel::handleAVMediaWithTimestampIndication(const common::DataConstBuffer& payload, IVideoServiceChannelEventHandler::Pointer eventHandler)
+void VideoServiceChannel::sendDroppedFramesAck()
 {
-    if(payload.size >= sizeof(messenger::Timestamp::ValueType))
-    {
-        messenger::Timestamp timestamp(payload);
-        eventHandler->onAVMediaWithTimestampIndication(timestamp.getValue(), common::DataConstBuffer(payload.cdata, payload.size, sizeof(messenger::Timestamp::ValueType)));
-    }
-    else
-    {
-        eventHandler->onChannelError(error::Error(error::ErrorCode::PARSE_PAYLOAD));
-    }
+    proto::messages::AVMediaAckIndication indication;
+    indication.set_session(session_);
+    indication.set_value(droppedFramesToAck_);
+    droppedFramesToAck_ = 0;
+
+    auto sendPromise = SendPromise::defer(strand_);
+    sendPromise->then([]() {}, [](const error::Error& e) {
+        AASDK_LOG(error) << "[VideoServiceChannel] dropped frame ack failed: " << e.what();
+    });
+    this->sendAVMediaAckIndication(indication, std::move(sendPromise));
 }
 
 }
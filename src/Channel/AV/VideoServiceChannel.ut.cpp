@@ -0,0 +1,239 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <boost/test/unit_test.hpp>
+#include <aasdk_proto/AVChannelMessageIdsEnum.pb.h>
+#include <aasdk_proto/AVMediaAckIndicationMessage.pb.h>
+#include <Messenger/UT/Messenger.mock.hpp>
+#include <Channel/AV/UT/VideoServiceChannelEventHandler.mock.hpp>
+#include <aasdk/Channel/AV/VideoServiceChannel.hpp>
+
+
+namespace aasdk
+{
+namespace channel
+{
+namespace av
+{
+namespace ut
+{
+
+using ::testing::_;
+using ::testing::NiceMock;
+using ::testing::SaveArg;
+
+namespace
+{
+
+const common::Data cKeyFrame{0x00, 0x00, 0x00, 0x01, 0x65, 0x88, 0x84};
+const common::Data cReferenceFrame{0x00, 0x00, 0x00, 0x01, 0x41, 0x9A, 0x02};
+
+}
+
+class VideoServiceChannelUnitTest
+{
+protected:
+    VideoServiceChannelUnitTest()
+        : strand_(ioService_)
+        , messengerMock_(std::make_shared<NiceMock<messenger::ut::MessengerMock>>())
+        , eventHandlerMock_(std::make_shared<NiceMock<VideoServiceChannelEventHandlerMock>>())
+        , channel_(std::make_shared<VideoServiceChannel>(strand_, messengerMock_))
+    {
+        ON_CALL(*messengerMock_, enqueueReceive(messenger::ChannelId::VIDEO, _)).WillByDefault(SaveArg<1>(&receivePromise_));
+        ON_CALL(*messengerMock_, enqueueSend(_, _)).WillByDefault(::testing::Invoke(
+            [this](messenger::Message::Pointer message, messenger::SendPromise::Pointer promise) {
+                messenger::MessageId messageId(message->getPayload());
+                if(messageId.getId() == proto::ids::AVChannelMessage::AV_MEDIA_ACK_INDICATION)
+                {
+                    proto::messages::AVMediaAckIndication indication;
+                    indication.ParseFromArray(message->getPayload().data() + messageId.getSizeOf(), message->getPayload().size() - messageId.getSizeOf());
+                    acks_.push_back(indication);
+                }
+
+                promise->resolve();
+            }));
+    }
+
+    void setup(uint32_t maxUnacked)
+    {
+        proto::messages::AVChannelSetupResponse response;
+        response.set_media_status(proto::enums::AVChannelSetupStatus::OK);
+        response.set_max_unacked(maxUnacked);
+        channel_->sendAVChannelSetupResponse(response, SendPromise::defer(ioService_));
+        this->run();
+    }
+
+    void deliver(uint16_t id, const google::protobuf::Message& indication)
+    {
+        auto message = std::make_shared<messenger::Message>(messenger::ChannelId::VIDEO, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC);
+        message->insertPayload(messenger::MessageId(id).getData());
+        message->insertPayload(indication);
+        this->deliver(std::move(message));
+    }
+
+    void deliverMedia(const common::Data& frame, std::chrono::milliseconds queueDelay = std::chrono::milliseconds(0))
+    {
+        auto message = std::make_shared<messenger::Message>(messenger::ChannelId::VIDEO, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC);
+        message->insertPayload(messenger::MessageId(proto::ids::AVChannelMessage::AV_MEDIA_INDICATION).getData());
+        message->insertPayload(frame);
+        message->getTrace().mark(messenger::TraceStage::REASSEMBLED, common::TraceClock::Clock::now() - queueDelay);
+        this->deliver(std::move(message));
+    }
+
+    void deliver(messenger::Message::Pointer message)
+    {
+        channel_->receive(eventHandlerMock_);
+        receivePromise_->resolve(std::move(message));
+        this->run();
+    }
+
+    void run()
+    {
+        ioService_.run();
+        ioService_.reset();
+    }
+
+    static VideoLatencyController::Pointer createLatencyController()
+    {
+        VideoLatencyController::Configuration configuration;
+        configuration.maxQueueDelay = std::chrono::milliseconds(100);
+        return std::make_shared<VideoLatencyController>(configuration);
+    }
+
+    static proto::messages::AVChannelStartIndication createStartIndication(int32_t session)
+    {
+        proto::messages::AVChannelStartIndication indication;
+        indication.set_session(session);
+        indication.set_config(0);
+        return indication;
+    }
+
+    asio::io_service ioService_;
+    asio::io_service::strand strand_;
+    std::shared_ptr<NiceMock<messenger::ut::MessengerMock>> messengerMock_;
+    std::shared_ptr<NiceMock<VideoServiceChannelEventHandlerMock>> eventHandlerMock_;
+    std::shared_ptr<VideoServiceChannel> channel_;
+    messenger::ReceivePromise::Pointer receivePromise_;
+    std::vector<proto::messages::AVMediaAckIndication> acks_;
+};
+
+BOOST_FIXTURE_TEST_CASE(VideoServiceChannel_AckEngineFollowsSession, VideoServiceChannelUnitTest)
+{
+    auto ackEngine = std::make_shared<AVMediaAckEngine>(ioService_, channel_);
+    channel_->setAckEngine(ackEngine);
+    this->setup(4);
+
+    EXPECT_CALL(*eventHandlerMock_, onAVChannelStartIndication(_));
+    EXPECT_CALL(*eventHandlerMock_, onAVMediaIndication(_)).Times(3);
+    EXPECT_CALL(*eventHandlerMock_, onAVChannelStopIndication(_));
+
+    this->deliver(proto::ids::AVChannelMessage::START_INDICATION, createStartIndication(3));
+    this->deliverMedia(common::Data(16, 0x01));
+    this->deliverMedia(common::Data(16, 0x02));
+
+    // Released frames are acknowledged in batches of half the advertised window.
+    ackEngine->release(2);
+    this->run();
+
+    BOOST_REQUIRE_EQUAL(acks_.size(), 1u);
+    BOOST_CHECK_EQUAL(acks_[0].session(), 3);
+    BOOST_CHECK_EQUAL(acks_[0].value(), 2u);
+
+    // Once stopped, frames of the old session are neither counted nor acknowledged.
+    this->deliver(proto::ids::AVChannelMessage::STOP_INDICATION, proto::messages::AVChannelStopIndication());
+    this->deliverMedia(common::Data(16, 0x03));
+    ackEngine->release(2);
+    this->run();
+
+    BOOST_CHECK_EQUAL(acks_.size(), 1u);
+    BOOST_CHECK_EQUAL(ackEngine->getStatistics().receivedFrames, 2u);
+}
+
+BOOST_FIXTURE_TEST_CASE(VideoServiceChannel_BatchDroppedFrameAcks, VideoServiceChannelUnitTest)
+{
+    auto latencyController = createLatencyController();
+    size_t keyFrameRequests = 0;
+    latencyController->setKeyFrameRequestHandler([&keyFrameRequests]() { ++keyFrameRequests; });
+    channel_->setLatencyController(latencyController);
+    this->setup(4);
+
+    EXPECT_CALL(*eventHandlerMock_, onAVMediaIndication(_)).Times(2);
+
+    this->deliver(proto::ids::AVChannelMessage::START_INDICATION, createStartIndication(5));
+    this->deliverMedia(cKeyFrame);
+    this->deliverMedia(cReferenceFrame, std::chrono::milliseconds(500));
+    BOOST_CHECK(acks_.empty());
+
+    // The second dropped frame fills half of the window.
+    this->deliverMedia(cReferenceFrame);
+    BOOST_REQUIRE_EQUAL(acks_.size(), 1u);
+    BOOST_CHECK_EQUAL(acks_[0].session(), 5);
+    BOOST_CHECK_EQUAL(acks_[0].value(), 2u);
+
+    // The rest of the drop run is acknowledged as soon as the next keyframe is delivered.
+    this->deliverMedia(cReferenceFrame);
+    this->deliverMedia(cKeyFrame);
+    BOOST_REQUIRE_EQUAL(acks_.size(), 2u);
+    BOOST_CHECK_EQUAL(acks_[1].value(), 1u);
+    BOOST_CHECK_EQUAL(keyFrameRequests, 1u);
+}
+
+BOOST_FIXTURE_TEST_CASE(VideoServiceChannel_ReleaseDroppedFramesThroughAckEngine, VideoServiceChannelUnitTest)
+{
+    auto ackEngine = std::make_shared<AVMediaAckEngine>(ioService_, channel_);
+    channel_->setAckEngine(ackEngine);
+    channel_->setLatencyController(createLatencyController());
+    this->setup(4);
+
+    EXPECT_CALL(*eventHandlerMock_, onAVMediaIndication(_)).Times(1);
+
+    this->deliver(proto::ids::AVChannelMessage::START_INDICATION, createStartIndication(5));
+    this->deliverMedia(cKeyFrame);
+    this->deliverMedia(cReferenceFrame, std::chrono::milliseconds(500));
+    this->deliverMedia(cReferenceFrame);
+
+    // Dropped frames share the batches of the delivered ones instead of being acked one by one.
+    BOOST_REQUIRE_EQUAL(acks_.size(), 1u);
+    BOOST_CHECK_EQUAL(acks_[0].session(), 5);
+    BOOST_CHECK_EQUAL(acks_[0].value(), 2u);
+
+    const auto statistics = ackEngine->getStatistics();
+    BOOST_CHECK_EQUAL(statistics.receivedFrames, 3u);
+    BOOST_CHECK_EQUAL(statistics.releasedFrames, 2u);
+}
+
+BOOST_FIXTURE_TEST_CASE(VideoServiceChannel_ForgetDroppedFramesOfStoppedSession, VideoServiceChannelUnitTest)
+{
+    channel_->setLatencyController(createLatencyController());
+    this->setup(4);
+
+    this->deliver(proto::ids::AVChannelMessage::START_INDICATION, createStartIndication(5));
+    this->deliverMedia(cKeyFrame);
+    this->deliverMedia(cReferenceFrame, std::chrono::milliseconds(500));
+    this->deliver(proto::ids::AVChannelMessage::STOP_INDICATION, proto::messages::AVChannelStopIndication());
+
+    // The phone forgets its credits with the session, acking the old drop would skew the new one.
+    this->deliver(proto::ids::AVChannelMessage::START_INDICATION, createStartIndication(6));
+    this->deliverMedia(cKeyFrame);
+
+    BOOST_CHECK(acks_.empty());
+}
+
+}
+}
+}
+}
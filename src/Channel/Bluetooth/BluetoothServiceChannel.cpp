@@ -68,7 +68,7 @@ void BluetoothServiceChannel::sendChannelOpenResponse(const proto::messages::Cha
 
 void BluetoothServiceChannel::sendBluetoothPairingResponse(const proto::messages::BluetoothPairingResponse& response, SendPromise::Pointer promise)
 {
-        AASDK_LOG(info) << "[BluetoothServiceChannel] pairing response ";
+    AASDK_LOG(info) << "[BluetoothServiceChannel] pairing response ";
 
     auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
     message->insertPayload(messenger::MessageId(proto::ids::BluetoothChannelMessage::PAIRING_RESPONSE).getData());
@@ -79,54 +79,30 @@ void BluetoothServiceChannel::sendBluetoothPairingResponse(const proto::messages
 
 void BluetoothServiceChannel::messageHandler(messenger::Message::Pointer message, IBluetoothServiceChannelEventHandler::Pointer eventHandler)
 {
+        this->traceMessage(*message);
+
         AASDK_LOG(info) << "[BluetoothServiceChannel] message handler ";
 
     messenger::MessageId messageId(message->getPayload());
     common::DataConstBuffer payload(message->getPayload(), messageId.getSizeOf());
 
-    switch(messageId.getId())
+    if(!dispatcher_.dispatch(*this, messageId.getId(), payload, eventHandler))
     {
-    case proto::ids::ControlMessage::CHANNEL_OPEN_REQUEST:
-        this->handleChannelOpenRequest(payload, std::move(eventHandler));
-        break;
-    case proto::ids::BluetoothChannelMessage::PAIRING_REQUEST:
-        this->handleBluetoothPairingRequest(payload, std::move(eventHandler));
-        break;
-    default:
         AASDK_LOG(error) << "[BluetoothServiceChannel] message not handled: " << messageId.getId();
         this->receive(std::move(eventHandler));
-        break;
     }
 }
 
-void BluetoothServiceChannel::handleChannelOpenRequest(const common::DataConstBuffer& payload, IBluetoothServiceChannelEventHandler::Pointer eventHandler)
+void BluetoothServiceChannel::handleChannelOpenRequest(const proto::messages::ChannelOpenRequest& request, IBluetoothServiceChannelEventHandler::Pointer eventHandler)
 {
-        AASDK_LOG(info) << "[BluetoothServiceChannel] channel open request ";
-
-    proto::messages::ChannelOpenRequest request;
-    if(request.ParseFromArray(payload.cdata, payload.size))
-    {
-        eventHandler->onChannelOpenRequest(request);
-    }
-    else
-    {
-        eventHandler->onChannelError(error::Error(error::ErrorCode::PARSE_PAYLOAD));
-    }
+    AASDK_LOG(info) << "[BluetoothServiceChannel] channel open request ";
+    eventHandler->onChannelOpenRequest(request);
 }
 
-void BluetoothServiceChannel::handleBluetoothPairingRequest(const common::DataConstBuffer& payload, IBluetoothServiceChannelEventHandler::Pointer eventHandler)
+void BluetoothServiceChannel::handleBluetoothPairingRequest(const proto::messages::BluetoothPairingRequest& request, IBluetoothServiceChannelEventHandler::Pointer eventHandler)
 {
-        AASDK_LOG(info) << "[BluetoothServiceChannel] pairing request ";
-
-    proto::messages::BluetoothPairingRequest request;
-    if(request.ParseFromArray(payload.cdata, payload.size))
-    {
-        eventHandler->onBluetoothPairingRequest(request);
-    }
-    else
-    {
-        eventHandler->onChannelError(error::Error(error::ErrorCode::PARSE_PAYLOAD));
-    }
+    AASDK_LOG(info) << "[BluetoothServiceChannel] pairing request ";
+    eventHandler->onBluetoothPairingRequest(request);
 }
 
 }
@@ -134,6 +134,11 @@ void ControlServiceChannel::sendPingRequest(const proto::messages::PingRequest&
     this->send(std::move(message), std::move(promise));
 }
 
+void ControlServiceChannel::setClockSyncEstimator(messenger::ClockSyncEstimator::Pointer clockSyncEstimator)
+{
+    clockSyncEstimator_ = std::move(clockSyncEstimator);
+}
+
 void ControlServiceChannel::receive(IControlServiceChannelEventHandler::Pointer eventHandler)
 {
     auto receivePromise  = messenger::ReceivePromise::defer(strand_);
@@ -147,6 +152,7 @@ void ControlServiceChannel::receive(IControlServiceChannelEventHandler::Pointer
 
 void ControlServiceChannel::messageHandler(messenger::Message::Pointer message, IControlServiceChannelEventHandler::Pointer eventHandler)
 {
+    this->traceMessage(*message);
     messenger::MessageId messageId(message->getPayload());
     common::DataConstBuffer payload(message->getPayload(), messageId.getSizeOf());
 
@@ -158,33 +164,12 @@ void ControlServiceChannel::messageHandler(messenger::Message::Pointer message,
     case proto::ids::ControlMessage::SSL_HANDSHAKE:
         eventHandler->onHandshake(payload);
         break;
-    case proto::ids::ControlMessage::SERVICE_DISCOVERY_REQUEST:
-        this->handleServiceDiscoveryRequest(payload, std::move(eventHandler));
-        break;
-    case proto::ids::ControlMessage::AUDIO_FOCUS_REQUEST:
-        this->handleAudioFocusRequest(payload, std::move(eventHandler));
-        break;
-    case proto::ids::ControlMessage::SHUTDOWN_REQUEST:
-        this->handleShutdownRequest(payload, std::move(eventHandler));
-        break;
-    case proto::ids::ControlMessage::SHUTDOWN_RESPONSE:
-        this->handleShutdownResponse(payload, std::move(eventHandler));
-        break;
-    case proto::ids::ControlMessage::NAVIGATION_FOCUS_REQUEST:
-        this->handleNavigationFocusRequest(payload, std::move(eventHandler));
-        break;
-    case proto::ids::ControlMessage::PING_REQUEST:
-        this->handlePingRequest(payload, std::move(eventHandler));
-        break;
-    case proto::ids::ControlMessage::PING_RESPONSE:
-        this->handlePingResponse(payload, std::move(eventHandler));
-        break;
-    case proto::ids::ControlMessage::VOICE_SESSION_REQUEST:
-        this->handleVoiceSessionRequest(payload, std::move(eventHandler));
-        break;
     default:
-        AASDK_LOG(error) << "[ControlServiceChannel] message not handled: " << messageId.getId();
-        this->receive(std::move(eventHandler));
+        if(!dispatcher_.dispatch(*this, messageId.getId(), payload, eventHandler))
+        {
+            AASDK_LOG(error) << "[ControlServiceChannel] message not handled: " << messageId.getId();
+            this->receive(std::move(eventHandler));
+        }
         break;
     }
 }
@@ -202,20 +187,6 @@ void ControlServiceChannel::handleVersionResponse(const common::DataConstBuffer&
   eventHandler->onVersionResponse(majorCode, minorCode, status);
 }
 
-void ControlServiceChannel::handleServiceDiscoveryRequest(const common::DataConstBuffer& payload, IControlServiceChannelEventHandler::Pointer eventHandler)
-{
-    proto::messages::ServiceDiscoveryRequest request;
-    if(request.ParseFromArray(payload.cdata, payload.size))
-    {
-        eventHandler->onServiceDiscoveryRequest(request);
-    }
-    else
-    {
-        eventHandler->onChannelError(error::Error(error::ErrorCode::PARSE_PAYLOAD));
-    }
-}
-
-
 void logUnknownFields(const ::google::protobuf::UnknownFieldSet& fields) {
   for (int i = 0; i < fields.field_count(); i++) {
     switch (fields.field(i).type()) {
@@ -241,94 +212,30 @@ void logUnknownFields(const ::google::protobuf::UnknownFieldSet& fields) {
   }
 }
 
-void ControlServiceChannel::handleAudioFocusRequest(const common::DataConstBuffer& payload, IControlServiceChannelEventHandler::Pointer eventHandler)
+void ControlServiceChannel::handleAudioFocusRequest(const proto::messages::AudioFocusRequest& request, IControlServiceChannelEventHandler::Pointer eventHandler)
 {
-    proto::messages::AudioFocusRequest request;
-    if(request.ParseFromArray(payload.cdata, payload.size))
-    {
-      logUnknownFields(request.unknown_fields());
-        eventHandler->onAudioFocusRequest(request);
-    }
-    else
-    {
-        eventHandler->onChannelError(error::Error(error::ErrorCode::PARSE_PAYLOAD));
-    }
+    logUnknownFields(request.unknown_fields());
+    eventHandler->onAudioFocusRequest(request);
 }
 
-void ControlServiceChannel::handleVoiceSessionRequest(const common::DataConstBuffer& payload, IControlServiceChannelEventHandler::Pointer eventHandler)
+void ControlServiceChannel::handlePingRequest(const proto::messages::PingRequest& request, IControlServiceChannelEventHandler::Pointer eventHandler)
 {
-    proto::messages::VoiceSessionRequest request;
-    if(request.ParseFromArray(payload.cdata, payload.size))
+    if(clockSyncEstimator_ != nullptr)
     {
-        eventHandler->onVoiceSessionRequest(request);
+        clockSyncEstimator_->onPingRequest(request.timestamp());
     }
-    else
-    {
-        eventHandler->onChannelError(error::Error(error::ErrorCode::PARSE_PAYLOAD));
-    }
-}
 
-void ControlServiceChannel::handleShutdownRequest(const common::DataConstBuffer& payload, IControlServiceChannelEventHandler::Pointer eventHandler)
-{
-    proto::messages::ShutdownRequest request;
-    if(request.ParseFromArray(payload.cdata, payload.size))
-    {
-        eventHandler->onShutdownRequest(request);
-    }
-    else
-    {
-        eventHandler->onChannelError(error::Error(error::ErrorCode::PARSE_PAYLOAD));
-    }
+    eventHandler->onPingRequest(request);
 }
 
-void ControlServiceChannel::handleShutdownResponse(const common::DataConstBuffer& payload, IControlServiceChannelEventHandler::Pointer eventHandler)
+void ControlServiceChannel::handlePingResponse(const proto::messages::PingResponse& response, IControlServiceChannelEventHandler::Pointer eventHandler)
 {
-    proto::messages::ShutdownResponse response;
-    if(response.ParseFromArray(payload.cdata, payload.size))
-    {
-        eventHandler->onShutdownResponse(response);
-    }
-    else
+    if(clockSyncEstimator_ != nullptr)
     {
-        eventHandler->onChannelError(error::Error(error::ErrorCode::PARSE_PAYLOAD));
+        clockSyncEstimator_->onPingResponse(response.timestamp());
     }
-}
 
-void ControlServiceChannel::handleNavigationFocusRequest(const common::DataConstBuffer& payload, IControlServiceChannelEventHandler::Pointer eventHandler)
-{
-    proto::messages::NavigationFocusRequest request;
-    if(request.ParseFromArray(payload.cdata, payload.size))
-    {
-        eventHandler->onNavigationFocusRequest(request);
-    }
-    else
-    {
-        eventHandler->onChannelError(error::Error(error::ErrorCode::PARSE_PAYLOAD));
-    }
-}
-void ControlServiceChannel::handlePingRequest(const common::DataConstBuffer& payload, IControlServiceChannelEventHandler::Pointer eventHandler)
-{
-    proto::messages::PingRequest request;
-    if(request.ParseFromArray(payload.cdata, payload.size))
-    {
-        eventHandler->onPingRequest(request);
-    }
-    else
-    {
-        eventHandler->onChannelError(error::Error(error::ErrorCode::PARSE_PAYLOAD));
-    }
-}
-void ControlServiceChannel::handlePingResponse(const common::DataConstBuffer& payload, IControlServiceChannelEventHandler::Pointer eventHandler)
-{
-    proto::messages::PingResponse response;
-    if(response.ParseFromArray(payload.cdata, payload.size))
-    {
-        eventHandler->onPingResponse(response);
-    }
-    else
-    {
-        eventHandler->onChannelError(error::Error(error::ErrorCode::PARSE_PAYLOAD));
-    }
+    eventHandler->onPingResponse(response);
 }
 
 }
@@ -0,0 +1,156 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <endian.h>
+#include <aasdk_proto/ControlMessageIdsEnum.pb.h>
+#include <aasdk/Channel/Control/DeviceControlServiceChannel.hpp>
+#include <aasdk/Channel/Control/IDeviceControlServiceChannelEventHandler.hpp>
+#include <aasdk/Common/Log.hpp>
+
+
+namespace aasdk
+{
+namespace channel
+{
+namespace control
+{
+
+DeviceControlServiceChannel::DeviceControlServiceChannel(asio::io_service::strand& strand, messenger::IMessenger::Pointer messenger)
+    : ServiceChannel(strand, std::move(messenger), messenger::ChannelId::CONTROL)
+{
+
+}
+
+void DeviceControlServiceChannel::sendVersionResponse(uint16_t majorCode, uint16_t minorCode, proto::enums::VersionResponseStatus::Enum status, SendPromise::Pointer promise)
+{
+    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::PLAIN, messenger::MessageType::SPECIFIC));
+    message->insertPayload(messenger::MessageId(proto::ids::ControlMessage::VERSION_RESPONSE).getData());
+
+    common::Data versionBuffer(6, 0);
+    reinterpret_cast<uint16_t&>(versionBuffer[0]) = htobe16(majorCode);
+    reinterpret_cast<uint16_t&>(versionBuffer[2]) = htobe16(minorCode);
+    reinterpret_cast<uint16_t&>(versionBuffer[4]) = htobe16(static_cast<uint16_t>(status));
+    message->insertPayload(versionBuffer);
+
+    this->send(std::move(message), std::move(promise));
+}
+
+void DeviceControlServiceChannel::sendHandshake(common::Data handshakeBuffer, SendPromise::Pointer promise)
+{
+    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::PLAIN, messenger::MessageType::SPECIFIC));
+    message->insertPayload(messenger::MessageId(proto::ids::ControlMessage::SSL_HANDSHAKE).getData());
+    message->insertPayload(handshakeBuffer);
+
+    this->send(std::move(message), std::move(promise));
+}
+
+void DeviceControlServiceChannel::sendServiceDiscoveryRequest(const proto::messages::ServiceDiscoveryRequest& request, SendPromise::Pointer promise)
+{
+    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
+    message->insertPayload(messenger::MessageId(proto::ids::ControlMessage::SERVICE_DISCOVERY_REQUEST).getData());
+    message->insertPayload(request);
+
+    this->send(std::move(message), std::move(promise));
+}
+
+void DeviceControlServiceChannel::sendShutdownRequest(const proto::messages::ShutdownRequest& request, SendPromise::Pointer promise)
+{
+    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
+    message->insertPayload(messenger::MessageId(proto::ids::ControlMessage::SHUTDOWN_REQUEST).getData());
+    message->insertPayload(request);
+
+    this->send(std::move(message), std::move(promise));
+}
+
+void DeviceControlServiceChannel::sendShutdownResponse(const proto::messages::ShutdownResponse& response, SendPromise::Pointer promise)
+{
+    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
+    message->insertPayload(messenger::MessageId(proto::ids::ControlMessage::SHUTDOWN_RESPONSE).getData());
+    message->insertPayload(response);
+
+    this->send(std::move(message), std::move(promise));
+}
+
+void DeviceControlServiceChannel::sendPingRequest(const proto::messages::PingRequest& request, SendPromise::Pointer promise)
+{
+    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::PLAIN, messenger::MessageType::SPECIFIC));
+    message->insertPayload(messenger::MessageId(proto::ids::ControlMessage::PING_REQUEST).getData());
+    message->insertPayload(request);
+
+    this->send(std::move(message), std::move(promise));
+}
+
+void DeviceControlServiceChannel::sendPingResponse(const proto::messages::PingResponse& response, SendPromise::Pointer promise)
+{
+    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::PLAIN, messenger::MessageType::SPECIFIC));
+    message->insertPayload(messenger::MessageId(proto::ids::ControlMessage::PING_RESPONSE).getData());
+    message->insertPayload(response);
+
+    this->send(std::move(message), std::move(promise));
+}
+
+void DeviceControlServiceChannel::receive(IDeviceControlServiceChannelEventHandler::Pointer eventHandler)
+{
+    auto receivePromise = messenger::ReceivePromise::defer(strand_);
+    receivePromise->then([this, self = this->shared_from_this(), eventHandler](messenger::Message::Pointer message) {
+                           this->messageHandler(std::move(message), eventHandler);},
+                         std::bind(&IDeviceControlServiceChannelEventHandler::onChannelError, eventHandler, std::placeholders::_1));
+
+    messenger_->enqueueReceive(channelId_, std::move(receivePromise));
+}
+
+void DeviceControlServiceChannel::messageHandler(messenger::Message::Pointer message, IDeviceControlServiceChannelEventHandler::Pointer eventHandler)
+{
+    this->traceMessage(*message);
+    messenger::MessageId messageId(message->getPayload());
+    common::DataConstBuffer payload(message->getPayload(), messageId.getSizeOf());
+
+    switch(messageId.getId())
+    {
+    case proto::ids::ControlMessage::VERSION_REQUEST:
+        this->handleVersionRequest(payload, std::move(eventHandler));
+        break;
+    case proto::ids::ControlMessage::SSL_HANDSHAKE:
+        eventHandler->onHandshake(payload);
+        break;
+    default:
+        if(!dispatcher_.dispatch(*this, messageId.getId(), payload, eventHandler))
+        {
+            AASDK_LOG(error) << "[DeviceControlServiceChannel] message not handled: " << messageId.getId();
+            this->receive(std::move(eventHandler));
+        }
+        break;
+    }
+}
+
+void DeviceControlServiceChannel::handleVersionRequest(const common::DataConstBuffer& payload, IDeviceControlServiceChannelEventHandler::Pointer eventHandler)
+{
+    if(payload.size >= 2 * sizeof(uint16_t))
+    {
+        const uint16_t* versionRequest = reinterpret_cast<const uint16_t*>(payload.cdata);
+        eventHandler->onVersionRequest(be16toh(versionRequest[0]), be16toh(versionRequest[1]));
+    }
+    else
+    {
+        eventHandler->onChannelError(error::Error(error::ErrorCode::PARSE_PAYLOAD));
+    }
+}
+
+}
+}
+}
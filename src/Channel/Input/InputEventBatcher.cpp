@@ -0,0 +1,157 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <aasdk/Channel/Input/InputEventBatcher.hpp>
+
+
+namespace aasdk
+{
+namespace channel
+{
+namespace input
+{
+
+InputEventBatcher::InputEventBatcher(asio::io_service& ioService, IInputServiceChannel::Pointer channel, Configuration configuration)
+    : strand_(ioService)
+    , timer_(ioService)
+    , channel_(std::move(channel))
+    , configuration_(std::move(configuration))
+    , receivedIndications_(0)
+    , sentIndications_(0)
+{
+
+}
+
+void InputEventBatcher::send(const proto::messages::InputEventIndication& indication, SendPromise::Pointer promise)
+{
+    strand_.dispatch([this, self = this->shared_from_this(), indication, promise = std::move(promise)]() mutable {
+        receivedIndications_.fetch_add(1, std::memory_order_relaxed);
+
+        if(!isMove(indication))
+        {
+            this->sendPending();
+            this->sendIndication(indication, {std::move(promise)});
+        }
+        else if(!pendingPromises_.empty() && pendingIndication_.disp_channel() == indication.disp_channel())
+        {
+            this->merge(indication);
+            pendingPromises_.push_back(std::move(promise));
+        }
+        else
+        {
+            this->sendPending();
+            pendingIndication_ = indication;
+            pendingPromises_.push_back(std::move(promise));
+
+            timer_.expires_from_now(configuration_.latencyBudget);
+            timer_.async_wait(strand_.wrap([this, self = this->shared_from_this()](const asio::error_code& ec) {
+                if(!ec)
+                {
+                    this->sendPending();
+                }
+            }));
+        }
+    });
+}
+
+void InputEventBatcher::flush()
+{
+    strand_.dispatch([this, self = this->shared_from_this()]() {
+        this->sendPending();
+    });
+}
+
+InputEventBatcher::Statistics InputEventBatcher::getStatistics() const
+{
+    Statistics statistics;
+    statistics.receivedIndications = receivedIndications_.load(std::memory_order_relaxed);
+    statistics.sentIndications = sentIndications_.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+bool InputEventBatcher::isMove(const proto::messages::InputEventIndication& indication)
+{
+    return indication.has_touch_event() && indication.touch_event().touch_action() == proto::enums::TouchAction::DRAG
+            && !indication.has_button_event() && !indication.has_absolute_input_event() && !indication.has_relative_input_event();
+}
+
+void InputEventBatcher::merge(const proto::messages::InputEventIndication& indication)
+{
+    // touch_location carries one entry per pointer, a newer sample replaces the older one.
+    auto* touchEvent = pendingIndication_.mutable_touch_event();
+
+    for(const auto& location : indication.touch_event().touch_location())
+    {
+        auto pendingLocation = std::find_if(touchEvent->mutable_touch_location()->begin(), touchEvent->mutable_touch_location()->end(),
+                                            [&](const auto& pending) { return pending.pointer_id() == location.pointer_id(); });
+
+        if(pendingLocation != touchEvent->mutable_touch_location()->end())
+        {
+            *pendingLocation = location;
+        }
+        else
+        {
+            *touchEvent->add_touch_location() = location;
+        }
+    }
+
+    pendingIndication_.set_timestamp(indication.timestamp());
+}
+
+void InputEventBatcher::sendPending()
+{
+    if(pendingPromises_.empty())
+    {
+        return;
+    }
+
+    timer_.cancel();
+    this->sendIndication(pendingIndication_, std::move(pendingPromises_));
+    pendingPromises_.clear();
+}
+
+void InputEventBatcher::sendIndication(const proto::messages::InputEventIndication& indication, std::vector<SendPromise::Pointer> promises)
+{
+    sentIndications_.fetch_add(1, std::memory_order_relaxed);
+
+    if(promises.size() == 1)
+    {
+        channel_->sendInputEventIndication(indication, std::move(promises.front()));
+        return;
+    }
+
+    auto sendPromise = SendPromise::defer(strand_);
+    sendPromise->then([promises]() {
+                          for(const auto& promise : promises)
+                          {
+                              promise->resolve();
+                          }
+                      },
+                      [promises](const error::Error& e) {
+                          for(const auto& promise : promises)
+                          {
+                              promise->reject(e);
+                          }
+                      });
+
+    channel_->sendInputEventIndication(indication, std::move(sendPromise));
+}
+
+}
+}
+}
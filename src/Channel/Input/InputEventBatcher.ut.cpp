@@ -0,0 +1,126 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <boost/test/unit_test.hpp>
+#include <Channel/UT/ChannelSend.fixture.hpp>
+#include <Channel/Input/UT/InputServiceChannel.mock.hpp>
+#include <aasdk/Channel/Input/InputEventBatcher.hpp>
+
+
+namespace aasdk
+{
+namespace channel
+{
+namespace input
+{
+namespace ut
+{
+
+using ::testing::_;
+
+class InputEventBatcherUnitTest: public channel::ut::ChannelSendFixture<InputServiceChannelMock, proto::messages::InputEventIndication>
+{
+protected:
+    InputEventBatcherUnitTest()
+        : resolvedPromises_(0)
+    {
+        ON_CALL(*channelMock_, sendInputEventIndication(_, _)).WillByDefault(this->recordSent());
+    }
+
+    InputEventBatcher::Pointer createBatcher(std::chrono::microseconds latencyBudget)
+    {
+        InputEventBatcher::Configuration configuration;
+        configuration.latencyBudget = latencyBudget;
+        return std::make_shared<InputEventBatcher>(ioService_, channelMock_, configuration);
+    }
+
+    SendPromise::Pointer createPromise()
+    {
+        auto promise = SendPromise::defer(ioService_);
+        promise->then([this]() { ++resolvedPromises_; }, [](const error::Error&) {});
+        return promise;
+    }
+
+    static proto::messages::InputEventIndication createTouch(proto::enums::TouchAction::Enum action, uint64_t timestamp,
+                                                             std::initializer_list<std::pair<uint32_t, uint32_t>> pointers)
+    {
+        proto::messages::InputEventIndication indication;
+        indication.set_timestamp(timestamp);
+        indication.mutable_touch_event()->set_touch_action(action);
+
+        for(const auto& pointer : pointers)
+        {
+            auto* location = indication.mutable_touch_event()->add_touch_location();
+            location->set_pointer_id(pointer.first);
+            location->set_x(pointer.second);
+            location->set_y(pointer.second);
+        }
+
+        return indication;
+    }
+
+    size_t resolvedPromises_;
+};
+
+BOOST_FIXTURE_TEST_CASE(InputEventBatcher_CoalesceMoves, InputEventBatcherUnitTest)
+{
+    auto batcher = this->createBatcher(std::chrono::milliseconds(4));
+    EXPECT_CALL(*channelMock_, sendInputEventIndication(_, _)).Times(1);
+
+    batcher->send(createTouch(proto::enums::TouchAction::DRAG, 1, {{0, 10}, {1, 20}}), this->createPromise());
+    batcher->send(createTouch(proto::enums::TouchAction::DRAG, 2, {{0, 11}}), this->createPromise());
+    batcher->send(createTouch(proto::enums::TouchAction::DRAG, 3, {{0, 12}, {1, 22}}), this->createPromise());
+    ioService_.run();
+
+    // The timer sent one indication holding the latest location of every pointer.
+    BOOST_REQUIRE_EQUAL(sentMessages_.size(), 1u);
+    const auto& touchEvent = sentMessages_[0].touch_event();
+    BOOST_CHECK_EQUAL(sentMessages_[0].timestamp(), 3u);
+    BOOST_REQUIRE_EQUAL(touchEvent.touch_location_size(), 2);
+    BOOST_CHECK_EQUAL(touchEvent.touch_location(0).x(), 12u);
+    BOOST_CHECK_EQUAL(touchEvent.touch_location(1).x(), 22u);
+    BOOST_CHECK_EQUAL(resolvedPromises_, 3u);
+
+    const auto statistics = batcher->getStatistics();
+    BOOST_CHECK_EQUAL(statistics.receivedIndications, 3u);
+    BOOST_CHECK_EQUAL(statistics.sentIndications, 1u);
+}
+
+BOOST_FIXTURE_TEST_CASE(InputEventBatcher_PressAndReleaseGoOutImmediately, InputEventBatcherUnitTest)
+{
+    // A budget the test never waits for: only PRESS and RELEASE may send the held move.
+    auto batcher = this->createBatcher(std::chrono::seconds(60));
+    EXPECT_CALL(*channelMock_, sendInputEventIndication(_, _)).Times(3);
+
+    batcher->send(createTouch(proto::enums::TouchAction::PRESS, 1, {{0, 10}}), this->createPromise());
+    batcher->send(createTouch(proto::enums::TouchAction::DRAG, 2, {{0, 11}}), this->createPromise());
+    batcher->send(createTouch(proto::enums::TouchAction::DRAG, 3, {{0, 12}}), this->createPromise());
+    batcher->send(createTouch(proto::enums::TouchAction::RELEASE, 4, {{0, 12}}), this->createPromise());
+    ioService_.poll();
+
+    BOOST_REQUIRE_EQUAL(sentMessages_.size(), 3u);
+    BOOST_CHECK(sentMessages_[0].touch_event().touch_action() == proto::enums::TouchAction::PRESS);
+    BOOST_CHECK(sentMessages_[1].touch_event().touch_action() == proto::enums::TouchAction::DRAG);
+    BOOST_CHECK_EQUAL(sentMessages_[1].timestamp(), 3u);
+    BOOST_CHECK(sentMessages_[2].touch_event().touch_action() == proto::enums::TouchAction::RELEASE);
+    BOOST_CHECK_EQUAL(resolvedPromises_, 4u);
+}
+
+}
+}
+}
+}
@@ -82,47 +82,14 @@ void InputServiceChannel::sendChannelOpenResponse(const proto::messages::Channel
 
 void InputServiceChannel::messageHandler(messenger::Message::Pointer message, IInputServiceChannelEventHandler::Pointer eventHandler)
 {
+    this->traceMessage(*message);
     messenger::MessageId messageId(message->getPayload());
     common::DataConstBuffer payload(message->getPayload(), messageId.getSizeOf());
 
-    switch(messageId.getId())
+    if(!dispatcher_.dispatch(*this, messageId.getId(), payload, eventHandler))
     {
-    case proto::ids::InputChannelMessage::BINDING_REQUEST:
-        this->handleBindingRequest(payload, std::move(eventHandler));
-        break;
-    case proto::ids::ControlMessage::CHANNEL_OPEN_REQUEST:
-        this->handleChannelOpenRequest(payload, std::move(eventHandler));
-        break;
-    default:
         AASDK_LOG(error) << "[InputServiceChannel] message not handled: " << messageId.getId();
         this->receive(std::move(eventHandler));
-        break;
-    }
-}
-
-void InputServiceChannel::handleBindingRequest(const common::DataConstBuffer& payload, IInputServiceChannelEventHandler::Pointer eventHandler)
-{
-    proto::messages::BindingRequest request;
-    if(request.ParseFromArray(payload.cdata, payload.size))
-    {
-        eventHandler->onBindingRequest(request);
-    }
-    else
-    {
-        eventHandler->onChannelError(error::Error(error::ErrorCode::PARSE_PAYLOAD));
-    }
-}
-
-void InputServiceChannel::handleChannelOpenRequest(const common::DataConstBuffer& payload, IInputServiceChannelEventHandler::Pointer eventHandler)
-{
-    proto::messages::ChannelOpenRequest request;
-    if(request.ParseFromArray(payload.cdata, payload.size))
-    {
-        eventHandler->onChannelOpenRequest(request);
-    }
-    else
-    {
-        eventHandler->onChannelError(error::Error(error::ErrorCode::PARSE_PAYLOAD));
     }
 }
 
@@ -0,0 +1,116 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <boost/test/unit_test.hpp>
+#include <gmock/gmock.h>
+#include <aasdk_proto/ControlMessageIdsEnum.pb.h>
+#include <aasdk_proto/PingRequestMessage.pb.h>
+#include <aasdk_proto/PingResponseMessage.pb.h>
+#include <aasdk/Channel/MessageDispatcher.hpp>
+
+
+namespace aasdk
+{
+namespace channel
+{
+namespace ut
+{
+
+using ::testing::_;
+
+class EventHandlerMock
+{
+public:
+    typedef std::shared_ptr<EventHandlerMock> Pointer;
+
+    MOCK_METHOD1(onPingRequest, void(const proto::messages::PingRequest& request));
+    MOCK_METHOD1(onChannelError, void(const error::Error& e));
+};
+
+class ChannelStub
+{
+public:
+    void handlePingResponse(const proto::messages::PingResponse& response, EventHandlerMock::Pointer)
+    {
+        timestamps_.push_back(response.timestamp());
+    }
+
+    typedef MessageDispatcher<ChannelStub, EventHandlerMock,
+        MessageRoute<proto::ids::ControlMessage::PING_REQUEST, &EventHandlerMock::onPingRequest>,
+        MessageRoute<proto::ids::ControlMessage::PING_RESPONSE, &ChannelStub::handlePingResponse>> Dispatcher;
+
+    std::vector<int64_t> timestamps_;
+};
+
+class MessageDispatcherUnitTest
+{
+protected:
+    MessageDispatcherUnitTest()
+        : eventHandlerMock_(std::make_shared<EventHandlerMock>())
+    {
+    }
+
+    template<typename MessageType>
+    static common::Data serialize(const MessageType& message)
+    {
+        common::Data data(message.ByteSizeLong());
+        message.SerializeToArray(&data[0], data.size());
+        return data;
+    }
+
+    ChannelStub channel_;
+    ChannelStub::Dispatcher dispatcher_;
+    EventHandlerMock::Pointer eventHandlerMock_;
+};
+
+BOOST_FIXTURE_TEST_CASE(MessageDispatcher_RouteToEventHandlerAndChannel, MessageDispatcherUnitTest)
+{
+    proto::messages::PingRequest request;
+    request.set_timestamp(10);
+    const auto requestData = serialize(request);
+
+    proto::messages::PingResponse response;
+    response.set_timestamp(20);
+    const auto responseData = serialize(response);
+
+    EXPECT_CALL(*eventHandlerMock_, onPingRequest(_)).WillOnce(::testing::Invoke(
+        [](const proto::messages::PingRequest& request) { BOOST_CHECK_EQUAL(request.timestamp(), 10); }));
+    EXPECT_CALL(*eventHandlerMock_, onChannelError(_)).Times(0);
+
+    BOOST_CHECK(dispatcher_.dispatch(channel_, proto::ids::ControlMessage::PING_REQUEST, common::DataConstBuffer(requestData), eventHandlerMock_));
+    BOOST_CHECK(dispatcher_.dispatch(channel_, proto::ids::ControlMessage::PING_RESPONSE, common::DataConstBuffer(responseData), eventHandlerMock_));
+    BOOST_CHECK(dispatcher_.dispatch(channel_, proto::ids::ControlMessage::PING_RESPONSE, common::DataConstBuffer(responseData), eventHandlerMock_));
+
+    BOOST_REQUIRE_EQUAL(channel_.timestamps_.size(), 2u);
+    BOOST_CHECK_EQUAL(channel_.timestamps_[0], 20);
+    BOOST_CHECK_EQUAL(channel_.timestamps_[1], 20);
+}
+
+BOOST_FIXTURE_TEST_CASE(MessageDispatcher_UnknownIdAndParseError, MessageDispatcherUnitTest)
+{
+    const common::Data garbage(4, 0xFF);
+
+    EXPECT_CALL(*eventHandlerMock_, onPingRequest(_)).Times(0);
+    EXPECT_CALL(*eventHandlerMock_, onChannelError(error::Error(error::ErrorCode::PARSE_PAYLOAD)));
+
+    BOOST_CHECK(!dispatcher_.dispatch(channel_, proto::ids::ControlMessage::SHUTDOWN_REQUEST, common::DataConstBuffer(garbage), eventHandlerMock_));
+    BOOST_CHECK(dispatcher_.dispatch(channel_, proto::ids::ControlMessage::PING_REQUEST, common::DataConstBuffer(garbage), eventHandlerMock_));
+}
+
+}
+}
+}
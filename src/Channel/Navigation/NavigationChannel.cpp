@@ -51,71 +51,13 @@ messenger::ChannelId NavigationChannel::getId() const
 
 void NavigationChannel::messageHandler(messenger::Message::Pointer message,
                                        INavigationChannelEventHandler::Pointer eventHandler) {
+  this->traceMessage(*message);
   messenger::MessageId messageId(message->getPayload());
   common::DataConstBuffer payload(message->getPayload(), messageId.getSizeOf());
 
-  switch (messageId.getId()) {
-    case proto::ids::NavigationChannelMessage::NAVIGATION_STATUS:
-      this->handleNavigationStatus(payload,
-                                   std::move(eventHandler));
-      break;
-    case proto::ids::NavigationChannelMessage::NAVIGATION_TURN_EVENT:
-      this->handleNavigationTurn(payload,
-                                 std::move(eventHandler));
-      break;
-    case proto::ids::NavigationChannelMessage::NAVIGATION_DISTANCE_EVENT:
-      this->handleNavigationDistance(payload,
-                                     std::move(eventHandler));
-      break;
-    case proto::ids::ControlMessage::CHANNEL_OPEN_REQUEST:
-      this->handleChannelOpenRequest(payload, std::move(eventHandler));
-      break;
-    default:AASDK_LOG(error) << "[NavigationChannel] message not handled: " << messageId.getId();
-      this->receive(std::move(eventHandler));
-      break;
-  }
-}
-
-void NavigationChannel::handleNavigationStatus(const common::DataConstBuffer &payload,
-                                               INavigationChannelEventHandler::Pointer eventHandler) {
-  proto::messages::NavigationRequestMessage request;
-  if (request.ParseFromArray(payload.cdata, payload.size)) {
-    eventHandler->onNavigationStatus(request);
-  } else {
-    eventHandler->onChannelError(error::Error(error::ErrorCode::PARSE_PAYLOAD));
-  }
-}
-
-void NavigationChannel::handleNavigationTurn(const common::DataConstBuffer &payload,
-                                             INavigationChannelEventHandler::Pointer eventHandler) {
-  proto::messages::NavigationTurnMessage request;
-  if (request.ParseFromArray(payload.cdata, payload.size)) {
-    eventHandler->onNavigationTurn(request);
-  } else {
-    eventHandler->onChannelError(error::Error(error::ErrorCode::PARSE_PAYLOAD));
-  }
-}
-
-void NavigationChannel::handleNavigationDistance(const common::DataConstBuffer &payload,
-                                                 INavigationChannelEventHandler::Pointer eventHandler) {
-  proto::messages::NavigationDistanceMessage request;
-  if (request.ParseFromArray(payload.cdata, payload.size)) {
-    eventHandler->onNavigationDistance(request);
-  } else {
-    eventHandler->onChannelError(error::Error(error::ErrorCode::PARSE_PAYLOAD));
-  }
-}
-
-void NavigationChannel::handleChannelOpenRequest(const common::DataConstBuffer& payload, INavigationChannelEventHandler::Pointer eventHandler)
-{
-  proto::messages::ChannelOpenRequest request;
-  if(request.ParseFromArray(payload.cdata, payload.size))
-  {
-    eventHandler->onChannelOpenRequest(request);
-  }
-  else
-  {
-    eventHandler->onChannelError(error::Error(error::ErrorCode::PARSE_PAYLOAD));
+  if (!dispatcher_.dispatch(*this, messageId.getId(), payload, eventHandler)) {
+    AASDK_LOG(error) << "[NavigationChannel] message not handled: " << messageId.getId();
+    this->receive(std::move(eventHandler));
   }
 }
 
@@ -64,49 +64,18 @@ namespace aasdk
 
             void PhoneStatusServiceChannel::messageHandler(messenger::Message::Pointer message, IPhoneStatusServiceChannelEventHandler::Pointer eventHandler)
             {
+                this->traceMessage(*message);
                 messenger::MessageId messageId(message->getPayload());
                 common::DataConstBuffer payload(message->getPayload(), messageId.getSizeOf());
 
-                switch(messageId.getId())
+                if(messageId.getId() == proto::ids::PhoneStatusChannelMessage::PHONE_STATUS_INPUT)
                 {
-                    case proto::ids::PhoneStatusChannelMessage::PHONE_STATUS:
-                        this->handlePhoneStatusMessage(payload, std::move(eventHandler));
-                        break;
-                    case proto::ids::PhoneStatusChannelMessage::PHONE_STATUS_INPUT:
-                        AASDK_LOG(info) << "[PhoneStatusServiceChannel] PHONE_STATUS_INPUT";
-                        break;
-                    case proto::ids::ControlMessage::CHANNEL_OPEN_REQUEST:
-                        this->handleChannelOpenRequest(payload, std::move(eventHandler));
-                        break;
-                    default:
-                        AASDK_LOG(error) << "[PhoneStatusServiceChannel] message not handled: " << messageId.getId();
-                        this->receive(std::move(eventHandler));
-                        break;
+                    AASDK_LOG(info) << "[PhoneStatusServiceChannel] PHONE_STATUS_INPUT";
                 }
-            }
-
-            void PhoneStatusServiceChannel::handleChannelOpenRequest(const common::DataConstBuffer& payload, IPhoneStatusServiceChannelEventHandler::Pointer eventHandler)
-            {
-                proto::messages::ChannelOpenRequest request;
-                if(request.ParseFromArray(payload.cdata, payload.size))
-                {
-                    eventHandler->onChannelOpenRequest(request);
-                }
-                else
-                {
-                    eventHandler->onChannelError(error::Error(error::ErrorCode::PARSE_PAYLOAD));
-                }
-            }
-
-            void PhoneStatusServiceChannel::handlePhoneStatusMessage(const common::DataConstBuffer& payload, IPhoneStatusServiceChannelEventHandler::Pointer eventHandler){
-                proto::messages::PhoneStatus request;
-                if(request.ParseFromArray(payload.cdata, payload.size))
-                {
-                    eventHandler->onPhoneStatusMessage(request);
-                }
-                else
+                else if(!dispatcher_.dispatch(*this, messageId.getId(), payload, eventHandler))
                 {
-                    eventHandler->onChannelError(error::Error(error::ErrorCode::PARSE_PAYLOAD));
+                    AASDK_LOG(error) << "[PhoneStatusServiceChannel] message not handled: " << messageId.getId();
+                    this->receive(std::move(eventHandler));
                 }
             }
 
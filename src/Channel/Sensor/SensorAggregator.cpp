@@ -0,0 +1,241 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include <aasdk/Channel/Sensor/SensorAggregator.hpp>
+#include <aasdk/Common/Log.hpp>
+
+
+namespace aasdk::channel::sensor {
+
+namespace
+{
+
+typedef proto::messages::SensorEventIndication Indication;
+
+// SensorEventIndication field carrying the readings of each sensor type. Types without a field
+// (dead reckoning, tires) cannot be reported through this channel.
+constexpr std::pair<proto::enums::SensorType::Enum, int> cSensorFields[] = {
+    {proto::enums::SensorType::LOCATION, Indication::kGpsLocationFieldNumber},
+    {proto::enums::SensorType::COMPASS, Indication::kCompassFieldNumber},
+    {proto::enums::SensorType::CAR_SPEED, Indication::kSpeedFieldNumber},
+    {proto::enums::SensorType::RPM, Indication::kRpmFieldNumber},
+    {proto::enums::SensorType::ODOMETER, Indication::kOdometerFieldNumber},
+    {proto::enums::SensorType::FUEL_LEVEL, Indication::kFuelLevelFieldNumber},
+    {proto::enums::SensorType::PARKING_BRAKE, Indication::kParkingBrakeFieldNumber},
+    {proto::enums::SensorType::GEAR, Indication::kGearFieldNumber},
+    {proto::enums::SensorType::DIAGNOSTICS, Indication::kDiagnosticsFieldNumber},
+    {proto::enums::SensorType::NIGHT_DATA, Indication::kNightModeFieldNumber},
+    {proto::enums::SensorType::ENVIRONMENT, Indication::kEnviormentFieldNumber},
+    {proto::enums::SensorType::HVAC, Indication::kHvacFieldNumber},
+    {proto::enums::SensorType::DRIVING_STATUS, Indication::kDrivingStatusFieldNumber},
+    {proto::enums::SensorType::PASSENGER, Indication::kPassengerFieldNumber},
+    {proto::enums::SensorType::DOOR, Indication::kDoorFieldNumber},
+    {proto::enums::SensorType::LIGHT, Indication::kLightFieldNumber},
+    {proto::enums::SensorType::ACCEL, Indication::kAccelFieldNumber},
+    {proto::enums::SensorType::GYRO, Indication::kGyroFieldNumber},
+    {proto::enums::SensorType::GPS, Indication::kGpsLocationFieldNumber}
+};
+
+int getFieldNumber(proto::enums::SensorType::Enum sensorType)
+{
+    const auto it = std::find_if(std::begin(cSensorFields), std::end(cSensorFields), [sensorType](const auto& sensorField) { return sensorField.first == sensorType; });
+    return it != std::end(cSensorFields) ? it->second : 0;
+}
+
+}
+
+SensorAggregator::SensorAggregator(asio::io_service& ioService, ISensorServiceChannel::Pointer channel, Configuration configuration)
+    : SensorAggregator(ioService, std::move(channel), std::move(configuration), &Clock::now)
+{
+
+}
+
+SensorAggregator::SensorAggregator(asio::io_service& ioService, ISensorServiceChannel::Pointer channel, Configuration configuration, TimeSource timeSource)
+    : strand_(ioService)
+    , timer_(ioService)
+    , channel_(std::move(channel))
+    , configuration_(std::move(configuration))
+    , timeSource_(std::move(timeSource))
+    , isTimerArmed_(false)
+    , receivedReadings_(0)
+    , suppressedReadings_(0)
+    , sentReadings_(0)
+    , sentIndications_(0)
+{
+
+}
+
+void SensorAggregator::start(const proto::messages::SensorStartRequestMessage& request)
+{
+    strand_.dispatch([this, self = this->shared_from_this(), request]() {
+        const auto fieldNumber = getFieldNumber(request.sensor_type());
+        if(fieldNumber == 0)
+        {
+            AASDK_LOG(warning) << "[SensorAggregator] sensor type " << request.sensor_type() << " has no indication field.";
+            return;
+        }
+
+        auto& sensor = sensors_[fieldNumber];
+        sensor.isStarted = true;
+        sensor.refreshInterval = std::chrono::milliseconds(std::max<int64_t>(request.refresh_interval(), 0));
+        sensor.nextTime = timeSource_();
+        // The phone expects the current state right after starting a sensor.
+        sensor.isPending = sensor.reading.ByteSizeLong() > 0;
+        sensor.sentReading.clear();
+        this->schedule();
+    });
+}
+
+void SensorAggregator::stop()
+{
+    strand_.dispatch([this, self = this->shared_from_this()]() {
+        for(auto& sensor : sensors_)
+        {
+            sensor.second.isStarted = false;
+        }
+
+        timer_.cancel();
+    });
+}
+
+void SensorAggregator::update(const proto::messages::SensorEventIndication& indication)
+{
+    strand_.dispatch([this, self = this->shared_from_this(), indication]() {
+        const auto* reflection = indication.GetReflection();
+        std::vector<const google::protobuf::FieldDescriptor*> fields;
+        reflection->ListFields(indication, &fields);
+
+        for(const auto* field : fields)
+        {
+            auto& sensor = sensors_[field->number()];
+            sensor.reading.Clear();
+
+            for(int i = 0; i < reflection->FieldSize(indication, field); ++i)
+            {
+                reflection->AddMessage(&sensor.reading, field)->CopyFrom(reflection->GetRepeatedMessage(indication, field, i));
+            }
+
+            sensor.isPending = sensor.reading.SerializeAsString() != sensor.sentReading;
+
+            receivedReadings_.fetch_add(1, std::memory_order_relaxed);
+            suppressedReadings_.fetch_add(sensor.isPending ? 0 : 1, std::memory_order_relaxed);
+        }
+
+        this->schedule();
+    });
+}
+
+SensorAggregator::Statistics SensorAggregator::getStatistics() const
+{
+    Statistics statistics;
+    statistics.receivedReadings = receivedReadings_.load(std::memory_order_relaxed);
+    statistics.suppressedReadings = suppressedReadings_.load(std::memory_order_relaxed);
+    statistics.sentReadings = sentReadings_.load(std::memory_order_relaxed);
+    statistics.sentIndications = sentIndications_.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+void SensorAggregator::schedule()
+{
+    if(isTimerArmed_)
+    {
+        return;
+    }
+
+    auto nextTime = Clock::time_point::max();
+    for(const auto& sensor : sensors_)
+    {
+        if(sensor.second.isStarted && sensor.second.isPending)
+        {
+            nextTime = std::min(nextTime, sensor.second.nextTime);
+        }
+    }
+
+    if(nextTime == Clock::time_point::max())
+    {
+        return;
+    }
+
+    isTimerArmed_ = true;
+    timer_.expires_from_now(std::max(nextTime - timeSource_(), Clock::duration::zero()));
+    timer_.async_wait(strand_.wrap([this, self = this->shared_from_this()](const asio::error_code& ec) {
+        isTimerArmed_ = false;
+
+        if(!ec)
+        {
+            this->sendDueReadings();
+        }
+
+        // A sensor started again after stop() cancelled the timer found it still armed and
+        // relies on this reschedule.
+        this->schedule();
+    }));
+}
+
+void SensorAggregator::sendDueReadings()
+{
+    const auto now = timeSource_();
+    proto::messages::SensorEventIndication indication;
+    const auto* reflection = indication.GetReflection();
+    uint64_t sentReadings = 0;
+
+    for(auto& sensor : sensors_)
+    {
+        auto& state = sensor.second;
+
+        if(!state.isStarted || !state.isPending || state.nextTime > now + configuration_.mergeWindow)
+        {
+            continue;
+        }
+
+        std::vector<const google::protobuf::FieldDescriptor*> fields;
+        reflection->ListFields(state.reading, &fields);
+
+        for(const auto* field : fields)
+        {
+            for(int i = 0; i < reflection->FieldSize(state.reading, field); ++i)
+            {
+                reflection->AddMessage(&indication, field)->CopyFrom(reflection->GetRepeatedMessage(state.reading, field, i));
+            }
+        }
+
+        state.sentReading = state.reading.SerializeAsString();
+        state.isPending = false;
+        state.nextTime = std::max(state.nextTime, now) + state.refreshInterval;
+        ++sentReadings;
+    }
+
+    if(sentReadings == 0)
+    {
+        return;
+    }
+
+    sentReadings_.fetch_add(sentReadings, std::memory_order_relaxed);
+    sentIndications_.fetch_add(1, std::memory_order_relaxed);
+
+    auto sendPromise = SendPromise::defer(strand_);
+    sendPromise->then([]() {}, [](const error::Error& e) {
+        AASDK_LOG(error) << "[SensorAggregator] send failed: " << e.what();
+    });
+    channel_->sendSensorEventIndication(indication, std::move(sendPromise));
+}
+
+}
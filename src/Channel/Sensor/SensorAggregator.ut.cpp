@@ -0,0 +1,191 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <boost/test/unit_test.hpp>
+#include <Channel/UT/ChannelSend.fixture.hpp>
+#include <Channel/Sensor/UT/SensorServiceChannel.mock.hpp>
+#include <aasdk/Channel/Sensor/SensorAggregator.hpp>
+
+
+namespace aasdk
+{
+namespace channel
+{
+namespace sensor
+{
+namespace ut
+{
+
+using ::testing::_;
+
+class SensorAggregatorUnitTest: public channel::ut::ChannelSendFixture<SensorServiceChannelMock, proto::messages::SensorEventIndication>
+{
+protected:
+    SensorAggregatorUnitTest()
+        : now_(SensorAggregator::Clock::now())
+    {
+        ON_CALL(*channelMock_, sendSensorEventIndication(_, _)).WillByDefault(this->recordSent());
+    }
+
+    SensorAggregator::Pointer createAggregator()
+    {
+        // Refresh decisions follow now_ only, the real timer merely wakes the aggregator up.
+        return std::make_shared<SensorAggregator>(ioService_, channelMock_, SensorAggregator::Configuration(), [this]() { return now_; });
+    }
+
+    static proto::messages::SensorStartRequestMessage createStartRequest(proto::enums::SensorType::Enum type, int64_t refreshInterval)
+    {
+        proto::messages::SensorStartRequestMessage request;
+        request.set_sensor_type(type);
+        request.set_refresh_interval(refreshInterval);
+        return request;
+    }
+
+    static proto::messages::SensorEventIndication createSpeed(int32_t speed)
+    {
+        proto::messages::SensorEventIndication indication;
+        indication.add_speed()->set_speed(speed);
+        return indication;
+    }
+
+    static proto::messages::SensorEventIndication createNightMode(bool isNight)
+    {
+        proto::messages::SensorEventIndication indication;
+        indication.add_night_mode()->set_is_night(isNight);
+        return indication;
+    }
+
+    static proto::messages::SensorEventIndication createLocation(int32_t latitude)
+    {
+        proto::messages::SensorEventIndication indication;
+        auto location = indication.add_gps_location();
+        location->set_timestamp(1);
+        location->set_latitude(latitude);
+        location->set_longitude(13);
+        location->set_accuracy(5);
+        return indication;
+    }
+
+    SensorAggregator::Clock::time_point now_;
+};
+
+BOOST_FIXTURE_TEST_CASE(SensorAggregator_MergeSensorsDueTogether, SensorAggregatorUnitTest)
+{
+    auto aggregator = this->createAggregator();
+    EXPECT_CALL(*channelMock_, sendSensorEventIndication(_, _)).Times(1);
+
+    aggregator->start(createStartRequest(proto::enums::SensorType::CAR_SPEED, 0));
+    aggregator->start(createStartRequest(proto::enums::SensorType::NIGHT_DATA, 0));
+    aggregator->update(createSpeed(10));
+    aggregator->update(createSpeed(20));
+    aggregator->update(createNightMode(true));
+    ioService_.run();
+
+    BOOST_REQUIRE_EQUAL(sentMessages_.size(), 1u);
+    BOOST_REQUIRE_EQUAL(sentMessages_[0].speed_size(), 1);
+    BOOST_CHECK_EQUAL(sentMessages_[0].speed(0).speed(), 20);
+    BOOST_REQUIRE_EQUAL(sentMessages_[0].night_mode_size(), 1);
+    BOOST_CHECK(sentMessages_[0].night_mode(0).is_night());
+
+    const auto statistics = aggregator->getStatistics();
+    BOOST_CHECK_EQUAL(statistics.receivedReadings, 3u);
+    BOOST_CHECK_EQUAL(statistics.sentReadings, 2u);
+    BOOST_CHECK_EQUAL(statistics.sentIndications, 1u);
+}
+
+BOOST_FIXTURE_TEST_CASE(SensorAggregator_SuppressUnchangedReadings, SensorAggregatorUnitTest)
+{
+    auto aggregator = this->createAggregator();
+    EXPECT_CALL(*channelMock_, sendSensorEventIndication(_, _)).Times(1);
+
+    // The reading arrives before the phone starts the sensor and is sent once it does.
+    aggregator->update(createNightMode(false));
+    aggregator->start(createStartRequest(proto::enums::SensorType::NIGHT_DATA, 0));
+    ioService_.run();
+    ioService_.reset();
+
+    aggregator->update(createNightMode(false));
+    ioService_.run();
+
+    BOOST_REQUIRE_EQUAL(sentMessages_.size(), 1u);
+    BOOST_CHECK_EQUAL(aggregator->getStatistics().suppressedReadings, 1u);
+}
+
+BOOST_FIXTURE_TEST_CASE(SensorAggregator_HonourRefreshInterval, SensorAggregatorUnitTest)
+{
+    auto aggregator = this->createAggregator();
+    EXPECT_CALL(*channelMock_, sendSensorEventIndication(_, _)).Times(2);
+
+    aggregator->start(createStartRequest(proto::enums::SensorType::CAR_SPEED, 50));
+    aggregator->update(createSpeed(1));
+    ioService_.run();
+    ioService_.reset();
+
+    // However late the timer fires, the readings are held until the interval has passed.
+    aggregator->update(createSpeed(2));
+    aggregator->update(createSpeed(3));
+    now_ += std::chrono::milliseconds(40);
+    ioService_.poll();
+    ioService_.reset();
+    BOOST_CHECK_EQUAL(sentMessages_.size(), 1u);
+
+    // Due within the merge window of the interval.
+    now_ += std::chrono::milliseconds(6);
+    ioService_.run();
+
+    BOOST_REQUIRE_EQUAL(sentMessages_.size(), 2u);
+    BOOST_CHECK_EQUAL(sentMessages_[1].speed(0).speed(), 3);
+    BOOST_CHECK_EQUAL(aggregator->getStatistics().sentReadings, 2u);
+}
+
+BOOST_FIXTURE_TEST_CASE(SensorAggregator_MapSensorTypeToField, SensorAggregatorUnitTest)
+{
+    auto aggregator = this->createAggregator();
+    EXPECT_CALL(*channelMock_, sendSensorEventIndication(_, _)).Times(1);
+
+    // GPS readings travel in gps_location; dead reckoning has no field and is not started.
+    aggregator->start(createStartRequest(proto::enums::SensorType::GPS, 0));
+    aggregator->start(createStartRequest(proto::enums::SensorType::DEAD_RECONING, 0));
+    aggregator->update(createLocation(52));
+    ioService_.run();
+
+    BOOST_REQUIRE_EQUAL(sentMessages_.size(), 1u);
+    BOOST_REQUIRE_EQUAL(sentMessages_[0].gps_location_size(), 1);
+    BOOST_CHECK_EQUAL(sentMessages_[0].gps_location(0).latitude(), 52);
+    BOOST_CHECK_EQUAL(sentMessages_[0].steering_wheel_size(), 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(SensorAggregator_RestartAfterStop, SensorAggregatorUnitTest)
+{
+    auto aggregator = this->createAggregator();
+    EXPECT_CALL(*channelMock_, sendSensorEventIndication(_, _)).Times(1);
+
+    // The restart lands while the cancelled timer is still armed.
+    aggregator->start(createStartRequest(proto::enums::SensorType::CAR_SPEED, 0));
+    aggregator->update(createSpeed(10));
+    aggregator->stop();
+    aggregator->start(createStartRequest(proto::enums::SensorType::CAR_SPEED, 0));
+    ioService_.run();
+
+    BOOST_REQUIRE_EQUAL(sentMessages_.size(), 1u);
+    BOOST_CHECK_EQUAL(sentMessages_[0].speed(0).speed(), 10);
+}
+
+}
+}
+}
+}
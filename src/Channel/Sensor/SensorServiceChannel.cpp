@@ -16,9 +16,6 @@
 *  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
 */
 
-#include <aasdk_proto/ControlMessageIdsEnum.pb.h>
-#include <aasdk_proto/ControlMessageIdsEnum.pb.h>
-#include <aasdk_proto/SensorChannelMessageIdsEnum.pb.h>
 #include <aasdk/Channel/Sensor/ISensorServiceChannelEventHandler.hpp>
 #include <aasdk/Channel/Sensor/SensorServiceChannel.hpp>
 #include <aasdk/Common/Log.hpp>
@@ -64,21 +61,14 @@ void SensorServiceChannel::sendChannelOpenResponse(const proto::messages::Channe
 
 void SensorServiceChannel::messageHandler(messenger::Message::Pointer message, ISensorServiceChannelEventHandler::Pointer eventHandler)
 {
+    this->traceMessage(*message);
     messenger::MessageId messageId(message->getPayload());
     common::DataConstBuffer payload(message->getPayload(), messageId.getSizeOf());
 
-    switch(messageId.getId())
+    if(!dispatcher_.dispatch(*this, messageId.getId(), payload, eventHandler))
     {
-    case proto::ids::SensorChannelMessage::SENSOR_START_REQUEST:
-        this->handleSensorStartRequest(payload, std::move(eventHandler));
-        break;
-    case proto::ids::ControlMessage::CHANNEL_OPEN_REQUEST:
-        this->handleChannelOpenRequest(payload, std::move(eventHandler));
-        break;
-    default:
         AASDK_LOG(error) << "[SensorServiceChannel] message not handled: " << messageId.getId();
         this->receive(std::move(eventHandler));
-        break;
     }
 }
 
@@ -100,32 +90,6 @@ void SensorServiceChannel::sendSensorStartResponse(const proto::messages::Sensor
     this->send(std::move(message), std::move(promise));
 }
 
-void SensorServiceChannel::handleSensorStartRequest(const common::DataConstBuffer& payload, ISensorServiceChannelEventHandler::Pointer eventHandler)
-{
-    proto::messages::SensorStartRequestMessage request;
-    if(request.ParseFromArray(payload.cdata, payload.size))
-    {
-        eventHandler->onSensorStartRequest(request);
-    }
-    else
-    {
-        eventHandler->onChannelError(error::Error(error::ErrorCode::PARSE_PAYLOAD));
-    }
-}
-
-void SensorServiceChannel::handleChannelOpenRequest(const common::DataConstBuffer& payload, ISensorServiceChannelEventHandler::Pointer eventHandler)
-{
-    proto::messages::ChannelOpenRequest request;
-    if(request.ParseFromArray(payload.cdata, payload.size))
-    {
-        eventHandler->onChannelOpenRequest(request);
-    }
-    else
-    {
-        eventHandler->onChannelError(error::Error(error::ErrorCode::PARSE_PAYLOAD));
-    }
-}
-
 }
 }
 }
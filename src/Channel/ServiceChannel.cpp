@@ -17,6 +17,7 @@
 */
 
 #include <aasdk/IO/PromiseLink.hpp>
+#include <aasdk/Messenger/LatencyTracer.hpp>
 #include <aasdk/Channel/ServiceChannel.hpp>
 
 
@@ -42,5 +43,16 @@ void ServiceChannel::send(messenger::Message::Pointer message, SendPromise::Poin
     messenger_->enqueueSend(std::move(message), std::move(sendPromise));
 }
 
+void ServiceChannel::traceMessage(messenger::Message& message) const
+{
+    auto& trace = message.getTrace();
+
+    if(trace.getTracer() != nullptr)
+    {
+        trace.mark(messenger::TraceStage::CHANNEL_HANDLER_ENTERED);
+        trace.getTracer()->record(channelId_, trace);
+    }
+}
+
 }
 }
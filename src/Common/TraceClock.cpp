@@ -0,0 +1,50 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <aasdk/Common/TraceClock.hpp>
+
+
+namespace aasdk
+{
+namespace common
+{
+
+std::atomic<size_t> TraceClock::users_(0);
+
+TraceClock::time_point TraceClock::now()
+{
+    return isEnabled() ? Clock::now() : time_point();
+}
+
+bool TraceClock::isEnabled()
+{
+    return users_.load(std::memory_order_relaxed) > 0;
+}
+
+void TraceClock::enable()
+{
+    users_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void TraceClock::disable()
+{
+    users_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+}
+}
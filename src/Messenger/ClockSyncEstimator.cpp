@@ -0,0 +1,173 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <limits>
+#include <aasdk/Messenger/ClockSyncEstimator.hpp>
+
+
+namespace aasdk
+{
+namespace messenger
+{
+
+namespace
+{
+
+constexpr int64_t cBucketDurationMicroseconds = 1000 * 1000;
+constexpr size_t cMaxSamples = 16;
+// Anything beyond this is a broken sample set rather than a crystal.
+constexpr double cMaxDrift = 1000e-6;
+
+int64_t toMicroseconds(ClockSyncEstimator::Clock::time_point timePoint)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(timePoint.time_since_epoch()).count();
+}
+
+}
+
+ClockSyncEstimator::ClockSyncEstimator()
+    : minRoundTripTime_(std::numeric_limits<int64_t>::max())
+    , bucketStart_(0)
+    , referenceTimestamp_(0)
+    , offset_(0)
+    , drift_(0)
+    , isSynchronized_(false)
+{
+
+}
+
+int64_t ClockSyncEstimator::now()
+{
+    return toMicroseconds(Clock::now());
+}
+
+void ClockSyncEstimator::onPingResponse(int64_t requestTimestamp, Clock::time_point arrival)
+{
+    const auto roundTripTime = toMicroseconds(arrival) - requestTimestamp;
+
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    if(roundTripTime >= 0 && roundTripTime < minRoundTripTime_)
+    {
+        minRoundTripTime_ = roundTripTime;
+    }
+}
+
+void ClockSyncEstimator::onPingRequest(int64_t phoneTimestamp, Clock::time_point arrival)
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    this->addSample(phoneTimestamp, arrival);
+}
+
+void ClockSyncEstimator::onMediaTimestamp(Timestamp::ValueType phoneTimestamp, Clock::time_point arrival)
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    this->addSample(static_cast<int64_t>(phoneTimestamp), arrival);
+}
+
+bool ClockSyncEstimator::isSynchronized() const
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    return isSynchronized_;
+}
+
+ClockSyncEstimator::Clock::time_point ClockSyncEstimator::toLocal(Timestamp::ValueType phoneTimestamp) const
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    const auto phone = static_cast<int64_t>(phoneTimestamp);
+    const auto offset = offset_ + drift_ * static_cast<double>(phone - referenceTimestamp_);
+    return Clock::time_point(std::chrono::duration_cast<Clock::duration>(std::chrono::microseconds(phone + static_cast<int64_t>(offset))));
+}
+
+double ClockSyncEstimator::getDrift() const
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    return drift_ * 1e6;
+}
+
+ClockSyncEstimator::Clock::duration ClockSyncEstimator::getMinRoundTripTime() const
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    return minRoundTripTime_ == std::numeric_limits<int64_t>::max() ? Clock::duration::zero() : std::chrono::microseconds(minRoundTripTime_);
+}
+
+void ClockSyncEstimator::addSample(int64_t phoneTimestamp, Clock::time_point arrival)
+{
+    const auto oneWayDelay = minRoundTripTime_ == std::numeric_limits<int64_t>::max() ? 0 : minRoundTripTime_ / 2;
+    const Sample sample{phoneTimestamp, toMicroseconds(arrival) - phoneTimestamp - oneWayDelay};
+
+    if(!samples_.empty() && (phoneTimestamp + cBucketDurationMicroseconds < bucketStart_ || phoneTimestamp - samples_.back().phoneTimestamp > static_cast<int64_t>(cMaxSamples) * cBucketDurationMicroseconds))
+    {
+        // The phone clock went backwards or stood still for long, start over.
+        samples_.clear();
+    }
+
+    if(samples_.empty() || phoneTimestamp - bucketStart_ >= cBucketDurationMicroseconds)
+    {
+        samples_.push_back(sample);
+        bucketStart_ = phoneTimestamp;
+
+        if(samples_.size() > cMaxSamples)
+        {
+            samples_.pop_front();
+        }
+    }
+    else if(sample.offset < samples_.back().offset)
+    {
+        // Every second is represented by its lowest bound.
+        samples_.back() = sample;
+    }
+
+    this->fit();
+}
+
+void ClockSyncEstimator::fit()
+{
+    referenceTimestamp_ = samples_.back().phoneTimestamp;
+    isSynchronized_ = true;
+
+    if(samples_.size() < 2)
+    {
+        offset_ = static_cast<double>(samples_.back().offset);
+        drift_ = 0;
+        return;
+    }
+
+    double meanX = 0;
+    double meanY = 0;
+    for(const auto& sample : samples_)
+    {
+        meanX += static_cast<double>(sample.phoneTimestamp - referenceTimestamp_);
+        meanY += static_cast<double>(sample.offset);
+    }
+    meanX /= samples_.size();
+    meanY /= samples_.size();
+
+    double covariance = 0;
+    double variance = 0;
+    for(const auto& sample : samples_)
+    {
+        const auto x = static_cast<double>(sample.phoneTimestamp - referenceTimestamp_) - meanX;
+        covariance += x * (static_cast<double>(sample.offset) - meanY);
+        variance += x * x;
+    }
+
+    drift_ = variance > 0 ? std::max(-cMaxDrift, std::min(cMaxDrift, covariance / variance)) : 0;
+    offset_ = meanY - drift_ * meanX;
+}
+
+}
+}
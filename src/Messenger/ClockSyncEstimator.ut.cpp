@@ -0,0 +1,82 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <boost/test/unit_test.hpp>
+#include <aasdk/Messenger/ClockSyncEstimator.hpp>
+
+
+namespace aasdk
+{
+namespace messenger
+{
+namespace ut
+{
+
+namespace
+{
+
+typedef ClockSyncEstimator::Clock Clock;
+
+// Local time of a phone timestamp for a phone clock 5 s behind and running 100 ppm slow.
+Clock::time_point toLocal(int64_t phoneTimestamp)
+{
+    return Clock::time_point(std::chrono::microseconds(5000000 + phoneTimestamp + phoneTimestamp / 10000));
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(ClockSyncEstimator_OffsetAndDrift)
+{
+    ClockSyncEstimator estimator;
+    BOOST_CHECK(!estimator.isSynchronized());
+
+    // Pings with a 4 ms round trip, the one-way delay is half of it.
+    estimator.onPingResponse(1000, Clock::time_point(std::chrono::microseconds(5000)));
+
+    for(int64_t frame = 0; frame < 300; ++frame)
+    {
+        // Frames arrive 2 ms after they were sent, every third one queued 5 ms longer.
+        const auto phoneTimestamp = frame * 33333;
+        const auto delay = std::chrono::microseconds(frame % 3 == 0 ? 7000 : 2000);
+        estimator.onMediaTimestamp(static_cast<Timestamp::ValueType>(phoneTimestamp), toLocal(phoneTimestamp) + delay);
+    }
+
+    BOOST_CHECK(estimator.isSynchronized());
+    BOOST_CHECK(estimator.getMinRoundTripTime() == std::chrono::milliseconds(4));
+    BOOST_CHECK_CLOSE(estimator.getDrift(), 100.0, 1.0);
+
+    const auto error = estimator.toLocal(20000000) - toLocal(20000000);
+    BOOST_CHECK(std::chrono::abs(error) < std::chrono::microseconds(100));
+}
+
+BOOST_AUTO_TEST_CASE(ClockSyncEstimator_RestartOnClockJump)
+{
+    ClockSyncEstimator estimator;
+
+    estimator.onPingRequest(100000000, Clock::time_point(std::chrono::microseconds(100000000)));
+    estimator.onPingRequest(101000000, Clock::time_point(std::chrono::microseconds(101000000)));
+
+    // The phone restarted its clock, the old samples no longer apply.
+    estimator.onPingRequest(1000, Clock::time_point(std::chrono::microseconds(102000000)));
+
+    BOOST_CHECK(estimator.toLocal(2000) == Clock::time_point(std::chrono::microseconds(102001000)));
+    BOOST_CHECK_EQUAL(estimator.getDrift(), 0.0);
+}
+
+}
+}
+}
@@ -1,6 +1,7 @@
 #include <algorithm>
 #include <functional>
 #include <aasdk/Messenger/Cryptor.hpp>
+#include <aasdk/Messenger/RecordDecryptor.hpp>
 #include <aasdk/Error/Error.hpp>
 #include <aasdk/Common/Log.hpp>
 
@@ -10,13 +11,29 @@ namespace messenger
 {
 
 Cryptor::Cryptor(transport::ISSLWrapper::Pointer sslWrapper)
+    : Cryptor(std::move(sslWrapper), nullptr, std::string())
+{
+
+}
+
+Cryptor::Cryptor(transport::ISSLWrapper::Pointer sslWrapper, Role role)
+    : Cryptor(std::move(sslWrapper), nullptr, std::string())
+{
+    role_ = role;
+}
+
+Cryptor::Cryptor(transport::ISSLWrapper::Pointer sslWrapper, ISSLSessionCache::Pointer sessionCache, std::string deviceId)
     : sslWrapper_(std::move(sslWrapper))
+    , role_(Role::CLIENT)
     , maxBufferSize_(1024 * 20)
     , certificate_(nullptr)
     , privateKey_(nullptr)
     , context_(nullptr)
     , ssl_(nullptr)
     , isActive_(false)
+    , sessionCache_(std::move(sessionCache))
+    , deviceId_(std::move(deviceId))
+    , isHandshakeStarted_(false)
 {
 
 }
@@ -39,7 +56,7 @@ void Cryptor::init()
         throw error::Error(error::ErrorCode::SSL_READ_PRIVATE_KEY);
     }
 
-    auto method = sslWrapper_->getMethod();
+    auto method = role_ == Role::SERVER ? sslWrapper_->getServerMethod() : sslWrapper_->getMethod();
 
     if(method == nullptr)
     {
@@ -84,7 +101,15 @@ void Cryptor::init()
 
     sslWrapper_->setBIOs(ssl_, bIOs_, maxBufferSize_);
 
-    sslWrapper_->setConnectState(ssl_);
+    if(role_ == Role::SERVER)
+    {
+        sslWrapper_->setAcceptState(ssl_);
+    }
+    else
+    {
+        this->restoreSession();
+        sslWrapper_->setConnectState(ssl_);
+    }
 }
 
 void Cryptor::deinit()
@@ -93,6 +118,12 @@ void Cryptor::deinit()
 
     if(ssl_ != nullptr)
     {
+        if(isActive_)
+        {
+            // TLS 1.3 tickets arrive after the handshake, so refresh the cached session before it is gone.
+            this->storeSession();
+        }
+
         sslWrapper_->free(ssl_);
         ssl_ = nullptr;
     }
@@ -116,12 +147,20 @@ void Cryptor::deinit()
         sslWrapper_->free(privateKey_);
         privateKey_ = nullptr;
     }
+
+    isHandshakeStarted_ = false;
 }
 
 bool Cryptor::doHandshake()
 {
     std::lock_guard<decltype(mutex_)> lock(mutex_);
 
+    if(!isHandshakeStarted_)
+    {
+        isHandshakeStarted_ = true;
+        handshakeStartTime_ = std::chrono::steady_clock::now();
+    }
+
     auto result = sslWrapper_->doHandshake(ssl_);
     if(result == SSL_ERROR_WANT_READ)
     {
@@ -130,15 +169,57 @@ bool Cryptor::doHandshake()
     else if(result == SSL_ERROR_NONE)
     {
         isActive_ = true;
+
+        const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - handshakeStartTime_);
+        const auto resumed = sslWrapper_->isSessionReused(ssl_);
+        AASDK_LOG(info) << "[Cryptor] " << (resumed ? "Resumed" : "Full") << " handshake completed in " << duration.count() << " us.";
+
+        if(sessionCache_ != nullptr)
+        {
+            sessionCache_->reportHandshake(resumed, duration);
+            this->storeSession();
+        }
+
         return true;
     }
     else
     {
+        if(sessionCache_ != nullptr)
+        {
+            sessionCache_->remove(deviceId_);
+        }
+
         throw error::Error(error::ErrorCode::SSL_HANDSHAKE, result);
     }
 }
 
 size_t Cryptor::encrypt(common::Data& output, const common::DataConstBuffer& buffer)
+{
+    error::Error e;
+    const auto size = this->encrypt(output, buffer, e);
+
+    if(e != error::ErrorCode::NONE)
+    {
+        throw e;
+    }
+
+    return size;
+}
+
+size_t Cryptor::decrypt(common::Data& output, const common::DataConstBuffer& buffer, int frameLength)
+{
+    error::Error e;
+    const auto size = this->decrypt(output, buffer, frameLength, e);
+
+    if(e != error::ErrorCode::NONE)
+    {
+        throw e;
+    }
+
+    return size;
+}
+
+size_t Cryptor::encrypt(common::Data& output, const common::DataConstBuffer& buffer, error::Error& e)
 {
     std::lock_guard<decltype(mutex_)> lock(mutex_);
 
@@ -151,22 +232,28 @@ size_t Cryptor::encrypt(common::Data& output, const common::DataConstBuffer& buf
 
         if(writeSize <= 0)
         {
-            throw error::Error(error::ErrorCode::SSL_WRITE, sslWrapper_->getError(ssl_, writeSize));
+            e = error::Error(error::ErrorCode::SSL_WRITE, sslWrapper_->getError(ssl_, writeSize));
+            return 0;
         }
 
         totalWrittenBytes += writeSize;
     }
 
-    return this->read(output);
+    return this->read(output, e);
 }
 
-size_t Cryptor::decrypt(common::Data& output, const common::DataConstBuffer& buffer, int frameLength)
+size_t Cryptor::decrypt(common::Data& output, const common::DataConstBuffer& buffer, int frameLength, error::Error& e)
 {
     int overhead = 29;
     int length = frameLength - overhead;
     std::lock_guard<decltype(mutex_)> lock(mutex_);
 
-    this->write(buffer);
+    this->write(buffer, e);
+    if(e != error::ErrorCode::NONE)
+    {
+        return 0;
+    }
+
     const size_t beginOffset = output.size();
     //output.resize(beginOffset + 1);
 
@@ -186,7 +273,8 @@ size_t Cryptor::decrypt(common::Data& output, const common::DataConstBuffer& buf
 
         if(readSize <= 0)
         {
-            throw error::Error(error::ErrorCode::SSL_READ, sslWrapper_->getError(ssl_, readSize));
+            e = error::Error(error::ErrorCode::SSL_READ, sslWrapper_->getError(ssl_, readSize));
+            return 0;
         }
 
         totalReadSize += readSize;
@@ -204,7 +292,14 @@ common::Data Cryptor::readHandshakeBuffer()
     std::lock_guard<decltype(mutex_)> lock(mutex_);
 
     common::Data output;
-    this->read(output);
+    error::Error e;
+    this->read(output, e);
+
+    if(e != error::ErrorCode::NONE)
+    {
+        throw e;
+    }
+
     return output;
 }
 
@@ -212,10 +307,16 @@ void Cryptor::writeHandshakeBuffer(const common::DataConstBuffer& buffer)
 {
     std::lock_guard<decltype(mutex_)> lock(mutex_);
 
-    this->write(buffer);
+    error::Error e;
+    this->write(buffer, e);
+
+    if(e != error::ErrorCode::NONE)
+    {
+        throw e;
+    }
 }
 
-size_t Cryptor::read(common::Data& output)
+size_t Cryptor::read(common::Data& output, error::Error& e)
 {
     const auto pendingSize = sslWrapper_->bioCtrlPending(bIOs_.second);
 
@@ -230,7 +331,8 @@ size_t Cryptor::read(common::Data& output)
 
         if(readSize <= 0)
         {
-            throw error::Error(error::ErrorCode::SSL_BIO_READ, sslWrapper_->getError(ssl_, readSize));
+            e = error::Error(error::ErrorCode::SSL_BIO_READ, sslWrapper_->getError(ssl_, readSize));
+            return 0;
         }
 
         totalReadSize += readSize;
@@ -239,7 +341,7 @@ size_t Cryptor::read(common::Data& output)
     return totalReadSize;
 }
 
-void Cryptor::write(const common::DataConstBuffer& buffer)
+void Cryptor::write(const common::DataConstBuffer& buffer, error::Error& e)
 {
     size_t totalWrittenBytes = 0;
 
@@ -250,13 +352,53 @@ void Cryptor::write(const common::DataConstBuffer& buffer)
 
         if(writeSize <= 0)
         {
-            throw error::Error(error::ErrorCode::SSL_BIO_WRITE, sslWrapper_->getError(ssl_, writeSize));
+            e = error::Error(error::ErrorCode::SSL_BIO_WRITE, sslWrapper_->getError(ssl_, writeSize));
+            return;
         }
 
         totalWrittenBytes += writeSize;
     }
 }
 
+void Cryptor::restoreSession()
+{
+    if(sessionCache_ == nullptr || deviceId_.empty())
+    {
+        return;
+    }
+
+    auto session = sessionCache_->find(deviceId_);
+
+    if(session != nullptr && !sslWrapper_->setSession(ssl_, session.get()))
+    {
+        sessionCache_->remove(deviceId_);
+    }
+}
+
+void Cryptor::storeSession()
+{
+    if(sessionCache_ == nullptr || deviceId_.empty())
+    {
+        return;
+    }
+
+    auto session = sslWrapper_->getSession(ssl_);
+
+    if(session == nullptr)
+    {
+        return;
+    }
+
+    if(!sslWrapper_->isSessionResumable(session))
+    {
+        sslWrapper_->free(session);
+        return;
+    }
+
+    auto sslWrapper = sslWrapper_;
+    sessionCache_->store(deviceId_, ISSLSessionCache::Session(session, [sslWrapper](SSL_SESSION* session) { sslWrapper->free(session); }));
+}
+
 bool Cryptor::isActive() const
 {
     std::lock_guard<decltype(mutex_)> lock(mutex_);
@@ -264,6 +406,20 @@ bool Cryptor::isActive() const
     return isActive_;
 }
 
+IRecordDecryptor::Pointer Cryptor::createRecordDecryptor()
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    transport::ISSLWrapper::RecordKeys keys;
+
+    if(!isActive_ || !sslWrapper_->exportPeerRecordKeys(ssl_, keys))
+    {
+        return nullptr;
+    }
+
+    return std::make_shared<RecordDecryptor>(std::move(keys));
+}
+
 const std::string Cryptor::cCertificate = "-----BEGIN CERTIFICATE-----\n\
 MIIDKjCCAhICARswDQYJKoZIhvcNAQELBQAwWzELMAkGA1UEBhMCVVMxEzARBgNV\n\
 BAgMCkNhbGlmb3JuaWExFjAUBgNVBAcMDU1vdW50YWluIFZpZXcxHzAdBgNVBAoM\n\
@@ -0,0 +1,161 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <boost/test/unit_test.hpp>
+#include <Transport/UT/SSLWrapper.mock.hpp>
+#include <aasdk/Messenger/Cryptor.hpp>
+#include <aasdk/Messenger/SSLSessionCache.hpp>
+#include <aasdk/Error/Error.hpp>
+
+
+namespace aasdk
+{
+namespace messenger
+{
+namespace ut
+{
+
+using ::testing::_;
+using ::testing::Return;
+using ::testing::NiceMock;
+
+class CryptorUnitTest
+{
+protected:
+    CryptorUnitTest()
+        : sslWrapperMock_(std::make_shared<NiceMock<transport::ut::SSLWrapperMock>>())
+        , sessionCache_(std::make_shared<SSLSessionCache>())
+        , certificate_(reinterpret_cast<X509*>(1))
+        , privateKey_(reinterpret_cast<EVP_PKEY*>(2))
+        , method_(reinterpret_cast<const SSL_METHOD*>(3))
+        , context_(reinterpret_cast<SSL_CTX*>(4))
+        , ssl_(reinterpret_cast<SSL*>(5))
+        , bIOs_(reinterpret_cast<BIO*>(6), reinterpret_cast<BIO*>(7))
+    {
+        ON_CALL(*sslWrapperMock_, readCertificate(_)).WillByDefault(Return(certificate_));
+        ON_CALL(*sslWrapperMock_, readPrivateKey(_)).WillByDefault(Return(privateKey_));
+        ON_CALL(*sslWrapperMock_, getMethod()).WillByDefault(Return(method_));
+        ON_CALL(*sslWrapperMock_, createContext(method_)).WillByDefault(Return(context_));
+        ON_CALL(*sslWrapperMock_, useCertificate(context_, certificate_)).WillByDefault(Return(true));
+        ON_CALL(*sslWrapperMock_, usePrivateKey(context_, privateKey_)).WillByDefault(Return(true));
+        ON_CALL(*sslWrapperMock_, createInstance(context_)).WillByDefault(Return(ssl_));
+        ON_CALL(*sslWrapperMock_, createBIOs()).WillByDefault(Return(bIOs_));
+        // Sessions handed to the cache are real, so the cache can free them.
+        ON_CALL(*sslWrapperMock_, free(::testing::An<SSL_SESSION*>())).WillByDefault(::testing::Invoke([](SSL_SESSION* session) { SSL_SESSION_free(session); }));
+    }
+
+    Cryptor::Pointer createCryptor()
+    {
+        return std::make_shared<Cryptor>(sslWrapperMock_, sessionCache_, "serial-1");
+    }
+
+    static ISSLSessionCache::Session createSession()
+    {
+        return ISSLSessionCache::Session(SSL_SESSION_new(), &SSL_SESSION_free);
+    }
+
+    std::shared_ptr<NiceMock<transport::ut::SSLWrapperMock>> sslWrapperMock_;
+    std::shared_ptr<SSLSessionCache> sessionCache_;
+    X509* certificate_;
+    EVP_PKEY* privateKey_;
+    const SSL_METHOD* method_;
+    SSL_CTX* context_;
+    SSL* ssl_;
+    transport::ISSLWrapper::BIOs bIOs_;
+};
+
+BOOST_FIXTURE_TEST_CASE(Cryptor_RestoreCachedSession, CryptorUnitTest)
+{
+    const auto session = createSession();
+    sessionCache_->store("serial-1", session);
+
+    EXPECT_CALL(*sslWrapperMock_, setSession(ssl_, session.get())).WillOnce(Return(true));
+    EXPECT_CALL(*sslWrapperMock_, setConnectState(ssl_));
+
+    auto cryptor = this->createCryptor();
+    cryptor->init();
+
+    BOOST_CHECK(sessionCache_->find("serial-1") == session);
+}
+
+BOOST_FIXTURE_TEST_CASE(Cryptor_DropSessionRejectedBySSL, CryptorUnitTest)
+{
+    sessionCache_->store("serial-1", createSession());
+    EXPECT_CALL(*sslWrapperMock_, setSession(ssl_, _)).WillOnce(Return(false));
+
+    auto cryptor = this->createCryptor();
+    cryptor->init();
+
+    BOOST_CHECK(sessionCache_->find("serial-1") == nullptr);
+}
+
+BOOST_FIXTURE_TEST_CASE(Cryptor_StoreSessionAfterHandshake, CryptorUnitTest)
+{
+    auto cryptor = this->createCryptor();
+    EXPECT_CALL(*sslWrapperMock_, setSession(_, _)).Times(0);
+    cryptor->init();
+
+    auto session = SSL_SESSION_new();
+    EXPECT_CALL(*sslWrapperMock_, doHandshake(ssl_)).WillOnce(Return(SSL_ERROR_WANT_READ)).WillOnce(Return(SSL_ERROR_NONE));
+    EXPECT_CALL(*sslWrapperMock_, isSessionReused(ssl_)).WillOnce(Return(true));
+    EXPECT_CALL(*sslWrapperMock_, getSession(ssl_)).WillOnce(Return(session));
+    EXPECT_CALL(*sslWrapperMock_, isSessionResumable(session)).WillOnce(Return(true));
+
+    BOOST_CHECK(!cryptor->doHandshake());
+    BOOST_CHECK(cryptor->doHandshake());
+
+    BOOST_CHECK(sessionCache_->find("serial-1").get() == session);
+    const auto statistics = sessionCache_->getStatistics();
+    BOOST_CHECK_EQUAL(statistics.resumedHandshakes, 1u);
+    BOOST_CHECK_EQUAL(statistics.fullHandshakes, 0u);
+}
+
+BOOST_FIXTURE_TEST_CASE(Cryptor_SkipNonResumableSession, CryptorUnitTest)
+{
+    auto cryptor = this->createCryptor();
+    cryptor->init();
+
+    auto session = SSL_SESSION_new();
+    EXPECT_CALL(*sslWrapperMock_, doHandshake(ssl_)).WillOnce(Return(SSL_ERROR_NONE));
+    EXPECT_CALL(*sslWrapperMock_, isSessionReused(ssl_)).WillOnce(Return(false));
+    EXPECT_CALL(*sslWrapperMock_, getSession(ssl_)).WillOnce(Return(session));
+    EXPECT_CALL(*sslWrapperMock_, isSessionResumable(session)).WillOnce(Return(false));
+    EXPECT_CALL(*sslWrapperMock_, free(session));
+
+    BOOST_CHECK(cryptor->doHandshake());
+    BOOST_CHECK(sessionCache_->find("serial-1") == nullptr);
+    BOOST_CHECK_EQUAL(sessionCache_->getStatistics().fullHandshakes, 1u);
+}
+
+BOOST_FIXTURE_TEST_CASE(Cryptor_EvictSessionOnFailedHandshake, CryptorUnitTest)
+{
+    const auto session = createSession();
+    sessionCache_->store("serial-1", session);
+    EXPECT_CALL(*sslWrapperMock_, setSession(ssl_, session.get())).WillOnce(Return(true));
+
+    auto cryptor = this->createCryptor();
+    cryptor->init();
+
+    EXPECT_CALL(*sslWrapperMock_, doHandshake(ssl_)).WillOnce(Return(SSL_ERROR_SSL));
+    BOOST_CHECK_EXCEPTION(cryptor->doHandshake(), error::Error, [](const error::Error& e) { return e == error::ErrorCode::SSL_HANDSHAKE; });
+
+    BOOST_CHECK(sessionCache_->find("serial-1") == nullptr);
+}
+
+}
+}
+}
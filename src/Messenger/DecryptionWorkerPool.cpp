@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <aasdk/Messenger/DecryptionWorkerPool.hpp>
+
+
+namespace aasdk
+{
+namespace messenger
+{
+
+DecryptionWorkerPool::DecryptionWorkerPool(size_t workerCount)
+    : state_(std::make_shared<State>())
+{
+    workerCount = std::max<size_t>(workerCount, 1);
+
+    for(size_t i = 0; i < workerCount; ++i)
+    {
+        workers_.emplace_back(&DecryptionWorkerPool::run, state_);
+    }
+}
+
+DecryptionWorkerPool::~DecryptionWorkerPool()
+{
+    {
+        std::lock_guard<decltype(state_->mutex)> lock(state_->mutex);
+        state_->isStopped = true;
+    }
+
+    state_->condition.notify_all();
+
+    for(auto& worker : workers_)
+    {
+        // The last job may hold the last reference to the pool, its worker keeps the state alive.
+        if(worker.get_id() == std::this_thread::get_id())
+        {
+            worker.detach();
+        }
+        else
+        {
+            worker.join();
+        }
+    }
+}
+
+void DecryptionWorkerPool::post(Job job)
+{
+    {
+        std::lock_guard<decltype(state_->mutex)> lock(state_->mutex);
+        state_->jobs.emplace_back(std::move(job));
+    }
+
+    state_->condition.notify_one();
+}
+
+size_t DecryptionWorkerPool::getWorkerCount() const
+{
+    return workers_.size();
+}
+
+void DecryptionWorkerPool::run(std::shared_ptr<State> state)
+{
+    while(true)
+    {
+        Job job;
+
+        {
+            std::unique_lock<decltype(state->mutex)> lock(state->mutex);
+            state->condition.wait(lock, [&state]() { return state->isStopped || !state->jobs.empty(); });
+
+            if(state->isStopped)
+            {
+                return;
+            }
+
+            job = std::move(state->jobs.front());
+            state->jobs.pop_front();
+        }
+
+        job();
+    }
+}
+
+}
+}
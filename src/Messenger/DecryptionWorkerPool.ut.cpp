@@ -0,0 +1,86 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <future>
+#include <aasdk/Messenger/DecryptionWorkerPool.hpp>
+
+
+namespace aasdk
+{
+namespace messenger
+{
+namespace ut
+{
+
+namespace
+{
+
+// Stands in for a stream which owns the pool and is kept alive by the jobs it posts.
+struct PoolOwner
+{
+    DecryptionWorkerPool::Pointer decryptionWorkerPool = std::make_shared<DecryptionWorkerPool>(2);
+};
+
+}
+
+BOOST_AUTO_TEST_CASE(DecryptionWorkerPool_RunPostedJobs)
+{
+    DecryptionWorkerPool decryptionWorkerPool(2);
+    BOOST_CHECK_EQUAL(decryptionWorkerPool.getWorkerCount(), 2u);
+
+    std::promise<void> done;
+    std::atomic<int> counter(0);
+
+    for(int i = 0; i < 10; ++i)
+    {
+        decryptionWorkerPool.post([&]() {
+            if(++counter == 10)
+            {
+                done.set_value();
+            }
+        });
+    }
+
+    BOOST_CHECK(done.get_future().wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+}
+
+BOOST_AUTO_TEST_CASE(DecryptionWorkerPool_DropLastReferenceFromJob)
+{
+    std::promise<void> released;
+
+    {
+        auto owner = std::make_shared<PoolOwner>();
+        auto decryptionWorkerPool = owner->decryptionWorkerPool;
+
+        decryptionWorkerPool->post([owner, &released]() mutable {
+            // Destroys the pool on its own worker thread.
+            owner.reset();
+            released.set_value();
+        });
+
+        owner.reset();
+        decryptionWorkerPool.reset();
+    }
+
+    BOOST_CHECK(released.get_future().wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+}
+
+}
+}
+}
@@ -0,0 +1,174 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <aasdk/Messenger/LatencyTracer.hpp>
+
+
+namespace aasdk
+{
+namespace messenger
+{
+
+LatencyHistogram::LatencyHistogram()
+    : count_(0)
+    , sum_(common::TraceClock::duration::zero())
+    , max_(common::TraceClock::duration::zero())
+{
+    buckets_.fill(0);
+}
+
+void LatencyHistogram::add(common::TraceClock::duration duration)
+{
+    ++buckets_[metrics::HistogramSnapshot::getBucket(duration)];
+    ++count_;
+    sum_ += duration;
+    max_ = std::max(max_, duration);
+}
+
+size_t LatencyHistogram::getCount() const
+{
+    return count_;
+}
+
+common::TraceClock::duration LatencyHistogram::getMean() const
+{
+    return count_ > 0 ? sum_ / static_cast<common::TraceClock::duration::rep>(count_) : common::TraceClock::duration::zero();
+}
+
+common::TraceClock::duration LatencyHistogram::getMax() const
+{
+    return max_;
+}
+
+common::TraceClock::duration LatencyHistogram::getPercentile(double fraction) const
+{
+    const auto threshold = static_cast<size_t>(std::ceil(fraction * count_));
+    size_t accumulated = 0;
+
+    for(size_t bucket = 0; bucket < cBucketCount; ++bucket)
+    {
+        accumulated += buckets_[bucket];
+
+        if(accumulated > 0 && accumulated >= threshold)
+        {
+            return std::min(max_, getBucketUpperBound(bucket));
+        }
+    }
+
+    return max_;
+}
+
+const std::array<size_t, LatencyHistogram::cBucketCount>& LatencyHistogram::getBuckets() const
+{
+    return buckets_;
+}
+
+common::TraceClock::duration LatencyHistogram::getBucketUpperBound(size_t bucket)
+{
+    return std::chrono::duration_cast<common::TraceClock::duration>(metrics::HistogramSnapshot::getBucketUpperBound(bucket));
+}
+
+LatencyTracer::LatencyTracer()
+{
+    common::TraceClock::enable();
+}
+
+LatencyTracer::~LatencyTracer()
+{
+    common::TraceClock::disable();
+}
+
+void LatencyTracer::setCallback(Callback callback)
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    callback_ = std::move(callback);
+}
+
+void LatencyTracer::record(ChannelId channelId, const MessageTrace& trace)
+{
+    Callback callback;
+
+    {
+        std::lock_guard<decltype(mutex_)> lock(mutex_);
+        auto& histograms = channels_[channelId];
+        bool isFirstStage = true;
+
+        // The first marked stage only anchors the trace.
+        for(size_t i = 0; i < histograms.stages.size(); ++i)
+        {
+            const auto stage = static_cast<TraceStage>(i);
+            if(trace.isMarked(stage))
+            {
+                if(!isFirstStage)
+                {
+                    histograms.stages[i].add(trace.getStageDuration(stage));
+                }
+
+                isFirstStage = false;
+            }
+        }
+
+        histograms.total.add(trace.getTotalDuration());
+        callback = callback_;
+    }
+
+    if(callback)
+    {
+        callback(channelId, trace);
+    }
+}
+
+void LatencyTracer::reset()
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    channels_.clear();
+}
+
+std::vector<ChannelId> LatencyTracer::getChannelIds() const
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    std::vector<ChannelId> channelIds;
+    for(const auto& channel : channels_)
+    {
+        channelIds.push_back(channel.first);
+    }
+
+    return channelIds;
+}
+
+LatencyHistogram LatencyTracer::getStageHistogram(ChannelId channelId, TraceStage stage) const
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    auto channel = channels_.find(channelId);
+    return channel != channels_.end() ? channel->second.stages[static_cast<size_t>(stage)] : LatencyHistogram();
+}
+
+LatencyHistogram LatencyTracer::getTotalHistogram(ChannelId channelId) const
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    auto channel = channels_.find(channelId);
+    return channel != channels_.end() ? channel->second.total : LatencyHistogram();
+}
+
+}
+}
@@ -0,0 +1,89 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <boost/test/unit_test.hpp>
+#include <aasdk/Messenger/LatencyTracer.hpp>
+
+
+namespace aasdk
+{
+namespace messenger
+{
+namespace ut
+{
+
+BOOST_AUTO_TEST_CASE(LatencyTracer_EnableTraceClockWhileAlive)
+{
+    BOOST_CHECK(common::TraceClock::now() == common::TraceClock::time_point());
+
+    {
+        LatencyTracer latencyTracer;
+        BOOST_CHECK(common::TraceClock::isEnabled());
+        BOOST_CHECK(common::TraceClock::now() != common::TraceClock::time_point());
+    }
+
+    BOOST_CHECK(!common::TraceClock::isEnabled());
+}
+
+BOOST_AUTO_TEST_CASE(LatencyTracer_RecordStageDurations)
+{
+    LatencyTracer latencyTracer;
+
+    ChannelId tracedChannelId = ChannelId::NONE;
+    latencyTracer.setCallback([&](ChannelId channelId, const MessageTrace&) { tracedChannelId = channelId; });
+
+    const auto start = common::TraceClock::now();
+    MessageTrace trace;
+    trace.mark(TraceStage::TRANSFER_COMPLETED, start);
+    trace.mark(TraceStage::DATA_DISTRIBUTED, start + std::chrono::microseconds(10));
+    trace.mark(TraceStage::DECRYPTED, start + std::chrono::microseconds(30));
+    trace.mark(TraceStage::CHANNEL_HANDLER_ENTERED, start + std::chrono::microseconds(100));
+
+    latencyTracer.record(ChannelId::VIDEO, trace);
+
+    BOOST_CHECK(tracedChannelId == ChannelId::VIDEO);
+    BOOST_CHECK(latencyTracer.getChannelIds() == std::vector<ChannelId>{ChannelId::VIDEO});
+
+    // Unmarked stages are skipped, so DECRYPTED covers the time since DATA_DISTRIBUTED.
+    BOOST_CHECK_EQUAL(latencyTracer.getStageHistogram(ChannelId::VIDEO, TraceStage::TRANSFER_COMPLETED).getCount(), 0);
+    BOOST_CHECK_EQUAL(latencyTracer.getStageHistogram(ChannelId::VIDEO, TraceStage::FRAME_HEADER_DECODED).getCount(), 0);
+    BOOST_CHECK(latencyTracer.getStageHistogram(ChannelId::VIDEO, TraceStage::DECRYPTED).getMax() == std::chrono::microseconds(20));
+    BOOST_CHECK(latencyTracer.getStageHistogram(ChannelId::VIDEO, TraceStage::CHANNEL_HANDLER_ENTERED).getMax() == std::chrono::microseconds(70));
+    BOOST_CHECK(latencyTracer.getTotalHistogram(ChannelId::VIDEO).getMax() == std::chrono::microseconds(100));
+    BOOST_CHECK_EQUAL(latencyTracer.getTotalHistogram(ChannelId::MEDIA_AUDIO).getCount(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(LatencyHistogram_Percentile)
+{
+    LatencyHistogram histogram;
+
+    for(size_t i = 0; i < 99; ++i)
+    {
+        histogram.add(std::chrono::microseconds(3));
+    }
+    histogram.add(std::chrono::milliseconds(5));
+
+    BOOST_CHECK_EQUAL(histogram.getCount(), 100);
+    BOOST_CHECK(histogram.getPercentile(0.5) == std::chrono::microseconds(4));
+    BOOST_CHECK(histogram.getPercentile(0.99) == std::chrono::microseconds(4));
+    BOOST_CHECK(histogram.getPercentile(1.0) == std::chrono::milliseconds(5));
+}
+
+}
+}
+}
@@ -18,6 +18,7 @@ Message::Message(Message&& other)
     , encryptionType_(other.encryptionType_)
     , type_(other.type_)
     , payload_(std::move(other.payload_))
+    , trace_(std::move(other.trace_))
 {
 
 }
@@ -28,6 +29,7 @@ Message& Message::operator=(Message&& other)
   encryptionType_ = other.encryptionType_;
   type_ = other.type_;
   payload_ = std::move(other.payload_);
+  trace_ = std::move(other.trace_);
 
   return *this;
 }
@@ -64,11 +66,11 @@ void Message::insertPayload(const common::Data& payload)
 
 void Message::insertPayload(const google::protobuf::Message& message)
 {
-    auto offset = payload_.size();
-    payload_.resize(payload_.size() + message.ByteSize());
+    const auto offset = payload_.size();
+    payload_.resize(offset + message.ByteSizeLong());
 
-    common::DataBuffer buffer(payload_, offset);
-    message.SerializeToArray(buffer.data, buffer.size);
+    // ByteSizeLong() cached the size of every submessage, so the tree is walked only once more.
+    message.SerializeWithCachedSizesToArray(payload_.data() + offset);
 }
 
 void Message::insertPayload(const common::DataConstBuffer& buffer)
@@ -81,5 +83,15 @@ void Message::insertPayload(common::DataBuffer& buffer)
     common::copy(payload_, buffer);
 }
 
+MessageTrace& Message::getTrace()
+{
+    return trace_;
+}
+
+const MessageTrace& Message::getTrace() const
+{
+    return trace_;
+}
+
 }
 }
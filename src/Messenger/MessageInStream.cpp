@@ -9,9 +9,22 @@ namespace messenger
 {
 
 MessageInStream::MessageInStream(asio::io_service& ioService, transport::ITransport::Pointer transport, ICryptor::Pointer cryptor)
+    : MessageInStream(ioService, std::move(transport), std::move(cryptor), nullptr)
+{
+
+}
+
+MessageInStream::MessageInStream(asio::io_service& ioService, transport::ITransport::Pointer transport, ICryptor::Pointer cryptor, DecryptionWorkerPool::Pointer decryptionWorkerPool)
     : strand_(ioService)
     , transport_(std::move(transport))
     , cryptor_(std::move(cryptor))
+    , frameHeader_(ChannelId::NONE, FrameType::BULK, EncryptionType::PLAIN, MessageType::SPECIFIC)
+    , isReceiving_(false)
+    , decryptionWorkerPool_(std::move(decryptionWorkerPool))
+    , pipelineState_(decryptionWorkerPool_ == nullptr ? PipelineState::DISABLED : PipelineState::PENDING)
+    , recordSequenceNumber_(cFirstApplicationRecordSequenceNumber)
+    , nextFrameIndex_(0)
+    , nextAssembledFrameIndex_(0)
 {
 
 }
@@ -19,76 +32,68 @@ MessageInStream::MessageInStream(asio::io_service& ioService, transport::ITransp
 void MessageInStream::startReceive(ReceivePromise::Pointer promise)
 {
     strand_.dispatch([this, self = this->shared_from_this(), promise = std::move(promise)]() mutable {
-        if(promise_ == nullptr){			
+        if(promise_ == nullptr)
+        {
             promise_ = std::move(promise);
-            auto transportPromise = transport::ITransport::ReceivePromise::defer(strand_);
-            transportPromise->then(
-			 [this, self = this->shared_from_this()](common::Data data) mutable {
-                        this->receiveFrameHeaderHandler(common::DataConstBuffer(data));
-                    },
-                    [this, self = this->shared_from_this()](const error::Error &e) mutable {
-                        promise_->reject(e);
-                        promise_.reset();
-                    });
-
-            transport_->receive(FrameHeader::getSizeOf(), std::move(transportPromise));
-        } else {
+
+            if(pipelineState_ == PipelineState::ACTIVE)
+            {
+                this->resolvePipelinedMessage();
+            }
+            else if(!isReceiving_)
+            {
+                this->receiveFrameHeader();
+            }
+        }
+        else
+        {
             promise->reject(error::Error(error::ErrorCode::OPERATION_IN_PROGRESS));
         }
     });
 }
 
+void MessageInStream::setMetrics(metrics::SessionMetrics::Pointer metrics)
+{
+    metrics_ = std::move(metrics);
+}
+
+void MessageInStream::receiveFrameHeader()
+{
+    isReceiving_ = true;
+
+    auto transportPromise = transport::ITransport::ReceivePromise::defer(strand_);
+    transportPromise->then(
+        [this, self = this->shared_from_this()](common::Data data) mutable {
+            this->receiveFrameHeaderHandler(common::DataConstBuffer(data));
+        },
+        [this, self = this->shared_from_this()](const error::Error& e) mutable {
+            this->rejectReceive(e);
+        });
+
+    transport_->receive(FrameHeader::getSizeOf(), std::move(transportPromise));
+}
+
 void MessageInStream::receiveFrameHeaderHandler(const common::DataConstBuffer& buffer)
 {
     FrameHeader frameHeader(buffer);
+    this->traceFrameHeader();
 
-    /*if(message_ != nullptr && message_->getChannelId() != frameHeader.getChannelId())
+    if(metrics_ != nullptr)
     {
-        messageBuffer_[message_->getChannelId()] = message_;
-        message_ = nullptr;
-    }*/
+        metrics_->getFramesReceived(frameHeader.getType()).increment();
+    }
+
     AASDK_LOG(debug) << "[MessageInStream] Processing Frame Header: Ch " << channelIdToString(frameHeader.getChannelId()) << " Fr " << frameTypeToString(frameHeader.getType());
 
-    isValidFrame_ = true;
+    frameHeader_ = frameHeader;
+	thisFrameType_ = frameHeader.getType();
 
-    auto bufferedMessage = messageBuffer_.find(frameHeader.getChannelId());
-    if (bufferedMessage != messageBuffer_.end()) {
-        // We have found a message...
-        message_ = std::move(bufferedMessage->second);
-        messageBuffer_.erase(bufferedMessage);
-		
-    /*if(bufferedMessage != messageBuffer_.end())
+    // Pipelined frames look up their message once all earlier frames are decrypted.
+    if(pipelineState_ != PipelineState::ACTIVE)
     {
-        if(frameHeader.getType() != FrameType::FIRST)
-        {
-            message_ = bufferedMessage->second;
-        }
-        else
-        {*/
-        AASDK_LOG(debug) << "[MessageInStream] Found existing message.";
-
-        if (frameHeader.getType() == FrameType::FIRST || frameHeader.getType() == FrameType::BULK) {
-            // If it's first or bulk, we need to override the message anyhow, so we will start again.
-            // Need to start a new message anyhow
-            message_ = std::make_shared<Message>(frameHeader.getChannelId(), frameHeader.getEncryptionType(), frameHeader.getMessageType());
-        }
-        /*messageBuffer_.erase(bufferedMessage);
-    }
-    else if(message_ == nullptr)
-    {*/
-	} else {
-        AASDK_LOG(debug) << "[MessageInStream] Could not find existing message.";
-        // No Message Found in Buffers and this is a middle or last frame, this an error.
-        // Still need to process the frame, but we will not resolve at the end.
-        message_ = std::make_shared<Message>(frameHeader.getChannelId(), frameHeader.getEncryptionType(), frameHeader.getMessageType());
-	    if (frameHeader.getType() == FrameType::MIDDLE || frameHeader.getType() == FrameType::LAST) {
-            // This is an error
-            isValidFrame_ = false;
-        }	
+        message_ = this->findMessage(frameHeader, isValidFrame_);
     }
 
-    //recentFrameType_ = frameHeader.getType();
-	thisFrameType_ = frameHeader.getType();
     const size_t frameSize = FrameSize::getSizeOf(frameHeader.getType() == FrameType::FIRST ? FrameSizeType::EXTENDED : FrameSizeType::SHORT);
 
     auto transportPromise = transport::ITransport::ReceivePromise::defer(strand_);
@@ -97,9 +102,7 @@ void MessageInStream::receiveFrameHeaderHandler(const common::DataConstBuffer& b
             this->receiveFrameSizeHandler(common::DataConstBuffer(data));
         },
         [this, self = this->shared_from_this()](const error::Error& e) mutable {
-            message_.reset();
-            promise_->reject(e);
-            promise_.reset();
+            this->rejectReceive(e);
         });
 
     transport_->receive(frameSize, std::move(transportPromise));
@@ -110,35 +113,44 @@ void MessageInStream::receiveFrameSizeHandler(const common::DataConstBuffer& buf
     auto transportPromise = transport::ITransport::ReceivePromise::defer(strand_);
     transportPromise->then(
         [this, self = this->shared_from_this()](common::Data data) mutable {
-            this->receiveFramePayloadHandler(common::DataConstBuffer(data));
+            this->receiveFramePayloadHandler(std::move(data));
         },
         [this, self = this->shared_from_this()](const error::Error& e) mutable {
-            message_.reset();
-            promise_->reject(e);
-            promise_.reset();
+            this->rejectReceive(e);
         });
 
     FrameSize frameSize(buffer);
-    //transport_->receive(frameSize.getSize(), std::move(transportPromise));
     frameSize_ = (int) frameSize.getFrameSize();
     transport_->receive(frameSize.getFrameSize(), std::move(transportPromise));
 }
 
-void MessageInStream::receiveFramePayloadHandler(const common::DataConstBuffer& buffer)
-{   
+void MessageInStream::receiveFramePayloadHandler(common::Data data)
+{
+    if(pipelineState_ == PipelineState::ACTIVE)
+    {
+        this->pipelineFrame(std::move(data));
+        return;
+    }
+
+    const common::DataConstBuffer buffer(data);
+
     if(message_->getEncryptionType() == EncryptionType::ENCRYPTED)
     {
-        try
-        {
-            //cryptor_->decrypt(message_->getPayload(), buffer);
-            cryptor_->decrypt(message_->getPayload(), buffer, frameSize_);	
-        }
-        catch(const error::Error& e)
+        if(pipelineState_ != PipelineState::PENDING || !this->activatePipeline(buffer))
         {
-            message_.reset();
-            promise_->reject(e);
-            promise_.reset();
-            return;
+            error::Error e;
+            cryptor_->decrypt(message_->getPayload(), buffer, frameSize_, e);
+
+            if(e != error::ErrorCode::NONE)
+            {
+                if(metrics_ != nullptr)
+                {
+                    metrics_->getDecryptFailures().increment();
+                }
+
+                this->rejectReceive(e);
+                return;
+            }
         }
     }
     else
@@ -146,13 +158,17 @@ void MessageInStream::receiveFramePayloadHandler(const common::DataConstBuffer&
         message_->insertPayload(buffer);
     }
 
-    //if(recentFrameType_ == FrameType::BULK || recentFrameType_ == FrameType::LAST)
+    frameTrace_.mark(TraceStage::DECRYPTED);
+    message_->getTrace().merge(frameTrace_);
+
 	bool isResolved = false;
 
     // If this is the LAST frame or a BULK frame...
     if((thisFrameType_ == FrameType::BULK || thisFrameType_ == FrameType::LAST) && isValidFrame_)
     {
 		AASDK_LOG(debug) << "[MessageInStream] Resolving message.";
+        message_->getTrace().mark(TraceStage::REASSEMBLED);
+        isReceiving_ = false;
         promise_->resolve(std::move(message_));
         promise_.reset();
 	    isResolved = true;
@@ -162,24 +178,239 @@ void MessageInStream::receiveFramePayloadHandler(const common::DataConstBuffer&
         // First or Middle message, we'll store in our buffer...
         messageBuffer_[message_->getChannelId()] = std::move(message_);	
     }
-    /*else
-    {*/
-	
+
 	// If the main promise isn't resolved, then carry on retrieving frame headers.
     if (!isResolved) {
-        auto transportPromise = transport::ITransport::ReceivePromise::defer(strand_);
-        transportPromise->then(
-          [this, self = this->shared_from_this()](common::Data data) mutable {
-                    this->receiveFrameHeaderHandler(common::DataConstBuffer(data));
-                },
-                [this, self = this->shared_from_this()](const error::Error& e) mutable {
-                    message_.reset();
-                    promise_->reject(e);
-                    promise_.reset();
-                });   
-
-        transport_->receive(FrameHeader::getSizeOf(), std::move(transportPromise));
+        this->receiveFrameHeader();
+    }
+}
+
+void MessageInStream::traceFrameHeader()
+{
+    frameTrace_ = MessageTrace();
+
+    // The transport timestamps belong to the chunk which delivered the frame header.
+    if(common::TraceClock::isEnabled())
+    {
+        const auto receiveTimestamps = transport_->getLastReceiveTimestamps();
+        frameTrace_.mark(TraceStage::TRANSFER_COMPLETED, receiveTimestamps.transferCompleted);
+        frameTrace_.mark(TraceStage::DATA_DISTRIBUTED, receiveTimestamps.distributed);
+        frameTrace_.mark(TraceStage::FRAME_HEADER_DECODED);
+    }
+}
+
+void MessageInStream::rejectReceive(const error::Error& e)
+{
+    message_.reset();
+    isReceiving_ = false;
+
+    if(pipelineState_ == PipelineState::ACTIVE)
+    {
+        // Messages completed before the failure are still delivered first.
+        pipelineError_ = e;
+        pipelinedFrames_.clear();
+        this->resolvePipelinedMessage();
+    }
+    else if(promise_ != nullptr)
+    {
+        promise_->reject(e);
+        promise_.reset();
+    }
+}
+
+Message::Pointer MessageInStream::findMessage(const FrameHeader& frameHeader, bool& isValidFrame)
+{
+    Message::Pointer message;
+    isValidFrame = true;
+
+    auto bufferedMessage = messageBuffer_.find(frameHeader.getChannelId());
+    if (bufferedMessage != messageBuffer_.end()) {
+        // We have found a message...
+        message = std::move(bufferedMessage->second);
+        messageBuffer_.erase(bufferedMessage);
+
+        AASDK_LOG(debug) << "[MessageInStream] Found existing message.";
+
+        if (frameHeader.getType() == FrameType::FIRST || frameHeader.getType() == FrameType::BULK) {
+            // If it's first or bulk, we need to override the message anyhow, so we will start again.
+            message = std::make_shared<Message>(frameHeader.getChannelId(), frameHeader.getEncryptionType(), frameHeader.getMessageType());
+        }
+	} else {
+        AASDK_LOG(debug) << "[MessageInStream] Could not find existing message.";
+        // No Message Found in Buffers and this is a middle or last frame, this an error.
+        // Still need to process the frame, but we will not resolve at the end.
+        message = std::make_shared<Message>(frameHeader.getChannelId(), frameHeader.getEncryptionType(), frameHeader.getMessageType());
+	    if (frameHeader.getType() == FrameType::MIDDLE || frameHeader.getType() == FrameType::LAST) {
+            // This is an error
+            isValidFrame = false;
+        }	
+    }
+
+    return message;
+}
+
+bool MessageInStream::activatePipeline(const common::DataConstBuffer& buffer)
+{
+    // The first application record is decrypted both ways: if the detached keys do not open it,
+    // the SSL object has not seen it yet and the session simply stays on the serial path.
+    recordDecryptor_ = cryptor_->createRecordDecryptor();
+
+    if(recordDecryptor_ != nullptr)
+    {
+        const auto recordCount = recordDecryptor_->getRecordCount(buffer);
+        error::Error e(error::ErrorCode::SSL_READ);
+
+        if(recordCount > 0)
+        {
+            e = error::Error();
+            recordDecryptor_->decrypt(message_->getPayload(), buffer, recordSequenceNumber_, e);
+        }
+
+        if(e == error::ErrorCode::NONE)
+        {
+            recordSequenceNumber_ += recordCount;
+            pipelineState_ = PipelineState::ACTIVE;
+
+            AASDK_LOG(info) << "[MessageInStream] Parallel decryption enabled, workers: " << decryptionWorkerPool_->getWorkerCount();
+            return true;
+        }
+    }
+
+    AASDK_LOG(info) << "[MessageInStream] Parallel decryption is not supported by this session.";
+    recordDecryptor_.reset();
+    pipelineState_ = PipelineState::DISABLED;
+    return false;
+}
+
+void MessageInStream::pipelineFrame(common::Data data)
+{
+    const auto frameIndex = nextFrameIndex_++;
+
+    if(frameHeader_.getEncryptionType() == EncryptionType::ENCRYPTED)
+    {
+        // Sequence numbers are assigned in arrival order, so workers may finish in any order.
+        const auto recordCount = recordDecryptor_->getRecordCount(common::DataConstBuffer(data));
+        const auto sequenceNumber = recordSequenceNumber_;
+        recordSequenceNumber_ += recordCount;
+
+        decryptionWorkerPool_->post([this, self = this->shared_from_this(), recordDecryptor = recordDecryptor_, frameIndex, frameHeader = frameHeader_, frameTrace = frameTrace_, data = std::move(data), sequenceNumber, recordCount]() mutable {
+            PipelinedFrame frame{frameHeader, common::Data(), error::Error(), std::move(frameTrace)};
+
+            if(recordCount == 0)
+            {
+                frame.error = error::Error(error::ErrorCode::SSL_READ);
+            }
+            else
+            {
+                recordDecryptor->decrypt(frame.payload, common::DataConstBuffer(data), sequenceNumber, frame.error);
+            }
+
+            frame.trace.mark(TraceStage::DECRYPTED);
+
+            strand_.post([this, self = std::move(self), frameIndex, frame = std::move(frame)]() mutable {
+                this->pipelinedFrameHandler(frameIndex, std::move(frame));
+            });
+        });
+    }
+    else
+    {
+        frameTrace_.mark(TraceStage::DECRYPTED);
+        pipelinedFrames_.emplace(frameIndex, PipelinedFrame{frameHeader_, std::move(data), error::Error(), frameTrace_});
+        this->assemblePipelinedFrames();
+    }
+
+    isReceiving_ = false;
+    this->resolvePipelinedMessage();
+}
+
+void MessageInStream::pipelinedFrameHandler(uint64_t frameIndex, PipelinedFrame frame)
+{
+    if(pipelineError_ != error::ErrorCode::NONE)
+    {
+        return;
+    }
+
+    pipelinedFrames_.emplace(frameIndex, std::move(frame));
+    this->assemblePipelinedFrames();
+    this->resolvePipelinedMessage();
+}
+
+void MessageInStream::assemblePipelinedFrames()
+{
+    for(auto it = pipelinedFrames_.find(nextAssembledFrameIndex_); it != pipelinedFrames_.end(); it = pipelinedFrames_.find(nextAssembledFrameIndex_))
+    {
+        auto frame = std::move(it->second);
+        pipelinedFrames_.erase(it);
+        ++nextAssembledFrameIndex_;
+
+        if(frame.error != error::ErrorCode::NONE)
+        {
+            if(metrics_ != nullptr)
+            {
+                metrics_->getDecryptFailures().increment();
+            }
+
+            this->rejectReceive(frame.error);
+            return;
+        }
+
+        bool isValidFrame = true;
+        auto message = this->findMessage(frame.frameHeader, isValidFrame);
+        auto& payload = message->getPayload();
+
+        if(payload.empty())
+        {
+            payload.swap(frame.payload);
+        }
+        else
+        {
+            message->insertPayload(frame.payload);
+        }
+
+        message->getTrace().merge(frame.trace);
+
+        const auto frameType = frame.frameHeader.getType();
+        if((frameType == FrameType::BULK || frameType == FrameType::LAST) && isValidFrame)
+        {
+            message->getTrace().mark(TraceStage::REASSEMBLED);
+            pipelinedMessages_.push_back(std::move(message));
+        }
+        else
+        {
+            const auto channelId = message->getChannelId();
+            messageBuffer_[channelId] = std::move(message);
+        }
+    }
+}
+
+void MessageInStream::resolvePipelinedMessage()
+{
+    if(promise_ != nullptr)
+    {
+        if(!pipelinedMessages_.empty())
+        {
+            promise_->resolve(std::move(pipelinedMessages_.front()));
+            pipelinedMessages_.pop_front();
+            promise_.reset();
+        }
+        else if(pipelineError_ != error::ErrorCode::NONE)
+        {
+            promise_->reject(pipelineError_);
+            promise_.reset();
+        }
     }
+
+    if(!isReceiving_ && this->canReceiveAhead())
+    {
+        this->receiveFrameHeader();
+    }
+}
+
+bool MessageInStream::canReceiveAhead() const
+{
+    return pipelineError_ == error::ErrorCode::NONE
+            && nextFrameIndex_ - nextAssembledFrameIndex_ < cMaxFramesInFlight
+            && pipelinedMessages_.size() < cMaxPipelinedMessages;
 }
 
 }
@@ -4,6 +4,7 @@
 #include <Messenger/UT/ReceivePromiseHandler.mock.hpp>
 #include <aasdk/Messenger/Promise.hpp>
 #include <aasdk/Messenger/MessageInStream.hpp>
+#include <aasdk/Messenger/LatencyTracer.hpp>
 
 
 namespace aasdk
@@ -40,9 +41,10 @@ protected:
 };
 
 
-ACTION(ThrowSSLReadException)
+ACTION(SetSSLReadError)
 {
-    throw error::Error(error::ErrorCode::SSL_READ, 123);
+    arg3 = error::Error(error::ErrorCode::SSL_READ, 123);
+    return 0;
 }
 
 BOOST_FIXTURE_TEST_CASE(MessageInStream_ReceivePlainMessage, MessageInStreamUnitTest)
@@ -115,7 +117,7 @@ BOOST_FIXTURE_TEST_CASE(MessageInStream_ReceiveEncryptedMessage, MessageInStream
     EXPECT_CALL(transportMock_, receive(framePayload.size(), _)).WillOnce(SaveArg<1>(&framePayloadTransportPromise));
 
     common::Data decryptedPayload(500, 0x5F);
-    EXPECT_CALL(cryptorMock_, decrypt(_, _)).WillOnce(testing::DoAll(SetArgReferee<0>(decryptedPayload), Return(decryptedPayload.size())));
+    EXPECT_CALL(cryptorMock_, decrypt(_, _, _, _)).WillOnce(testing::DoAll(SetArgReferee<0>(decryptedPayload), Return(decryptedPayload.size())));
     frameSizeTransportPromise->resolve(frameSize.getData());
 
     ioService_.run();
@@ -136,6 +138,51 @@ BOOST_FIXTURE_TEST_CASE(MessageInStream_ReceiveEncryptedMessage, MessageInStream
     BOOST_CHECK_EQUAL_COLLECTIONS(payload.begin(), payload.end(), decryptedPayload.begin(), decryptedPayload.end());
 }
 
+BOOST_FIXTURE_TEST_CASE(MessageInStream_ParallelDecryptionNotSupported, MessageInStreamUnitTest)
+{
+    auto decryptionWorkerPool = std::make_shared<DecryptionWorkerPool>(1);
+    MessageInStream::Pointer messageInStream(std::make_shared<MessageInStream>(ioService_, transport_, cryptor_, decryptionWorkerPool));
+
+    FrameHeader frameHeader(ChannelId::VIDEO, FrameType::BULK, EncryptionType::ENCRYPTED, MessageType::CONTROL);
+    transport::ITransport::ReceivePromise::Pointer frameHeaderTransportPromise;
+    EXPECT_CALL(transportMock_, receive(FrameHeader::getSizeOf(), _)).WillOnce(SaveArg<1>(&frameHeaderTransportPromise));
+
+    messageInStream->startReceive(std::move(receivePromise_));
+
+    ioService_.run();
+    ioService_.reset();
+
+    common::Data framePayload(1000, 0x5E);
+    FrameSize frameSize(framePayload.size());
+    transport::ITransport::ReceivePromise::Pointer frameSizeTransportPromise;
+    EXPECT_CALL(transportMock_, receive(FrameSize::getSizeOf(FrameSizeType::SHORT), _)).WillOnce(SaveArg<1>(&frameSizeTransportPromise));
+    frameHeaderTransportPromise->resolve(frameHeader.getData());
+
+    ioService_.run();
+    ioService_.reset();
+
+    transport::ITransport::ReceivePromise::Pointer framePayloadTransportPromise;
+    EXPECT_CALL(transportMock_, receive(framePayload.size(), _)).WillOnce(SaveArg<1>(&framePayloadTransportPromise));
+    frameSizeTransportPromise->resolve(frameSize.getData());
+
+    ioService_.run();
+    ioService_.reset();
+
+    common::Data decryptedPayload(500, 0x5F);
+    EXPECT_CALL(cryptorMock_, createRecordDecryptor()).WillOnce(Return(nullptr));
+    EXPECT_CALL(cryptorMock_, decrypt(_, _, _, _)).WillOnce(testing::DoAll(SetArgReferee<0>(decryptedPayload), Return(decryptedPayload.size())));
+
+    Message::Pointer message;
+    EXPECT_CALL(receivePromiseHandlerMock_, onReject(_)).Times(0);
+    EXPECT_CALL(receivePromiseHandlerMock_, onResolve(_)).WillOnce(SaveArg<0>(&message));
+    framePayloadTransportPromise->resolve(framePayload);
+
+    ioService_.run();
+
+    const auto& payload = message->getPayload();
+    BOOST_CHECK_EQUAL_COLLECTIONS(payload.begin(), payload.end(), decryptedPayload.begin(), decryptedPayload.end());
+}
+
 BOOST_FIXTURE_TEST_CASE(MessageInStream_MessageDecryptionFailed, MessageInStreamUnitTest)
 {
     MessageInStream::Pointer messageInStream(std::make_shared<MessageInStream>(ioService_, transport_, cryptor_));
@@ -162,7 +209,7 @@ BOOST_FIXTURE_TEST_CASE(MessageInStream_MessageDecryptionFailed, MessageInStream
     EXPECT_CALL(transportMock_, receive(framePayload.size(), _)).WillOnce(SaveArg<1>(&framePayloadTransportPromise));
 
     common::Data decryptedPayload(500, 0x5F);
-    EXPECT_CALL(cryptorMock_, decrypt(_, _)).WillOnce(ThrowSSLReadException());
+    EXPECT_CALL(cryptorMock_, decrypt(_, _, _, _)).WillOnce(SetSSLReadError());
     frameSizeTransportPromise->resolve(frameSize.getData());
 
     ioService_.run();
@@ -399,6 +446,56 @@ BOOST_FIXTURE_TEST_CASE(MessageInStream_RejectWhenInProgress, MessageInStreamUni
 }
 
 
+BOOST_FIXTURE_TEST_CASE(MessageInStream_TraceReceivedMessage, MessageInStreamUnitTest)
+{
+    LatencyTracer latencyTracer;
+    MessageInStream::Pointer messageInStream(std::make_shared<MessageInStream>(ioService_, transport_, cryptor_));
+
+    FrameHeader frameHeader(ChannelId::VIDEO, FrameType::BULK, EncryptionType::PLAIN, MessageType::SPECIFIC);
+    transport::ITransport::ReceivePromise::Pointer frameHeaderTransportPromise;
+    EXPECT_CALL(transportMock_, receive(FrameHeader::getSizeOf(), _)).WillOnce(SaveArg<1>(&frameHeaderTransportPromise));
+
+    messageInStream->startReceive(std::move(receivePromise_));
+
+    ioService_.run();
+    ioService_.reset();
+
+    const auto transferCompleted = common::TraceClock::now() - std::chrono::microseconds(200);
+    const transport::ITransport::ReceiveTimestamps receiveTimestamps{transferCompleted, transferCompleted + std::chrono::microseconds(50)};
+    EXPECT_CALL(transportMock_, getLastReceiveTimestamps()).WillOnce(Return(receiveTimestamps));
+
+    common::Data framePayload(100, 0x5E);
+    FrameSize frameSize(framePayload.size());
+    transport::ITransport::ReceivePromise::Pointer frameSizeTransportPromise;
+    EXPECT_CALL(transportMock_, receive(FrameSize::getSizeOf(FrameSizeType::SHORT), _)).WillOnce(SaveArg<1>(&frameSizeTransportPromise));
+    frameHeaderTransportPromise->resolve(frameHeader.getData());
+
+    ioService_.run();
+    ioService_.reset();
+
+    transport::ITransport::ReceivePromise::Pointer framePayloadTransportPromise;
+    EXPECT_CALL(transportMock_, receive(framePayload.size(), _)).WillOnce(SaveArg<1>(&framePayloadTransportPromise));
+    frameSizeTransportPromise->resolve(frameSize.getData());
+
+    ioService_.run();
+    ioService_.reset();
+
+    Message::Pointer message;
+    EXPECT_CALL(receivePromiseHandlerMock_, onResolve(_)).WillOnce(SaveArg<0>(&message));
+    framePayloadTransportPromise->resolve(framePayload);
+
+    ioService_.run();
+
+    const auto& trace = message->getTrace();
+    BOOST_CHECK(trace.get(TraceStage::TRANSFER_COMPLETED) == receiveTimestamps.transferCompleted);
+    BOOST_CHECK(trace.get(TraceStage::DATA_DISTRIBUTED) == receiveTimestamps.distributed);
+    BOOST_CHECK(trace.get(TraceStage::FRAME_HEADER_DECODED) >= receiveTimestamps.distributed);
+    BOOST_CHECK(trace.get(TraceStage::DECRYPTED) >= trace.get(TraceStage::FRAME_HEADER_DECODED));
+    BOOST_CHECK(trace.get(TraceStage::REASSEMBLED) >= trace.get(TraceStage::DECRYPTED));
+    BOOST_CHECK(!trace.isMarked(TraceStage::MESSENGER_DISPATCHED));
+    BOOST_CHECK(trace.getStageDuration(TraceStage::DATA_DISTRIBUTED) == std::chrono::microseconds(50));
+}
+
 }
 }
 }
@@ -37,68 +37,75 @@ void MessageOutStream::stream(Message::Pointer message, SendPromise::Pointer pro
         }
         else
         {
-            try
-            {
-                auto data(this->compoundFrame(FrameType::BULK, common::DataConstBuffer(message_->getPayload())));
+            error::Error e;
+            auto data(this->compoundFrame(FrameType::BULK, common::DataConstBuffer(message_->getPayload()), e));
 
-                auto transportPromise = transport::ITransport::SendPromise::defer(strand_);
-                io::PromiseLink<>::forward(*transportPromise, std::move(promise_));
-                transport_->send(std::move(data), std::move(transportPromise));
-            }
-            catch(const error::Error& e)
+            if(e != error::ErrorCode::NONE)
             {
                 promise_->reject(e);
                 promise_.reset();
             }
+            else
+            {
+                auto transportPromise = transport::ITransport::SendPromise::defer(strand_);
+                io::PromiseLink<>::forward(*transportPromise, std::move(promise_));
+                transport_->send(std::move(data), std::move(transportPromise));
+            }
 
             this->reset();
         }
     });
 }
 
-void MessageOutStream::streamSplittedMessage()
+void MessageOutStream::setMetrics(metrics::SessionMetrics::Pointer metrics)
 {
-    try
-    {
-        const auto& payload = message_->getPayload();
-        auto ptr = &payload[offset_];
-        auto size = remainingSize_ < cMaxFramePayloadSize ? remainingSize_ : cMaxFramePayloadSize;
+    metrics_ = std::move(metrics);
+}
 
-        FrameType frameType = offset_ == 0 ? FrameType::FIRST : (remainingSize_ - size > 0 ? FrameType::MIDDLE : FrameType::LAST);
-        auto data(this->compoundFrame(frameType, common::DataConstBuffer(ptr, size)));
+void MessageOutStream::streamSplittedMessage()
+{
+    const auto& payload = message_->getPayload();
+    auto ptr = &payload[offset_];
+    auto size = remainingSize_ < cMaxFramePayloadSize ? remainingSize_ : cMaxFramePayloadSize;
 
-        auto transportPromise = transport::ITransport::SendPromise::defer(strand_);
+    FrameType frameType = offset_ == 0 ? FrameType::FIRST : (remainingSize_ - size > 0 ? FrameType::MIDDLE : FrameType::LAST);
 
-        if(frameType == FrameType::LAST)
-        {
-            this->reset();
-            io::PromiseLink<>::forward(*transportPromise, std::move(promise_));
-        }
-        else
-        {
-            transportPromise->then([this, self = this->shared_from_this(), size]() mutable {
-                    offset_ += size;
-                    remainingSize_ -= size;
-                    this->streamSplittedMessage();
-                },
-                [this, self = this->shared_from_this()](const error::Error& e) mutable {
-                    this->reset();
-                    promise_->reject(e);
-                    promise_.reset();
-                });
-        }
+    error::Error e;
+    auto data(this->compoundFrame(frameType, common::DataConstBuffer(ptr, size), e));
 
-        transport_->send(std::move(data), std::move(transportPromise));
-    }
-    catch(const error::Error& e)
+    if(e != error::ErrorCode::NONE)
     {
         this->reset();
         promise_->reject(e);
         promise_.reset();
+        return;
+    }
+
+    auto transportPromise = transport::ITransport::SendPromise::defer(strand_);
+
+    if(frameType == FrameType::LAST)
+    {
+        this->reset();
+        io::PromiseLink<>::forward(*transportPromise, std::move(promise_));
+    }
+    else
+    {
+        transportPromise->then([this, self = this->shared_from_this(), size]() mutable {
+                offset_ += size;
+                remainingSize_ -= size;
+                this->streamSplittedMessage();
+            },
+            [this, self = this->shared_from_this()](const error::Error& e) mutable {
+                this->reset();
+                promise_->reject(e);
+                promise_.reset();
+            });
     }
+
+    transport_->send(std::move(data), std::move(transportPromise));
 }
 
-common::Data MessageOutStream::compoundFrame(FrameType frameType, const common::DataConstBuffer& payloadBuffer)
+common::Data MessageOutStream::compoundFrame(FrameType frameType, const common::DataConstBuffer& payloadBuffer, error::Error& e)
 {
     const FrameHeader frameHeader(message_->getChannelId(), frameType, message_->getEncryptionType(), message_->getType());
     common::Data data(frameHeader.getData());
@@ -107,7 +114,12 @@ common::Data MessageOutStream::compoundFrame(FrameType frameType, const common::
 
     if(message_->getEncryptionType() == EncryptionType::ENCRYPTED)
     {
-        payloadSize = cryptor_->encrypt(data, payloadBuffer);
+        payloadSize = cryptor_->encrypt(data, payloadBuffer, e);
+
+        if(e != error::ErrorCode::NONE)
+        {
+            return common::Data();
+        }
     }
     else
     {
@@ -116,6 +128,12 @@ common::Data MessageOutStream::compoundFrame(FrameType frameType, const common::
     }
 
     this->setFrameSize(data, frameType, payloadSize, message_->getPayload().size());
+
+    if(metrics_ != nullptr)
+    {
+        metrics_->getFramesSent(frameType).increment();
+    }
+
     return data;
 }
 
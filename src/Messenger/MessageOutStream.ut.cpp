@@ -39,9 +39,10 @@ protected:
     SendPromise::Pointer sendPromise_;
 };
 
-ACTION(ThrowSSLWriteException)
+ACTION(SetSSLWriteError)
 {
-    throw error::Error(error::ErrorCode::SSL_WRITE, 32);
+    arg2 = error::Error(error::ErrorCode::SSL_WRITE, 32);
+    return 0;
 }
 
 BOOST_FIXTURE_TEST_CASE(MessageOutStream_SendPlainMessage, MessageOutStreamUnitTest)
@@ -90,7 +91,7 @@ BOOST_FIXTURE_TEST_CASE(MessageOutStream_SendEncryptedMessage, MessageOutStreamU
     common::Data encryptedData(expectedData.begin(), expectedData.begin() + FrameHeader::getSizeOf() + FrameSize::getSizeOf(FrameSizeType::SHORT));
     encryptedData.insert(encryptedData.end(), encryptedPayload.begin(), encryptedPayload.end());
     transport::ITransport::SendPromise::Pointer transportSendPromise;
-    EXPECT_CALL(cryptorMock_, encrypt(_, _)).WillOnce(testing::DoAll(SetArgReferee<0>(encryptedData), Return(encryptedPayload.size())));
+    EXPECT_CALL(cryptorMock_, encrypt(_, _, _)).WillOnce(testing::DoAll(SetArgReferee<0>(encryptedData), Return(encryptedPayload.size())));
     EXPECT_CALL(transportMock_, send(expectedData, _)).WillOnce(SaveArg<1>(&transportSendPromise));
 
     Message::Pointer message(std::make_shared<Message>(ChannelId::VIDEO, EncryptionType::ENCRYPTED, MessageType::CONTROL));
@@ -115,7 +116,7 @@ BOOST_FIXTURE_TEST_CASE(MessageOutStream_MessageEncryptionFailed, MessageOutStre
     message->insertPayload(payload);
     MessageOutStream::Pointer messageOutStream(std::make_shared<MessageOutStream>(ioService_, transport_, cryptor_));
 
-    EXPECT_CALL(cryptorMock_, encrypt(_, _)).WillOnce(ThrowSSLWriteException());
+    EXPECT_CALL(cryptorMock_, encrypt(_, _, _)).WillOnce(SetSSLWriteError());
     EXPECT_CALL(sendPromiseHandlerMock_, onReject(error::Error(error::ErrorCode::SSL_WRITE, 32)));
     EXPECT_CALL(sendPromiseHandlerMock_, onResolve()).Times(0);
     messageOutStream->stream(message, std::move(sendPromise_));
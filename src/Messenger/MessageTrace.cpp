@@ -0,0 +1,128 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <aasdk/Messenger/MessageTrace.hpp>
+
+
+namespace aasdk
+{
+namespace messenger
+{
+
+std::string traceStageToString(TraceStage stage)
+{
+    switch(stage)
+    {
+    case TraceStage::TRANSFER_COMPLETED:
+        return "TRANSFER_COMPLETED";
+    case TraceStage::DATA_DISTRIBUTED:
+        return "DATA_DISTRIBUTED";
+    case TraceStage::FRAME_HEADER_DECODED:
+        return "FRAME_HEADER_DECODED";
+    case TraceStage::DECRYPTED:
+        return "DECRYPTED";
+    case TraceStage::REASSEMBLED:
+        return "REASSEMBLED";
+    case TraceStage::MESSENGER_DISPATCHED:
+        return "MESSENGER_DISPATCHED";
+    case TraceStage::CHANNEL_HANDLER_ENTERED:
+        return "CHANNEL_HANDLER_ENTERED";
+    default:
+        return "(null)";
+    }
+}
+
+void MessageTrace::mark(TraceStage stage)
+{
+    this->mark(stage, common::TraceClock::now());
+}
+
+void MessageTrace::mark(TraceStage stage, common::TraceClock::time_point timePoint)
+{
+    if(timePoint != common::TraceClock::time_point())
+    {
+        timePoints_[static_cast<size_t>(stage)] = timePoint;
+    }
+}
+
+void MessageTrace::merge(const MessageTrace& other)
+{
+    for(size_t i = 0; i < timePoints_.size(); ++i)
+    {
+        this->mark(static_cast<TraceStage>(i), other.timePoints_[i]);
+    }
+}
+
+bool MessageTrace::isMarked(TraceStage stage) const
+{
+    return this->get(stage) != common::TraceClock::time_point();
+}
+
+common::TraceClock::time_point MessageTrace::get(TraceStage stage) const
+{
+    return timePoints_[static_cast<size_t>(stage)];
+}
+
+common::TraceClock::duration MessageTrace::getStageDuration(TraceStage stage) const
+{
+    if(!this->isMarked(stage))
+    {
+        return common::TraceClock::duration::zero();
+    }
+
+    for(auto i = static_cast<size_t>(stage); i > 0; --i)
+    {
+        const auto& previous = timePoints_[i - 1];
+        if(previous != common::TraceClock::time_point())
+        {
+            return this->get(stage) - previous;
+        }
+    }
+
+    return common::TraceClock::duration::zero();
+}
+
+common::TraceClock::duration MessageTrace::getTotalDuration() const
+{
+    common::TraceClock::time_point first;
+    common::TraceClock::time_point last;
+
+    for(const auto& timePoint : timePoints_)
+    {
+        if(timePoint != common::TraceClock::time_point())
+        {
+            first = first == common::TraceClock::time_point() ? timePoint : first;
+            last = timePoint;
+        }
+    }
+
+    return last - first;
+}
+
+void MessageTrace::setTracer(std::shared_ptr<LatencyTracer> tracer)
+{
+    tracer_ = std::move(tracer);
+}
+
+const std::shared_ptr<LatencyTracer>& MessageTrace::getTracer() const
+{
+    return tracer_;
+}
+
+}
+}
@@ -1,3 +1,5 @@
+#include <aasdk_proto/ControlMessageIdsEnum.pb.h>
+#include <aasdk_proto/AVChannelMessageIdsEnum.pb.h>
 #include <aasdk/Error/Error.hpp>
 #include <aasdk/Messenger/Messenger.hpp>
 #include <utility>
@@ -22,6 +24,11 @@ void Messenger::enqueueReceive(ChannelId channelId, ReceivePromise::Pointer prom
     receiveStrand_.dispatch([this, self = this->shared_from_this(), channelId, promise = std::move(promise)]() mutable {
         if(!channelReceiveMessageQueue_.empty(channelId))
         {
+            if(metrics_ != nullptr)
+            {
+                metrics_->getChannel(channelId).receiveQueueDepth.decrement();
+            }
+
             promise->resolve(channelReceiveMessageQueue_.pop(channelId));
         }
         else
@@ -42,7 +49,15 @@ void Messenger::enqueueReceive(ChannelId channelId, ReceivePromise::Pointer prom
 void Messenger::enqueueSend(Message::Pointer message, SendPromise::Pointer promise)
 {
     sendStrand_.dispatch([this, self = this->shared_from_this(), message = std::move(message), promise = std::move(promise)]() mutable {
+        if(metrics_ != nullptr)
+        {
+            auto& channelMetrics = metrics_->getChannel(message->getChannelId());
+            channelMetrics.messagesSent.increment();
+            channelMetrics.bytesSent.increment(message->getPayload().size());
+        }
+
         channelSendPromiseQueue_.emplace_back(std::make_pair(std::move(message), std::move(promise)));
+        this->updateSendQueueDepth();
 
         if(channelSendPromiseQueue_.size() == 1)
         {
@@ -55,12 +70,35 @@ void Messenger::inStreamMessageHandler(Message::Pointer message)
 {
     auto channelId = message->getChannelId();
 
+    if(metrics_ != nullptr)
+    {
+        auto& channelMetrics = metrics_->getChannel(channelId);
+        channelMetrics.messagesReceived.increment();
+        channelMetrics.bytesReceived.increment(message->getPayload().size());
+    }
+
+    if(startupTimeline_ != nullptr)
+    {
+        this->markStartupPhase(*message, "received");
+    }
+
+    if(latencyTracer_ != nullptr)
+    {
+        message->getTrace().mark(TraceStage::MESSENGER_DISPATCHED);
+        message->getTrace().setTracer(latencyTracer_);
+    }
+
     if(channelReceivePromiseQueue_.isPending(channelId))
     {
         channelReceivePromiseQueue_.pop(channelId)->resolve(std::move(message));
     }
     else
     {
+        if(metrics_ != nullptr)
+        {
+            metrics_->getChannel(channelId).receiveQueueDepth.increment();
+        }
+
         channelReceiveMessageQueue_.push(std::move(message));
     }
 
@@ -76,6 +114,12 @@ void Messenger::inStreamMessageHandler(Message::Pointer message)
 void Messenger::doSend()
 {
     auto queueElementIter = channelSendPromiseQueue_.begin();
+
+    if(startupTimeline_ != nullptr)
+    {
+        this->markStartupPhase(*queueElementIter->first, "sent");
+    }
+
     auto outStreamPromise = SendPromise::defer(sendStrand_);
     outStreamPromise->then([this, self = this->shared_from_this(), queueElementIter](){outStreamMessageHandler(queueElementIter);},
                            [this, self = this->shared_from_this()](const error::Error &e){rejectSendPromiseQueue(e);});
@@ -87,6 +131,7 @@ void Messenger::outStreamMessageHandler(ChannelSendQueue::iterator queueElement)
 {
     queueElement->second->resolve();
     channelSendPromiseQueue_.erase(queueElement);
+    this->updateSendQueueDepth();
 
     if(!channelSendPromiseQueue_.empty())
     {
@@ -96,26 +141,146 @@ void Messenger::outStreamMessageHandler(ChannelSendQueue::iterator queueElement)
 
 void Messenger::rejectReceivePromiseQueue(const error::Error& e)
 {
+    if(startupTimeline_ != nullptr)
+    {
+        startupTimeline_->finish(e);
+    }
+
     while(!channelReceivePromiseQueue_.empty())
     {
+        if(metrics_ != nullptr)
+        {
+            metrics_->getReceiveRejections().increment();
+        }
+
         channelReceivePromiseQueue_.pop()->reject(e);
     }
 }
 
 void Messenger::rejectSendPromiseQueue(const error::Error& e)
 {
+    if(startupTimeline_ != nullptr)
+    {
+        startupTimeline_->finish(e);
+    }
+
     while(!channelSendPromiseQueue_.empty())
     {
         auto queueElement(std::move(channelSendPromiseQueue_.front()));
         channelSendPromiseQueue_.pop_front();
+
+        if(metrics_ != nullptr)
+        {
+            metrics_->getSendRejections().increment();
+        }
+
         queueElement.second->reject(e);
     }
+
+    this->updateSendQueueDepth();
+}
+
+void Messenger::updateSendQueueDepth()
+{
+    if(metrics_ != nullptr)
+    {
+        metrics_->getSendQueueDepth().set(static_cast<int64_t>(channelSendPromiseQueue_.size()));
+    }
+}
+
+void Messenger::setLatencyTracer(LatencyTracer::Pointer latencyTracer)
+{
+    receiveStrand_.dispatch([this, self = this->shared_from_this(), latencyTracer = std::move(latencyTracer)]() mutable {
+        latencyTracer_ = std::move(latencyTracer);
+    });
+}
+
+void Messenger::setMetrics(metrics::SessionMetrics::Pointer metrics)
+{
+    metrics_ = std::move(metrics);
+}
+
+void Messenger::setStartupTimeline(metrics::StartupTimeline::Pointer startupTimeline)
+{
+    startupTimeline_ = std::move(startupTimeline);
+}
+
+void Messenger::markStartupPhase(const Message& message, const char* direction)
+{
+    const auto& payload = message.getPayload();
+    if(payload.size() < MessageId::getSizeOf() || startupTimeline_->isCompleted())
+    {
+        return;
+    }
+
+    const auto channelId = message.getChannelId();
+    const MessageId messageId(payload);
+    const auto detail = channelIdToString(channelId) + " " + direction;
+
+    if(channelId == ChannelId::VIDEO && message.getType() == MessageType::SPECIFIC)
+    {
+        if(messageId == proto::ids::AVChannelMessage::AV_MEDIA_WITH_TIMESTAMP_INDICATION || messageId == proto::ids::AVChannelMessage::AV_MEDIA_INDICATION)
+        {
+            startupTimeline_->mark(metrics::StartupPhase::FIRST_VIDEO_FRAME, detail);
+        }
+
+        return;
+    }
+
+    // Channel open is a control message on the channel being opened, everything else lives on the control channel.
+    if(channelId != ChannelId::CONTROL && message.getType() != MessageType::CONTROL)
+    {
+        return;
+    }
+
+    switch(messageId.getId())
+    {
+    case proto::ids::ControlMessage::VERSION_REQUEST:
+        startupTimeline_->mark(metrics::StartupPhase::VERSION_REQUEST, detail);
+        break;
+    case proto::ids::ControlMessage::VERSION_RESPONSE:
+        startupTimeline_->mark(metrics::StartupPhase::VERSION_RESPONSE, detail);
+        break;
+    case proto::ids::ControlMessage::SSL_HANDSHAKE:
+        startupTimeline_->mark(metrics::StartupPhase::SSL_HANDSHAKE, detail);
+        break;
+    case proto::ids::ControlMessage::AUTH_COMPLETE:
+        startupTimeline_->mark(metrics::StartupPhase::AUTH_COMPLETE, detail);
+        break;
+    case proto::ids::ControlMessage::SERVICE_DISCOVERY_REQUEST:
+        startupTimeline_->mark(metrics::StartupPhase::SERVICE_DISCOVERY_REQUEST, detail);
+        break;
+    case proto::ids::ControlMessage::SERVICE_DISCOVERY_RESPONSE:
+        startupTimeline_->mark(metrics::StartupPhase::SERVICE_DISCOVERY_RESPONSE, detail);
+        break;
+    case proto::ids::ControlMessage::CHANNEL_OPEN_REQUEST:
+        startupTimeline_->mark(metrics::StartupPhase::CHANNEL_OPEN_REQUEST, detail);
+        break;
+    case proto::ids::ControlMessage::CHANNEL_OPEN_RESPONSE:
+        startupTimeline_->mark(metrics::StartupPhase::CHANNEL_OPEN_RESPONSE, detail);
+        break;
+    default:
+        break;
+    }
 }
 
 void Messenger::stop()
 {
     receiveStrand_.dispatch([this, self = this->shared_from_this()]() {
         channelReceiveMessageQueue_.clear();
+
+        if(startupTimeline_ != nullptr)
+        {
+            startupTimeline_->finish(error::Error(error::ErrorCode::OPERATION_ABORTED));
+        }
+
+        if(metrics_ != nullptr)
+        {
+            for(size_t i = 0; i < metrics::SessionMetrics::cChannelCount; ++i)
+            {
+                metrics_->getChannel(static_cast<ChannelId>(i)).receiveQueueDepth.set(0);
+            }
+        }
     });
 }
 
@@ -207,6 +207,73 @@ BOOST_FIXTURE_TEST_CASE(Messenger_SendFailed, MessengerUnitTest)
     ioService_.run();
 }
 
+BOOST_FIXTURE_TEST_CASE(Messenger_MarkStartupTimeline, MessengerUnitTest)
+{
+    auto themessenger(std::make_shared<Messenger>(ioService_, messageInStream_, messageOutStream_));
+
+    size_t callbackCount = 0;
+    metrics::StartupTimeline::Events events;
+    themessenger->setStartupTimeline(std::make_shared<metrics::StartupTimeline>([&](const metrics::StartupTimeline::Events& timeline, const error::Error&) {
+        ++callbackCount;
+        events = timeline;
+    }));
+
+    Message::Pointer versionRequest(std::make_shared<Message>(ChannelId::CONTROL, EncryptionType::PLAIN, MessageType::SPECIFIC));
+    versionRequest->insertPayload(MessageId(0x0001).getData());
+    themessenger->enqueueSend(versionRequest, std::move(sendPromise_));
+    themessenger->enqueueReceive(ChannelId::VIDEO, std::move(receivePromise_));
+
+    ReceivePromise::Pointer inStreamReceivePromise;
+    EXPECT_CALL(messageOutStreamMock_, stream(versionRequest, _));
+    EXPECT_CALL(messageInStreamMock_, startReceive(_)).WillRepeatedly(SaveArg<0>(&inStreamReceivePromise));
+    EXPECT_CALL(receivePromiseHandlerMock_, onResolve(_));
+
+    ioService_.run();
+    ioService_.reset();
+
+    Message::Pointer videoFrame(std::make_shared<Message>(ChannelId::VIDEO, EncryptionType::ENCRYPTED, MessageType::SPECIFIC));
+    videoFrame->insertPayload(MessageId(0x0000).getData());
+    inStreamReceivePromise->resolve(videoFrame);
+    ioService_.run();
+
+    BOOST_CHECK_EQUAL(callbackCount, 1);
+    BOOST_REQUIRE_EQUAL(events.size(), 2);
+    BOOST_CHECK(events[0].phase == metrics::StartupPhase::VERSION_REQUEST);
+    BOOST_CHECK_EQUAL(events[0].detail, "CONTROL sent");
+    BOOST_CHECK(events[1].phase == metrics::StartupPhase::FIRST_VIDEO_FRAME);
+    BOOST_CHECK_EQUAL(events[1].detail, "VIDEO received");
+}
+
+BOOST_FIXTURE_TEST_CASE(Messenger_FinishStartupTimelineOnStop, MessengerUnitTest)
+{
+    auto themessenger(std::make_shared<Messenger>(ioService_, messageInStream_, messageOutStream_));
+
+    size_t callbackCount = 0;
+    metrics::StartupTimeline::Events events;
+    error::Error error;
+    themessenger->setStartupTimeline(std::make_shared<metrics::StartupTimeline>([&](const metrics::StartupTimeline::Events& timeline, const error::Error& e) {
+        ++callbackCount;
+        events = timeline;
+        error = e;
+    }));
+
+    Message::Pointer versionRequest(std::make_shared<Message>(ChannelId::CONTROL, EncryptionType::PLAIN, MessageType::SPECIFIC));
+    versionRequest->insertPayload(MessageId(0x0001).getData());
+    themessenger->enqueueSend(versionRequest, std::move(sendPromise_));
+
+    EXPECT_CALL(messageOutStreamMock_, stream(versionRequest, _));
+    ioService_.run();
+    ioService_.reset();
+
+    themessenger->stop();
+    ioService_.run();
+
+    BOOST_CHECK_EQUAL(callbackCount, 1);
+    BOOST_CHECK(error == error::ErrorCode::OPERATION_ABORTED);
+    BOOST_REQUIRE_EQUAL(events.size(), 1);
+    BOOST_CHECK(events[0].phase == metrics::StartupPhase::VERSION_REQUEST);
+}
+
 }
 }
 }
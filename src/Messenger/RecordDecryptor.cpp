@@ -0,0 +1,143 @@
+#include <memory>
+#include <openssl/evp.h>
+#include <openssl/crypto.h>
+#include <openssl/ssl.h>
+#include <aasdk/Messenger/RecordDecryptor.hpp>
+
+
+namespace aasdk
+{
+namespace messenger
+{
+
+RecordDecryptor::RecordDecryptor(transport::ISSLWrapper::RecordKeys keys)
+    : keys_(std::move(keys))
+{
+
+}
+
+RecordDecryptor::~RecordDecryptor()
+{
+    OPENSSL_cleanse(keys_.key.data(), keys_.key.size());
+}
+
+size_t RecordDecryptor::getRecordCount(const common::DataConstBuffer& buffer) const
+{
+    size_t offset = 0;
+    size_t count = 0;
+
+    while(offset < buffer.size)
+    {
+        if(buffer.size - offset < cRecordHeaderSize)
+        {
+            return 0;
+        }
+
+        const size_t recordSize = cRecordHeaderSize + ((buffer.cdata[offset + 3] << 8) | buffer.cdata[offset + 4]);
+        if(buffer.size - offset < recordSize)
+        {
+            return 0;
+        }
+
+        offset += recordSize;
+        ++count;
+    }
+
+    return count;
+}
+
+size_t RecordDecryptor::decrypt(common::Data& output, const common::DataConstBuffer& buffer, uint64_t sequenceNumber, error::Error& e) const
+{
+    const size_t beginOffset = output.size();
+    size_t offset = 0;
+
+    while(offset < buffer.size)
+    {
+        const common::DataConstBuffer remaining(buffer.cdata, buffer.size, offset);
+        const size_t recordSize = remaining.size < cRecordHeaderSize ? 0 : cRecordHeaderSize + ((remaining.cdata[3] << 8) | remaining.cdata[4]);
+        const size_t recordOffset = output.size();
+
+        if(recordSize == 0 || recordSize > remaining.size || !this->decryptRecord(output, common::DataConstBuffer(remaining.cdata, recordSize), sequenceNumber++))
+        {
+            output.resize(beginOffset);
+            e = error::Error(error::ErrorCode::SSL_READ);
+            return 0;
+        }
+
+        // The SSL object never sees pipelined records, so alerts are handled here the way SSL_read would:
+        // warnings are consumed, close_notify ends the stream and anything fatal fails it.
+        if(remaining.cdata[0] == cAlertContentType)
+        {
+            const bool isValidAlert = output.size() - recordOffset == 2;
+            const auto level = isValidAlert ? output[recordOffset] : cAlertLevelFatal;
+            const auto description = isValidAlert ? output[recordOffset + 1] : 0;
+            output.resize(recordOffset);
+
+            if(level == cAlertLevelFatal || description == cAlertCloseNotify)
+            {
+                output.resize(beginOffset);
+                e = error::Error(error::ErrorCode::SSL_READ, level == cAlertLevelFatal ? SSL_ERROR_SSL : SSL_ERROR_ZERO_RETURN);
+                return 0;
+            }
+        }
+
+        offset += recordSize;
+    }
+
+    return output.size() - beginOffset;
+}
+
+bool RecordDecryptor::decryptRecord(common::Data& output, const common::DataConstBuffer& record, uint64_t sequenceNumber) const
+{
+    // Handshake and change_cipher_spec records would need the SSL object (renegotiation), which the pipeline bypasses.
+    if(record.size < cRecordHeaderSize + cExplicitNonceSize + cTagSize
+       || (record.cdata[0] != cApplicationDataContentType && record.cdata[0] != cAlertContentType))
+    {
+        return false;
+    }
+
+    const size_t plainSize = record.size - cRecordHeaderSize - cExplicitNonceSize - cTagSize;
+    const auto explicitNonce = record.cdata + cRecordHeaderSize;
+    const auto cipherText = explicitNonce + cExplicitNonceSize;
+    const auto tag = cipherText + plainSize;
+
+    uint8_t nonce[12];
+    std::copy(keys_.implicitIv.begin(), keys_.implicitIv.end(), nonce);
+    std::copy(explicitNonce, explicitNonce + cExplicitNonceSize, nonce + keys_.implicitIv.size());
+
+    // Additional data: sequence number, content type, version and plaintext length.
+    uint8_t additionalData[13];
+    for(size_t i = 0; i < 8; ++i)
+    {
+        additionalData[i] = static_cast<uint8_t>(sequenceNumber >> (56 - i * 8));
+    }
+    additionalData[8] = record.cdata[0];
+    additionalData[9] = record.cdata[1];
+    additionalData[10] = record.cdata[2];
+    additionalData[11] = static_cast<uint8_t>(plainSize >> 8);
+    additionalData[12] = static_cast<uint8_t>(plainSize);
+
+    std::unique_ptr<EVP_CIPHER_CTX, decltype(&EVP_CIPHER_CTX_free)> context(EVP_CIPHER_CTX_new(), &EVP_CIPHER_CTX_free);
+    if(context == nullptr || EVP_DecryptInit_ex(context.get(), keys_.cipher, nullptr, keys_.key.data(), nonce) != 1)
+    {
+        return false;
+    }
+
+    const size_t beginOffset = output.size();
+    output.resize(beginOffset + plainSize);
+
+    int size = 0;
+    if(EVP_DecryptUpdate(context.get(), nullptr, &size, additionalData, sizeof(additionalData)) != 1
+       || EVP_DecryptUpdate(context.get(), output.data() + beginOffset, &size, cipherText, static_cast<int>(plainSize)) != 1
+       || EVP_CIPHER_CTX_ctrl(context.get(), EVP_CTRL_GCM_SET_TAG, cTagSize, const_cast<uint8_t*>(tag)) != 1
+       || EVP_DecryptFinal_ex(context.get(), output.data() + beginOffset + size, &size) != 1)
+    {
+        output.resize(beginOffset);
+        return false;
+    }
+
+    return true;
+}
+
+}
+}
@@ -0,0 +1,161 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <openssl/evp.h>
+#include <openssl/ssl.h>
+#include <aasdk/Messenger/RecordDecryptor.hpp>
+
+
+namespace aasdk
+{
+namespace messenger
+{
+namespace ut
+{
+
+class RecordDecryptorUnitTest
+{
+protected:
+    RecordDecryptorUnitTest()
+    {
+        keys_.cipher = EVP_aes_128_gcm();
+        keys_.key.assign(16, 0x4B);
+        keys_.implicitIv = {0x01, 0x02, 0x03, 0x04};
+    }
+
+    // Seals a TLS 1.2 AES-GCM record the way the peer would.
+    void appendRecord(common::Data& buffer, uint8_t contentType, const common::Data& plainText, uint64_t sequenceNumber)
+    {
+        uint8_t explicitNonce[8];
+        for(size_t i = 0; i < 8; ++i)
+        {
+            explicitNonce[i] = static_cast<uint8_t>(sequenceNumber >> (56 - i * 8));
+        }
+
+        uint8_t nonce[12];
+        std::copy(keys_.implicitIv.begin(), keys_.implicitIv.end(), nonce);
+        std::copy(explicitNonce, explicitNonce + sizeof(explicitNonce), nonce + keys_.implicitIv.size());
+
+        uint8_t additionalData[13];
+        std::copy(explicitNonce, explicitNonce + sizeof(explicitNonce), additionalData);
+        additionalData[8] = contentType;
+        additionalData[9] = 0x03;
+        additionalData[10] = 0x03;
+        additionalData[11] = static_cast<uint8_t>(plainText.size() >> 8);
+        additionalData[12] = static_cast<uint8_t>(plainText.size());
+
+        const size_t recordLength = sizeof(explicitNonce) + plainText.size() + 16;
+        buffer.insert(buffer.end(), {contentType, 0x03, 0x03, static_cast<uint8_t>(recordLength >> 8), static_cast<uint8_t>(recordLength)});
+        buffer.insert(buffer.end(), explicitNonce, explicitNonce + sizeof(explicitNonce));
+
+        const size_t cipherTextOffset = buffer.size();
+        buffer.resize(cipherTextOffset + plainText.size() + 16);
+
+        std::unique_ptr<EVP_CIPHER_CTX, decltype(&EVP_CIPHER_CTX_free)> context(EVP_CIPHER_CTX_new(), &EVP_CIPHER_CTX_free);
+        int size = 0;
+        EVP_EncryptInit_ex(context.get(), keys_.cipher, nullptr, keys_.key.data(), nonce);
+        EVP_EncryptUpdate(context.get(), nullptr, &size, additionalData, sizeof(additionalData));
+        EVP_EncryptUpdate(context.get(), buffer.data() + cipherTextOffset, &size, plainText.data(), static_cast<int>(plainText.size()));
+        EVP_EncryptFinal_ex(context.get(), buffer.data() + cipherTextOffset + size, &size);
+        EVP_CIPHER_CTX_ctrl(context.get(), EVP_CTRL_GCM_GET_TAG, 16, buffer.data() + cipherTextOffset + plainText.size());
+    }
+
+    transport::ISSLWrapper::RecordKeys keys_;
+};
+
+BOOST_FIXTURE_TEST_CASE(RecordDecryptor_DecryptApplicationData, RecordDecryptorUnitTest)
+{
+    common::Data buffer;
+    this->appendRecord(buffer, 23, common::Data(100, 0x5A), 7);
+    this->appendRecord(buffer, 23, common::Data(50, 0x5B), 8);
+
+    RecordDecryptor recordDecryptor(keys_);
+    BOOST_CHECK_EQUAL(recordDecryptor.getRecordCount(common::DataConstBuffer(buffer)), 2u);
+
+    common::Data output;
+    error::Error e;
+    BOOST_CHECK_EQUAL(recordDecryptor.decrypt(output, common::DataConstBuffer(buffer), 7, e), 150u);
+    BOOST_CHECK(e == error::ErrorCode::NONE);
+
+    common::Data expected(100, 0x5A);
+    expected.resize(150, 0x5B);
+    BOOST_CHECK(output == expected);
+
+    // A wrong sequence number must not authenticate.
+    output.clear();
+    BOOST_CHECK_EQUAL(recordDecryptor.decrypt(output, common::DataConstBuffer(buffer), 8, e), 0u);
+    BOOST_CHECK(e == error::ErrorCode::SSL_READ);
+    BOOST_CHECK(output.empty());
+}
+
+BOOST_FIXTURE_TEST_CASE(RecordDecryptor_ConsumeWarningAlert, RecordDecryptorUnitTest)
+{
+    common::Data buffer;
+    this->appendRecord(buffer, 23, common::Data(10, 0x5A), 3);
+    // no_renegotiation warning.
+    this->appendRecord(buffer, 21, common::Data{1, 100}, 4);
+    this->appendRecord(buffer, 23, common::Data(20, 0x5B), 5);
+
+    RecordDecryptor recordDecryptor(keys_);
+    BOOST_CHECK_EQUAL(recordDecryptor.getRecordCount(common::DataConstBuffer(buffer)), 3u);
+
+    common::Data output;
+    error::Error e;
+    BOOST_CHECK_EQUAL(recordDecryptor.decrypt(output, common::DataConstBuffer(buffer), 3, e), 30u);
+    BOOST_CHECK(e == error::ErrorCode::NONE);
+
+    common::Data expected(10, 0x5A);
+    expected.resize(30, 0x5B);
+    BOOST_CHECK(output == expected);
+}
+
+BOOST_FIXTURE_TEST_CASE(RecordDecryptor_CloseNotifyEndsStream, RecordDecryptorUnitTest)
+{
+    common::Data buffer;
+    this->appendRecord(buffer, 23, common::Data(10, 0x5A), 1);
+    this->appendRecord(buffer, 21, common::Data{1, 0}, 2);
+
+    RecordDecryptor recordDecryptor(keys_);
+
+    common::Data output{0x01};
+    error::Error e;
+    BOOST_CHECK_EQUAL(recordDecryptor.decrypt(output, common::DataConstBuffer(buffer), 1, e), 0u);
+    BOOST_CHECK(e == error::ErrorCode::SSL_READ);
+    BOOST_CHECK_EQUAL(e.getNativeCode(), static_cast<uint32_t>(SSL_ERROR_ZERO_RETURN));
+    BOOST_CHECK(output == common::Data{0x01});
+}
+
+BOOST_FIXTURE_TEST_CASE(RecordDecryptor_FatalAlertFailsStream, RecordDecryptorUnitTest)
+{
+    common::Data buffer;
+    // bad_record_mac.
+    this->appendRecord(buffer, 21, common::Data{2, 20}, 0);
+
+    RecordDecryptor recordDecryptor(keys_);
+
+    common::Data output;
+    error::Error e;
+    BOOST_CHECK_EQUAL(recordDecryptor.decrypt(output, common::DataConstBuffer(buffer), 0, e), 0u);
+    BOOST_CHECK(e == error::ErrorCode::SSL_READ);
+    BOOST_CHECK_EQUAL(e.getNativeCode(), static_cast<uint32_t>(SSL_ERROR_SSL));
+}
+
+}
+}
+}
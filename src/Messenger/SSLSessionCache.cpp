@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <aasdk/Messenger/SSLSessionCache.hpp>
+
+
+namespace aasdk
+{
+namespace messenger
+{
+
+SSLSessionCache::SSLSessionCache(size_t capacity)
+    : capacity_(std::max<size_t>(capacity, 1))
+{
+
+}
+
+ISSLSessionCache::Session SSLSessionCache::find(const std::string& deviceId)
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    auto it = this->lookup(deviceId);
+    if(it == sessions_.end())
+    {
+        return nullptr;
+    }
+
+    sessions_.splice(sessions_.begin(), sessions_, it);
+    return sessions_.front().second;
+}
+
+void SSLSessionCache::store(const std::string& deviceId, Session session)
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    auto it = this->lookup(deviceId);
+    if(it != sessions_.end())
+    {
+        sessions_.erase(it);
+    }
+
+    if(session == nullptr)
+    {
+        return;
+    }
+
+    sessions_.emplace_front(deviceId, std::move(session));
+
+    while(sessions_.size() > capacity_)
+    {
+        sessions_.pop_back();
+    }
+}
+
+void SSLSessionCache::remove(const std::string& deviceId)
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    auto it = this->lookup(deviceId);
+    if(it != sessions_.end())
+    {
+        sessions_.erase(it);
+    }
+}
+
+void SSLSessionCache::reportHandshake(bool resumed, std::chrono::microseconds duration)
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    if(resumed)
+    {
+        ++statistics_.resumedHandshakes;
+        statistics_.resumedHandshakesDuration += duration;
+    }
+    else
+    {
+        ++statistics_.fullHandshakes;
+        statistics_.fullHandshakesDuration += duration;
+    }
+
+    statistics_.lastHandshakeDuration = duration;
+    statistics_.lastHandshakeResumed = resumed;
+}
+
+HandshakeStatistics SSLSessionCache::getStatistics() const
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    return statistics_;
+}
+
+SSLSessionCache::Sessions::iterator SSLSessionCache::lookup(const std::string& deviceId)
+{
+    return std::find_if(sessions_.begin(), sessions_.end(), [&](const auto& entry) { return entry.first == deviceId; });
+}
+
+}
+}
@@ -0,0 +1,88 @@
+#include <boost/test/unit_test.hpp>
+#include <aasdk/Messenger/SSLSessionCache.hpp>
+
+
+namespace aasdk
+{
+namespace messenger
+{
+namespace ut
+{
+
+class SSLSessionCacheUnitTest
+{
+protected:
+    ISSLSessionCache::Session createSession()
+    {
+        return ISSLSessionCache::Session(SSL_SESSION_new(), &SSL_SESSION_free);
+    }
+};
+
+BOOST_FIXTURE_TEST_CASE(SSLSessionCache_FindStoredSession, SSLSessionCacheUnitTest)
+{
+    SSLSessionCache sessionCache;
+    auto session = this->createSession();
+
+    sessionCache.store("serial-1", session);
+
+    BOOST_CHECK(sessionCache.find("serial-1") == session);
+    BOOST_CHECK(sessionCache.find("serial-2") == nullptr);
+}
+
+BOOST_FIXTURE_TEST_CASE(SSLSessionCache_ReplaceSession, SSLSessionCacheUnitTest)
+{
+    SSLSessionCache sessionCache;
+    auto session1 = this->createSession();
+    auto session2 = this->createSession();
+
+    sessionCache.store("serial-1", session1);
+    sessionCache.store("serial-1", session2);
+
+    BOOST_CHECK(sessionCache.find("serial-1") == session2);
+    BOOST_CHECK_EQUAL(session1.use_count(), 1);
+}
+
+BOOST_FIXTURE_TEST_CASE(SSLSessionCache_RemoveSession, SSLSessionCacheUnitTest)
+{
+    SSLSessionCache sessionCache;
+
+    sessionCache.store("serial-1", this->createSession());
+    sessionCache.remove("serial-1");
+
+    BOOST_CHECK(sessionCache.find("serial-1") == nullptr);
+}
+
+BOOST_FIXTURE_TEST_CASE(SSLSessionCache_EvictLeastRecentlyUsedSession, SSLSessionCacheUnitTest)
+{
+    SSLSessionCache sessionCache(2);
+
+    sessionCache.store("serial-1", this->createSession());
+    sessionCache.store("serial-2", this->createSession());
+    sessionCache.find("serial-1");
+    sessionCache.store("serial-3", this->createSession());
+
+    BOOST_CHECK(sessionCache.find("serial-1") != nullptr);
+    BOOST_CHECK(sessionCache.find("serial-2") == nullptr);
+    BOOST_CHECK(sessionCache.find("serial-3") != nullptr);
+}
+
+BOOST_FIXTURE_TEST_CASE(SSLSessionCache_ReportHandshakes, SSLSessionCacheUnitTest)
+{
+    SSLSessionCache sessionCache;
+
+    sessionCache.reportHandshake(false, std::chrono::microseconds(9000));
+    sessionCache.reportHandshake(true, std::chrono::microseconds(1500));
+    sessionCache.reportHandshake(true, std::chrono::microseconds(500));
+
+    const auto statistics = sessionCache.getStatistics();
+    BOOST_CHECK_EQUAL(statistics.fullHandshakes, 1);
+    BOOST_CHECK_EQUAL(statistics.resumedHandshakes, 2);
+    BOOST_CHECK_EQUAL(statistics.fullHandshakesDuration.count(), 9000);
+    BOOST_CHECK_EQUAL(statistics.resumedHandshakesDuration.count(), 2000);
+    BOOST_CHECK_EQUAL(statistics.lastHandshakeDuration.count(), 500);
+    BOOST_CHECK(statistics.lastHandshakeResumed);
+}
+
+}
+}
+}
@@ -0,0 +1,118 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <aasdk/Metrics/Metric.hpp>
+
+
+namespace aasdk
+{
+namespace metrics
+{
+
+Counter::Counter()
+    : value_(0)
+{
+
+}
+
+void Counter::increment(uint64_t value)
+{
+    value_.fetch_add(value, std::memory_order_relaxed);
+}
+
+uint64_t Counter::get() const
+{
+    return value_.load(std::memory_order_relaxed);
+}
+
+Gauge::Gauge()
+    : value_(0)
+{
+
+}
+
+void Gauge::set(int64_t value)
+{
+    value_.store(value, std::memory_order_relaxed);
+}
+
+void Gauge::increment(int64_t value)
+{
+    value_.fetch_add(value, std::memory_order_relaxed);
+}
+
+void Gauge::decrement(int64_t value)
+{
+    value_.fetch_sub(value, std::memory_order_relaxed);
+}
+
+int64_t Gauge::get() const
+{
+    return value_.load(std::memory_order_relaxed);
+}
+
+size_t HistogramSnapshot::getBucket(std::chrono::nanoseconds duration)
+{
+    // Upper bounds are inclusive, as Prometheus reads "le".
+    size_t bucket = 0;
+    while(bucket < cBucketCount - 1 && duration > getBucketUpperBound(bucket))
+    {
+        ++bucket;
+    }
+
+    return bucket;
+}
+
+std::chrono::nanoseconds HistogramSnapshot::getBucketUpperBound(size_t bucket)
+{
+    return bucket < cBucketCount - 1 ? std::chrono::nanoseconds(std::chrono::microseconds(1LL << bucket)) : std::chrono::nanoseconds::max();
+}
+
+Histogram::Histogram()
+    : count_(0)
+    , sum_(0)
+{
+    for(auto& bucket : buckets_)
+    {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+void Histogram::observe(std::chrono::nanoseconds duration)
+{
+    buckets_[HistogramSnapshot::getBucket(duration)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(duration.count(), std::memory_order_relaxed);
+}
+
+HistogramSnapshot Histogram::getSnapshot() const
+{
+    HistogramSnapshot snapshot;
+
+    for(size_t i = 0; i < buckets_.size(); ++i)
+    {
+        snapshot.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+    }
+
+    snapshot.count = count_.load(std::memory_order_relaxed);
+    snapshot.sum = std::chrono::nanoseconds(sum_.load(std::memory_order_relaxed));
+    return snapshot;
+}
+
+}
+}
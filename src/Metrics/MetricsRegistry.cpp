@@ -0,0 +1,115 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <aasdk/Metrics/MetricsRegistry.hpp>
+#include <aasdk/Error/Error.hpp>
+
+
+namespace aasdk
+{
+namespace metrics
+{
+
+Counter& MetricsRegistry::getCounter(const std::string& name, const std::string& help, const Labels& labels)
+{
+    return *this->getEntry(name, help, MetricType::COUNTER, labels).counter;
+}
+
+Gauge& MetricsRegistry::getGauge(const std::string& name, const std::string& help, const Labels& labels)
+{
+    return *this->getEntry(name, help, MetricType::GAUGE, labels).gauge;
+}
+
+Histogram& MetricsRegistry::getHistogram(const std::string& name, const std::string& help, const Labels& labels)
+{
+    return *this->getEntry(name, help, MetricType::HISTOGRAM, labels).histogram;
+}
+
+MetricsSnapshot MetricsRegistry::getSnapshot() const
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    MetricsSnapshot snapshot(entries_.size());
+    for(size_t i = 0; i < entries_.size(); ++i)
+    {
+        const auto& entry = entries_[i];
+        auto& metricSnapshot = snapshot[i];
+        metricSnapshot.descriptor = entry.descriptor;
+
+        switch(entry.descriptor->type)
+        {
+        case MetricType::COUNTER:
+            metricSnapshot.value = static_cast<double>(entry.counter->get());
+            break;
+        case MetricType::GAUGE:
+            metricSnapshot.value = static_cast<double>(entry.gauge->get());
+            break;
+        case MetricType::HISTOGRAM:
+            metricSnapshot.histogram = entry.histogram->getSnapshot();
+            break;
+        }
+    }
+
+    return snapshot;
+}
+
+MetricsRegistry::Entry& MetricsRegistry::getEntry(const std::string& name, const std::string& help, MetricType type, const Labels& labels)
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    for(auto& entry : entries_)
+    {
+        if(entry.descriptor->name != name)
+        {
+            continue;
+        }
+
+        // Samples of one name share a TYPE line in the exposition format.
+        if(entry.descriptor->type != type)
+        {
+            throw error::Error(error::ErrorCode::METRIC_TYPE_MISMATCH);
+        }
+
+        if(entry.descriptor->labels == labels)
+        {
+            return entry;
+        }
+    }
+
+    Entry entry;
+    entry.descriptor = std::make_shared<MetricDescriptor>(MetricDescriptor{name, help, type, labels});
+
+    switch(type)
+    {
+    case MetricType::COUNTER:
+        entry.counter = std::make_unique<Counter>();
+        break;
+    case MetricType::GAUGE:
+        entry.gauge = std::make_unique<Gauge>();
+        break;
+    case MetricType::HISTOGRAM:
+        entry.histogram = std::make_unique<Histogram>();
+        break;
+    }
+
+    entries_.push_back(std::move(entry));
+    return entries_.back();
+}
+
+}
+}
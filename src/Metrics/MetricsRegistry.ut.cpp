@@ -0,0 +1,105 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <thread>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <aasdk/Metrics/MetricsRegistry.hpp>
+#include <aasdk/Metrics/SessionMetrics.hpp>
+#include <aasdk/Error/Error.hpp>
+
+
+namespace aasdk
+{
+namespace metrics
+{
+namespace ut
+{
+
+BOOST_AUTO_TEST_CASE(MetricsRegistry_ReturnSameMetricForSameLabels)
+{
+    MetricsRegistry registry;
+
+    auto& counter = registry.getCounter("aasdk_test_total", "Test counter.", {{"channel", "VIDEO"}});
+    BOOST_CHECK(&counter == &registry.getCounter("aasdk_test_total", "Test counter.", {{"channel", "VIDEO"}}));
+    BOOST_CHECK(&counter != &registry.getCounter("aasdk_test_total", "Test counter.", {{"channel", "INPUT"}}));
+}
+
+BOOST_AUTO_TEST_CASE(MetricsRegistry_RejectTypeMismatch)
+{
+    MetricsRegistry registry;
+    registry.getCounter("aasdk_test_total", "Test counter.", {{"channel", "VIDEO"}});
+
+    BOOST_CHECK_THROW(registry.getGauge("aasdk_test_total", "Test gauge.", {{"channel", "VIDEO"}}), error::Error);
+    BOOST_CHECK_THROW(registry.getHistogram("aasdk_test_total", "Test histogram.", {{"channel", "INPUT"}}), error::Error);
+    BOOST_CHECK_EQUAL(registry.getSnapshot().size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(MetricsRegistry_SnapshotConcurrentUpdates)
+{
+    MetricsRegistry registry;
+    auto& counter = registry.getCounter("aasdk_test_total", "Test counter.");
+    auto& gauge = registry.getGauge("aasdk_test_depth", "Test gauge.");
+    auto& histogram = registry.getHistogram("aasdk_test_seconds", "Test histogram.");
+
+    std::vector<std::thread> threads;
+    for(size_t i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([&]() {
+            for(size_t j = 0; j < 10000; ++j)
+            {
+                counter.increment();
+                gauge.increment();
+                gauge.decrement();
+                histogram.observe(std::chrono::microseconds(3));
+            }
+        });
+    }
+
+    for(auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    const auto snapshot = registry.getSnapshot();
+    BOOST_REQUIRE_EQUAL(snapshot.size(), 3);
+    BOOST_CHECK_EQUAL(snapshot[0].value, 40000);
+    BOOST_CHECK_EQUAL(snapshot[1].value, 0);
+    BOOST_CHECK_EQUAL(snapshot[2].histogram.count, 40000);
+    BOOST_CHECK_EQUAL(snapshot[2].histogram.buckets[2], 40000);
+    BOOST_CHECK(snapshot[2].histogram.sum == std::chrono::microseconds(3 * 40000));
+}
+
+BOOST_AUTO_TEST_CASE(SessionMetrics_MapUnknownChannelToSharedSlot)
+{
+    auto registry = std::make_shared<MetricsRegistry>();
+    SessionMetrics sessionMetrics(registry, {{"session", "1"}});
+
+    sessionMetrics.getChannel(messenger::ChannelId::VIDEO).messagesReceived.increment();
+    sessionMetrics.getChannel(messenger::ChannelId::NONE).messagesReceived.increment(2);
+    sessionMetrics.getFramesReceived(messenger::FrameType::BULK).increment();
+
+    BOOST_CHECK(&sessionMetrics.getChannel(messenger::ChannelId::NONE) == &sessionMetrics.getChannel(static_cast<messenger::ChannelId>(100)));
+    BOOST_CHECK_EQUAL(registry->getCounter("aasdk_channel_messages_received_total", "", {{"session", "1"}, {"channel", "VIDEO"}}).get(), 1);
+    BOOST_CHECK_EQUAL(registry->getCounter("aasdk_channel_messages_received_total", "", {{"session", "1"}, {"channel", "NONE"}}).get(), 2);
+    BOOST_CHECK_EQUAL(registry->getCounter("aasdk_frames_received_total", "", {{"session", "1"}, {"frame_type", "BULK"}}).get(), 1);
+}
+
+}
+}
+}
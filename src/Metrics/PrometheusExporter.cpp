@@ -0,0 +1,154 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <map>
+#include <sstream>
+#include <aasdk/Metrics/PrometheusExporter.hpp>
+
+
+namespace aasdk
+{
+namespace metrics
+{
+
+std::string PrometheusExporter::format(const MetricsSnapshot& snapshot)
+{
+    // Samples of one metric name have to be grouped under a single HELP and TYPE line.
+    std::vector<std::string> names;
+    std::map<std::string, std::vector<const MetricSnapshot*>> samples;
+
+    for(const auto& metricSnapshot : snapshot)
+    {
+        auto& nameSamples = samples[metricSnapshot.descriptor->name];
+        if(nameSamples.empty())
+        {
+            names.push_back(metricSnapshot.descriptor->name);
+        }
+
+        nameSamples.push_back(&metricSnapshot);
+    }
+
+    std::ostringstream output;
+    output.precision(15);
+
+    for(const auto& name : names)
+    {
+        const auto& nameSamples = samples[name];
+        const auto& descriptor = *nameSamples.front()->descriptor;
+
+        output << "# HELP " << name << " " << escape(descriptor.help, false) << "\n";
+        output << "# TYPE " << name << " " << typeToString(descriptor.type) << "\n";
+
+        for(const auto* sample : nameSamples)
+        {
+            const auto& labels = sample->descriptor->labels;
+
+            if(sample->descriptor->type != MetricType::HISTOGRAM)
+            {
+                output << name << formatLabels(labels) << " " << sample->value << "\n";
+                continue;
+            }
+
+            const auto& histogram = sample->histogram;
+            uint64_t cumulativeCount = 0;
+
+            for(size_t bucket = 0; bucket < HistogramSnapshot::cBucketCount - 1; ++bucket)
+            {
+                cumulativeCount += histogram.buckets[bucket];
+
+                std::ostringstream upperBound;
+                upperBound.precision(15);
+                upperBound << std::chrono::duration<double>(HistogramSnapshot::getBucketUpperBound(bucket)).count();
+
+                output << name << "_bucket" << formatLabels(labels, "le", upperBound.str()) << " " << cumulativeCount << "\n";
+            }
+
+            output << name << "_bucket" << formatLabels(labels, "le", "+Inf") << " " << histogram.count << "\n";
+            output << name << "_sum" << formatLabels(labels) << " " << std::chrono::duration<double>(histogram.sum).count() << "\n";
+            output << name << "_count" << formatLabels(labels) << " " << histogram.count << "\n";
+        }
+    }
+
+    return output.str();
+}
+
+std::string PrometheusExporter::formatLabels(const Labels& labels, const std::string& extraName, const std::string& extraValue)
+{
+    if(labels.empty() && extraName.empty())
+    {
+        return std::string();
+    }
+
+    std::string output("{");
+    for(const auto& label : labels)
+    {
+        output += (output.size() > 1 ? "," : "") + label.first + "=\"" + escape(label.second) + "\"";
+    }
+
+    if(!extraName.empty())
+    {
+        output += (output.size() > 1 ? "," : "") + extraName + "=\"" + escape(extraValue) + "\"";
+    }
+
+    return output + "}";
+}
+
+std::string PrometheusExporter::escape(const std::string& value, bool escapeQuotes)
+{
+    std::string output;
+    output.reserve(value.size());
+
+    for(const auto character : value)
+    {
+        switch(character)
+        {
+        case '\\':
+            output += "\\\\";
+            break;
+        case '"':
+            output += escapeQuotes ? "\\\"" : "\"";
+            break;
+        case '\n':
+            output += "\\n";
+            break;
+        default:
+            output += character;
+            break;
+        }
+    }
+
+    return output;
+}
+
+std::string PrometheusExporter::typeToString(MetricType type)
+{
+    switch(type)
+    {
+    case MetricType::COUNTER:
+        return "counter";
+    case MetricType::GAUGE:
+        return "gauge";
+    case MetricType::HISTOGRAM:
+        return "histogram";
+    default:
+        return "untyped";
+    }
+}
+
+}
+}
@@ -0,0 +1,98 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <boost/test/unit_test.hpp>
+#include <aasdk/Metrics/MetricsRegistry.hpp>
+#include <aasdk/Metrics/PrometheusExporter.hpp>
+
+
+namespace aasdk
+{
+namespace metrics
+{
+namespace ut
+{
+
+BOOST_AUTO_TEST_CASE(PrometheusExporter_GroupSamplesByName)
+{
+    MetricsRegistry registry;
+    registry.getCounter("aasdk_bytes_total", "Bytes.", {{"channel", "VIDEO"}}).increment(10);
+    registry.getGauge("aasdk_depth", "Depth.").set(3);
+    registry.getCounter("aasdk_bytes_total", "Bytes.", {{"channel", "IN\"PUT"}}).increment(5);
+
+    const std::string expected =
+            "# HELP aasdk_bytes_total Bytes.\n"
+            "# TYPE aasdk_bytes_total counter\n"
+            "aasdk_bytes_total{channel=\"VIDEO\"} 10\n"
+            "aasdk_bytes_total{channel=\"IN\\\"PUT\"} 5\n"
+            "# HELP aasdk_depth Depth.\n"
+            "# TYPE aasdk_depth gauge\n"
+            "aasdk_depth 3\n";
+
+    BOOST_CHECK_EQUAL(PrometheusExporter::format(registry.getSnapshot()), expected);
+}
+
+BOOST_AUTO_TEST_CASE(PrometheusExporter_EscapeHelp)
+{
+    MetricsRegistry registry;
+    registry.getGauge("aasdk_depth", "Queue \"depth\"\nin C:\\frames.").set(1);
+
+    const std::string expected =
+            "# HELP aasdk_depth Queue \"depth\"\\nin C:\\\\frames.\n"
+            "# TYPE aasdk_depth gauge\n"
+            "aasdk_depth 1\n";
+
+    BOOST_CHECK_EQUAL(PrometheusExporter::format(registry.getSnapshot()), expected);
+}
+
+BOOST_AUTO_TEST_CASE(PrometheusExporter_CountBoundaryValueInItsBucket)
+{
+    MetricsRegistry registry;
+    auto& histogram = registry.getHistogram("aasdk_latency_seconds", "Latency.");
+    histogram.observe(std::chrono::microseconds(1));
+    histogram.observe(std::chrono::microseconds(4));
+    histogram.observe(std::chrono::nanoseconds(4001));
+
+    const auto output = PrometheusExporter::format(registry.getSnapshot());
+
+    BOOST_CHECK(output.find("aasdk_latency_seconds_bucket{le=\"1e-06\"} 1\n") != std::string::npos);
+    BOOST_CHECK(output.find("aasdk_latency_seconds_bucket{le=\"2e-06\"} 1\n") != std::string::npos);
+    BOOST_CHECK(output.find("aasdk_latency_seconds_bucket{le=\"4e-06\"} 2\n") != std::string::npos);
+    BOOST_CHECK(output.find("aasdk_latency_seconds_bucket{le=\"8e-06\"} 3\n") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(PrometheusExporter_FormatHistogram)
+{
+    MetricsRegistry registry;
+    auto& histogram = registry.getHistogram("aasdk_latency_seconds", "Latency.", {{"direction", "receive"}});
+    histogram.observe(std::chrono::microseconds(3));
+    histogram.observe(std::chrono::seconds(100));
+
+    const auto output = PrometheusExporter::format(registry.getSnapshot());
+
+    BOOST_CHECK(output.find("# TYPE aasdk_latency_seconds histogram\n") != std::string::npos);
+    BOOST_CHECK(output.find("aasdk_latency_seconds_bucket{direction=\"receive\",le=\"2e-06\"} 0\n") != std::string::npos);
+    BOOST_CHECK(output.find("aasdk_latency_seconds_bucket{direction=\"receive\",le=\"4e-06\"} 1\n") != std::string::npos);
+    BOOST_CHECK(output.find("aasdk_latency_seconds_bucket{direction=\"receive\",le=\"+Inf\"} 2\n") != std::string::npos);
+    BOOST_CHECK(output.find("aasdk_latency_seconds_sum{direction=\"receive\"} 100.000003\n") != std::string::npos);
+    BOOST_CHECK(output.find("aasdk_latency_seconds_count{direction=\"receive\"} 2\n") != std::string::npos);
+}
+
+}
+}
+}
@@ -0,0 +1,146 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <aasdk/Metrics/SessionMetrics.hpp>
+
+
+namespace aasdk
+{
+namespace metrics
+{
+
+namespace
+{
+
+Labels withLabel(Labels labels, std::string name, std::string value)
+{
+    labels.emplace_back(std::move(name), std::move(value));
+    return labels;
+}
+
+}
+
+SessionMetrics::SessionMetrics(MetricsRegistry::Pointer registry, Labels labels)
+    : registry_(std::move(registry))
+    , decryptFailures_(registry_->getCounter("aasdk_decrypt_failures_total", "Received frames which failed to decrypt.", labels))
+    , sendQueueDepth_(registry_->getGauge("aasdk_messenger_send_queue_depth", "Messages waiting in the messenger send queue.", labels))
+    , receiveRejections_(registry_->getCounter("aasdk_messenger_rejected_promises_total", "Messenger promises rejected with an error.", withLabel(labels, "direction", "receive")))
+    , sendRejections_(registry_->getCounter("aasdk_messenger_rejected_promises_total", "Messenger promises rejected with an error.", withLabel(labels, "direction", "send")))
+    , transportBytesReceived_(registry_->getCounter("aasdk_transport_bytes_received_total", "Bytes read from the transport.", labels))
+    , transportBytesSent_(registry_->getCounter("aasdk_transport_bytes_sent_total", "Bytes queued for sending on the transport.", labels))
+    , transportReceiveRejections_(registry_->getCounter("aasdk_transport_rejected_promises_total", "Transport promises rejected with an error.", withLabel(labels, "direction", "receive")))
+    , transportSendRejections_(registry_->getCounter("aasdk_transport_rejected_promises_total", "Transport promises rejected with an error.", withLabel(labels, "direction", "send")))
+    , receiveTransferLatency_(registry_->getHistogram("aasdk_transport_transfer_latency_seconds", "Time from submitting a transport transfer to its completion.", withLabel(labels, "direction", "receive")))
+    , sendTransferLatency_(registry_->getHistogram("aasdk_transport_transfer_latency_seconds", "Time from submitting a transport transfer to its completion.", withLabel(labels, "direction", "send")))
+{
+    channels_.reserve(cChannelCount);
+
+    for(size_t i = 0; i < cChannelCount; ++i)
+    {
+        const auto channelLabels = withLabel(labels, "channel", messenger::channelIdToString(i < cChannelCount - 1 ? static_cast<messenger::ChannelId>(i) : messenger::ChannelId::NONE));
+
+        channels_.push_back(ChannelMetrics{
+            registry_->getCounter("aasdk_channel_messages_received_total", "Messages received on a channel.", channelLabels),
+            registry_->getCounter("aasdk_channel_messages_sent_total", "Messages sent on a channel.", channelLabels),
+            registry_->getCounter("aasdk_channel_bytes_received_total", "Payload bytes received on a channel.", channelLabels),
+            registry_->getCounter("aasdk_channel_bytes_sent_total", "Payload bytes sent on a channel.", channelLabels),
+            registry_->getGauge("aasdk_channel_receive_queue_depth", "Received messages waiting for the channel to ask for them.", channelLabels)
+        });
+    }
+
+    for(size_t i = 0; i < cFrameTypeCount; ++i)
+    {
+        const auto frameType = messenger::frameTypeToString(static_cast<messenger::FrameType>(i));
+        framesReceived_[i] = &registry_->getCounter("aasdk_frames_received_total", "Frames received by frame type.", withLabel(labels, "frame_type", frameType));
+        framesSent_[i] = &registry_->getCounter("aasdk_frames_sent_total", "Frames sent by frame type.", withLabel(labels, "frame_type", frameType));
+    }
+}
+
+SessionMetrics::ChannelMetrics& SessionMetrics::getChannel(messenger::ChannelId channelId)
+{
+    const auto index = static_cast<size_t>(channelId);
+    return channels_[index < cChannelCount - 1 ? index : cChannelCount - 1];
+}
+
+Counter& SessionMetrics::getFramesReceived(messenger::FrameType frameType)
+{
+    return *framesReceived_[static_cast<size_t>(frameType) % cFrameTypeCount];
+}
+
+Counter& SessionMetrics::getFramesSent(messenger::FrameType frameType)
+{
+    return *framesSent_[static_cast<size_t>(frameType) % cFrameTypeCount];
+}
+
+Counter& SessionMetrics::getDecryptFailures()
+{
+    return decryptFailures_;
+}
+
+Gauge& SessionMetrics::getSendQueueDepth()
+{
+    return sendQueueDepth_;
+}
+
+Counter& SessionMetrics::getReceiveRejections()
+{
+    return receiveRejections_;
+}
+
+Counter& SessionMetrics::getSendRejections()
+{
+    return sendRejections_;
+}
+
+Counter& SessionMetrics::getTransportBytesReceived()
+{
+    return transportBytesReceived_;
+}
+
+Counter& SessionMetrics::getTransportBytesSent()
+{
+    return transportBytesSent_;
+}
+
+Counter& SessionMetrics::getTransportReceiveRejections()
+{
+    return transportReceiveRejections_;
+}
+
+Counter& SessionMetrics::getTransportSendRejections()
+{
+    return transportSendRejections_;
+}
+
+Histogram& SessionMetrics::getReceiveTransferLatency()
+{
+    return receiveTransferLatency_;
+}
+
+Histogram& SessionMetrics::getSendTransferLatency()
+{
+    return sendTransferLatency_;
+}
+
+const MetricsRegistry::Pointer& SessionMetrics::getRegistry() const
+{
+    return registry_;
+}
+
+}
+}
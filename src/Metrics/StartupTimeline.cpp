@@ -0,0 +1,124 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <aasdk/Metrics/StartupTimeline.hpp>
+
+
+namespace aasdk
+{
+namespace metrics
+{
+
+std::string startupPhaseToString(StartupPhase phase)
+{
+    switch(phase)
+    {
+    case StartupPhase::HOTPLUG_ARRIVED: return "HOTPLUG_ARRIVED";
+    case StartupPhase::ACCESSORY_MODE_QUERY: return "ACCESSORY_MODE_QUERY";
+    case StartupPhase::ACCESSORY_MODE_SWITCHED: return "ACCESSORY_MODE_SWITCHED";
+    case StartupPhase::DEVICE_REENUMERATED: return "DEVICE_REENUMERATED";
+    case StartupPhase::AOAP_DEVICE_CREATED: return "AOAP_DEVICE_CREATED";
+    case StartupPhase::VERSION_REQUEST: return "VERSION_REQUEST";
+    case StartupPhase::VERSION_RESPONSE: return "VERSION_RESPONSE";
+    case StartupPhase::SSL_HANDSHAKE: return "SSL_HANDSHAKE";
+    case StartupPhase::AUTH_COMPLETE: return "AUTH_COMPLETE";
+    case StartupPhase::SERVICE_DISCOVERY_REQUEST: return "SERVICE_DISCOVERY_REQUEST";
+    case StartupPhase::SERVICE_DISCOVERY_RESPONSE: return "SERVICE_DISCOVERY_RESPONSE";
+    case StartupPhase::CHANNEL_OPEN_REQUEST: return "CHANNEL_OPEN_REQUEST";
+    case StartupPhase::CHANNEL_OPEN_RESPONSE: return "CHANNEL_OPEN_RESPONSE";
+    case StartupPhase::FIRST_VIDEO_FRAME: return "FIRST_VIDEO_FRAME";
+    default: return "(null)";
+    }
+}
+
+StartupTimeline::StartupTimeline(Callback callback)
+    : callback_(std::move(callback))
+    , isCompleted_(false)
+{
+    Clock::enable();
+}
+
+StartupTimeline::~StartupTimeline()
+{
+    if(!isCompleted_)
+    {
+        Clock::disable();
+    }
+}
+
+void StartupTimeline::mark(StartupPhase phase, std::string detail)
+{
+    std::unique_lock<decltype(mutex_)> lock(mutex_);
+
+    if(isCompleted_)
+    {
+        return;
+    }
+
+    events_.push_back(Event{phase, std::move(detail), Clock::now()});
+
+    if(phase == StartupPhase::FIRST_VIDEO_FRAME)
+    {
+        this->complete(lock, error::Error());
+    }
+}
+
+void StartupTimeline::finish(const error::Error& e)
+{
+    std::unique_lock<decltype(mutex_)> lock(mutex_);
+
+    if(!isCompleted_)
+    {
+        this->complete(lock, e);
+    }
+}
+
+void StartupTimeline::complete(std::unique_lock<std::mutex>& lock, const error::Error& e)
+{
+    isCompleted_ = true;
+    Clock::disable();
+
+    const auto events = events_;
+    lock.unlock();
+
+    // Called without the lock so the callback may query the timeline.
+    if(callback_)
+    {
+        callback_(events, e);
+    }
+}
+
+StartupTimeline::Events StartupTimeline::getEvents() const
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    return events_;
+}
+
+bool StartupTimeline::isCompleted() const
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    return isCompleted_;
+}
+
+StartupTimeline::Clock::duration StartupTimeline::getElapsed(const Events& events, const Event& event)
+{
+    return events.empty() ? Clock::duration::zero() : event.time - events.front().time;
+}
+
+}
+}
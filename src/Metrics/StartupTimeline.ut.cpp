@@ -0,0 +1,90 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <boost/test/unit_test.hpp>
+#include <aasdk/Metrics/StartupTimeline.hpp>
+
+
+namespace aasdk
+{
+namespace metrics
+{
+namespace ut
+{
+
+BOOST_AUTO_TEST_CASE(StartupTimeline_CompleteOnFirstVideoFrame)
+{
+    size_t callbackCount = 0;
+    StartupTimeline::Events events;
+    error::Error error(error::ErrorCode::OPERATION_ABORTED);
+    StartupTimeline startupTimeline([&](const StartupTimeline::Events& timeline, const error::Error& e) {
+        ++callbackCount;
+        events = timeline;
+        error = e;
+    });
+
+    startupTimeline.mark(StartupPhase::HOTPLUG_ARRIVED, "18d1:4ee1");
+    startupTimeline.mark(StartupPhase::ACCESSORY_MODE_QUERY, "PROTOCOL_VERSION");
+    BOOST_CHECK(!startupTimeline.isCompleted());
+
+    startupTimeline.mark(StartupPhase::FIRST_VIDEO_FRAME, "VIDEO received");
+    startupTimeline.mark(StartupPhase::CHANNEL_OPEN_REQUEST, "INPUT received");
+
+    startupTimeline.finish(error::Error(error::ErrorCode::USB_TRANSFER));
+
+    BOOST_CHECK(startupTimeline.isCompleted());
+    BOOST_CHECK_EQUAL(callbackCount, 1);
+    BOOST_CHECK(error == error::ErrorCode::NONE);
+    BOOST_REQUIRE_EQUAL(events.size(), 3);
+    BOOST_CHECK_EQUAL(startupTimeline.getEvents().size(), 3);
+    BOOST_CHECK(events[0].phase == StartupPhase::HOTPLUG_ARRIVED);
+    BOOST_CHECK_EQUAL(events[1].detail, "PROTOCOL_VERSION");
+    BOOST_CHECK(StartupTimeline::getElapsed(events, events[0]) == StartupTimeline::Clock::duration::zero());
+    BOOST_CHECK(StartupTimeline::getElapsed(events, events[2]) >= StartupTimeline::getElapsed(events, events[1]));
+}
+
+BOOST_AUTO_TEST_CASE(StartupTimeline_FinishBeforeFirstVideoFrame)
+{
+    size_t callbackCount = 0;
+    StartupTimeline::Events events;
+    error::Error error;
+    StartupTimeline startupTimeline([&](const StartupTimeline::Events& timeline, const error::Error& e) {
+        ++callbackCount;
+        events = timeline;
+        error = e;
+    });
+
+    BOOST_CHECK(common::TraceClock::isEnabled());
+    startupTimeline.mark(StartupPhase::HOTPLUG_ARRIVED, "18d1:4ee1");
+    startupTimeline.mark(StartupPhase::ACCESSORY_MODE_QUERY, "PROTOCOL_VERSION");
+    startupTimeline.finish(error::Error(error::ErrorCode::USB_TRANSFER, 5));
+    startupTimeline.mark(StartupPhase::ACCESSORY_MODE_SWITCHED);
+    startupTimeline.finish(error::Error(error::ErrorCode::OPERATION_ABORTED));
+
+    // The phases reached so far are reported once, with the error which ended the connection.
+    BOOST_CHECK(startupTimeline.isCompleted());
+    BOOST_CHECK_EQUAL(callbackCount, 1);
+    BOOST_CHECK(error == error::Error(error::ErrorCode::USB_TRANSFER, 5));
+    BOOST_REQUIRE_EQUAL(events.size(), 2);
+    BOOST_CHECK(events[1].phase == StartupPhase::ACCESSORY_MODE_QUERY);
+    BOOST_CHECK(events[0].time != StartupTimeline::Clock::time_point());
+}
+
+}
+}
+}
@@ -0,0 +1,246 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <endian.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <aasdk/Transport/CaptureFile.hpp>
+#include <aasdk/Error/Error.hpp>
+#include <aasdk/Common/Log.hpp>
+
+
+namespace aasdk
+{
+namespace transport
+{
+
+namespace
+{
+
+constexpr char cCaptureMagic[8] = {'A', 'A', 'S', 'D', 'K', 'C', 'A', 'P'};
+constexpr uint32_t cCaptureVersion = 1;
+constexpr size_t cHeaderSize = sizeof(cCaptureMagic) + 2 * sizeof(uint32_t);
+constexpr size_t cRecordHeaderSize = sizeof(uint64_t) + sizeof(uint32_t);
+constexpr uint32_t cDirectionBit = 0x80000000;
+constexpr size_t cMinGrowthSize = 4 * 1024 * 1024;
+
+}
+
+CaptureWriter::CaptureWriter(const std::string& path)
+    : fd_(::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644))
+    , mapping_(nullptr)
+    , capacity_(0)
+    , size_(0)
+    , startTime_(std::chrono::steady_clock::now())
+{
+    if(fd_ < 0)
+    {
+        throw error::Error(error::ErrorCode::CAPTURE_FILE_OPEN, errno);
+    }
+
+    if(!this->reserve(cHeaderSize))
+    {
+        const auto nativeCode = errno;
+        ::close(fd_);
+        throw error::Error(error::ErrorCode::CAPTURE_FILE_WRITE, nativeCode);
+    }
+
+    const uint32_t version = htole32(cCaptureVersion);
+    const uint32_t headerSize = htole32(cHeaderSize);
+    memcpy(mapping_, cCaptureMagic, sizeof(cCaptureMagic));
+    memcpy(mapping_ + sizeof(cCaptureMagic), &version, sizeof(version));
+    memcpy(mapping_ + sizeof(cCaptureMagic) + sizeof(version), &headerSize, sizeof(headerSize));
+    size_ = cHeaderSize;
+}
+
+CaptureWriter::~CaptureWriter()
+{
+    this->close();
+}
+
+void CaptureWriter::write(CaptureDirection direction, const common::DataConstBuffer& buffer)
+{
+    this->write(direction, buffer, std::chrono::steady_clock::now());
+}
+
+void CaptureWriter::write(CaptureDirection direction, const common::DataConstBuffer& buffer, std::chrono::steady_clock::time_point timestamp)
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    const auto offset = std::max(std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp - startTime_).count(), std::chrono::nanoseconds::rep(0));
+
+    if(fd_ < 0 || buffer.size == 0 || buffer.size >= cDirectionBit)
+    {
+        return;
+    }
+
+    if(!this->reserve(size_ + cRecordHeaderSize + buffer.size))
+    {
+        // A full disk must not take the session down; the capture simply ends here.
+        AASDK_LOG(error) << "[CaptureWriter] capture stopped, errno: " << errno;
+        munmap(mapping_, capacity_);
+        mapping_ = nullptr;
+        ::ftruncate(fd_, size_);
+        ::close(fd_);
+        fd_ = -1;
+        return;
+    }
+
+    const uint64_t timestampLe = htole64(static_cast<uint64_t>(offset));
+    const uint32_t sizeLe = htole32(static_cast<uint32_t>(buffer.size) | (direction == CaptureDirection::SEND ? cDirectionBit : 0));
+
+    memcpy(mapping_ + size_, &timestampLe, sizeof(timestampLe));
+    memcpy(mapping_ + size_ + sizeof(timestampLe), &sizeLe, sizeof(sizeLe));
+    memcpy(mapping_ + size_ + cRecordHeaderSize, buffer.cdata, buffer.size);
+    size_ += cRecordHeaderSize + buffer.size;
+}
+
+void CaptureWriter::close()
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    if(fd_ < 0)
+    {
+        return;
+    }
+
+    msync(mapping_, size_, MS_SYNC);
+    munmap(mapping_, capacity_);
+    mapping_ = nullptr;
+
+    ::ftruncate(fd_, size_);
+    ::close(fd_);
+    fd_ = -1;
+}
+
+bool CaptureWriter::reserve(size_t size)
+{
+    if(size <= capacity_)
+    {
+        return true;
+    }
+
+    const auto capacity = std::max(size, std::max(capacity_ * 2, cMinGrowthSize));
+
+    // Blocks are allocated up front: a sparse tail would turn a full disk into SIGBUS on the mapped write.
+    const auto result = ::posix_fallocate(fd_, capacity_, capacity - capacity_);
+    if(result != 0)
+    {
+        errno = result;
+        return false;
+    }
+
+    if(mapping_ != nullptr)
+    {
+        munmap(mapping_, capacity_);
+    }
+
+    auto mapping = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if(mapping == MAP_FAILED)
+    {
+        mapping_ = nullptr;
+        capacity_ = 0;
+        return false;
+    }
+
+    mapping_ = static_cast<common::Data::value_type*>(mapping);
+    capacity_ = capacity;
+    return true;
+}
+
+CaptureReader::CaptureReader(const std::string& path)
+    : fd_(::open(path.c_str(), O_RDONLY | O_CLOEXEC))
+    , mapping_(nullptr)
+    , size_(0)
+{
+    if(fd_ < 0)
+    {
+        throw error::Error(error::ErrorCode::CAPTURE_FILE_OPEN, errno);
+    }
+
+    struct stat fileStat;
+    if(fstat(fd_, &fileStat) != 0 || static_cast<size_t>(fileStat.st_size) < cHeaderSize)
+    {
+        ::close(fd_);
+        throw error::Error(error::ErrorCode::CAPTURE_FILE_FORMAT);
+    }
+
+    size_ = fileStat.st_size;
+    auto mapping = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+    if(mapping == MAP_FAILED)
+    {
+        const auto nativeCode = errno;
+        ::close(fd_);
+        throw error::Error(error::ErrorCode::CAPTURE_FILE_OPEN, nativeCode);
+    }
+
+    mapping_ = static_cast<const common::Data::value_type*>(mapping);
+
+    uint32_t version;
+    uint32_t headerSize;
+    memcpy(&version, mapping_ + sizeof(cCaptureMagic), sizeof(version));
+    memcpy(&headerSize, mapping_ + sizeof(cCaptureMagic) + sizeof(version), sizeof(headerSize));
+
+    if(memcmp(mapping_, cCaptureMagic, sizeof(cCaptureMagic)) != 0 || le32toh(version) != cCaptureVersion
+       || le32toh(headerSize) < cHeaderSize || le32toh(headerSize) > size_)
+    {
+        munmap(const_cast<common::Data::value_type*>(mapping_), size_);
+        ::close(fd_);
+        throw error::Error(error::ErrorCode::CAPTURE_FILE_FORMAT);
+    }
+
+    for(size_t offset = le32toh(headerSize); offset + cRecordHeaderSize <= size_;)
+    {
+        uint64_t timestamp;
+        uint32_t sizeAndDirection;
+        memcpy(&timestamp, mapping_ + offset, sizeof(timestamp));
+        memcpy(&sizeAndDirection, mapping_ + offset + sizeof(timestamp), sizeof(sizeAndDirection));
+
+        sizeAndDirection = le32toh(sizeAndDirection);
+        const size_t recordSize = sizeAndDirection & ~cDirectionBit;
+
+        if(recordSize == 0 || offset + cRecordHeaderSize + recordSize > size_)
+        {
+            break;
+        }
+
+        records_.push_back(Record{std::chrono::nanoseconds(le64toh(timestamp)),
+                                  (sizeAndDirection & cDirectionBit) != 0 ? CaptureDirection::SEND : CaptureDirection::RECEIVE,
+                                  common::DataConstBuffer(mapping_ + offset + cRecordHeaderSize, recordSize)});
+        offset += cRecordHeaderSize + recordSize;
+    }
+}
+
+CaptureReader::~CaptureReader()
+{
+    munmap(const_cast<common::Data::value_type*>(mapping_), size_);
+    ::close(fd_);
+}
+
+const std::vector<CaptureReader::Record>& CaptureReader::getRecords() const
+{
+    return records_;
+}
+
+}
+}
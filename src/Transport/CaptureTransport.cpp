@@ -0,0 +1,81 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <aasdk/Transport/CaptureTransport.hpp>
+
+
+namespace aasdk
+{
+namespace transport
+{
+
+CaptureTransport::CaptureTransport(asio::io_service& ioService, ITransport::Pointer transport, CaptureWriter::Pointer captureWriter)
+    : receiveStrand_(ioService)
+    , transport_(std::move(transport))
+    , captureWriter_(std::move(captureWriter))
+{
+    // The wrapped transport only records transfer completion times while tracing is enabled.
+    common::TraceClock::enable();
+}
+
+CaptureTransport::~CaptureTransport()
+{
+    common::TraceClock::disable();
+}
+
+void CaptureTransport::receive(size_t size, ReceivePromise::Pointer promise)
+{
+    // Completions are recorded on one strand so the capture keeps the delivery order.
+    auto capturePromise = ReceivePromise::defer(receiveStrand_);
+    capturePromise->then([this, self = this->shared_from_this(), promise](common::Data data) {
+            // Receives are forwarded as they are issued and consumers issue the next one only after
+            // this one is delivered, so the last timestamps still belong to this chunk.
+            auto timestamp = transport_->getLastReceiveTimestamps().transferCompleted;
+            if(timestamp == common::TraceClock::time_point())
+            {
+                timestamp = common::TraceClock::Clock::now();
+            }
+
+            captureWriter_->write(CaptureDirection::RECEIVE, common::DataConstBuffer(data), timestamp);
+            promise->resolve(std::move(data));
+        },
+        [promise](const error::Error& e) {
+            promise->reject(e);
+        });
+
+    transport_->receive(size, std::move(capturePromise));
+}
+
+void CaptureTransport::send(common::Data data, SendPromise::Pointer promise)
+{
+    captureWriter_->write(CaptureDirection::SEND, common::DataConstBuffer(data));
+    transport_->send(std::move(data), std::move(promise));
+}
+
+void CaptureTransport::stop()
+{
+    transport_->stop();
+}
+
+CaptureTransport::ReceiveTimestamps CaptureTransport::getLastReceiveTimestamps() const
+{
+    return transport_->getLastReceiveTimestamps();
+}
+
+}
+}
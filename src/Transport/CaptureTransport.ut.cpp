@@ -0,0 +1,214 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <Transport/UT/Transport.mock.hpp>
+#include <Transport/UT/TransportReceivePromiseHandler.mock.hpp>
+#include <Transport/UT/TransportSendPromiseHandler.mock.hpp>
+#include <aasdk/Transport/MemoryTransport.hpp>
+#include <aasdk/Transport/CaptureTransport.hpp>
+#include <aasdk/Transport/ReplayTransport.hpp>
+
+
+namespace aasdk
+{
+namespace transport
+{
+namespace ut
+{
+
+using ::testing::_;
+using ::testing::Return;
+using ::testing::SaveArg;
+
+class CaptureTransportUnitTest
+{
+protected:
+    CaptureTransportUnitTest()
+        : capturePath_("/tmp/aasdk_capture_transport_ut.cap")
+        , receivePromise_(ITransport::ReceivePromise::defer(ioService_))
+        , sendPromise_(ITransport::SendPromise::defer(ioService_))
+    {
+        receivePromise_->then(std::bind(&TransportReceivePromiseHandlerMock::onResolve, &receivePromiseHandlerMock_, std::placeholders::_1),
+                              std::bind(&TransportReceivePromiseHandlerMock::onReject, &receivePromiseHandlerMock_, std::placeholders::_1));
+
+        sendPromise_->then(std::bind(&TransportSendPromiseHandlerMock::onResolve, &sendPromiseHandlerMock_),
+                           std::bind(&TransportSendPromiseHandlerMock::onReject, &sendPromiseHandlerMock_, std::placeholders::_1));
+    }
+
+    ~CaptureTransportUnitTest()
+    {
+        std::remove(capturePath_.c_str());
+    }
+
+    std::string capturePath_;
+    asio::io_service ioService_;
+    TransportReceivePromiseHandlerMock receivePromiseHandlerMock_;
+    ITransport::ReceivePromise::Pointer receivePromise_;
+    TransportSendPromiseHandlerMock sendPromiseHandlerMock_;
+    ITransport::SendPromise::Pointer sendPromise_;
+};
+
+BOOST_FIXTURE_TEST_CASE(CaptureTransport_RecordsBothDirections, CaptureTransportUnitTest)
+{
+    auto transports = MemoryTransport::createPair(ioService_);
+    auto captureWriter = std::make_shared<CaptureWriter>(capturePath_);
+    auto captureTransport = std::make_shared<CaptureTransport>(ioService_, transports.first, captureWriter);
+
+    const common::Data sentData(100, 0x11);
+    const common::Data receivedData(200, 0x22);
+
+    EXPECT_CALL(sendPromiseHandlerMock_, onResolve());
+    EXPECT_CALL(receivePromiseHandlerMock_, onResolve(receivedData));
+
+    captureTransport->send(sentData, std::move(sendPromise_));
+    captureTransport->receive(receivedData.size(), std::move(receivePromise_));
+    transports.second->send(receivedData, ITransport::SendPromise::defer(ioService_));
+    ioService_.run();
+    captureWriter->close();
+
+    CaptureReader captureReader(capturePath_);
+    const auto& records = captureReader.getRecords();
+
+    BOOST_REQUIRE_EQUAL(records.size(), 2u);
+    BOOST_TEST((records[0].direction == CaptureDirection::SEND));
+    BOOST_TEST((common::createData(records[0].data) == sentData));
+    BOOST_TEST((records[1].direction == CaptureDirection::RECEIVE));
+    BOOST_TEST((common::createData(records[1].data) == receivedData));
+    BOOST_TEST(records[0].timestamp.count() <= records[1].timestamp.count());
+}
+
+BOOST_FIXTURE_TEST_CASE(CaptureTransport_StampsReceivesWithTransferCompletion, CaptureTransportUnitTest)
+{
+    auto transportMock = std::make_shared<TransportMock>();
+    auto captureWriter = std::make_shared<CaptureWriter>(capturePath_);
+    auto captureTransport = std::make_shared<CaptureTransport>(ioService_, transportMock, captureWriter);
+
+    // Both chunks are consumed at the same time, but their transfers completed 30 ms apart.
+    const auto transferCompleted = std::chrono::steady_clock::now();
+    ITransport::ReceivePromise::Pointer firstTransportPromise;
+    ITransport::ReceivePromise::Pointer secondTransportPromise;
+    EXPECT_CALL(*transportMock, receive(1, _)).WillOnce(SaveArg<1>(&firstTransportPromise)).WillOnce(SaveArg<1>(&secondTransportPromise));
+    EXPECT_CALL(*transportMock, getLastReceiveTimestamps())
+            .WillOnce(Return(ITransport::ReceiveTimestamps{transferCompleted, transferCompleted}))
+            .WillOnce(Return(ITransport::ReceiveTimestamps{transferCompleted + std::chrono::milliseconds(30), transferCompleted}));
+    EXPECT_CALL(receivePromiseHandlerMock_, onResolve(common::Data{0x01}));
+
+    captureTransport->receive(1, std::move(receivePromise_));
+    firstTransportPromise->resolve(common::Data{0x01});
+    ioService_.run();
+    ioService_.reset();
+
+    captureTransport->receive(1, ITransport::ReceivePromise::defer(ioService_));
+    secondTransportPromise->resolve(common::Data{0x02});
+    ioService_.run();
+    captureWriter->close();
+
+    CaptureReader captureReader(capturePath_);
+    const auto& records = captureReader.getRecords();
+
+    BOOST_REQUIRE_EQUAL(records.size(), 2u);
+    BOOST_TEST((records[1].timestamp - records[0].timestamp == std::chrono::milliseconds(30)));
+}
+
+BOOST_FIXTURE_TEST_CASE(ReplayTransport_ServesReceivedBytesAcrossRecords, CaptureTransportUnitTest)
+{
+    auto captureWriter = std::make_shared<CaptureWriter>(capturePath_);
+    captureWriter->write(CaptureDirection::RECEIVE, common::DataConstBuffer(common::Data{0x01, 0x02, 0x03}));
+    captureWriter->write(CaptureDirection::SEND, common::DataConstBuffer(common::Data{0xFF}));
+    captureWriter->write(CaptureDirection::RECEIVE, common::DataConstBuffer(common::Data{0x04, 0x05}));
+    captureWriter->close();
+
+    auto replayTransport = std::make_shared<ReplayTransport>(ioService_, std::make_shared<CaptureReader>(capturePath_), ReplayTransport::Pacing::AS_FAST_AS_POSSIBLE);
+
+    EXPECT_CALL(receivePromiseHandlerMock_, onResolve(common::Data{0x01, 0x02, 0x03, 0x04}));
+
+    TransportReceivePromiseHandlerMock secondReceivePromiseHandlerMock;
+    auto secondReceivePromise = ITransport::ReceivePromise::defer(ioService_);
+    secondReceivePromise->then(std::bind(&TransportReceivePromiseHandlerMock::onResolve, &secondReceivePromiseHandlerMock, std::placeholders::_1),
+                               std::bind(&TransportReceivePromiseHandlerMock::onReject, &secondReceivePromiseHandlerMock, std::placeholders::_1));
+    EXPECT_CALL(secondReceivePromiseHandlerMock, onResolve(common::Data{0x05}));
+
+    TransportReceivePromiseHandlerMock thirdReceivePromiseHandlerMock;
+    auto thirdReceivePromise = ITransport::ReceivePromise::defer(ioService_);
+    thirdReceivePromise->then(std::bind(&TransportReceivePromiseHandlerMock::onResolve, &thirdReceivePromiseHandlerMock, std::placeholders::_1),
+                              std::bind(&TransportReceivePromiseHandlerMock::onReject, &thirdReceivePromiseHandlerMock, std::placeholders::_1));
+    EXPECT_CALL(thirdReceivePromiseHandlerMock, onReject(error::Error(error::ErrorCode::OPERATION_ABORTED)));
+
+    replayTransport->receive(4, std::move(receivePromise_));
+    replayTransport->receive(1, std::move(secondReceivePromise));
+    replayTransport->receive(1, std::move(thirdReceivePromise));
+    ioService_.run();
+}
+
+BOOST_FIXTURE_TEST_CASE(ReplayTransport_OriginalPacing, CaptureTransportUnitTest)
+{
+    auto captureWriter = std::make_shared<CaptureWriter>(capturePath_);
+    captureWriter->write(CaptureDirection::RECEIVE, common::DataConstBuffer(common::Data{0x01}));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    captureWriter->write(CaptureDirection::RECEIVE, common::DataConstBuffer(common::Data{0x02}));
+    captureWriter->close();
+
+    auto replayTransport = std::make_shared<ReplayTransport>(ioService_, std::make_shared<CaptureReader>(capturePath_), ReplayTransport::Pacing::ORIGINAL);
+
+    EXPECT_CALL(receivePromiseHandlerMock_, onResolve(common::Data{0x01, 0x02}));
+
+    const auto start = std::chrono::steady_clock::now();
+    replayTransport->receive(2, std::move(receivePromise_));
+    ioService_.run();
+
+    const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    BOOST_TEST(duration.count() >= 50);
+}
+
+BOOST_FIXTURE_TEST_CASE(ReplayTransport_OriginalPacingKeepsUnevenGaps, CaptureTransportUnitTest)
+{
+    auto captureWriter = std::make_shared<CaptureWriter>(capturePath_);
+    const auto captureStart = std::chrono::steady_clock::now();
+    captureWriter->write(CaptureDirection::RECEIVE, common::DataConstBuffer(common::Data{0x01}), captureStart);
+    captureWriter->write(CaptureDirection::RECEIVE, common::DataConstBuffer(common::Data{0x02}), captureStart + std::chrono::milliseconds(5));
+    captureWriter->write(CaptureDirection::RECEIVE, common::DataConstBuffer(common::Data{0x03}), captureStart + std::chrono::milliseconds(80));
+    captureWriter->close();
+
+    auto replayTransport = std::make_shared<ReplayTransport>(ioService_, std::make_shared<CaptureReader>(capturePath_), ReplayTransport::Pacing::ORIGINAL);
+
+    std::vector<std::chrono::steady_clock::time_point> deliveryTimes;
+    for(size_t i = 0; i < 3; ++i)
+    {
+        auto promise = ITransport::ReceivePromise::defer(ioService_);
+        promise->then([&deliveryTimes](common::Data) { deliveryTimes.push_back(std::chrono::steady_clock::now()); });
+        replayTransport->receive(1, std::move(promise));
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    ioService_.run();
+
+    BOOST_REQUIRE_EQUAL(deliveryTimes.size(), 3u);
+    // The first two chunks arrived as a burst and must not be spread over the long gap.
+    BOOST_TEST((deliveryTimes[1] - deliveryTimes[0] < std::chrono::milliseconds(40)));
+    BOOST_TEST((deliveryTimes[1] - start >= std::chrono::milliseconds(5)));
+    BOOST_TEST((deliveryTimes[2] - start >= std::chrono::milliseconds(80)));
+}
+
+}
+}
+}
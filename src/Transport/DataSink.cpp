@@ -41,10 +41,22 @@ common::DataBuffer DataSink::fill()
 }
 
 void DataSink::commit(common::Data::size_type size)
+{
+    error::Error e;
+    this->commit(size, e);
+
+    if(e != error::ErrorCode::NONE)
+    {
+        throw e;
+    }
+}
+
+void DataSink::commit(common::Data::size_type size, error::Error& e)
 {
     if(size > cChunkSize)
     {
-        throw error::Error(error::ErrorCode::DATA_SINK_COMMIT_OVERFLOW);
+        e = error::Error(error::ErrorCode::DATA_SINK_COMMIT_OVERFLOW);
+        return;
     }
 
     data_.erase_end((cChunkSize - size));
@@ -56,10 +68,24 @@ common::Data::size_type DataSink::getAvailableSize()
 }
 
 common::Data DataSink::consume(common::Data::size_type size)
+{
+    error::Error e;
+    auto data(this->consume(size, e));
+
+    if(e != error::ErrorCode::NONE)
+    {
+        throw e;
+    }
+
+    return data;
+}
+
+common::Data DataSink::consume(common::Data::size_type size, error::Error& e)
 {
     if(size > data_.size())
     {
-        throw error::Error(error::ErrorCode::DATA_SINK_CONSUME_UNDERFLOW);
+        e = error::Error(error::ErrorCode::DATA_SINK_CONSUME_UNDERFLOW);
+        return common::Data();
     }
 
     common::Data data(size, 0);
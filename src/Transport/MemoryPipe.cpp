@@ -0,0 +1,216 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <aasdk/Transport/MemoryPipe.hpp>
+#include <aasdk/Error/Error.hpp>
+
+
+namespace aasdk
+{
+namespace transport
+{
+
+MemoryPipe::MemoryPipe(asio::io_service& ioService, Configuration configuration)
+    : configuration_(std::move(configuration))
+    , data_(std::max(configuration_.capacity, configuration_.maxTransferSize))
+    , linkFreeTime_(Clock::now())
+    , isClosed_(false)
+    , writeOffset_(0)
+    , writeTimer_(ioService)
+    , readTimer_(ioService)
+    , isReadTimerArmed_(false)
+{
+    configuration_.packetSize = std::max<size_t>(configuration_.packetSize, 1);
+    configuration_.maxTransferSize = std::max(configuration_.maxTransferSize, configuration_.packetSize);
+}
+
+void MemoryPipe::write(common::DataConstBuffer buffer, Promise::Pointer promise)
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    if(isClosed_)
+    {
+        promise->reject(error::Error(error::ErrorCode::OPERATION_ABORTED));
+    }
+    else if(writePromise_ != nullptr)
+    {
+        promise->reject(error::Error(error::ErrorCode::OPERATION_IN_PROGRESS));
+    }
+    else
+    {
+        writeBuffer_ = buffer;
+        writeOffset_ = 0;
+        writePromise_ = std::move(promise);
+        this->pushTransfers();
+    }
+}
+
+void MemoryPipe::read(common::DataBuffer buffer, Promise::Pointer promise)
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    if(isClosed_)
+    {
+        promise->reject(error::Error(error::ErrorCode::OPERATION_ABORTED));
+    }
+    else if(readPromise_ != nullptr)
+    {
+        promise->reject(error::Error(error::ErrorCode::OPERATION_IN_PROGRESS));
+    }
+    else
+    {
+        readBuffer_ = buffer;
+        readPromise_ = std::move(promise);
+        this->deliverTransfer();
+    }
+}
+
+void MemoryPipe::close()
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    isClosed_ = true;
+    writeTimer_.cancel();
+    readTimer_.cancel();
+
+    if(writePromise_ != nullptr)
+    {
+        writePromise_->reject(error::Error(error::ErrorCode::OPERATION_ABORTED));
+        writePromise_.reset();
+    }
+
+    if(readPromise_ != nullptr)
+    {
+        readPromise_->reject(error::Error(error::ErrorCode::OPERATION_ABORTED));
+        readPromise_.reset();
+    }
+
+    transfers_.clear();
+    data_.clear();
+}
+
+void MemoryPipe::pushTransfers()
+{
+    if(writePromise_ == nullptr)
+    {
+        return;
+    }
+
+    while(writeOffset_ < writeBuffer_.size)
+    {
+        const auto size = std::min(configuration_.maxTransferSize, writeBuffer_.size - writeOffset_);
+
+        // The ring buffer is full; the rest is pushed once the reader drains it.
+        if(data_.reserve() < size)
+        {
+            return;
+        }
+
+        linkFreeTime_ = std::max(linkFreeTime_, Clock::now()) + this->getWireTime(size);
+        transfers_.push_back(Transfer{size, linkFreeTime_ + configuration_.latency});
+
+        const auto begin = writeBuffer_.cdata + writeOffset_;
+        data_.insert(data_.end(), begin, begin + size);
+        writeOffset_ += size;
+    }
+
+    const auto bytesTransferred = writeBuffer_.size;
+    auto promise = std::move(writePromise_);
+    writePromise_.reset();
+
+    if(linkFreeTime_ <= Clock::now())
+    {
+        promise->resolve(bytesTransferred);
+    }
+    else
+    {
+        writeTimer_.expires_at(linkFreeTime_);
+        writeTimer_.async_wait([self = this->shared_from_this(), promise = std::move(promise), bytesTransferred](const asio::error_code& ec) {
+            if(!ec)
+            {
+                promise->resolve(bytesTransferred);
+            }
+            else
+            {
+                promise->reject(error::Error(error::ErrorCode::OPERATION_ABORTED));
+            }
+        });
+    }
+
+    this->deliverTransfer();
+}
+
+void MemoryPipe::deliverTransfer()
+{
+    if(readPromise_ == nullptr || transfers_.empty() || isReadTimerArmed_)
+    {
+        return;
+    }
+
+    auto& transfer = transfers_.front();
+
+    if(transfer.arrivalTime > Clock::now())
+    {
+        isReadTimerArmed_ = true;
+        readTimer_.expires_at(transfer.arrivalTime);
+        readTimer_.async_wait([this, self = this->shared_from_this()](const asio::error_code& ec) {
+            std::lock_guard<decltype(mutex_)> lock(mutex_);
+            isReadTimerArmed_ = false;
+
+            if(!ec)
+            {
+                this->deliverTransfer();
+            }
+        });
+
+        return;
+    }
+
+    const auto size = std::min(readBuffer_.size, transfer.size);
+    std::copy(data_.begin(), data_.begin() + size, readBuffer_.data);
+    data_.erase_begin(size);
+
+    transfer.size -= size;
+    if(transfer.size == 0)
+    {
+        transfers_.pop_front();
+    }
+
+    readPromise_->resolve(size);
+    readPromise_.reset();
+
+    this->pushTransfers();
+}
+
+MemoryPipe::Clock::duration MemoryPipe::getWireTime(size_t size) const
+{
+    if(configuration_.bandwidth == 0)
+    {
+        return Clock::duration::zero();
+    }
+
+    // Every bulk transfer occupies whole packets on the wire.
+    const auto packets = (size + configuration_.packetSize - 1) / configuration_.packetSize;
+    const auto wireSize = packets * configuration_.packetSize;
+
+    return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(static_cast<double>(wireSize) / configuration_.bandwidth));
+}
+
+}
+}
@@ -0,0 +1,98 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <aasdk/Transport/MemoryTransport.hpp>
+
+
+namespace aasdk
+{
+namespace transport
+{
+
+MemoryTransport::MemoryTransport(asio::io_service& ioService, MemoryPipe::Pointer inPipe, MemoryPipe::Pointer outPipe)
+    : Transport(ioService)
+    , inPipe_(std::move(inPipe))
+    , outPipe_(std::move(outPipe))
+{
+
+}
+
+MemoryTransport::Pair MemoryTransport::createPair(asio::io_service& ioService, const MemoryPipe::Configuration& configuration)
+{
+    auto firstToSecond = std::make_shared<MemoryPipe>(ioService, configuration);
+    auto secondToFirst = std::make_shared<MemoryPipe>(ioService, configuration);
+
+    return std::make_pair(std::make_shared<MemoryTransport>(ioService, secondToFirst, firstToSecond),
+                          std::make_shared<MemoryTransport>(ioService, firstToSecond, secondToFirst));
+}
+
+void MemoryTransport::enqueueReceive(common::DataBuffer buffer)
+{
+    auto receivePromise = MemoryPipe::Promise::defer(receiveStrand_);
+    receivePromise->then([this, self = this->shared_from_this()](auto bytesTransferred) {
+            this->receiveHandler(bytesTransferred);
+        },
+        [this, self = this->shared_from_this()](auto e) {
+            this->rejectReceivePromises(e);
+        });
+
+    inPipe_->read(buffer, std::move(receivePromise));
+}
+
+void MemoryTransport::enqueueSend(SendQueue::iterator queueElement)
+{
+    auto sendPromise = MemoryPipe::Promise::defer(sendStrand_);
+
+    sendPromise->then([this, self = this->shared_from_this(), queueElement](auto) {
+        this->sendHandler(queueElement, error::Error());
+    },
+    [this, self = this->shared_from_this(), queueElement](auto e) {
+        this->sendHandler(queueElement, e);
+    });
+
+    outPipe_->write(common::DataConstBuffer(queueElement->first), std::move(sendPromise));
+}
+
+void MemoryTransport::stop()
+{
+    // Closing both directions looks like an unplug to this end and to the peer.
+    inPipe_->close();
+    outPipe_->close();
+}
+
+void MemoryTransport::sendHandler(SendQueue::iterator queueElement, const error::Error& e)
+{
+    if(!e)
+    {
+        queueElement->second->resolve();
+    }
+    else
+    {
+        queueElement->second->reject(e);
+    }
+
+    sendQueue_.erase(queueElement);
+
+    if(!sendQueue_.empty())
+    {
+        this->enqueueSend(sendQueue_.begin());
+    }
+}
+
+}
+}
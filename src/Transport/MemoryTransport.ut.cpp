@@ -0,0 +1,112 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <boost/test/unit_test.hpp>
+#include <Transport/UT/TransportReceivePromiseHandler.mock.hpp>
+#include <Transport/UT/TransportSendPromiseHandler.mock.hpp>
+#include <aasdk/Transport/MemoryTransport.hpp>
+
+
+namespace aasdk
+{
+namespace transport
+{
+namespace ut
+{
+
+using ::testing::_;
+
+class MemoryTransportUnitTest
+{
+protected:
+    MemoryTransportUnitTest()
+        : receivePromise_(ITransport::ReceivePromise::defer(ioService_))
+        , sendPromise_(ITransport::SendPromise::defer(ioService_))
+    {
+        receivePromise_->then(std::bind(&TransportReceivePromiseHandlerMock::onResolve, &receivePromiseHandlerMock_, std::placeholders::_1),
+                              std::bind(&TransportReceivePromiseHandlerMock::onReject, &receivePromiseHandlerMock_, std::placeholders::_1));
+
+        sendPromise_->then(std::bind(&TransportSendPromiseHandlerMock::onResolve, &sendPromiseHandlerMock_),
+                           std::bind(&TransportSendPromiseHandlerMock::onReject, &sendPromiseHandlerMock_, std::placeholders::_1));
+    }
+
+    asio::io_service ioService_;
+    TransportReceivePromiseHandlerMock receivePromiseHandlerMock_;
+    ITransport::ReceivePromise::Pointer receivePromise_;
+    TransportSendPromiseHandlerMock sendPromiseHandlerMock_;
+    ITransport::SendPromise::Pointer sendPromise_;
+};
+
+BOOST_FIXTURE_TEST_CASE(MemoryTransport_SendToPeer, MemoryTransportUnitTest)
+{
+    auto transports = MemoryTransport::createPair(ioService_);
+
+    common::Data data(100000, 0x5E);
+    data[0] = 0x01;
+    data[data.size() - 1] = 0x02;
+
+    EXPECT_CALL(sendPromiseHandlerMock_, onResolve());
+    EXPECT_CALL(sendPromiseHandlerMock_, onReject(_)).Times(0);
+    EXPECT_CALL(receivePromiseHandlerMock_, onResolve(data));
+    EXPECT_CALL(receivePromiseHandlerMock_, onReject(_)).Times(0);
+
+    transports.second->receive(data.size(), std::move(receivePromise_));
+    transports.first->send(data, std::move(sendPromise_));
+    ioService_.run();
+}
+
+BOOST_FIXTURE_TEST_CASE(MemoryTransport_BandwidthAndLatency, MemoryTransportUnitTest)
+{
+    MemoryPipe::Configuration configuration;
+    configuration.bandwidth = 1024 * 1024;
+    configuration.latency = std::chrono::milliseconds(20);
+    auto transports = MemoryTransport::createPair(ioService_, configuration);
+
+    const common::Data data(100 * 1024, 0x5E);
+
+    EXPECT_CALL(sendPromiseHandlerMock_, onResolve());
+    EXPECT_CALL(receivePromiseHandlerMock_, onResolve(data));
+
+    const auto start = std::chrono::steady_clock::now();
+    transports.second->receive(data.size(), std::move(receivePromise_));
+    transports.first->send(data, std::move(sendPromise_));
+    ioService_.run();
+
+    // 100 KiB at 1 MiB/s takes about 100 ms on the wire, plus the one-way latency.
+    const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    BOOST_TEST(duration.count() >= 115);
+}
+
+BOOST_FIXTURE_TEST_CASE(MemoryTransport_StopRejectsPeerReceive, MemoryTransportUnitTest)
+{
+    auto transports = MemoryTransport::createPair(ioService_);
+
+    EXPECT_CALL(receivePromiseHandlerMock_, onReject(error::Error(error::ErrorCode::OPERATION_ABORTED)));
+    EXPECT_CALL(receivePromiseHandlerMock_, onResolve(_)).Times(0);
+
+    transports.second->receive(100, std::move(receivePromise_));
+    ioService_.run();
+    ioService_.reset();
+
+    transports.first->stop();
+    ioService_.run();
+}
+
+}
+}
+}
@@ -0,0 +1,203 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <aasdk/Transport/ReplayTransport.hpp>
+#include <aasdk/Error/Error.hpp>
+
+
+namespace aasdk
+{
+namespace transport
+{
+
+ReplayTransport::ReplayTransport(asio::io_service& ioService, CaptureReader::Pointer captureReader, Pacing pacing)
+    : strand_(ioService)
+    , timer_(ioService)
+    , captureReader_(std::move(captureReader))
+    , pacing_(pacing)
+    , recordIndex_(0)
+    , recordOffset_(0)
+    , isStarted_(false)
+    , isTimerArmed_(false)
+    , isStopped_(false)
+{
+
+}
+
+void ReplayTransport::receive(size_t size, ReceivePromise::Pointer promise)
+{
+    strand_.dispatch([this, self = this->shared_from_this(), size, promise = std::move(promise)]() mutable {
+        if(isStopped_)
+        {
+            promise->reject(error::Error(error::ErrorCode::OPERATION_ABORTED));
+            return;
+        }
+
+        if(!isStarted_)
+        {
+            // The first received chunk of the capture is due right now.
+            const auto& records = captureReader_->getRecords();
+            const auto firstReceived = std::find_if(records.begin(), records.end(), [](const auto& record) { return record.direction == CaptureDirection::RECEIVE; });
+            const auto offset = firstReceived != records.end() ? firstReceived->timestamp : std::chrono::nanoseconds(0);
+
+            startTime_ = Clock::now() - std::chrono::duration_cast<Clock::duration>(offset);
+            isStarted_ = true;
+        }
+
+        receiveQueue_.emplace_back(std::make_pair(size, std::move(promise)));
+
+        if(receiveQueue_.size() == 1)
+        {
+            this->distributeRecords();
+        }
+    });
+}
+
+void ReplayTransport::send(common::Data, SendPromise::Pointer promise)
+{
+    strand_.dispatch([this, self = this->shared_from_this(), promise = std::move(promise)]() {
+        if(isStopped_)
+        {
+            promise->reject(error::Error(error::ErrorCode::OPERATION_ABORTED));
+        }
+        else
+        {
+            promise->resolve();
+        }
+    });
+}
+
+void ReplayTransport::stop()
+{
+    strand_.dispatch([this, self = this->shared_from_this()]() {
+        isStopped_ = true;
+        timer_.cancel();
+        this->rejectReceivePromises(error::Error(error::ErrorCode::OPERATION_ABORTED));
+    });
+}
+
+ReplayTransport::ReceiveTimestamps ReplayTransport::getLastReceiveTimestamps() const
+{
+    std::lock_guard<decltype(receiveTimestampsMutex_)> lock(receiveTimestampsMutex_);
+    return lastReceiveTimestamps_;
+}
+
+void ReplayTransport::distributeRecords()
+{
+    const auto& records = captureReader_->getRecords();
+
+    while(!receiveQueue_.empty() && !isTimerArmed_)
+    {
+        const auto size = receiveQueue_.front().first;
+        std::chrono::nanoseconds timestamp;
+
+        if(!this->findAvailableSize(size, timestamp))
+        {
+            this->rejectReceivePromises(error::Error(error::ErrorCode::OPERATION_ABORTED));
+            return;
+        }
+
+        const auto dueTime = startTime_ + std::chrono::duration_cast<Clock::duration>(timestamp);
+        if(pacing_ == Pacing::ORIGINAL && dueTime > Clock::now())
+        {
+            isTimerArmed_ = true;
+            timer_.expires_at(dueTime);
+            timer_.async_wait(strand_.wrap([this, self = this->shared_from_this()](const asio::error_code& ec) {
+                isTimerArmed_ = false;
+
+                if(!ec)
+                {
+                    this->distributeRecords();
+                }
+            }));
+
+            return;
+        }
+
+        common::Data data;
+        data.reserve(size);
+
+        while(data.size() < size)
+        {
+            const auto& record = records[recordIndex_];
+            if(record.direction != CaptureDirection::RECEIVE)
+            {
+                ++recordIndex_;
+                continue;
+            }
+
+            const auto chunkSize = std::min(size - data.size(), record.data.size - recordOffset_);
+            common::copy(data, common::DataConstBuffer(record.data.cdata + recordOffset_, chunkSize));
+            recordOffset_ += chunkSize;
+
+            if(recordOffset_ == record.data.size)
+            {
+                ++recordIndex_;
+                recordOffset_ = 0;
+            }
+        }
+
+        if(common::TraceClock::isEnabled())
+        {
+            // The replayed chunk is both completed and distributed at the time it is due.
+            const auto now = common::TraceClock::now();
+            std::lock_guard<decltype(receiveTimestampsMutex_)> lock(receiveTimestampsMutex_);
+            lastReceiveTimestamps_ = ReceiveTimestamps{now, now};
+        }
+
+        receiveQueue_.front().second->resolve(std::move(data));
+        receiveQueue_.pop_front();
+    }
+}
+
+bool ReplayTransport::findAvailableSize(size_t size, std::chrono::nanoseconds& timestamp) const
+{
+    const auto& records = captureReader_->getRecords();
+    size_t availableSize = 0;
+
+    for(auto index = recordIndex_; index < records.size(); ++index)
+    {
+        if(records[index].direction != CaptureDirection::RECEIVE)
+        {
+            continue;
+        }
+
+        availableSize += records[index].data.size - (index == recordIndex_ ? recordOffset_ : 0);
+        if(availableSize >= size)
+        {
+            timestamp = records[index].timestamp;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ReplayTransport::rejectReceivePromises(const error::Error& e)
+{
+    for(auto& queueElement : receiveQueue_)
+    {
+        queueElement.second->reject(e);
+    }
+
+    receiveQueue_.clear();
+}
+
+}
+}
@@ -1,8 +1,11 @@
+#include <algorithm>
 #include <string>
+#include <vector>
 #include <openssl/engine.h>
 #include <openssl/err.h>
 #include <openssl/ssl.h>
 #include <openssl/conf.h>
+#include <openssl/hmac.h>
 #include <aasdk/Transport/SSLWrapper.hpp>
 #include <aasdk/Common/Log.hpp>
 
@@ -12,36 +15,50 @@ namespace transport
 {
 
 SSLWrapper::SSLWrapper()
+    : SSLWrapper(cDevCryptoEngine)
+{
+
+}
+
+SSLWrapper::SSLWrapper(const std::string& cryptoBackend)
+    : engine_(nullptr)
+    , cryptoBackend_(cDefaultCryptoBackend)
 {
     SSL_library_init();
     SSL_load_error_strings();
     //ERR_load_BIO_strings();
     OpenSSL_add_all_algorithms();
-  ENGINE *e;
-  const char *engine_id = "DEVCRYPTO";
-  ENGINE_load_builtin_engines();
-  e = ENGINE_by_id(engine_id);
-  if (!e)
-    /* the engine isn't available */
-    return;
-  if (!ENGINE_init(e)) {
-    /* the engine couldn't initialise, release 'e' */
-    ENGINE_free(e);
-    return;
-  }
-  if (!ENGINE_set_default_RSA(e)) {
-    /*
-     * This should only happen when 'e' can't initialise, but the previous
-     * statement suggests it did.
-     */
-    abort();
-  }
-  ENGINE_set_default_DSA(e);
-  ENGINE_set_default_ciphers(e);
+    ENGINE_load_builtin_engines();
+
+    if(cryptoBackend == cAutoCryptoBackend)
+    {
+        const auto engineId = selectFastestEngine(measureEngines());
+
+        if(engineId != cDefaultCryptoBackend)
+        {
+            this->useEngine(engineId);
+        }
+    }
+    else if(cryptoBackend != cDefaultCryptoBackend)
+    {
+        this->useEngine(cryptoBackend);
+    }
+
+    AASDK_LOG(info) << "[SSLWrapper] Crypto backend: " << cryptoBackend_;
 }
 
 SSLWrapper::~SSLWrapper()
 {
+    if(engine_ != nullptr)
+    {
+        // Defaults are process wide, later wrappers must not keep running on this engine.
+        ENGINE_unregister_RSA(engine_);
+        ENGINE_unregister_DSA(engine_);
+        ENGINE_unregister_ciphers(engine_);
+        ENGINE_finish(engine_);
+        ENGINE_free(engine_);
+    }
+
     //FIPS_mode_set(0);
     ENGINE_cleanup();
     //CONF_modules_unload(1);
@@ -55,6 +72,177 @@ SSLWrapper::~SSLWrapper()
     ERR_load_ERR_strings();
 }
 
+const std::string& SSLWrapper::getCryptoBackend() const
+{
+    return cryptoBackend_;
+}
+
+std::vector<std::string> SSLWrapper::getAvailableCryptoBackends()
+{
+    std::vector<std::string> cryptoBackends{cDefaultCryptoBackend};
+
+    ENGINE_load_builtin_engines();
+
+    for(auto engine = ENGINE_get_first(); engine != nullptr; engine = ENGINE_get_next(engine))
+    {
+        if(!ENGINE_init(engine))
+        {
+            ERR_clear_error();
+            continue;
+        }
+
+        cryptoBackends.emplace_back(ENGINE_get_id(engine));
+        ENGINE_finish(engine);
+    }
+
+    return cryptoBackends;
+}
+
+bool SSLWrapper::useEngine(const std::string& engineId)
+{
+    auto engine = ENGINE_by_id(engineId.c_str());
+
+    if(engine == nullptr)
+    {
+        AASDK_LOG(info) << "[SSLWrapper] Engine " << engineId << " is not available.";
+        ERR_clear_error();
+        return false;
+    }
+
+    if(!ENGINE_init(engine))
+    {
+        AASDK_LOG(error) << "[SSLWrapper] Engine " << engineId << " could not be initialized.";
+        ENGINE_free(engine);
+        ERR_clear_error();
+        return false;
+    }
+
+    if(!ENGINE_set_default_RSA(engine))
+    {
+        AASDK_LOG(error) << "[SSLWrapper] Engine " << engineId << " could not be set as default.";
+        ENGINE_unregister_RSA(engine);
+        ENGINE_finish(engine);
+        ENGINE_free(engine);
+        ERR_clear_error();
+        return false;
+    }
+
+    ENGINE_set_default_DSA(engine);
+    ENGINE_set_default_ciphers(engine);
+
+    engine_ = engine;
+    cryptoBackend_ = engineId;
+    return true;
+}
+
+std::vector<SSLWrapper::EngineTiming> SSLWrapper::measureEngines()
+{
+    // Record ciphers negotiated by phones; an engine only wins on ciphers it actually implements.
+    const std::pair<int, const EVP_CIPHER*> ciphers[] = {
+        {NID_aes_128_gcm, EVP_aes_128_gcm()},
+        {NID_aes_128_cbc, EVP_aes_128_cbc()}
+    };
+
+    std::vector<EngineTiming> timings;
+
+    for(auto engine = ENGINE_get_first(); engine != nullptr; engine = ENGINE_get_next(engine))
+    {
+        if(!ENGINE_init(engine))
+        {
+            ERR_clear_error();
+            continue;
+        }
+
+        EngineTiming timing{ENGINE_get_id(engine), std::chrono::nanoseconds(0), std::chrono::nanoseconds(0)};
+
+        for(const auto& cipher : ciphers)
+        {
+            if(ENGINE_get_cipher(engine, cipher.first) != nullptr)
+            {
+                timing.engineDuration += measureCipher(engine, cipher.second);
+                timing.defaultDuration += measureCipher(nullptr, cipher.second);
+            }
+        }
+
+        ENGINE_finish(engine);
+        ERR_clear_error();
+        timings.push_back(std::move(timing));
+    }
+
+    return timings;
+}
+
+std::string SSLWrapper::selectFastestEngine(const std::vector<EngineTiming>& timings)
+{
+    std::string fastestEngineId = cDefaultCryptoBackend;
+    double fastestRatio = 1.0;
+
+    for(const auto& timing : timings)
+    {
+        if(timing.engineDuration.count() == 0 || timing.defaultDuration.count() == 0)
+        {
+            continue;
+        }
+
+        const double ratio = static_cast<double>(timing.engineDuration.count()) / timing.defaultDuration.count();
+        AASDK_LOG(info) << "[SSLWrapper] Engine " << timing.engineId << " runs at " << ratio << "x the default record cipher time.";
+
+        if(ratio < fastestRatio)
+        {
+            fastestRatio = ratio;
+            fastestEngineId = timing.engineId;
+        }
+    }
+
+    return fastestEngineId;
+}
+
+std::chrono::nanoseconds SSLWrapper::measureCipher(ENGINE* engine, const EVP_CIPHER* cipher)
+{
+    const size_t recordSizes[] = {64, 1024, 0x4000};
+    const size_t iterations = 32;
+
+    std::vector<unsigned char> key(EVP_CIPHER_key_length(cipher), 0x5A);
+    std::vector<unsigned char> iv(EVP_CIPHER_iv_length(cipher), 0xA5);
+    std::vector<unsigned char> input(0x4000, 0x3C);
+    std::vector<unsigned char> output(0x4000 + EVP_MAX_BLOCK_LENGTH * 2);
+
+    auto context = EVP_CIPHER_CTX_new();
+    if(context == nullptr)
+    {
+        return std::chrono::nanoseconds(0);
+    }
+
+    std::chrono::nanoseconds duration(0);
+
+    for(int encrypt = 1; encrypt >= 0; --encrypt)
+    {
+        if(EVP_CipherInit_ex(context, cipher, engine, key.data(), iv.data(), encrypt) != 1)
+        {
+            EVP_CIPHER_CTX_free(context);
+            return std::chrono::nanoseconds(0);
+        }
+
+        EVP_CIPHER_CTX_set_padding(context, 0);
+        const auto begin = std::chrono::steady_clock::now();
+
+        for(size_t i = 0; i < iterations; ++i)
+        {
+            for(const auto recordSize : recordSizes)
+            {
+                int outputSize = 0;
+                EVP_CipherInit_ex(context, nullptr, nullptr, nullptr, iv.data(), encrypt);
+                EVP_CipherUpdate(context, output.data(), &outputSize, input.data(), static_cast<int>(recordSize));
+            }
+        }
+
+        duration += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin);
+    }
+
+    EVP_CIPHER_CTX_free(context);
+    return duration;
+}
+
 X509* SSLWrapper::readCertificate(const std::string& certificate)
 {
     auto bio = BIO_new_mem_buf(certificate.c_str(), certificate.size());
@@ -82,6 +270,15 @@ const SSL_METHOD* SSLWrapper::getMethod()
 #endif
 }
 
+const SSL_METHOD* SSLWrapper::getServerMethod()
+{
+#if (OPENSSL_VERSION_NUMBER < 0x10100000L)
+    return TLSv1_2_server_method();
+#else
+    return TLS_server_method();
+#endif
+}
+
 SSL_CTX* SSLWrapper::createContext(const SSL_METHOD* method)
 {
     return SSL_CTX_new(method);
@@ -127,6 +324,15 @@ void SSLWrapper::setConnectState(SSL* ssl)
     SSL_set_verify(ssl, SSL_VERIFY_NONE, nullptr);
 }
 
+void SSLWrapper::setAcceptState(SSL* ssl)
+{
+#if (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+    // Phones negotiate TLS 1.2, and Cryptor::decrypt sizes its reads for TLS 1.2 GCM records.
+    SSL_set_max_proto_version(ssl, TLS1_2_VERSION);
+#endif
+    SSL_set_accept_state(ssl);
+}
+
 int SSLWrapper::doHandshake(SSL* ssl)
 {
     auto result = SSL_do_handshake(ssl);
@@ -160,6 +366,141 @@ void SSLWrapper::free(EVP_PKEY* privateKey)
     EVP_PKEY_free(privateKey);
 }
 
+void SSLWrapper::free(SSL_SESSION* session)
+{
+    SSL_SESSION_free(session);
+}
+
+SSL_SESSION* SSLWrapper::getSession(SSL* ssl)
+{
+    return SSL_get1_session(ssl);
+}
+
+bool SSLWrapper::setSession(SSL* ssl, SSL_SESSION* session)
+{
+    return SSL_set_session(ssl, session) == 1;
+}
+
+bool SSLWrapper::isSessionReused(SSL* ssl)
+{
+    return SSL_session_reused(ssl) == 1;
+}
+
+bool SSLWrapper::isSessionResumable(const SSL_SESSION* session)
+{
+#if (OPENSSL_VERSION_NUMBER < 0x10101000L)
+    return session != nullptr;
+#else
+    return session != nullptr && SSL_SESSION_is_resumable(session) == 1;
+#endif
+}
+
+bool SSLWrapper::exportPeerRecordKeys(SSL* ssl, RecordKeys& keys)
+{
+#if (OPENSSL_VERSION_NUMBER < 0x10101000L)
+    return false;
+#else
+    // Only TLS 1.2 AEAD suites carry an explicit per-record nonce, which lets records be opened outside the SSL object.
+    if(SSL_version(ssl) != TLS1_2_VERSION)
+    {
+        return false;
+    }
+
+    const auto sslCipher = SSL_get_current_cipher(ssl);
+    if(sslCipher == nullptr)
+    {
+        return false;
+    }
+
+    const EVP_CIPHER* cipher = nullptr;
+    switch(SSL_CIPHER_get_cipher_nid(sslCipher))
+    {
+    case NID_aes_128_gcm:
+        cipher = EVP_aes_128_gcm();
+        break;
+    case NID_aes_256_gcm:
+        cipher = EVP_aes_256_gcm();
+        break;
+    default:
+        return false;
+    }
+
+    const auto digest = SSL_CIPHER_get_handshake_digest(sslCipher);
+    const auto session = SSL_get_session(ssl);
+    if(digest == nullptr || session == nullptr)
+    {
+        return false;
+    }
+
+    std::vector<uint8_t> masterKey(SSL_MAX_MASTER_KEY_LENGTH);
+    masterKey.resize(SSL_SESSION_get_master_key(session, masterKey.data(), masterKey.size()));
+
+    std::vector<uint8_t> seed(SSL3_RANDOM_SIZE * 2);
+    SSL_get_server_random(ssl, seed.data(), SSL3_RANDOM_SIZE);
+    SSL_get_client_random(ssl, seed.data() + SSL3_RANDOM_SIZE, SSL3_RANDOM_SIZE);
+
+    const size_t keyLength = EVP_CIPHER_key_length(cipher);
+    const size_t implicitIvLength = 4;
+    std::vector<uint8_t> keyBlock(keyLength * 2 + implicitIvLength * 2);
+
+    const auto result = derivePRF(digest, masterKey, "key expansion", seed, keyBlock);
+    OPENSSL_cleanse(masterKey.data(), masterKey.size());
+
+    if(!result)
+    {
+        return false;
+    }
+
+    // Key block layout: client key, server key, client IV, server IV.
+    const size_t peerIndex = SSL_is_server(ssl) == 1 ? 0 : 1;
+    const auto keyBegin = keyBlock.begin() + peerIndex * keyLength;
+    const auto implicitIvBegin = keyBlock.begin() + keyLength * 2 + peerIndex * implicitIvLength;
+
+    keys.cipher = cipher;
+    keys.key.assign(keyBegin, keyBegin + keyLength);
+    keys.implicitIv.assign(implicitIvBegin, implicitIvBegin + implicitIvLength);
+    OPENSSL_cleanse(keyBlock.data(), keyBlock.size());
+
+    return true;
+#endif
+}
+
+bool SSLWrapper::derivePRF(const EVP_MD* digest, const std::vector<uint8_t>& secret, const std::string& label, const std::vector<uint8_t>& seed, std::vector<uint8_t>& output)
+{
+    std::vector<uint8_t> labelSeed(label.begin(), label.end());
+    labelSeed.insert(labelSeed.end(), seed.begin(), seed.end());
+
+    // RFC 5246 P_hash: A(0) = label + seed, A(i) = HMAC(secret, A(i-1)).
+    std::vector<uint8_t> a(labelSeed);
+    std::vector<uint8_t> block(EVP_MAX_MD_SIZE);
+    size_t offset = 0;
+
+    while(offset < output.size())
+    {
+        unsigned int size = 0;
+        if(HMAC(digest, secret.data(), static_cast<int>(secret.size()), a.data(), a.size(), block.data(), &size) == nullptr)
+        {
+            return false;
+        }
+        a.assign(block.begin(), block.begin() + size);
+
+        std::vector<uint8_t> input(a);
+        input.insert(input.end(), labelSeed.begin(), labelSeed.end());
+
+        if(HMAC(digest, secret.data(), static_cast<int>(secret.size()), input.data(), input.size(), block.data(), &size) == nullptr)
+        {
+            return false;
+        }
+
+        const size_t copySize = std::min<size_t>(size, output.size() - offset);
+        std::copy(block.begin(), block.begin() + copySize, output.begin() + offset);
+        offset += copySize;
+    }
+
+    OPENSSL_cleanse(block.data(), block.size());
+    return true;
+}
+
 size_t SSLWrapper::bioCtrlPending(BIO* b)
 {
     return BIO_ctrl_pending(b);
@@ -198,5 +539,9 @@ int SSLWrapper::getError(SSL* ssl, int returnCode)
     return SSL_get_error(ssl, returnCode);
 }
 
+const std::string SSLWrapper::cDefaultCryptoBackend = "default";
+const std::string SSLWrapper::cAutoCryptoBackend = "auto";
+const std::string SSLWrapper::cDevCryptoEngine = "DEVCRYPTO";
+
 }
 }
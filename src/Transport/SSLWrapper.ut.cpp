@@ -0,0 +1,71 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <boost/test/unit_test.hpp>
+#include <aasdk/Transport/SSLWrapper.hpp>
+
+
+namespace aasdk
+{
+namespace transport
+{
+namespace ut
+{
+
+BOOST_AUTO_TEST_CASE(SSLWrapper_SelectFastestEngine)
+{
+    const std::vector<SSLWrapper::EngineTiming> timings{
+        {"slow", std::chrono::microseconds(300), std::chrono::microseconds(200)},
+        {"fast", std::chrono::microseconds(50), std::chrono::microseconds(200)},
+        {"faster-on-paper", std::chrono::microseconds(10), std::chrono::microseconds(100)},
+        {"no-ciphers", std::chrono::nanoseconds(0), std::chrono::nanoseconds(0)}
+    };
+
+    BOOST_CHECK_EQUAL(SSLWrapper::selectFastestEngine(timings), "faster-on-paper");
+}
+
+BOOST_AUTO_TEST_CASE(SSLWrapper_KeepDefaultWhenNoEngineIsFaster)
+{
+    BOOST_CHECK_EQUAL(SSLWrapper::selectFastestEngine({}), SSLWrapper::cDefaultCryptoBackend);
+
+    const std::vector<SSLWrapper::EngineTiming> timings{
+        {"equal", std::chrono::microseconds(200), std::chrono::microseconds(200)},
+        {"slow", std::chrono::microseconds(900), std::chrono::microseconds(200)},
+        {"no-ciphers", std::chrono::nanoseconds(0), std::chrono::microseconds(200)}
+    };
+
+    BOOST_CHECK_EQUAL(SSLWrapper::selectFastestEngine(timings), SSLWrapper::cDefaultCryptoBackend);
+}
+
+BOOST_AUTO_TEST_CASE(SSLWrapper_FallBackToDefaultForUnavailableEngine)
+{
+    SSLWrapper sslWrapper("aasdk-missing-engine");
+    BOOST_CHECK_EQUAL(sslWrapper.getCryptoBackend(), SSLWrapper::cDefaultCryptoBackend);
+}
+
+BOOST_AUTO_TEST_CASE(SSLWrapper_AutoSelectAvailableBackend)
+{
+    SSLWrapper sslWrapper(SSLWrapper::cAutoCryptoBackend);
+
+    const auto cryptoBackends = SSLWrapper::getAvailableCryptoBackends();
+    BOOST_CHECK(std::find(cryptoBackends.begin(), cryptoBackends.end(), sslWrapper.getCryptoBackend()) != cryptoBackends.end());
+}
+
+}
+}
+}
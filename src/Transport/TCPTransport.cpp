@@ -34,7 +34,12 @@ TCPTransport::TCPTransport(asio::io_service& ioService, tcp::ITCPEndpoint::Point
 void TCPTransport::enqueueReceive(common::DataBuffer buffer)
 {
     auto receivePromise = tcp::ITCPEndpoint::Promise::defer(receiveStrand_);
-    receivePromise->then([this, self = this->shared_from_this()](auto bytesTransferred) {
+    receivePromise->then([this, self = this->shared_from_this(), submitTime = std::chrono::steady_clock::now()](auto bytesTransferred) {
+            if(metrics_ != nullptr)
+            {
+                metrics_->getReceiveTransferLatency().observe(std::chrono::steady_clock::now() - submitTime);
+            }
+
             this->receiveHandler(bytesTransferred);
         },
         [this, self = this->shared_from_this()](auto e) {
@@ -48,7 +53,12 @@ void TCPTransport::enqueueSend(SendQueue::iterator queueElement)
 {
     auto sendPromise = tcp::ITCPEndpoint::Promise::defer(sendStrand_);
 
-    sendPromise->then([this, self = this->shared_from_this(), queueElement](auto) {
+    sendPromise->then([this, self = this->shared_from_this(), queueElement, submitTime = std::chrono::steady_clock::now()](auto) {
+        if(metrics_ != nullptr)
+        {
+            metrics_->getSendTransferLatency().observe(std::chrono::steady_clock::now() - submitTime);
+        }
+
         this->sendHandler(queueElement, error::Error());
     },
     [this, self = this->shared_from_this(), queueElement](auto e) {
@@ -71,6 +81,11 @@ void TCPTransport::sendHandler(SendQueue::iterator queueElement, const error::Er
     }
     else
     {
+        if(metrics_ != nullptr)
+        {
+            metrics_->getTransportSendRejections().increment();
+        }
+
         queueElement->second->reject(e);
     }
 
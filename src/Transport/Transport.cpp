@@ -36,29 +36,35 @@ void Transport::receive(size_t size, ReceivePromise::Pointer promise)
 
         if(receiveQueue_.size() == 1)
         {
-            try
-            {
-                this->distributeReceivedData();
-            }
-            catch(const error::Error& e)
-            {
-                this->rejectReceivePromises(e);
-            }
+            this->distributeReceivedData();
         }
     });
 }
 
 void Transport::receiveHandler(size_t bytesTransferred)
 {
-    try
+    this->receiveHandler(bytesTransferred, common::TraceClock::now());
+}
+
+void Transport::receiveHandler(size_t bytesTransferred, common::TraceClock::time_point transferCompletionTime)
+{
+    lastTransferCompletionTime_ = transferCompletionTime;
+
+    if(metrics_ != nullptr)
     {
-        receivedDataSink_.commit(bytesTransferred);
-        this->distributeReceivedData();
+        metrics_->getTransportBytesReceived().increment(bytesTransferred);
     }
-    catch(const error::Error& e)
+
+    error::Error e;
+    receivedDataSink_.commit(bytesTransferred, e);
+
+    if(e != error::ErrorCode::NONE)
     {
         this->rejectReceivePromises(e);
+        return;
     }
+
+    this->distributeReceivedData();
 }
 
 void Transport::distributeReceivedData()
@@ -74,7 +80,21 @@ void Transport::distributeReceivedData()
         }
         else
         {
-            auto data(receivedDataSink_.consume(queueElement->first));
+            error::Error e;
+            auto data(receivedDataSink_.consume(queueElement->first, e));
+
+            if(e != error::ErrorCode::NONE)
+            {
+                this->rejectReceivePromises(e);
+                return;
+            }
+
+            if(common::TraceClock::isEnabled())
+            {
+                std::lock_guard<decltype(receiveTimestampsMutex_)> lock(receiveTimestampsMutex_);
+                lastReceiveTimestamps_ = ReceiveTimestamps{lastTransferCompletionTime_, common::TraceClock::now()};
+            }
+
             queueElement->second->resolve(std::move(data));
             queueElement = receiveQueue_.erase(queueElement);
         }
@@ -83,6 +103,11 @@ void Transport::distributeReceivedData()
 
 void Transport::rejectReceivePromises(const error::Error& e)
 {
+    if(metrics_ != nullptr)
+    {
+        metrics_->getTransportReceiveRejections().increment(receiveQueue_.size());
+    }
+
     for(auto& queueElement : receiveQueue_)
     {
         queueElement.second->reject(e);
@@ -91,9 +116,25 @@ void Transport::rejectReceivePromises(const error::Error& e)
     receiveQueue_.clear();
 }
 
+void Transport::setMetrics(metrics::SessionMetrics::Pointer metrics)
+{
+    metrics_ = std::move(metrics);
+}
+
+Transport::ReceiveTimestamps Transport::getLastReceiveTimestamps() const
+{
+    std::lock_guard<decltype(receiveTimestampsMutex_)> lock(receiveTimestampsMutex_);
+    return lastReceiveTimestamps_;
+}
+
 void Transport::send(common::Data data, SendPromise::Pointer promise)
 {
     sendStrand_.dispatch([this, self = this->shared_from_this(), data = std::move(data), promise = std::move(promise)]() mutable {
+        if(metrics_ != nullptr)
+        {
+            metrics_->getTransportBytesSent().increment(data.size());
+        }
+
         sendQueue_.emplace_back(std::make_pair(std::move(data), std::move(promise)));
 
         if(sendQueue_.size() == 1)
@@ -32,8 +32,14 @@ USBTransport::USBTransport(asio::io_service& ioService, usb::IAOAPDevice::Pointe
 void USBTransport::enqueueReceive(common::DataBuffer buffer)
 {
     auto usbEndpointPromise = usb::IUSBEndpoint::Promise::defer(receiveStrand_);
-    usbEndpointPromise->then([this, self = this->shared_from_this()](auto bytesTransferred) {
-            this->receiveHandler(bytesTransferred);
+    usbEndpointPromise->then([this, self = this->shared_from_this(), submitTime = std::chrono::steady_clock::now()](auto bytesTransferred) {
+            if(metrics_ != nullptr)
+            {
+                metrics_->getReceiveTransferLatency().observe(std::chrono::steady_clock::now() - submitTime);
+            }
+
+            const auto transferCompletionTime = common::TraceClock::isEnabled() ? aoapDevice_->getInEndpoint().getLastTransferCompletionTime() : common::TraceClock::time_point();
+            this->receiveHandler(bytesTransferred, transferCompletionTime);
         },
         [this, self = this->shared_from_this()](auto e) {
             this->rejectReceivePromises(e);
@@ -50,10 +56,20 @@ void USBTransport::enqueueSend(SendQueue::iterator queueElement)
 void USBTransport::doSend(SendQueue::iterator queueElement, common::Data::size_type offset)
 {
     auto usbEndpointPromise = usb::IUSBEndpoint::Promise::defer(sendStrand_);
-    usbEndpointPromise->then([this, self = this->shared_from_this(), queueElement, offset](size_t bytesTransferred) mutable {
+    usbEndpointPromise->then([this, self = this->shared_from_this(), queueElement, offset, submitTime = std::chrono::steady_clock::now()](size_t bytesTransferred) mutable {
+            if(metrics_ != nullptr)
+            {
+                metrics_->getSendTransferLatency().observe(std::chrono::steady_clock::now() - submitTime);
+            }
+
             this->sendHandler(queueElement, offset, bytesTransferred);
         },
         [this, self = this->shared_from_this(), queueElement](const error::Error& e) mutable {
+            if(metrics_ != nullptr)
+            {
+                metrics_->getTransportSendRejections().increment();
+            }
+
             queueElement->second->reject(e);
             sendQueue_.erase(queueElement);
 
@@ -61,7 +61,7 @@ IUSBEndpoint& AOAPDevice::getOutEndpoint()
     return *outEndpoint_;
 }
 
-IAOAPDevice::Pointer AOAPDevice::create(IUSBWrapper& usbWrapper, asio::io_service& ioService, DeviceHandle handle)
+IAOAPDevice::Pointer AOAPDevice::create(IUSBWrapper& usbWrapper, asio::io_service& ioService, DeviceHandle handle, metrics::StartupTimeline::Pointer startupTimeline)
 {
     auto configDescriptorHandle = AOAPDevice::getConfigDescriptor(usbWrapper, handle);
     auto interface = AOAPDevice::getInterface(configDescriptorHandle);
@@ -79,7 +79,14 @@ IAOAPDevice::Pointer AOAPDevice::create(IUSBWrapper& usbWrapper, asio::io_servic
         throw error::Error(error::ErrorCode::USB_CLAIM_INTERFACE, result);
     }
 
-    return std::make_unique<AOAPDevice>(usbWrapper, ioService, std::move(handle), interfaceDescriptor);
+    auto device = std::make_unique<AOAPDevice>(usbWrapper, ioService, std::move(handle), interfaceDescriptor);
+
+    if(startupTimeline != nullptr)
+    {
+        startupTimeline->mark(metrics::StartupPhase::AOAP_DEVICE_CREATED);
+    }
+
+    return device;
 }
 
 ConfigDescriptorHandle AOAPDevice::getConfigDescriptor(IUSBWrapper& usbWrapper, DeviceHandle handle)
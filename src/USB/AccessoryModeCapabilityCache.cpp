@@ -0,0 +1,51 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <aasdk/USB/AccessoryModeCapabilityCache.hpp>
+
+
+namespace aasdk
+{
+namespace usb
+{
+
+AccessoryModeCapabilityCache::Key AccessoryModeCapabilityCache::getKey(const libusb_device_descriptor& deviceDescriptor)
+{
+    return (static_cast<Key>(deviceDescriptor.idVendor) << 32) | (static_cast<Key>(deviceDescriptor.idProduct) << 16) | deviceDescriptor.bcdDevice;
+}
+
+bool AccessoryModeCapabilityCache::contains(Key key) const
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    return keys_.count(key) != 0;
+}
+
+void AccessoryModeCapabilityCache::insert(Key key)
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    keys_.insert(key);
+}
+
+void AccessoryModeCapabilityCache::erase(Key key)
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    keys_.erase(key);
+}
+
+}
+}
@@ -16,6 +16,7 @@
 *  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <iterator>
 #include <aasdk/USB/AccessoryModeQueryChain.hpp>
 #include <aasdk/Error/Error.hpp>
 #include <aasdk/USB/USBEndpoint.hpp>
@@ -26,12 +27,30 @@ namespace aasdk
 namespace usb
 {
 
+namespace
+{
+
+constexpr AccessoryModeQueryType cSendStringQueryTypes[] = {
+    AccessoryModeQueryType::SEND_MANUFACTURER,
+    AccessoryModeQueryType::SEND_MODEL,
+    AccessoryModeQueryType::SEND_DESCRIPTION,
+    AccessoryModeQueryType::SEND_VERSION,
+    AccessoryModeQueryType::SEND_URI,
+    AccessoryModeQueryType::SEND_SERIAL
+};
+
+}
+
 AccessoryModeQueryChain::AccessoryModeQueryChain(IUSBWrapper& usbWrapper,
                                                  asio::io_service& ioService,
-                                                 IAccessoryModeQueryFactory& queryFactory)
+                                                 IAccessoryModeQueryFactory& queryFactory,
+                                                 AccessoryModeCapabilityCache::Pointer capabilityCache)
     : usbWrapper_(usbWrapper)
     , strand_(ioService)
     , queryFactory_(queryFactory)
+    , pendingStringQueries_(0)
+    , capabilityCache_(std::move(capabilityCache))
+    , capabilityKey_(0)
 {
 
 }
@@ -47,24 +66,32 @@ void AccessoryModeQueryChain::start(DeviceHandle handle, Promise::Pointer promis
         {
             promise_ = std::move(promise);
 
+            auto usbEndpoint = std::make_shared<USBEndpoint>(usbWrapper_, strand_.context(), handle);
+
+            if(capabilityCache_ != nullptr)
+            {
+                libusb_device_descriptor deviceDescriptor = {};
+                if(usbWrapper_.getDeviceDescriptor(usbWrapper_.getDevice(handle), deviceDescriptor) == 0)
+                {
+                    capabilityKey_ = AccessoryModeCapabilityCache::getKey(deviceDescriptor);
+
+                    if(capabilityCache_->contains(capabilityKey_))
+                    {
+                        this->sendStrings(std::move(usbEndpoint));
+                        return;
+                    }
+                }
+            }
+
             auto queryPromise = IAccessoryModeQuery::Promise::defer(strand_);
             queryPromise->then([this, self = this->shared_from_this()](IUSBEndpoint::Pointer usbEndpoint) mutable {
                     this->protocolVersionQueryHandler(std::move(usbEndpoint));
                 },
                 [this, self = this->shared_from_this()](const error::Error& e) mutable {
-                    promise_->reject(e);
-                    promise_.reset();
+                    this->queryErrorHandler(e);
                 });
 
-#if BOOST_VERSION < 106600
-            this->startQuery(AccessoryModeQueryType::PROTOCOL_VERSION,
-                             std::make_shared<USBEndpoint>(usbWrapper_, strand_.context(), std::move(handle)),
-                             std::move(queryPromise));
-#else
-            this->startQuery(AccessoryModeQueryType::PROTOCOL_VERSION,
-                             std::make_shared<USBEndpoint>(usbWrapper_, strand_.context(), std::move(handle)),
-                             std::move(queryPromise));
-#endif
+            this->startQuery(AccessoryModeQueryType::PROTOCOL_VERSION, std::move(usbEndpoint), std::move(queryPromise));
         }
     });
 }
@@ -72,136 +99,121 @@ void AccessoryModeQueryChain::start(DeviceHandle handle, Promise::Pointer promis
 void AccessoryModeQueryChain::cancel()
 {
     strand_.dispatch([this, self = this->shared_from_this()]() {
-        if(activeQuery_ != nullptr)
+        for(const auto& query : activeQueries_)
         {
-            activeQuery_->cancel();
-            activeQuery_.reset();
+            query->cancel();
         }
+
+        activeQueries_.clear();
     });
 }
 
-void AccessoryModeQueryChain::startQuery(AccessoryModeQueryType queryType, IUSBEndpoint::Pointer usbEndpoint, IAccessoryModeQuery::Promise::Pointer queryPromise)
+void AccessoryModeQueryChain::setStartupTimeline(metrics::StartupTimeline::Pointer startupTimeline)
 {
-    activeQuery_ = queryFactory_.createQuery(queryType, std::move(usbEndpoint));
-    activeQuery_->start(std::move(queryPromise));
+    strand_.dispatch([this, self = this->shared_from_this(), startupTimeline = std::move(startupTimeline)]() mutable {
+        startupTimeline_ = std::move(startupTimeline);
+    });
 }
 
-void AccessoryModeQueryChain::protocolVersionQueryHandler(IUSBEndpoint::Pointer usbEndpoint)
+void AccessoryModeQueryChain::startQuery(AccessoryModeQueryType queryType, IUSBEndpoint::Pointer usbEndpoint, IAccessoryModeQuery::Promise::Pointer queryPromise)
 {
-    auto queryPromise = IAccessoryModeQuery::Promise::defer(strand_);
-    queryPromise->then([this, self = this->shared_from_this()](IUSBEndpoint::Pointer usbEndpoint) mutable {
-            this->manufacturerQueryHandler(std::move(usbEndpoint));
-        },
-        [this, self = this->shared_from_this()](const error::Error& e) mutable {
-            promise_->reject(e);
-            promise_.reset();
-        });
+    if(startupTimeline_ != nullptr)
+    {
+        startupTimeline_->mark(metrics::StartupPhase::ACCESSORY_MODE_QUERY, accessoryModeQueryTypeToString(queryType));
+    }
 
-    this->startQuery(AccessoryModeQueryType::SEND_MANUFACTURER,
-                     std::move(usbEndpoint),
-                     std::move(queryPromise));
+    activeQueries_.push_back(queryFactory_.createQuery(queryType, std::move(usbEndpoint)));
+    activeQueries_.back()->start(std::move(queryPromise));
 }
 
-void AccessoryModeQueryChain::manufacturerQueryHandler(IUSBEndpoint::Pointer usbEndpoint)
+void AccessoryModeQueryChain::protocolVersionQueryHandler(IUSBEndpoint::Pointer usbEndpoint)
 {
-    auto queryPromise = IAccessoryModeQuery::Promise::defer(strand_);
-    queryPromise->then([this, self = this->shared_from_this()](IUSBEndpoint::Pointer usbEndpoint) mutable {
-            this->modelQueryHandler(std::move(usbEndpoint));
-        },
-        [this, self = this->shared_from_this()](const error::Error& e) mutable {
-            promise_->reject(e);
-            promise_.reset();
-        });
+    if(capabilityCache_ != nullptr)
+    {
+        capabilityCache_->insert(capabilityKey_);
+    }
 
-    this->startQuery(AccessoryModeQueryType::SEND_MODEL,
-                     std::move(usbEndpoint),
-                     std::move(queryPromise));
+    this->sendStrings(std::move(usbEndpoint));
 }
 
-void AccessoryModeQueryChain::modelQueryHandler(IUSBEndpoint::Pointer usbEndpoint)
+void AccessoryModeQueryChain::sendStrings(IUSBEndpoint::Pointer usbEndpoint)
 {
-    auto queryPromise = IAccessoryModeQuery::Promise::defer(strand_);
-    queryPromise->then([this, self = this->shared_from_this()](IUSBEndpoint::Pointer usbEndpoint) mutable {
-            this->descriptionQueryHandler(std::move(usbEndpoint));
-        },
-        [this, self = this->shared_from_this()](const error::Error& e) mutable {
-            promise_->reject(e);
-            promise_.reset();
-        });
-
-    this->startQuery(AccessoryModeQueryType::SEND_DESCRIPTION,
-                     std::move(usbEndpoint),
-                     std::move(queryPromise));
+    activeQueries_.clear();
+
+    // The string queries do not depend on each other, so all control transfers are submitted
+    // back to back instead of waiting a round trip for each.
+    pendingStringQueries_ = std::size(cSendStringQueryTypes);
+
+    for(const auto queryType : cSendStringQueryTypes)
+    {
+        auto queryPromise = IAccessoryModeQuery::Promise::defer(strand_);
+        queryPromise->then([this, self = this->shared_from_this()](IUSBEndpoint::Pointer usbEndpoint) mutable {
+                this->sendStringQueryHandler(std::move(usbEndpoint));
+            },
+            [this, self = this->shared_from_this()](const error::Error& e) mutable {
+                this->queryErrorHandler(e);
+            });
+
+        this->startQuery(queryType, usbEndpoint, std::move(queryPromise));
+    }
 }
 
-void AccessoryModeQueryChain::descriptionQueryHandler(IUSBEndpoint::Pointer usbEndpoint)
+void AccessoryModeQueryChain::sendStringQueryHandler(IUSBEndpoint::Pointer usbEndpoint)
 {
-    auto queryPromise = IAccessoryModeQuery::Promise::defer(strand_);
-    queryPromise->then([this, self = this->shared_from_this()](IUSBEndpoint::Pointer usbEndpoint) mutable {
-            this->versionQueryHandler(std::move(usbEndpoint));
-        },
-        [this, self = this->shared_from_this()](const error::Error& e) mutable {
-            promise_->reject(e);
-            promise_.reset();
-        });
+    if(promise_ == nullptr || --pendingStringQueries_ > 0)
+    {
+        return;
+    }
 
-    this->startQuery(AccessoryModeQueryType::SEND_VERSION,
-                     std::move(usbEndpoint),
-                     std::move(queryPromise));
-}
+    activeQueries_.clear();
 
-void AccessoryModeQueryChain::versionQueryHandler(IUSBEndpoint::Pointer usbEndpoint)
-{
     auto queryPromise = IAccessoryModeQuery::Promise::defer(strand_);
     queryPromise->then([this, self = this->shared_from_this()](IUSBEndpoint::Pointer usbEndpoint) mutable {
-            this->uriQueryHandler(std::move(usbEndpoint));
+            this->startQueryHandler(std::move(usbEndpoint));
         },
         [this, self = this->shared_from_this()](const error::Error& e) mutable {
-            promise_->reject(e);
-            promise_.reset();
+            this->queryErrorHandler(e);
         });
 
-    this->startQuery(AccessoryModeQueryType::SEND_URI,
-                     std::move(usbEndpoint),
-                     std::move(queryPromise));
+    this->startQuery(AccessoryModeQueryType::START, std::move(usbEndpoint), std::move(queryPromise));
 }
 
-void AccessoryModeQueryChain::uriQueryHandler(IUSBEndpoint::Pointer usbEndpoint)
+void AccessoryModeQueryChain::startQueryHandler(IUSBEndpoint::Pointer usbEndpoint)
 {
-    auto queryPromise = IAccessoryModeQuery::Promise::defer(strand_);
-    queryPromise->then([this, self = this->shared_from_this()](IUSBEndpoint::Pointer usbEndpoint) mutable {
-            this->serialQueryHandler(std::move(usbEndpoint));
-        },
-        [this, self = this->shared_from_this()](const error::Error& e) mutable {
-            promise_->reject(e);
-            promise_.reset();
-        });
-
-    this->startQuery(AccessoryModeQueryType::SEND_SERIAL,
-                     std::move(usbEndpoint),
-                     std::move(queryPromise));
-}
+    activeQueries_.clear();
 
-void AccessoryModeQueryChain::serialQueryHandler(IUSBEndpoint::Pointer usbEndpoint)
-{
-    auto queryPromise = IAccessoryModeQuery::Promise::defer(strand_);
-    queryPromise->then([this, self = this->shared_from_this()](IUSBEndpoint::Pointer usbEndpoint) mutable {
-            this->startQueryHandler(std::move(usbEndpoint));
-        },
-        [this, self = this->shared_from_this()](const error::Error& e) mutable {
-            promise_->reject(e);
-            promise_.reset();
-        });
+    if(startupTimeline_ != nullptr)
+    {
+        startupTimeline_->mark(metrics::StartupPhase::ACCESSORY_MODE_SWITCHED);
+    }
 
-    this->startQuery(AccessoryModeQueryType::START,
-                     std::move(usbEndpoint),
-                     std::move(queryPromise));
+    promise_->resolve(usbEndpoint->getDeviceHandle());
+    promise_.reset();
 }
 
-void AccessoryModeQueryChain::startQueryHandler(IUSBEndpoint::Pointer usbEndpoint)
+void AccessoryModeQueryChain::queryErrorHandler(const error::Error& e)
 {
-    activeQuery_.reset();
-    promise_->resolve(usbEndpoint->getDeviceHandle());
+    // Pipelined string queries may fail more than once; only the first failure counts.
+    if(promise_ == nullptr)
+    {
+        return;
+    }
+
+    for(const auto& query : activeQueries_)
+    {
+        query->cancel();
+    }
+
+    activeQueries_.clear();
+
+    // A device which fails after the probe was skipped gets the full chain next time.
+    // Cancellation says nothing about the device, so it keeps its entry.
+    if(capabilityCache_ != nullptr && e != error::ErrorCode::OPERATION_ABORTED)
+    {
+        capabilityCache_->erase(capabilityKey_);
+    }
+
+    promise_->reject(e);
     promise_.reset();
 }
 
@@ -35,6 +35,8 @@ using ::testing::_;
 using ::testing::Return;
 using ::testing::SaveArg;
 using ::testing::NotNull;
+using ::testing::Invoke;
+using ::testing::SetArgReferee;
 
 class AccessoryModeQueryChainUnitTest
 {
@@ -56,6 +58,37 @@ protected:
     std::shared_ptr<AccessoryModeQueryMock> queryMock_;
     AccessoryModeQueryChainPromiseHandlerMock promiseHandlerMock_;
     IAccessoryModeQueryChain::Promise::Pointer promise_;
+    std::vector<IAccessoryModeQuery::Promise::Pointer> queryPromises_;
+
+    void expectQueries()
+    {
+        EXPECT_CALL(*queryMock_, start(_)).WillRepeatedly(Invoke([this](IAccessoryModeQuery::Promise::Pointer promise) {
+            queryPromises_.push_back(std::move(promise));
+        }));
+    }
+
+    void expectSendStringQueries()
+    {
+        for(const auto queryType : {AccessoryModeQueryType::SEND_MANUFACTURER, AccessoryModeQueryType::SEND_MODEL, AccessoryModeQueryType::SEND_DESCRIPTION,
+                                    AccessoryModeQueryType::SEND_VERSION, AccessoryModeQueryType::SEND_URI, AccessoryModeQueryType::SEND_SERIAL})
+        {
+            EXPECT_CALL(queryFactoryMock_, createQuery(queryType, _)).WillOnce(Return(queryMock_));
+        }
+    }
+
+    void resolveQueries(IUSBEndpoint::Pointer usbEndpoint)
+    {
+        auto queryPromises = std::move(queryPromises_);
+        queryPromises_.clear();
+
+        for(const auto& queryPromise : queryPromises)
+        {
+            queryPromise->resolve(usbEndpoint);
+        }
+
+        ioService_.run();
+        ioService_.reset();
+    }
 };
 
 BOOST_FIXTURE_TEST_CASE(AccessoryModeQueryChain_QueryAOAPDevice, AccessoryModeQueryChainUnitTest)
@@ -63,389 +96,201 @@ BOOST_FIXTURE_TEST_CASE(AccessoryModeQueryChain_QueryAOAPDevice, AccessoryModeQu
     AccessoryModeQueryChain::Pointer queryChain(std::make_shared<AccessoryModeQueryChain>(usbWrapperMock_, ioService_, queryFactoryMock_));
 
     IUSBEndpoint::Pointer usbEndpoint;
-
-    IAccessoryModeQuery::Promise::Pointer queryPromise;
-    EXPECT_CALL(*queryMock_, start(_)).WillRepeatedly(SaveArg<0>(&queryPromise));
+    this->expectQueries();
     EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::PROTOCOL_VERSION, _)).WillOnce(testing::DoAll(SaveArg<1>(&usbEndpoint), Return(queryMock_)));
     queryChain->start(deviceHandle_, std::move(promise_));
     ioService_.run();
     ioService_.reset();
 
-    queryPromise->resolve(usbEndpoint);
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::SEND_MANUFACTURER, usbEndpoint)).WillOnce(Return(queryMock_));
-    ioService_.run();
-    ioService_.reset();
-
-    queryPromise->resolve(usbEndpoint);
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::SEND_MODEL, usbEndpoint)).WillOnce(Return(queryMock_));
-    ioService_.run();
-    ioService_.reset();
-
-    queryPromise->resolve(usbEndpoint);
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::SEND_DESCRIPTION, usbEndpoint)).WillOnce(Return(queryMock_));
-    ioService_.run();
-    ioService_.reset();
-
-    queryPromise->resolve(usbEndpoint);
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::SEND_VERSION, usbEndpoint)).WillOnce(Return(queryMock_));
-    ioService_.run();
-    ioService_.reset();
-
-    queryPromise->resolve(usbEndpoint);
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::SEND_URI, usbEndpoint)).WillOnce(Return(queryMock_));
-    ioService_.run();
-    ioService_.reset();
-
-    queryPromise->resolve(usbEndpoint);
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::SEND_SERIAL, usbEndpoint)).WillOnce(Return(queryMock_));
-    ioService_.run();
-    ioService_.reset();
+    // All strings are sent at once, before any of them completes.
+    this->expectSendStringQueries();
+    this->resolveQueries(usbEndpoint);
+    BOOST_CHECK_EQUAL(queryPromises_.size(), 6);
 
-    queryPromise->resolve(usbEndpoint);
     EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::START, usbEndpoint)).WillOnce(Return(queryMock_));
-    ioService_.run();
-    ioService_.reset();
+    this->resolveQueries(usbEndpoint);
+    BOOST_CHECK_EQUAL(queryPromises_.size(), 1);
 
-    queryPromise->resolve(usbEndpoint);
     EXPECT_CALL(promiseHandlerMock_, onResolve(deviceHandle_));
     EXPECT_CALL(promiseHandlerMock_, onReject(_)).Times(0);
-    ioService_.run();
+    this->resolveQueries(usbEndpoint);
 }
 
 BOOST_FIXTURE_TEST_CASE(AccessoryModeQueryChain_ProtocolVersionQueryFailed, AccessoryModeQueryChainUnitTest)
 {
     AccessoryModeQueryChain::Pointer queryChain(std::make_shared<AccessoryModeQueryChain>(usbWrapperMock_, ioService_, queryFactoryMock_));
 
-    IUSBEndpoint::Pointer usbEndpoint;
-
-    IAccessoryModeQuery::Promise::Pointer queryPromise;
-    EXPECT_CALL(*queryMock_, start(_)).WillRepeatedly(SaveArg<0>(&queryPromise));
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::PROTOCOL_VERSION, _)).WillOnce(testing::DoAll(SaveArg<1>(&usbEndpoint), Return(queryMock_)));
+    this->expectQueries();
+    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::PROTOCOL_VERSION, _)).WillOnce(Return(queryMock_));
     queryChain->start(deviceHandle_, std::move(promise_));
 
     ioService_.run();
     ioService_.reset();
 
     const error::Error e(error::ErrorCode::USB_AOAP_PROTOCOL_VERSION);
-    queryPromise->reject(e);
+    queryPromises_.front()->reject(e);
     EXPECT_CALL(promiseHandlerMock_, onResolve(_)).Times(0);
     EXPECT_CALL(promiseHandlerMock_, onReject(e));
     ioService_.run();
 }
 
-BOOST_FIXTURE_TEST_CASE(AccessoryModeQueryChain_ManufacturerQueryFailed, AccessoryModeQueryChainUnitTest)
+BOOST_FIXTURE_TEST_CASE(AccessoryModeQueryChain_SendStringQueryFailed, AccessoryModeQueryChainUnitTest)
 {
     AccessoryModeQueryChain::Pointer queryChain(std::make_shared<AccessoryModeQueryChain>(usbWrapperMock_, ioService_, queryFactoryMock_));
 
     IUSBEndpoint::Pointer usbEndpoint;
-
-    IAccessoryModeQuery::Promise::Pointer queryPromise;
-    EXPECT_CALL(*queryMock_, start(_)).WillRepeatedly(SaveArg<0>(&queryPromise));
+    this->expectQueries();
     EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::PROTOCOL_VERSION, _)).WillOnce(testing::DoAll(SaveArg<1>(&usbEndpoint), Return(queryMock_)));
     queryChain->start(deviceHandle_, std::move(promise_));
-
     ioService_.run();
     ioService_.reset();
 
-    queryPromise->resolve(usbEndpoint);
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::SEND_MANUFACTURER, usbEndpoint)).WillOnce(Return(queryMock_));
-    ioService_.run();
-    ioService_.reset();
+    this->expectSendStringQueries();
+    this->resolveQueries(usbEndpoint);
 
+    // The first failure cancels the remaining strings and rejects the chain once.
     const error::Error e(error::ErrorCode::USB_TRANSFER);
-    queryPromise->reject(e);
+    EXPECT_CALL(*queryMock_, cancel()).Times(6);
+    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::START, _)).Times(0);
     EXPECT_CALL(promiseHandlerMock_, onResolve(_)).Times(0);
     EXPECT_CALL(promiseHandlerMock_, onReject(e));
-    ioService_.run();
-}
 
-BOOST_FIXTURE_TEST_CASE(AccessoryModeQueryChain_ModelQueryFailed, AccessoryModeQueryChainUnitTest)
-{
-    AccessoryModeQueryChain::Pointer queryChain(std::make_shared<AccessoryModeQueryChain>(usbWrapperMock_, ioService_, queryFactoryMock_));
-
-    IUSBEndpoint::Pointer usbEndpoint;
-
-    IAccessoryModeQuery::Promise::Pointer queryPromise;
-    EXPECT_CALL(*queryMock_, start(_)).WillRepeatedly(SaveArg<0>(&queryPromise));
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::PROTOCOL_VERSION, _)).WillOnce(testing::DoAll(SaveArg<1>(&usbEndpoint), Return(queryMock_)));
-    queryChain->start(deviceHandle_, std::move(promise_));
-
-    ioService_.run();
-    ioService_.reset();
-
-    queryPromise->resolve(usbEndpoint);
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::SEND_MANUFACTURER, usbEndpoint)).WillOnce(Return(queryMock_));
-    ioService_.run();
-    ioService_.reset();
-
-    queryPromise->resolve(usbEndpoint);
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::SEND_MODEL, usbEndpoint)).WillOnce(Return(queryMock_));
-    ioService_.run();
-    ioService_.reset();
-
-    const error::Error e(error::ErrorCode::USB_TRANSFER);
-    queryPromise->reject(e);
-    EXPECT_CALL(promiseHandlerMock_, onResolve(_)).Times(0);
-    EXPECT_CALL(promiseHandlerMock_, onReject(e));
+    queryPromises_[1]->reject(e);
+    queryPromises_[0]->resolve(usbEndpoint);
+    queryPromises_[2]->reject(error::Error(error::ErrorCode::OPERATION_ABORTED));
     ioService_.run();
 }
 
-BOOST_FIXTURE_TEST_CASE(AccessoryModeQueryChain_DescriptionQueryFailed, AccessoryModeQueryChainUnitTest)
+BOOST_FIXTURE_TEST_CASE(AccessoryModeQueryChain_StartQueryFailed, AccessoryModeQueryChainUnitTest)
 {
     AccessoryModeQueryChain::Pointer queryChain(std::make_shared<AccessoryModeQueryChain>(usbWrapperMock_, ioService_, queryFactoryMock_));
 
     IUSBEndpoint::Pointer usbEndpoint;
-
-    IAccessoryModeQuery::Promise::Pointer queryPromise;
-    EXPECT_CALL(*queryMock_, start(_)).WillRepeatedly(SaveArg<0>(&queryPromise));
+    this->expectQueries();
     EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::PROTOCOL_VERSION, _)).WillOnce(testing::DoAll(SaveArg<1>(&usbEndpoint), Return(queryMock_)));
     queryChain->start(deviceHandle_, std::move(promise_));
-
-    ioService_.run();
-    ioService_.reset();
-
-    queryPromise->resolve(usbEndpoint);
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::SEND_MANUFACTURER, usbEndpoint)).WillOnce(Return(queryMock_));
     ioService_.run();
     ioService_.reset();
 
-    queryPromise->resolve(usbEndpoint);
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::SEND_MODEL, usbEndpoint)).WillOnce(Return(queryMock_));
-    ioService_.run();
-    ioService_.reset();
+    this->expectSendStringQueries();
+    this->resolveQueries(usbEndpoint);
 
-    queryPromise->resolve(usbEndpoint);
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::SEND_DESCRIPTION, usbEndpoint)).WillOnce(Return(queryMock_));
-    ioService_.run();
-    ioService_.reset();
+    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::START, usbEndpoint)).WillOnce(Return(queryMock_));
+    this->resolveQueries(usbEndpoint);
 
     const error::Error e(error::ErrorCode::USB_TRANSFER);
-    queryPromise->reject(e);
+    EXPECT_CALL(*queryMock_, cancel());
     EXPECT_CALL(promiseHandlerMock_, onResolve(_)).Times(0);
     EXPECT_CALL(promiseHandlerMock_, onReject(e));
+    queryPromises_.front()->reject(e);
     ioService_.run();
 }
 
-BOOST_FIXTURE_TEST_CASE(AccessoryModeQueryChain_VersionQueryFailed, AccessoryModeQueryChainUnitTest)
+BOOST_FIXTURE_TEST_CASE(AccessoryModeQueryChain_Cancel, AccessoryModeQueryChainUnitTest)
 {
     AccessoryModeQueryChain::Pointer queryChain(std::make_shared<AccessoryModeQueryChain>(usbWrapperMock_, ioService_, queryFactoryMock_));
 
     IUSBEndpoint::Pointer usbEndpoint;
-
-    IAccessoryModeQuery::Promise::Pointer queryPromise;
-    EXPECT_CALL(*queryMock_, start(_)).WillRepeatedly(SaveArg<0>(&queryPromise));
+    this->expectQueries();
     EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::PROTOCOL_VERSION, _)).WillOnce(testing::DoAll(SaveArg<1>(&usbEndpoint), Return(queryMock_)));
     queryChain->start(deviceHandle_, std::move(promise_));
-
-    ioService_.run();
-    ioService_.reset();
-
-    queryPromise->resolve(usbEndpoint);
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::SEND_MANUFACTURER, usbEndpoint)).WillOnce(Return(queryMock_));
     ioService_.run();
     ioService_.reset();
 
-    queryPromise->resolve(usbEndpoint);
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::SEND_MODEL, usbEndpoint)).WillOnce(Return(queryMock_));
-    ioService_.run();
-    ioService_.reset();
+    this->expectSendStringQueries();
+    this->resolveQueries(usbEndpoint);
 
-    queryPromise->resolve(usbEndpoint);
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::SEND_DESCRIPTION, usbEndpoint)).WillOnce(Return(queryMock_));
-    ioService_.run();
-    ioService_.reset();
+    EXPECT_CALL(*queryMock_, cancel()).Times(6);
+    queryChain->cancel();
 
-    queryPromise->resolve(usbEndpoint);
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::SEND_VERSION, usbEndpoint)).WillOnce(Return(queryMock_));
-    ioService_.run();
-    ioService_.reset();
+    const error::Error e(error::ErrorCode::OPERATION_ABORTED);
+    for(const auto& queryPromise : queryPromises_)
+    {
+        queryPromise->reject(e);
+    }
 
-    const error::Error e(error::ErrorCode::USB_TRANSFER);
-    queryPromise->reject(e);
     EXPECT_CALL(promiseHandlerMock_, onResolve(_)).Times(0);
     EXPECT_CALL(promiseHandlerMock_, onReject(e));
     ioService_.run();
 }
 
-BOOST_FIXTURE_TEST_CASE(AccessoryModeQueryChain_URIQueryFailed, AccessoryModeQueryChainUnitTest)
+BOOST_FIXTURE_TEST_CASE(AccessoryModeQueryChain_SkipProtocolVersionForKnownDevice, AccessoryModeQueryChainUnitTest)
 {
-    AccessoryModeQueryChain::Pointer queryChain(std::make_shared<AccessoryModeQueryChain>(usbWrapperMock_, ioService_, queryFactoryMock_));
-
-    IUSBEndpoint::Pointer usbEndpoint;
-
-    IAccessoryModeQuery::Promise::Pointer queryPromise;
-    EXPECT_CALL(*queryMock_, start(_)).WillRepeatedly(SaveArg<0>(&queryPromise));
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::PROTOCOL_VERSION, _)).WillOnce(testing::DoAll(SaveArg<1>(&usbEndpoint), Return(queryMock_)));
-    queryChain->start(deviceHandle_, std::move(promise_));
-
-    ioService_.run();
-    ioService_.reset();
-
-    queryPromise->resolve(usbEndpoint);
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::SEND_MANUFACTURER, usbEndpoint)).WillOnce(Return(queryMock_));
-    ioService_.run();
-    ioService_.reset();
-
-    queryPromise->resolve(usbEndpoint);
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::SEND_MODEL, usbEndpoint)).WillOnce(Return(queryMock_));
-    ioService_.run();
-    ioService_.reset();
-
-    queryPromise->resolve(usbEndpoint);
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::SEND_DESCRIPTION, usbEndpoint)).WillOnce(Return(queryMock_));
-    ioService_.run();
-    ioService_.reset();
-
-    queryPromise->resolve(usbEndpoint);
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::SEND_VERSION, usbEndpoint)).WillOnce(Return(queryMock_));
-    ioService_.run();
-    ioService_.reset();
-
-    queryPromise->resolve(usbEndpoint);
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::SEND_URI, usbEndpoint)).WillOnce(Return(queryMock_));
-    ioService_.run();
-    ioService_.reset();
+    libusb_device_descriptor deviceDescriptor = {0};
+    deviceDescriptor.idVendor = 0x04E8;
+    deviceDescriptor.idProduct = 0x6860;
+    deviceDescriptor.bcdDevice = 0x0400;
 
-    const error::Error e(error::ErrorCode::USB_TRANSFER);
-    queryPromise->reject(e);
-    EXPECT_CALL(promiseHandlerMock_, onResolve(_)).Times(0);
-    EXPECT_CALL(promiseHandlerMock_, onReject(e));
-    ioService_.run();
-}
+    auto capabilityCache = std::make_shared<AccessoryModeCapabilityCache>();
+    const auto device = reinterpret_cast<libusb_device*>(-1);
+    EXPECT_CALL(usbWrapperMock_, getDevice(deviceHandle_)).WillRepeatedly(Return(device));
+    EXPECT_CALL(usbWrapperMock_, getDeviceDescriptor(device, _)).WillRepeatedly(testing::DoAll(SetArgReferee<1>(deviceDescriptor), Return(0)));
 
-BOOST_FIXTURE_TEST_CASE(AccessoryModeQueryChain_SerialQueryFailed, AccessoryModeQueryChainUnitTest)
-{
-    AccessoryModeQueryChain::Pointer queryChain(std::make_shared<AccessoryModeQueryChain>(usbWrapperMock_, ioService_, queryFactoryMock_));
+    // The first connection runs the protocol version query and remembers the device.
+    AccessoryModeQueryChain::Pointer queryChain(std::make_shared<AccessoryModeQueryChain>(usbWrapperMock_, ioService_, queryFactoryMock_, capabilityCache));
 
     IUSBEndpoint::Pointer usbEndpoint;
-
-    IAccessoryModeQuery::Promise::Pointer queryPromise;
-    EXPECT_CALL(*queryMock_, start(_)).WillRepeatedly(SaveArg<0>(&queryPromise));
+    this->expectQueries();
     EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::PROTOCOL_VERSION, _)).WillOnce(testing::DoAll(SaveArg<1>(&usbEndpoint), Return(queryMock_)));
     queryChain->start(deviceHandle_, std::move(promise_));
-
-    ioService_.run();
-    ioService_.reset();
-
-    queryPromise->resolve(usbEndpoint);
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::SEND_MANUFACTURER, usbEndpoint)).WillOnce(Return(queryMock_));
-    ioService_.run();
-    ioService_.reset();
-
-    queryPromise->resolve(usbEndpoint);
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::SEND_MODEL, usbEndpoint)).WillOnce(Return(queryMock_));
-    ioService_.run();
-    ioService_.reset();
-
-    queryPromise->resolve(usbEndpoint);
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::SEND_DESCRIPTION, usbEndpoint)).WillOnce(Return(queryMock_));
     ioService_.run();
     ioService_.reset();
 
-    queryPromise->resolve(usbEndpoint);
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::SEND_VERSION, usbEndpoint)).WillOnce(Return(queryMock_));
-    ioService_.run();
-    ioService_.reset();
+    this->expectSendStringQueries();
+    this->resolveQueries(usbEndpoint);
+    BOOST_CHECK(capabilityCache->contains(AccessoryModeCapabilityCache::getKey(deviceDescriptor)));
 
-    queryPromise->resolve(usbEndpoint);
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::SEND_URI, usbEndpoint)).WillOnce(Return(queryMock_));
-    ioService_.run();
-    ioService_.reset();
+    // A reconnect goes straight to the strings.
+    AccessoryModeQueryChain::Pointer secondQueryChain(std::make_shared<AccessoryModeQueryChain>(usbWrapperMock_, ioService_, queryFactoryMock_, capabilityCache));
+    auto secondPromise = IAccessoryModeQueryChain::Promise::defer(ioService_);
+    queryPromises_.clear();
 
-    queryPromise->resolve(usbEndpoint);
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::SEND_SERIAL, usbEndpoint)).WillOnce(Return(queryMock_));
+    this->expectSendStringQueries();
+    secondQueryChain->start(deviceHandle_, std::move(secondPromise));
     ioService_.run();
     ioService_.reset();
 
-    const error::Error e(error::ErrorCode::USB_TRANSFER);
-    queryPromise->reject(e);
-    EXPECT_CALL(promiseHandlerMock_, onResolve(_)).Times(0);
-    EXPECT_CALL(promiseHandlerMock_, onReject(e));
-    ioService_.run();
+    BOOST_CHECK_EQUAL(queryPromises_.size(), 6);
 }
 
-BOOST_FIXTURE_TEST_CASE(AccessoryModeQueryChain_StartQueryFailed, AccessoryModeQueryChainUnitTest)
+BOOST_FIXTURE_TEST_CASE(AccessoryModeQueryChain_CancelKeepsKnownDevice, AccessoryModeQueryChainUnitTest)
 {
-    AccessoryModeQueryChain::Pointer queryChain(std::make_shared<AccessoryModeQueryChain>(usbWrapperMock_, ioService_, queryFactoryMock_));
-
-    IUSBEndpoint::Pointer usbEndpoint;
-
-    IAccessoryModeQuery::Promise::Pointer queryPromise;
-    EXPECT_CALL(*queryMock_, start(_)).WillRepeatedly(SaveArg<0>(&queryPromise));
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::PROTOCOL_VERSION, _)).WillOnce(testing::DoAll(SaveArg<1>(&usbEndpoint), Return(queryMock_)));
-    queryChain->start(deviceHandle_, std::move(promise_));
-
-    ioService_.run();
-    ioService_.reset();
-
-    queryPromise->resolve(usbEndpoint);
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::SEND_MANUFACTURER, usbEndpoint)).WillOnce(Return(queryMock_));
-    ioService_.run();
-    ioService_.reset();
+    libusb_device_descriptor deviceDescriptor = {0};
+    deviceDescriptor.idVendor = 0x04E8;
+    deviceDescriptor.idProduct = 0x6860;
+    deviceDescriptor.bcdDevice = 0x0400;
 
-    queryPromise->resolve(usbEndpoint);
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::SEND_MODEL, usbEndpoint)).WillOnce(Return(queryMock_));
-    ioService_.run();
-    ioService_.reset();
-
-    queryPromise->resolve(usbEndpoint);
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::SEND_DESCRIPTION, usbEndpoint)).WillOnce(Return(queryMock_));
-    ioService_.run();
-    ioService_.reset();
-
-    queryPromise->resolve(usbEndpoint);
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::SEND_VERSION, usbEndpoint)).WillOnce(Return(queryMock_));
-    ioService_.run();
-    ioService_.reset();
+    auto capabilityCache = std::make_shared<AccessoryModeCapabilityCache>();
+    const auto device = reinterpret_cast<libusb_device*>(-1);
+    EXPECT_CALL(usbWrapperMock_, getDevice(deviceHandle_)).WillRepeatedly(Return(device));
+    EXPECT_CALL(usbWrapperMock_, getDeviceDescriptor(device, _)).WillRepeatedly(testing::DoAll(SetArgReferee<1>(deviceDescriptor), Return(0)));
 
-    queryPromise->resolve(usbEndpoint);
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::SEND_URI, usbEndpoint)).WillOnce(Return(queryMock_));
-    ioService_.run();
-    ioService_.reset();
-
-    queryPromise->resolve(usbEndpoint);
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::SEND_SERIAL, usbEndpoint)).WillOnce(Return(queryMock_));
-    ioService_.run();
-    ioService_.reset();
-
-    queryPromise->resolve(usbEndpoint);
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::START, usbEndpoint)).WillOnce(Return(queryMock_));
-    ioService_.run();
-    ioService_.reset();
-
-    const error::Error e(error::ErrorCode::USB_TRANSFER);
-    queryPromise->reject(e);
-    EXPECT_CALL(promiseHandlerMock_, onResolve(_)).Times(0);
-    EXPECT_CALL(promiseHandlerMock_, onReject(e));
-    ioService_.run();
-}
-
-BOOST_FIXTURE_TEST_CASE(AccessoryModeQueryChain_Cancel, AccessoryModeQueryChainUnitTest)
-{
-    AccessoryModeQueryChain::Pointer queryChain(std::make_shared<AccessoryModeQueryChain>(usbWrapperMock_, ioService_, queryFactoryMock_));
+    AccessoryModeQueryChain::Pointer queryChain(std::make_shared<AccessoryModeQueryChain>(usbWrapperMock_, ioService_, queryFactoryMock_, capabilityCache));
 
     IUSBEndpoint::Pointer usbEndpoint;
-    IAccessoryModeQuery::Promise::Pointer queryPromise;
-    EXPECT_CALL(*queryMock_, start(_)).WillRepeatedly(SaveArg<0>(&queryPromise));
+    this->expectQueries();
     EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::PROTOCOL_VERSION, _)).WillOnce(testing::DoAll(SaveArg<1>(&usbEndpoint), Return(queryMock_)));
     queryChain->start(deviceHandle_, std::move(promise_));
-
     ioService_.run();
     ioService_.reset();
 
-    queryPromise->resolve(usbEndpoint);
-    EXPECT_CALL(queryFactoryMock_, createQuery(AccessoryModeQueryType::SEND_MANUFACTURER, usbEndpoint)).WillOnce(Return(queryMock_));
-    ioService_.run();
-    ioService_.reset();
+    this->expectSendStringQueries();
+    this->resolveQueries(usbEndpoint);
 
-    EXPECT_CALL(*queryMock_, cancel());
+    EXPECT_CALL(*queryMock_, cancel()).Times(6);
     queryChain->cancel();
 
     const error::Error e(error::ErrorCode::OPERATION_ABORTED);
-    queryPromise->reject(e);
+    for(const auto& queryPromise : queryPromises_)
+    {
+        queryPromise->reject(e);
+    }
+
     EXPECT_CALL(promiseHandlerMock_, onResolve(_)).Times(0);
     EXPECT_CALL(promiseHandlerMock_, onReject(e));
     ioService_.run();
+
+    BOOST_CHECK(capabilityCache->contains(AccessoryModeCapabilityCache::getKey(deviceDescriptor)));
 }
 
 BOOST_FIXTURE_TEST_CASE(AccessoryModeQueryChain_RejectWhenInProgress, AccessoryModeQueryChainUnitTest)
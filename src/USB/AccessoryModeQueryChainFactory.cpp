@@ -28,16 +28,26 @@ namespace usb
 AccessoryModeQueryChainFactory::AccessoryModeQueryChainFactory(IUSBWrapper& usbWrapper,
                                                                asio::io_service& ioService,
                                                                IAccessoryModeQueryFactory& queryFactory)
+    : AccessoryModeQueryChainFactory(usbWrapper, ioService, queryFactory, std::make_shared<AccessoryModeCapabilityCache>())
+{
+
+}
+
+AccessoryModeQueryChainFactory::AccessoryModeQueryChainFactory(IUSBWrapper& usbWrapper,
+                                                               asio::io_service& ioService,
+                                                               IAccessoryModeQueryFactory& queryFactory,
+                                                               AccessoryModeCapabilityCache::Pointer capabilityCache)
     : usbWrapper_(usbWrapper)
     , ioService_(ioService)
     , queryFactory_(queryFactory)
+    , capabilityCache_(std::move(capabilityCache))
 {
 
 }
 
 IAccessoryModeQueryChain::Pointer AccessoryModeQueryChainFactory::create()
 {
-    return std::make_shared<AccessoryModeQueryChain>(usbWrapper_, ioService_, queryFactory_);
+    return std::make_shared<AccessoryModeQueryChain>(usbWrapper_, ioService_, queryFactory_, capabilityCache_);
 }
 
 }
@@ -0,0 +1,44 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <aasdk/USB/AccessoryModeQueryType.hpp>
+
+
+namespace aasdk
+{
+namespace usb
+{
+
+std::string accessoryModeQueryTypeToString(AccessoryModeQueryType queryType)
+{
+    switch(queryType)
+    {
+    case AccessoryModeQueryType::PROTOCOL_VERSION: return "PROTOCOL_VERSION";
+    case AccessoryModeQueryType::SEND_MANUFACTURER: return "SEND_MANUFACTURER";
+    case AccessoryModeQueryType::SEND_MODEL: return "SEND_MODEL";
+    case AccessoryModeQueryType::SEND_DESCRIPTION: return "SEND_DESCRIPTION";
+    case AccessoryModeQueryType::SEND_VERSION: return "SEND_VERSION";
+    case AccessoryModeQueryType::SEND_URI: return "SEND_URI";
+    case AccessoryModeQueryType::SEND_SERIAL: return "SEND_SERIAL";
+    case AccessoryModeQueryType::START: return "START";
+    default: return "(null)";
+    }
+}
+
+}
+}
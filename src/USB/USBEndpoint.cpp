@@ -31,6 +31,7 @@ USBEndpoint::USBEndpoint(IUSBWrapper& usbWrapper, asio::io_service& ioService, D
     , strand_(ioService)
     , handle_(std::move(handle))
     , endpointAddress_(endpointAddress)
+    , lastTransferCompletionTime_(common::TraceClock::time_point())
 {
 }
 
@@ -140,11 +141,17 @@ DeviceHandle USBEndpoint::getDeviceHandle() const
     return handle_;
 }
 
+common::TraceClock::time_point USBEndpoint::getLastTransferCompletionTime() const
+{
+    return lastTransferCompletionTime_.load(std::memory_order_relaxed);
+}
+
 void USBEndpoint::transferHandler(libusb_transfer *transfer)
 {
     auto self = reinterpret_cast<USBEndpoint*>(transfer->user_data)->shared_from_this();
+    const auto completionTime = common::TraceClock::now();
 
-    self->strand_.dispatch([self, transfer]() mutable {
+    self->strand_.dispatch([self, transfer, completionTime]() mutable {
         if(self->transfers_.count(transfer) == 0)
         {
             return;
@@ -154,6 +161,7 @@ void USBEndpoint::transferHandler(libusb_transfer *transfer)
 
         if(transfer->status == LIBUSB_TRANSFER_COMPLETED)
         {
+            self->lastTransferCompletionTime_.store(completionTime, std::memory_order_relaxed);
             promise->resolve(transfer->actual_length);
         }
         else
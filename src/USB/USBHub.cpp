@@ -1,5 +1,6 @@
 
-#include <thread>
+#include <algorithm>
+#include <cstdio>
 #include <aasdk/USB/IUSBWrapper.hpp>
 #include <aasdk/USB/USBHub.hpp>
 #include <aasdk/USB/AccessoryModeQueryChain.hpp>
@@ -12,9 +13,15 @@ namespace usb
 {
 
 USBHub::USBHub(IUSBWrapper& usbWrapper, asio::io_service& ioService, IAccessoryModeQueryChainFactory& queryChainFactory)
+    : USBHub(usbWrapper, ioService, queryChainFactory, Configuration())
+{
+}
+
+USBHub::USBHub(IUSBWrapper& usbWrapper, asio::io_service& ioService, IAccessoryModeQueryChainFactory& queryChainFactory, Configuration configuration)
     : usbWrapper_(usbWrapper)
     , strand_(ioService)
     , queryChainFactory_(queryChainFactory)
+    , configuration_(std::move(configuration))
 {
 }
 
@@ -49,8 +56,17 @@ void USBHub::cancel()
             hotplugPromise_.reset();
         }
 
+        std::for_each(delayTimers_.begin(), delayTimers_.end(), [](const auto& timer) { timer->cancel(); });
         std::for_each(queryChainQueue_.begin(), queryChainQueue_.end(), std::bind(&IAccessoryModeQueryChain::cancel, std::placeholders::_1));
 
+        // Timelines of delayed and running query chains are finished by their handlers.
+        for(const auto& startupTimeline : switchedDeviceStartupTimelines_)
+        {
+            startupTimeline->finish(error::Error(error::ErrorCode::OPERATION_ABORTED));
+        }
+
+        switchedDeviceStartupTimelines_.clear();
+
         if(self_ != nullptr)
         {
             hotplugHandle_.reset();
@@ -59,6 +75,19 @@ void USBHub::cancel()
     });
 }
 
+void USBHub::setStartupTimelineFactory(metrics::StartupTimeline::Factory startupTimelineFactory)
+{
+    strand_.dispatch([this, self = this->shared_from_this(), startupTimelineFactory = std::move(startupTimelineFactory)]() mutable {
+        startupTimelineFactory_ = std::move(startupTimelineFactory);
+    });
+}
+
+metrics::StartupTimeline::Pointer USBHub::getStartupTimeline() const
+{
+    std::lock_guard<decltype(startupTimelineMutex_)> lock(startupTimelineMutex_);
+    return startupTimeline_;
+}
+
 int USBHub::hotplugEventsHandler(libusb_context* usbContext, libusb_device* device, libusb_hotplug_event event, void* userData)
 {
     if(event == LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED)
@@ -76,6 +105,50 @@ bool USBHub::isAOAPDevice(const libusb_device_descriptor& deviceDescriptor) cons
             (deviceDescriptor.idProduct == cAOAPId || deviceDescriptor.idProduct == cAOAPWithAdbId);
 }
 
+bool USBHub::isCandidateDevice(libusb_device* device, const libusb_device_descriptor& deviceDescriptor) const
+{
+    const auto& vendorIds = configuration_.vendorIds;
+    if(!vendorIds.empty() && std::find(vendorIds.begin(), vendorIds.end(), deviceDescriptor.idVendor) == vendorIds.end())
+    {
+        return false;
+    }
+
+    const auto nonAOAPDevice = nonAOAPDevices_.find((static_cast<uint32_t>(deviceDescriptor.idVendor) << 16) | deviceDescriptor.idProduct);
+    if(nonAOAPDevice != nonAOAPDevices_.end() && std::chrono::steady_clock::now() < nonAOAPDevice->second)
+    {
+        return false;
+    }
+
+    if(deviceDescriptor.bDeviceClass != LIBUSB_CLASS_PER_INTERFACE)
+    {
+        return !this->isIgnoredClass(deviceDescriptor.bDeviceClass);
+    }
+
+    // Reading the configuration descriptor does not need the device to be opened.
+    ConfigDescriptorHandle configDescriptorHandle;
+    if(usbWrapper_.getConfigDescriptor(device, 0, configDescriptorHandle) != 0 || configDescriptorHandle == nullptr)
+    {
+        return true;
+    }
+
+    for(uint8_t i = 0; i < configDescriptorHandle->bNumInterfaces; ++i)
+    {
+        const auto& interface = configDescriptorHandle->interface[i];
+        if(interface.num_altsetting > 0 && !this->isIgnoredClass(interface.altsetting[0].bInterfaceClass))
+        {
+            return true;
+        }
+    }
+
+    return configDescriptorHandle->bNumInterfaces == 0;
+}
+
+bool USBHub::isIgnoredClass(uint8_t deviceClass) const
+{
+    const auto& ignoredClasses = configuration_.ignoredClasses;
+    return std::find(ignoredClasses.begin(), ignoredClasses.end(), deviceClass) != ignoredClasses.end();
+}
+
 void USBHub::handleDevice(libusb_device* device)
 {
     if(hotplugPromise_ == nullptr)
@@ -89,38 +162,131 @@ void USBHub::handleDevice(libusb_device* device)
         return;
     }
 
+    if(!this->isAOAPDevice(deviceDescriptor) && !this->isCandidateDevice(device, deviceDescriptor))
+    {
+        return;
+    }
+
+    auto startupTimeline = this->createStartupTimeline(deviceDescriptor);
+
     DeviceHandle handle;
     auto openResult = usbWrapper_.open(device, handle);
 
     if(openResult != 0)
     {
+        if(startupTimeline != nullptr)
+        {
+            startupTimeline->finish(error::Error(error::ErrorCode::USB_AOAP_DEVICE_NOT_FOUND, openResult));
+        }
+
         return;
     }
 
     if(this->isAOAPDevice(deviceDescriptor))
     {
+        {
+            // The rest of the sequence belongs to the session of this device.
+            std::lock_guard<decltype(startupTimelineMutex_)> lock(startupTimelineMutex_);
+            startupTimeline_ = std::move(startupTimeline);
+        }
+
         hotplugPromise_->resolve(std::move(handle));
         hotplugPromise_.reset();
     }
     else
     {
-        ////////// Workaround for VMware
-        std::this_thread::sleep_for(std::chrono::milliseconds(1000));
-        //////////
-
         queryChainQueue_.emplace_back(queryChainFactory_.create());
 
+        if(startupTimeline != nullptr)
+        {
+            queryChainQueue_.back()->setStartupTimeline(startupTimeline);
+        }
+
         auto queueElementIter = std::prev(queryChainQueue_.end());
-        auto queryChainPromise = IAccessoryModeQueryChain::Promise::defer(strand_);
-        queryChainPromise->then([this, self = this->shared_from_this(), queueElementIter](DeviceHandle handle) mutable {
-                queryChainQueue_.erase(queueElementIter);
-            },
-            [this, self = this->shared_from_this(), queueElementIter](const error::Error& e) mutable {
+        const uint32_t deviceId = (static_cast<uint32_t>(deviceDescriptor.idVendor) << 16) | deviceDescriptor.idProduct;
+
+        if(configuration_.queryChainDelay.count() == 0)
+        {
+            this->startQueryChain(queueElementIter, std::move(handle), deviceId, std::move(startupTimeline));
+            return;
+        }
+
+        // Wait on a timer instead of the strand, so other devices keep being handled meanwhile.
+        delayTimers_.emplace_back(std::make_shared<asio::steady_timer>(strand_.context(), configuration_.queryChainDelay));
+        auto timerIter = std::prev(delayTimers_.end());
+        (*timerIter)->async_wait(strand_.wrap([this, self = this->shared_from_this(), queueElementIter, timerIter, deviceId, handle = std::move(handle), startupTimeline = std::move(startupTimeline)](const asio::error_code& ec) mutable {
+            delayTimers_.erase(timerIter);
+
+            if(ec)
+            {
+                if(startupTimeline != nullptr)
+                {
+                    startupTimeline->finish(error::Error(error::ErrorCode::OPERATION_ABORTED));
+                }
+
                 queryChainQueue_.erase(queueElementIter);
-            });
+            }
+            else
+            {
+                this->startQueryChain(queueElementIter, std::move(handle), deviceId, std::move(startupTimeline));
+            }
+        }));
+    }
+}
+
+void USBHub::startQueryChain(QueryChainQueue::iterator queueElementIter, DeviceHandle handle, uint32_t deviceId, metrics::StartupTimeline::Pointer startupTimeline)
+{
+    auto queryChainPromise = IAccessoryModeQueryChain::Promise::defer(strand_);
+    queryChainPromise->then([this, self = this->shared_from_this(), queueElementIter, startupTimeline](DeviceHandle handle) mutable {
+            if(startupTimeline != nullptr)
+            {
+                switchedDeviceStartupTimelines_.push_back(std::move(startupTimeline));
+            }
+
+            queryChainQueue_.erase(queueElementIter);
+        },
+        [this, self = this->shared_from_this(), queueElementIter, deviceId, startupTimeline](const error::Error& e) mutable {
+            if(configuration_.isNonAOAPDeviceCacheEnabled && e == error::ErrorCode::USB_AOAP_PROTOCOL_VERSION)
+            {
+                nonAOAPDevices_[deviceId] = std::chrono::steady_clock::now() + configuration_.nonAOAPDeviceCacheDuration;
+            }
 
-        queryChainQueue_.back()->start(std::move(handle), std::move(queryChainPromise));
+            if(startupTimeline != nullptr)
+            {
+                startupTimeline->finish(e);
+            }
+
+            queryChainQueue_.erase(queueElementIter);
+        });
+
+    (*queueElementIter)->start(std::move(handle), std::move(queryChainPromise));
+}
+
+metrics::StartupTimeline::Pointer USBHub::createStartupTimeline(const libusb_device_descriptor& deviceDescriptor)
+{
+    char deviceId[10];
+    std::snprintf(deviceId, sizeof(deviceId), "%04x:%04x", deviceDescriptor.idVendor, deviceDescriptor.idProduct);
+
+    if(this->isAOAPDevice(deviceDescriptor))
+    {
+        // Devices switch in the order their query chains finished; one which was already in
+        // accessory mode starts a timeline of its own.
+        if(!switchedDeviceStartupTimelines_.empty())
+        {
+            auto startupTimeline = std::move(switchedDeviceStartupTimelines_.front());
+            switchedDeviceStartupTimelines_.pop_front();
+            startupTimeline->mark(metrics::StartupPhase::DEVICE_REENUMERATED, deviceId);
+            return startupTimeline;
+        }
     }
+
+    auto startupTimeline = startupTimelineFactory_ != nullptr ? startupTimelineFactory_() : nullptr;
+    if(startupTimeline != nullptr)
+    {
+        startupTimeline->mark(this->isAOAPDevice(deviceDescriptor) ? metrics::StartupPhase::DEVICE_REENUMERATED : metrics::StartupPhase::HOTPLUG_ARRIVED, deviceId);
+    }
+
+    return startupTimeline;
 }
 
 }
@@ -237,6 +237,402 @@ BOOST_FIXTURE_TEST_CASE(USBHub_CancelAllQueryChains, USBHubUnitTest)
     ioService_.run();
 }
 
+BOOST_FIXTURE_TEST_CASE(USBHub_DelayQueryChain, USBHubUnitTest)
+{
+    void* userData = nullptr;
+    EXPECT_CALL(usbWrapperMock_, hotplugRegisterCallback(LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED, _,
+                                                         LIBUSB_HOTPLUG_MATCH_ANY, LIBUSB_HOTPLUG_MATCH_ANY,
+                                                         LIBUSB_HOTPLUG_MATCH_ANY, _, _))
+            .WillOnce(testing::DoAll(SaveArg<5>(&hotplugCallback_), SaveArg<6>(&userData), Return(hotplugCallbackHandle_)));
+
+    USBHub::Configuration configuration;
+    configuration.queryChainDelay = std::chrono::milliseconds(50);
+    USBHub::Pointer usbHub(std::make_shared<USBHub>(usbWrapperMock_, ioService_, queryChainFactoryMock_, configuration));
+    usbHub->start(std::move(promise_));
+
+    ioService_.run();
+    ioService_.reset();
+
+    libusb_device_descriptor connectedDeviceDescriptor = {0};
+    connectedDeviceDescriptor.idVendor = 123;
+    connectedDeviceDescriptor.idProduct = 456;
+
+    EXPECT_CALL(usbWrapperMock_, getDeviceDescriptor(device_, _)).WillOnce(testing::DoAll(SetArgReferee<1>(connectedDeviceDescriptor), Return(0)));
+    EXPECT_CALL(usbWrapperMock_, open(device_, _)).WillOnce(testing::DoAll(SetArgReferee<1>(deviceHandle_), Return(0)));
+    EXPECT_CALL(queryChainFactoryMock_, create()).WillOnce(Return(queryChain_));
+
+    IAccessoryModeQueryChain::Promise::Pointer queryChainPromise;
+    EXPECT_CALL(queryChainMock_, start(deviceHandle_, _)).WillOnce(SaveArg<1>(&queryChainPromise));
+
+    const auto start = std::chrono::steady_clock::now();
+    hotplugCallback_(nullptr, device_, LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED, userData);
+    ioService_.run();
+    ioService_.reset();
+
+    BOOST_CHECK(std::chrono::steady_clock::now() - start >= configuration.queryChainDelay);
+    BOOST_REQUIRE(queryChainPromise != nullptr);
+
+    EXPECT_CALL(promiseHandlerMock_, onReject(error::Error(error::ErrorCode::OPERATION_ABORTED)));
+    queryChainPromise->resolve(deviceHandle_);
+    usbHub->cancel();
+    ioService_.run();
+}
+
+BOOST_FIXTURE_TEST_CASE(USBHub_CancelDelayedQueryChain, USBHubUnitTest)
+{
+    void* userData = nullptr;
+    EXPECT_CALL(usbWrapperMock_, hotplugRegisterCallback(LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED, _,
+                                                         LIBUSB_HOTPLUG_MATCH_ANY, LIBUSB_HOTPLUG_MATCH_ANY,
+                                                         LIBUSB_HOTPLUG_MATCH_ANY, _, _))
+            .WillOnce(testing::DoAll(SaveArg<5>(&hotplugCallback_), SaveArg<6>(&userData), Return(hotplugCallbackHandle_)));
+
+    USBHub::Configuration configuration;
+    configuration.queryChainDelay = std::chrono::seconds(10);
+    USBHub::Pointer usbHub(std::make_shared<USBHub>(usbWrapperMock_, ioService_, queryChainFactoryMock_, configuration));
+    usbHub->start(std::move(promise_));
+
+    ioService_.run();
+    ioService_.reset();
+
+    libusb_device_descriptor connectedDeviceDescriptor = {0};
+    EXPECT_CALL(usbWrapperMock_, getDeviceDescriptor(device_, _)).WillOnce(testing::DoAll(SetArgReferee<1>(connectedDeviceDescriptor), Return(0)));
+    EXPECT_CALL(usbWrapperMock_, open(device_, _)).WillOnce(testing::DoAll(SetArgReferee<1>(deviceHandle_), Return(0)));
+    EXPECT_CALL(queryChainFactoryMock_, create()).WillOnce(Return(queryChain_));
+    EXPECT_CALL(queryChainMock_, start(_, _)).Times(0);
+    EXPECT_CALL(queryChainMock_, cancel());
+    EXPECT_CALL(promiseHandlerMock_, onReject(error::Error(error::ErrorCode::OPERATION_ABORTED)));
+
+    hotplugCallback_(nullptr, device_, LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED, userData);
+    usbHub->cancel();
+    ioService_.run();
+}
+
+BOOST_FIXTURE_TEST_CASE(USBHub_SkipFilteredDevices, USBHubUnitTest)
+{
+    void* userData = nullptr;
+    EXPECT_CALL(usbWrapperMock_, hotplugRegisterCallback(LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED, _,
+                                                         LIBUSB_HOTPLUG_MATCH_ANY, LIBUSB_HOTPLUG_MATCH_ANY,
+                                                         LIBUSB_HOTPLUG_MATCH_ANY, _, _))
+            .WillOnce(testing::DoAll(SaveArg<5>(&hotplugCallback_), SaveArg<6>(&userData), Return(hotplugCallbackHandle_)));
+
+    USBHub::Configuration configuration;
+    configuration.vendorIds = {0x04E8};
+    configuration.ignoredClasses = {LIBUSB_CLASS_HUB, LIBUSB_CLASS_MASS_STORAGE};
+    USBHub::Pointer usbHub(std::make_shared<USBHub>(usbWrapperMock_, ioService_, queryChainFactoryMock_, configuration));
+    usbHub->start(std::move(promise_));
+
+    ioService_.run();
+    ioService_.reset();
+
+    libusb_device_descriptor otherVendorDescriptor = {0};
+    otherVendorDescriptor.idVendor = 123;
+    libusb_device_descriptor hubDescriptor = {0};
+    hubDescriptor.idVendor = 0x04E8;
+    hubDescriptor.bDeviceClass = LIBUSB_CLASS_HUB;
+
+    libusb_interface_descriptor storageInterfaceDescriptor = {0};
+    storageInterfaceDescriptor.bInterfaceClass = LIBUSB_CLASS_MASS_STORAGE;
+    libusb_interface storageInterface = {&storageInterfaceDescriptor, 1};
+    libusb_config_descriptor storageConfigDescriptor = {0};
+    storageConfigDescriptor.bNumInterfaces = 1;
+    storageConfigDescriptor.interface = &storageInterface;
+    ConfigDescriptorHandle storageConfigDescriptorHandle(&storageConfigDescriptor, [](auto*) {});
+    libusb_device_descriptor storageDescriptor = {0};
+    storageDescriptor.idVendor = 0x04E8;
+
+    EXPECT_CALL(usbWrapperMock_, getDeviceDescriptor(device_, _))
+            .WillOnce(testing::DoAll(SetArgReferee<1>(otherVendorDescriptor), Return(0)))
+            .WillOnce(testing::DoAll(SetArgReferee<1>(hubDescriptor), Return(0)))
+            .WillOnce(testing::DoAll(SetArgReferee<1>(storageDescriptor), Return(0)));
+    EXPECT_CALL(usbWrapperMock_, getConfigDescriptor(device_, 0, _)).WillOnce(testing::DoAll(SetArgReferee<2>(storageConfigDescriptorHandle), Return(0)));
+    EXPECT_CALL(usbWrapperMock_, open(_, _)).Times(0);
+    EXPECT_CALL(queryChainFactoryMock_, create()).Times(0);
+
+    for(size_t i = 0; i < 3; ++i)
+    {
+        hotplugCallback_(nullptr, device_, LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED, userData);
+    }
+
+    ioService_.run();
+    ioService_.reset();
+
+    EXPECT_CALL(promiseHandlerMock_, onReject(error::Error(error::ErrorCode::OPERATION_ABORTED)));
+    usbHub->cancel();
+    ioService_.run();
+}
+
+BOOST_FIXTURE_TEST_CASE(USBHub_SkipCachedNonAOAPDevice, USBHubUnitTest)
+{
+    void* userData = nullptr;
+    EXPECT_CALL(usbWrapperMock_, hotplugRegisterCallback(LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED, _,
+                                                         LIBUSB_HOTPLUG_MATCH_ANY, LIBUSB_HOTPLUG_MATCH_ANY,
+                                                         LIBUSB_HOTPLUG_MATCH_ANY, _, _))
+            .WillOnce(testing::DoAll(SaveArg<5>(&hotplugCallback_), SaveArg<6>(&userData), Return(hotplugCallbackHandle_)));
+
+    USBHub::Pointer usbHub(std::make_shared<USBHub>(usbWrapperMock_, ioService_, queryChainFactoryMock_));
+    usbHub->start(std::move(promise_));
+
+    ioService_.run();
+    ioService_.reset();
+
+    libusb_device_descriptor connectedDeviceDescriptor = {0};
+    connectedDeviceDescriptor.idVendor = 123;
+    connectedDeviceDescriptor.idProduct = 456;
+    connectedDeviceDescriptor.bDeviceClass = 0xFF;
+
+    EXPECT_CALL(usbWrapperMock_, getDeviceDescriptor(device_, _)).Times(2).WillRepeatedly(testing::DoAll(SetArgReferee<1>(connectedDeviceDescriptor), Return(0)));
+    EXPECT_CALL(usbWrapperMock_, open(device_, _)).WillOnce(testing::DoAll(SetArgReferee<1>(deviceHandle_), Return(0)));
+    EXPECT_CALL(queryChainFactoryMock_, create()).WillOnce(Return(queryChain_));
+
+    IAccessoryModeQueryChain::Promise::Pointer queryChainPromise;
+    EXPECT_CALL(queryChainMock_, start(deviceHandle_, _)).WillOnce(SaveArg<1>(&queryChainPromise));
+
+    hotplugCallback_(nullptr, device_, LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED, userData);
+    ioService_.run();
+    ioService_.reset();
+
+    queryChainPromise->reject(error::Error(error::ErrorCode::USB_AOAP_PROTOCOL_VERSION));
+    ioService_.run();
+    ioService_.reset();
+
+    hotplugCallback_(nullptr, device_, LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED, userData);
+    ioService_.run();
+    ioService_.reset();
+
+    EXPECT_CALL(promiseHandlerMock_, onReject(error::Error(error::ErrorCode::OPERATION_ABORTED)));
+    usbHub->cancel();
+    ioService_.run();
+}
+
+BOOST_FIXTURE_TEST_CASE(USBHub_ProbeWirelessAndAudioDevicesByDefault, USBHubUnitTest)
+{
+    void* userData = nullptr;
+    EXPECT_CALL(usbWrapperMock_, hotplugRegisterCallback(LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED, _,
+                                                         LIBUSB_HOTPLUG_MATCH_ANY, LIBUSB_HOTPLUG_MATCH_ANY,
+                                                         LIBUSB_HOTPLUG_MATCH_ANY, _, _))
+            .WillOnce(testing::DoAll(SaveArg<5>(&hotplugCallback_), SaveArg<6>(&userData), Return(hotplugCallbackHandle_)));
+
+    USBHub::Pointer usbHub(std::make_shared<USBHub>(usbWrapperMock_, ioService_, queryChainFactoryMock_));
+    usbHub->start(std::move(promise_));
+
+    ioService_.run();
+    ioService_.reset();
+
+    // A phone tethering over RNDIS and a phone in USB-MIDI mode.
+    libusb_device_descriptor rndisDescriptor = {0};
+    rndisDescriptor.idVendor = 0x04E8;
+    rndisDescriptor.idProduct = 0x6863;
+    rndisDescriptor.bDeviceClass = LIBUSB_CLASS_WIRELESS;
+
+    libusb_interface_descriptor audioInterfaceDescriptor = {0};
+    audioInterfaceDescriptor.bInterfaceClass = LIBUSB_CLASS_AUDIO;
+    libusb_interface audioInterface = {&audioInterfaceDescriptor, 1};
+    libusb_config_descriptor midiConfigDescriptor = {0};
+    midiConfigDescriptor.bNumInterfaces = 1;
+    midiConfigDescriptor.interface = &audioInterface;
+    ConfigDescriptorHandle midiConfigDescriptorHandle(&midiConfigDescriptor, [](auto*) {});
+    libusb_device_descriptor midiDescriptor = {0};
+    midiDescriptor.idVendor = 0x04E8;
+    midiDescriptor.idProduct = 0x6866;
+
+    EXPECT_CALL(usbWrapperMock_, getDeviceDescriptor(device_, _))
+            .WillOnce(testing::DoAll(SetArgReferee<1>(rndisDescriptor), Return(0)))
+            .WillOnce(testing::DoAll(SetArgReferee<1>(midiDescriptor), Return(0)));
+    EXPECT_CALL(usbWrapperMock_, getConfigDescriptor(device_, 0, _)).WillOnce(testing::DoAll(SetArgReferee<2>(midiConfigDescriptorHandle), Return(0)));
+    EXPECT_CALL(usbWrapperMock_, open(device_, _)).Times(2).WillRepeatedly(testing::DoAll(SetArgReferee<1>(deviceHandle_), Return(0)));
+    EXPECT_CALL(queryChainFactoryMock_, create()).Times(2).WillRepeatedly(Return(queryChain_));
+    EXPECT_CALL(queryChainMock_, start(deviceHandle_, _)).Times(2);
+
+    for(size_t i = 0; i < 2; ++i)
+    {
+        hotplugCallback_(nullptr, device_, LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED, userData);
+    }
+
+    ioService_.run();
+    ioService_.reset();
+
+    EXPECT_CALL(queryChainMock_, cancel()).Times(2);
+    EXPECT_CALL(promiseHandlerMock_, onReject(error::Error(error::ErrorCode::OPERATION_ABORTED)));
+    usbHub->cancel();
+    ioService_.run();
+}
+
+BOOST_FIXTURE_TEST_CASE(USBHub_ProbeNonAOAPDeviceAgainAfterExpiry, USBHubUnitTest)
+{
+    void* userData = nullptr;
+    EXPECT_CALL(usbWrapperMock_, hotplugRegisterCallback(LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED, _,
+                                                         LIBUSB_HOTPLUG_MATCH_ANY, LIBUSB_HOTPLUG_MATCH_ANY,
+                                                         LIBUSB_HOTPLUG_MATCH_ANY, _, _))
+            .WillOnce(testing::DoAll(SaveArg<5>(&hotplugCallback_), SaveArg<6>(&userData), Return(hotplugCallbackHandle_)));
+
+    USBHub::Configuration configuration;
+    configuration.nonAOAPDeviceCacheDuration = std::chrono::seconds(0);
+    USBHub::Pointer usbHub(std::make_shared<USBHub>(usbWrapperMock_, ioService_, queryChainFactoryMock_, configuration));
+    usbHub->start(std::move(promise_));
+
+    ioService_.run();
+    ioService_.reset();
+
+    libusb_device_descriptor connectedDeviceDescriptor = {0};
+    connectedDeviceDescriptor.idVendor = 123;
+    connectedDeviceDescriptor.idProduct = 456;
+    connectedDeviceDescriptor.bDeviceClass = 0xFF;
+
+    EXPECT_CALL(usbWrapperMock_, getDeviceDescriptor(device_, _)).Times(2).WillRepeatedly(testing::DoAll(SetArgReferee<1>(connectedDeviceDescriptor), Return(0)));
+    EXPECT_CALL(usbWrapperMock_, open(device_, _)).Times(2).WillRepeatedly(testing::DoAll(SetArgReferee<1>(deviceHandle_), Return(0)));
+    EXPECT_CALL(queryChainFactoryMock_, create()).Times(2).WillRepeatedly(Return(queryChain_));
+
+    IAccessoryModeQueryChain::Promise::Pointer queryChainPromise;
+    EXPECT_CALL(queryChainMock_, start(deviceHandle_, _)).Times(2).WillRepeatedly(SaveArg<1>(&queryChainPromise));
+
+    hotplugCallback_(nullptr, device_, LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED, userData);
+    ioService_.run();
+    ioService_.reset();
+
+    queryChainPromise->reject(error::Error(error::ErrorCode::USB_AOAP_PROTOCOL_VERSION));
+    ioService_.run();
+    ioService_.reset();
+
+    // The rejection has already expired, the device is probed again.
+    hotplugCallback_(nullptr, device_, LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED, userData);
+    ioService_.run();
+    ioService_.reset();
+
+    EXPECT_CALL(queryChainMock_, cancel());
+    EXPECT_CALL(promiseHandlerMock_, onReject(error::Error(error::ErrorCode::OPERATION_ABORTED)));
+    usbHub->cancel();
+    ioService_.run();
+}
+
+BOOST_FIXTURE_TEST_CASE(USBHub_StartupTimelinePerDevice, USBHubUnitTest)
+{
+    void* userData = nullptr;
+    EXPECT_CALL(usbWrapperMock_, hotplugRegisterCallback(LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED, _,
+                                                         LIBUSB_HOTPLUG_MATCH_ANY, LIBUSB_HOTPLUG_MATCH_ANY,
+                                                         LIBUSB_HOTPLUG_MATCH_ANY, _, _))
+            .WillOnce(testing::DoAll(SaveArg<5>(&hotplugCallback_), SaveArg<6>(&userData), Return(hotplugCallbackHandle_)));
+
+    std::vector<metrics::StartupTimeline::Pointer> startupTimelines;
+    std::vector<error::Error> finishErrors;
+    USBHub::Pointer usbHub(std::make_shared<USBHub>(usbWrapperMock_, ioService_, queryChainFactoryMock_));
+    usbHub->setStartupTimelineFactory([&]() {
+        startupTimelines.push_back(std::make_shared<metrics::StartupTimeline>([&](const auto&, const error::Error& e) { finishErrors.push_back(e); }));
+        return startupTimelines.back();
+    });
+    usbHub->start(std::move(promise_));
+
+    ioService_.run();
+    ioService_.reset();
+
+    libusb_device_descriptor rejectingDeviceDescriptor = {0};
+    rejectingDeviceDescriptor.idVendor = 0x007B;
+    rejectingDeviceDescriptor.idProduct = 0x01C8;
+    libusb_device_descriptor phoneDeviceDescriptor = {0};
+    phoneDeviceDescriptor.idVendor = 0x007C;
+    phoneDeviceDescriptor.idProduct = 0x01C9;
+    libusb_device_descriptor aoapDeviceDescriptor = {0};
+    aoapDeviceDescriptor.idVendor = cGoogleVendorId;
+    aoapDeviceDescriptor.idProduct = cAOAPWithAdbId;
+
+    EXPECT_CALL(usbWrapperMock_, getDeviceDescriptor(device_, _))
+            .WillOnce(testing::DoAll(SetArgReferee<1>(rejectingDeviceDescriptor), Return(0)))
+            .WillOnce(testing::DoAll(SetArgReferee<1>(phoneDeviceDescriptor), Return(0)))
+            .WillOnce(testing::DoAll(SetArgReferee<1>(aoapDeviceDescriptor), Return(0)));
+    EXPECT_CALL(usbWrapperMock_, open(device_, _)).Times(3).WillRepeatedly(testing::DoAll(SetArgReferee<1>(deviceHandle_), Return(0)));
+    EXPECT_CALL(queryChainFactoryMock_, create()).Times(2).WillRepeatedly(Return(queryChain_));
+    EXPECT_CALL(queryChainMock_, setStartupTimeline(_)).Times(2);
+
+    IAccessoryModeQueryChain::Promise::Pointer queryChainPromise[2];
+    EXPECT_CALL(queryChainMock_, start(deviceHandle_, _)).WillOnce(SaveArg<1>(&queryChainPromise[0])).WillOnce(SaveArg<1>(&queryChainPromise[1]));
+
+    hotplugCallback_(nullptr, device_, LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED, userData);
+    hotplugCallback_(nullptr, device_, LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED, userData);
+    ioService_.run();
+    ioService_.reset();
+
+    queryChainPromise[0]->reject(error::Error(error::ErrorCode::USB_AOAP_PROTOCOL_VERSION));
+    queryChainPromise[1]->resolve(deviceHandle_);
+    ioService_.run();
+    ioService_.reset();
+
+    // The rejecting device reports its partial timeline, the phone's carries on after switching.
+    BOOST_REQUIRE_EQUAL(startupTimelines.size(), 2u);
+    BOOST_REQUIRE_EQUAL(finishErrors.size(), 1u);
+    BOOST_CHECK(finishErrors[0] == error::ErrorCode::USB_AOAP_PROTOCOL_VERSION);
+    BOOST_CHECK(startupTimelines[0]->isCompleted());
+    BOOST_CHECK(!startupTimelines[1]->isCompleted());
+
+    EXPECT_CALL(promiseHandlerMock_, onResolve(deviceHandle_));
+    hotplugCallback_(nullptr, device_, LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED, userData);
+    ioService_.run();
+    ioService_.reset();
+
+    BOOST_CHECK(usbHub->getStartupTimeline() == startupTimelines[1]);
+    const auto events = startupTimelines[1]->getEvents();
+    BOOST_REQUIRE_EQUAL(events.size(), 2u);
+    BOOST_CHECK(events[0].phase == metrics::StartupPhase::HOTPLUG_ARRIVED);
+    BOOST_CHECK_EQUAL(events[0].detail, "007c:01c9");
+    BOOST_CHECK(events[1].phase == metrics::StartupPhase::DEVICE_REENUMERATED);
+    BOOST_CHECK_EQUAL(events[1].detail, "18d1:2d01");
+
+    usbHub->cancel();
+    ioService_.run();
+}
+
+BOOST_FIXTURE_TEST_CASE(USBHub_FinishStartupTimelinesOnCancel, USBHubUnitTest)
+{
+    void* userData = nullptr;
+    EXPECT_CALL(usbWrapperMock_, hotplugRegisterCallback(LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED, _,
+                                                         LIBUSB_HOTPLUG_MATCH_ANY, LIBUSB_HOTPLUG_MATCH_ANY,
+                                                         LIBUSB_HOTPLUG_MATCH_ANY, _, _))
+            .WillOnce(testing::DoAll(SaveArg<5>(&hotplugCallback_), SaveArg<6>(&userData), Return(hotplugCallbackHandle_)));
+
+    std::vector<error::Error> finishErrors;
+    USBHub::Pointer usbHub(std::make_shared<USBHub>(usbWrapperMock_, ioService_, queryChainFactoryMock_));
+    usbHub->setStartupTimelineFactory([&]() {
+        return std::make_shared<metrics::StartupTimeline>([&](const auto&, const error::Error& e) { finishErrors.push_back(e); });
+    });
+    usbHub->start(std::move(promise_));
+
+    ioService_.run();
+    ioService_.reset();
+
+    libusb_device_descriptor connectedDeviceDescriptor = {0};
+    connectedDeviceDescriptor.idVendor = 123;
+    connectedDeviceDescriptor.idProduct = 456;
+
+    EXPECT_CALL(usbWrapperMock_, getDeviceDescriptor(device_, _)).Times(2).WillRepeatedly(testing::DoAll(SetArgReferee<1>(connectedDeviceDescriptor), Return(0)));
+    EXPECT_CALL(usbWrapperMock_, open(device_, _)).Times(2).WillRepeatedly(testing::DoAll(SetArgReferee<1>(deviceHandle_), Return(0)));
+    EXPECT_CALL(queryChainFactoryMock_, create()).Times(2).WillRepeatedly(Return(queryChain_));
+    EXPECT_CALL(queryChainMock_, setStartupTimeline(_)).Times(2);
+
+    IAccessoryModeQueryChain::Promise::Pointer queryChainPromise[2];
+    EXPECT_CALL(queryChainMock_, start(deviceHandle_, _)).WillOnce(SaveArg<1>(&queryChainPromise[0])).WillOnce(SaveArg<1>(&queryChainPromise[1]));
+
+    hotplugCallback_(nullptr, device_, LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED, userData);
+    hotplugCallback_(nullptr, device_, LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED, userData);
+    ioService_.run();
+    ioService_.reset();
+
+    // One device switched and waits for its re-enumeration, the other one is still queried.
+    queryChainPromise[0]->resolve(deviceHandle_);
+    ioService_.run();
+    ioService_.reset();
+
+    EXPECT_CALL(queryChainMock_, cancel());
+    EXPECT_CALL(promiseHandlerMock_, onReject(error::Error(error::ErrorCode::OPERATION_ABORTED)));
+    usbHub->cancel();
+    ioService_.run();
+    ioService_.reset();
+
+    queryChainPromise[1]->reject(error::Error(error::ErrorCode::OPERATION_ABORTED));
+    ioService_.run();
+
+    BOOST_REQUIRE_EQUAL(finishErrors.size(), 2u);
+    BOOST_CHECK(finishErrors[0] == error::ErrorCode::OPERATION_ABORTED);
+    BOOST_CHECK(finishErrors[1] == error::ErrorCode::OPERATION_ABORTED);
+}
+
 }
 }
 }
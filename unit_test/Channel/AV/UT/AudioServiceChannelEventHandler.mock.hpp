@@ -0,0 +1,48 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <gmock/gmock.h>
+#include <aasdk/Channel/AV/IAudioServiceChannelEventHandler.hpp>
+
+
+namespace aasdk
+{
+namespace channel
+{
+namespace av
+{
+namespace ut
+{
+
+class AudioServiceChannelEventHandlerMock: public IAudioServiceChannelEventHandler
+{
+public:
+    MOCK_METHOD1(onChannelOpenRequest, void(const proto::messages::ChannelOpenRequest& request));
+    MOCK_METHOD1(onAVChannelSetupRequest, void(const proto::messages::AVChannelSetupRequest& request));
+    MOCK_METHOD1(onAVChannelStartIndication, void(const proto::messages::AVChannelStartIndication& indication));
+    MOCK_METHOD1(onAVChannelStopIndication, void(const proto::messages::AVChannelStopIndication& indication));
+    MOCK_METHOD2(onAVMediaWithTimestampIndication, void(messenger::Timestamp::ValueType timestamp, const common::DataConstBuffer& buffer));
+    MOCK_METHOD1(onAVMediaIndication, void(const common::DataConstBuffer& buffer));
+    MOCK_METHOD1(onChannelError, void(const error::Error& e));
+};
+
+}
+}
+}
+}
@@ -0,0 +1,62 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <gmock/gmock.h>
+#include <asio.hpp>
+#include <aasdk/Channel/Promise.hpp>
+
+
+namespace aasdk
+{
+namespace channel
+{
+namespace ut
+{
+
+// Base of the fixtures testing a component which sends through a mocked service channel.
+// recordSent() is the default action for the mocked send method: it keeps the message and
+// resolves its promise, so the tests check sentMessages_ instead of matching arguments.
+template<typename ChannelMockType, typename MessageType>
+class ChannelSendFixture
+{
+protected:
+    ChannelSendFixture()
+        : channelMock_(std::make_shared<ChannelMockType>())
+    {
+
+    }
+
+    auto recordSent()
+    {
+        return ::testing::Invoke([this](const MessageType& message, SendPromise::Pointer promise) {
+            sentMessages_.push_back(message);
+            promise->resolve();
+        });
+    }
+
+    asio::io_service ioService_;
+    std::shared_ptr<ChannelMockType> channelMock_;
+    std::vector<MessageType> sentMessages_;
+};
+
+}
+}
+}
@@ -36,10 +36,13 @@ public:
     MOCK_METHOD0(deinit, void());
     MOCK_METHOD0(doHandshake, bool());
     MOCK_METHOD2(encrypt, size_t(common::Data& output, const common::DataConstBuffer& buffer));
-    MOCK_METHOD2(decrypt, size_t(common::Data& output, const common::DataConstBuffer& buffer));
+    MOCK_METHOD3(decrypt, size_t(common::Data& output, const common::DataConstBuffer& buffer, int length));
+    MOCK_METHOD3(encrypt, size_t(common::Data& output, const common::DataConstBuffer& buffer, error::Error& e));
+    MOCK_METHOD4(decrypt, size_t(common::Data& output, const common::DataConstBuffer& buffer, int length, error::Error& e));
     MOCK_METHOD0(readHandshakeBuffer, common::Data());
     MOCK_METHOD1(writeHandshakeBuffer, void(const common::DataConstBuffer& buffer));
     MOCK_CONST_METHOD0(isActive, bool());
+    MOCK_METHOD0(createRecordDecryptor, IRecordDecryptor::Pointer());
 };
 
 }
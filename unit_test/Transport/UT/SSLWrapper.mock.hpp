@@ -0,0 +1,70 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <gmock/gmock.h>
+#include <aasdk/Transport/ISSLWrapper.hpp>
+
+
+namespace aasdk
+{
+namespace transport
+{
+namespace ut
+{
+
+class SSLWrapperMock: public ISSLWrapper
+{
+public:
+    MOCK_METHOD1(readCertificate, X509*(const std::string& certificate));
+    MOCK_METHOD1(readPrivateKey, EVP_PKEY*(const std::string& privateKey));
+    MOCK_METHOD0(getMethod, const SSL_METHOD*());
+    MOCK_METHOD0(getServerMethod, const SSL_METHOD*());
+    MOCK_METHOD1(createContext, SSL_CTX*(const SSL_METHOD* method));
+    MOCK_METHOD2(useCertificate, bool(SSL_CTX* context, X509* certificate));
+    MOCK_METHOD2(usePrivateKey, bool(SSL_CTX* context, EVP_PKEY* privateKey));
+    MOCK_METHOD1(createInstance, SSL*(SSL_CTX* context));
+    MOCK_METHOD1(checkPrivateKey, bool(SSL* ssl));
+    MOCK_METHOD0(createBIOs, std::pair<BIO*, BIO*>());
+    MOCK_METHOD3(setBIOs, void(SSL* ssl, const BIOs& bIOs, size_t maxBufferSize));
+    MOCK_METHOD1(setConnectState, void(SSL* ssl));
+    MOCK_METHOD1(setAcceptState, void(SSL* ssl));
+    MOCK_METHOD1(doHandshake, int(SSL* ssl));
+    MOCK_METHOD1(free, void(SSL* ssl));
+    MOCK_METHOD1(free, void(SSL_CTX* context));
+    MOCK_METHOD1(free, void(BIO* bio));
+    MOCK_METHOD1(free, void(X509* certificate));
+    MOCK_METHOD1(free, void(EVP_PKEY* privateKey));
+    MOCK_METHOD1(free, void(SSL_SESSION* session));
+    MOCK_METHOD1(getSession, SSL_SESSION*(SSL* ssl));
+    MOCK_METHOD2(setSession, bool(SSL* ssl, SSL_SESSION* session));
+    MOCK_METHOD1(isSessionReused, bool(SSL* ssl));
+    MOCK_METHOD1(isSessionResumable, bool(const SSL_SESSION* session));
+    MOCK_METHOD2(exportPeerRecordKeys, bool(SSL* ssl, RecordKeys& keys));
+    MOCK_METHOD1(bioCtrlPending, size_t(BIO* b));
+    MOCK_METHOD3(bioRead, int(BIO* b, void* data, int len));
+    MOCK_METHOD3(bioWrite, int(BIO* b, const void* data, int len));
+    MOCK_METHOD1(getAvailableBytes, int(const SSL* ssl));
+    MOCK_METHOD3(sslRead, int(SSL* ssl, void* buf, int num));
+    MOCK_METHOD3(sslWrite, int(SSL* ssl, const void* buf, int num));
+    MOCK_METHOD2(getError, int(SSL* ssl, int returnCode));
+};
+
+}
+}
+}
@@ -35,6 +35,7 @@ public:
     MOCK_METHOD2(receive, void(size_t size, ReceivePromise::Pointer promise));
     MOCK_METHOD2(send, void(common::Data data, SendPromise::Pointer promise));
     MOCK_METHOD0(stop, void());
+    MOCK_CONST_METHOD0(getLastReceiveTimestamps, ReceiveTimestamps());
 };
 
 }
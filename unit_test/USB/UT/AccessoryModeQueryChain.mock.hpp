@@ -34,6 +34,7 @@ class AccessoryModeQueryChainMock: public IAccessoryModeQueryChain
 public:
     MOCK_METHOD2(start, void(DeviceHandle handle, Promise::Pointer promise));
     MOCK_METHOD0(cancel, void());
+    MOCK_METHOD1(setStartupTimeline, void(metrics::StartupTimeline::Pointer startupTimeline));
 };
 
 }
@@ -34,6 +34,8 @@ class USBHubMock: public IUSBHub
 public:
     MOCK_METHOD1(start, void(Promise::Pointer promise));
     MOCK_METHOD0(cancel, void());
+    MOCK_METHOD1(setStartupTimelineFactory, void(metrics::StartupTimeline::Factory startupTimelineFactory));
+    MOCK_CONST_METHOD0(getStartupTimeline, metrics::StartupTimeline::Pointer());
     MOCK_METHOD1(listenHotplugEvents, void(Promise::Pointer promise));
     MOCK_METHOD0(stopListenHotplugEvents, void());
 };